@@ -0,0 +1,293 @@
+/**
+ * @file LogFile.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link LogFile}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "LogFile.h"
+
+/**
+ * @brief Create a new instance of {@link LogFile}.
+ */
+LogFile::LogFile()
+{
+	this->skippedBytes = 0;
+}
+
+/**
+ * @brief Destroy the {@link LogFile} instance.
+ */
+LogFile::~LogFile()
+{
+}
+
+/**
+ * @brief Load a binary log file from the disk and check the header.
+ * @param fileName path to the log file
+ * @return true when the file was loaded
+ * @return false when the file could not be read or is not a supported log file
+ */
+bool LogFile::loadFromFile(const std::filesystem::path fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	this->data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	file.close();
+
+	return this->data.size() >= HEADER_SIZE && std::memcmp(this->data.data(), "NLLG", 4) == 0 && this->data[4] == FILE_VERSION;
+}
+
+/**
+ * @brief Decode all messages and write them as text lines.
+ * The lines look exactly like the ones rendered by the controller.
+ * Bytes which do not belong to a valid record are skipped.
+ * @param output stream for the text lines
+ * @return number of decoded messages
+ */
+size_t LogFile::decode(std::ostream &output)
+{
+	this->locations.clear();
+	this->texts.clear();
+	this->skippedBytes = 0;
+
+	size_t messageCount = 0;
+	size_t position = HEADER_SIZE;
+	while (position < this->data.size())
+	{
+		size_t size = 0;
+		if (this->data[position] == RecordType::LOCATION && this->readLocation(position, size))
+		{
+			position += size;
+		}
+		else if (this->data[position] == RecordType::TEXT && this->readText(position, size))
+		{
+			position += size;
+		}
+		else if ((this->data[position] & 0xFC) == RecordType::MESSAGE && this->readMessage(position, output, size))
+		{
+			position += size;
+			messageCount++;
+		}
+		else if ((this->data[position] & 0xFC) == RecordType::CONSTANT_MESSAGE && this->readConstantMessage(position, output, size))
+		{
+			position += size;
+			messageCount++;
+		}
+		else
+		{
+			position++;
+			this->skippedBytes++;
+		}
+	}
+
+	return messageCount;
+}
+
+/**
+ * @brief Get the number of bytes which were skipped during the last decoding because they are broken.
+ * @return number of skipped bytes
+ */
+size_t LogFile::getSkippedBytes()
+{
+	return this->skippedBytes;
+}
+
+/**
+ * @brief Read a location record and remember it for the following messages.
+ * @param position offset of the record
+ * @param size reference to the variable which will hold the size of the record
+ * @return true when the record is valid
+ * @return false when the record is broken
+ */
+bool LogFile::readLocation(const size_t position, size_t &size)
+{
+	if (position + 9 > this->data.size())
+	{
+		return false;
+	}
+
+	const uint8_t fileLength = this->data[position + 7];
+	if (position + 9 + fileLength > this->data.size())
+	{
+		return false;
+	}
+
+	const uint8_t functionLength = this->data[position + 8 + fileLength];
+	size = 9 + fileLength + functionLength;
+	if (position + size > this->data.size())
+	{
+		return false;
+	}
+
+	Location location;
+	location.file.assign(reinterpret_cast<const char *>(&this->data[position + 8]), fileLength);
+	location.function.assign(reinterpret_cast<const char *>(&this->data[position + 9 + fileLength]), functionLength);
+	location.line = this->readUint16(position + 5);
+	this->locations[this->readUint32(position + 1)] = location;
+	return true;
+}
+
+/**
+ * @brief Read a text record and remember it for the following constant messages.
+ * @param position offset of the record
+ * @param size reference to the variable which will hold the size of the record
+ * @return true when the record is valid
+ * @return false when the record is broken
+ */
+bool LogFile::readText(const size_t position, size_t &size)
+{
+	if (position + 7 > this->data.size())
+	{
+		return false;
+	}
+
+	size = 7 + this->readUint16(position + 5);
+	if (size - 7 > MAX_MESSAGE_LENGTH || position + size > this->data.size())
+	{
+		return false;
+	}
+
+	this->texts[this->readUint32(position + 1)].assign(reinterpret_cast<const char *>(&this->data[position + 7]), size - 7);
+	return true;
+}
+
+/**
+ * @brief Read a message record and write it as text line.
+ * @param position offset of the record
+ * @param output stream for the text line
+ * @param size reference to the variable which will hold the size of the record
+ * @return true when the record is valid
+ * @return false when the record is broken
+ */
+bool LogFile::readMessage(const size_t position, std::ostream &output, size_t &size)
+{
+	if (position + 11 > this->data.size())
+	{
+		return false;
+	}
+
+	size = 11 + this->readUint16(position + 9);
+	if (size - 11 > MAX_MESSAGE_LENGTH || position + size > this->data.size())
+	{
+		return false;
+	}
+
+	this->writeLine(output, this->data[position] & 0x03, this->readUint32(position + 1), this->readUint32(position + 5), reinterpret_cast<const char *>(&this->data[position + 11]), size - 11);
+	return true;
+}
+
+/**
+ * @brief Read a constant message record and write it as text line.
+ * @param position offset of the record
+ * @param output stream for the text line
+ * @param size reference to the variable which will hold the size of the record
+ * @return true when the record is valid
+ * @return false when the record is broken
+ */
+bool LogFile::readConstantMessage(const size_t position, std::ostream &output, size_t &size)
+{
+	size = 13;
+	if (position + size > this->data.size())
+	{
+		return false;
+	}
+
+	std::string text;
+	const uint32_t textId = this->readUint32(position + 9);
+	const std::unordered_map<uint32_t, std::string>::const_iterator known = this->texts.find(textId);
+	if (known != this->texts.end())
+	{
+		text = known->second;
+	}
+	else
+	{
+		char id[32];
+		std::snprintf(id, sizeof(id), "unknown text 0x%x", textId);
+		text = id;
+	}
+
+	this->writeLine(output, this->data[position] & 0x03, this->readUint32(position + 1), this->readUint32(position + 5), text.data(), text.size());
+	return true;
+}
+
+/**
+ * @brief Write a message as text line.
+ * @param output stream for the text line
+ * @param logLevel log level of the message
+ * @param time time in ms since the start of the controller
+ * @param locationId id of the source location
+ * @param message message text, does not need to be null terminated
+ * @param messageLength length of the message
+ */
+void LogFile::writeLine(std::ostream &output, const uint8_t logLevel, const uint32_t time, const uint32_t locationId, const char *message, const size_t messageLength)
+{
+	static const char *logLevels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+	uint32_t milli = time;
+	const uint32_t hour = milli / 3600000;
+	milli = milli - 3600000 * hour;
+	const uint32_t min = milli / 60000;
+	milli = milli - 60000 * min;
+	const uint32_t sec = milli / 1000;
+	milli = milli - 1000 * sec;
+
+	Location location;
+	const std::unordered_map<uint32_t, Location>::const_iterator known = this->locations.find(locationId);
+	if (known != this->locations.end())
+	{
+		location = known->second;
+	}
+	else
+	{
+		char id[16];
+		std::snprintf(id, sizeof(id), "0x%x", locationId);
+		location.file = id;
+		location.function = "unknown";
+		location.line = 0;
+	}
+
+	char prefix[32];
+	std::snprintf(prefix, sizeof(prefix), "%02u:%02u:%02u:%03u", hour, min, sec, milli);
+	output << prefix << " [" << logLevels[logLevel] << "] (" << location.file << ") (" << location.function << ") (" << location.line << "): ";
+	output.write(message, messageLength);
+	output << "\r\n";
+}
+
+/**
+ * @brief Read a little endian uint16 from the data.
+ * @param position offset of the value
+ * @return value
+ */
+uint16_t LogFile::readUint16(const size_t position)
+{
+	return this->data[position] | this->data[position + 1] << 8;
+}
+
+/**
+ * @brief Read a little endian uint32 from the data.
+ * @param position offset of the value
+ * @return value
+ */
+uint32_t LogFile::readUint32(const size_t position)
+{
+	return this->data[position] | this->data[position + 1] << 8 | this->data[position + 2] << 16 | static_cast<uint32_t>(this->data[position + 3]) << 24;
+}
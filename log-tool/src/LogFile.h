@@ -0,0 +1,79 @@
+/**
+ * @file LogFile.h
+ * @author TheRealKasumi
+ * @brief Contains a class to decode the binary log file of the controller.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef LOG_FILE_H
+#define LOG_FILE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+
+class LogFile
+{
+public:
+	enum RecordType
+	{
+		MESSAGE = 0xA0,
+		CONSTANT_MESSAGE = 0xA4,
+		TEXT = 0xAE,
+		LOCATION = 0xAF
+	};
+
+	struct Location
+	{
+		std::string file;
+		std::string function;
+		uint16_t line;
+	};
+
+	LogFile();
+	~LogFile();
+
+	bool loadFromFile(const std::filesystem::path fileName);
+	size_t decode(std::ostream &output);
+	size_t getSkippedBytes();
+
+private:
+	static const uint8_t FILE_VERSION = 1;
+	static const size_t HEADER_SIZE = 5;
+	static const size_t MAX_MESSAGE_LENGTH = 256;
+
+	std::vector<uint8_t> data;
+	std::unordered_map<uint32_t, Location> locations;
+	std::unordered_map<uint32_t, std::string> texts;
+	size_t skippedBytes;
+
+	bool readLocation(const size_t position, size_t &size);
+	bool readText(const size_t position, size_t &size);
+	bool readMessage(const size_t position, std::ostream &output, size_t &size);
+	bool readConstantMessage(const size_t position, std::ostream &output, size_t &size);
+	void writeLine(std::ostream &output, const uint8_t logLevel, const uint32_t time, const uint32_t locationId, const char *message, const size_t messageLength);
+	uint16_t readUint16(const size_t position);
+	uint32_t readUint32(const size_t position);
+};
+
+#endif
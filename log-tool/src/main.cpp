@@ -0,0 +1,106 @@
+/**
+ * @file main.cpp
+ * @author TheRealKasumi
+ * @brief Entry point for the NikoLight Log Tool.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "LogFile.h"
+
+// Function declarations
+void printHeader();
+void printHelp();
+
+/**
+ * @brief Entry point of the application.
+ * @param argc number of command line arguments
+ * @param argv command line argument
+ * @return int status code, 0 for success or the error code otherwise
+ */
+int main(int argc, char *argv[])
+{
+	if (argc != 2 && argc != 3)
+	{
+		printHeader();
+		printHelp();
+		exit(1);
+	}
+
+	const std::filesystem::path inputFile = argv[1];
+	LogFile logFile;
+	if (!logFile.loadFromFile(inputFile))
+	{
+		std::cerr << "Failed to load the log file. Only binary log files of the controller are supported." << std::endl;
+		exit(2);
+	}
+
+	// Without an output file the text is written to the console
+	if (argc == 2)
+	{
+		logFile.decode(std::cout);
+		exit(0);
+	}
+
+	printHeader();
+	const std::filesystem::path outputFile = argv[2];
+	std::ofstream output(outputFile, std::ios::binary);
+	if (!output.is_open())
+	{
+		std::cerr << "Failed to open the output file." << std::endl;
+		exit(3);
+	}
+
+	const size_t messageCount = logFile.decode(output);
+	output.close();
+	if (!output)
+	{
+		std::cerr << "Failed to write the output file." << std::endl;
+		exit(4);
+	}
+
+	std::cout << "Decoded " << messageCount << " messages to: " << outputFile << std::endl;
+	if (logFile.getSkippedBytes() > 0)
+	{
+		std::cout << "Skipped " << logFile.getSkippedBytes() << " bytes which do not belong to a valid record." << std::endl;
+	}
+	exit(0);
+}
+
+/**
+ * @brief Print the header because we can.
+ */
+void printHeader()
+{
+	std::cout << "NikoLight Log Tool (NLLT)" << std::endl;
+	std::cout << std::endl;
+}
+
+/**
+ * @brief Print the help.
+ */
+void printHelp()
+{
+	std::cout << "This tool decodes the binary log file of the controller into readable text. ";
+	std::cout << "Without an output file, the text is written to the console." << std::endl
+			  << std::endl;
+	std::cout << "Please call me again with the following arguments: nllt <input_log> [output_file]" << std::endl;
+}
@@ -24,6 +24,9 @@
 
 #include <Arduino.h>
 #include <SD.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
 
 #include "SystemInformation.h"
 #include "configuration/SystemConfiguration.h"
@@ -40,6 +43,7 @@
 #include "sensor/TemperatureSensor.h"
 #include "sensor/LightSensor.h"
 #include "sensor/MotionSensor.h"
+#include "sensor/SensorSnapshot.h"
 #include "wifi/WiFiManager.h"
 #include "server/WebServerManager.h"
 #include "server/ConnectionTestEndpoint.h"
@@ -55,24 +59,30 @@
 #include "server/MotionSensorEndpoint.h"
 #include "server/AudioUnitConfigurationEndpoint.h"
 #include "server/UIConfigurationEndpoint.h"
+#include "server/ProfilingEndpoint.h"
 #include "util/FileUtil.h"
+#include "util/FseqIndex.h"
 #include "util/WatchDog.h"
+#include "util/Profiler.h"
 #include "update/Updater.h"
 
 class NikoLight
 {
 public:
 	static void begin();
-	static void run();
 
 private:
 	NikoLight();
 
+	// Tasks
+	static TaskHandle_t renderTaskHandle;
+	static TaskHandle_t systemTaskHandle;
+	static esp_timer_handle_t frameTimerHandle;
+
 	// Timer
 	static unsigned long lightSensorInterval;
 	static unsigned long motionSensorInterval;
 	static unsigned long audioUnitInterval;
-	static unsigned long frameTimer;
 	static unsigned long lightSensorTimer;
 	static unsigned long motionSensorTimer;
 	static unsigned long audioUnitTimer;
@@ -81,9 +91,15 @@ private:
 	static unsigned long statusPrintTimer;
 	static unsigned long webServerTimer;
 
-	// Counter
+	// Counter, written by the render task and read by the system task
+	static portMUX_TYPE counterMux;
 	static uint16_t frameCounter;
 	static float ledPowerCounter;
+	static uint32_t renderTimeCounter;
+	static uint32_t transmitTimeCounter;
+	static uint32_t frameJitterCounter;
+	static uint32_t maxFrameJitter;
+	static uint32_t droppedFrameCounter;
 
 	// Workaround for v2.2
 	#if defined(HW_VERSION_2_2)
@@ -96,6 +112,7 @@ private:
 	static void initializeSdCard();
 	static void initializeSystemInformation();
 	static void initializeConfiguration();
+	static void initializeFseqIndex();
 	static void initializeHardwareModules();
 	static void initializeLedManager();
 	static void initializeMotionSensor();
@@ -106,6 +123,13 @@ private:
 	static void initializeWebServerManager();
 	static void initializeRestApi();
 	static void initializeTimers();
+	static void initializeTasks();
+
+	// Task functions
+	static void renderTask(void *parameter);
+	static void systemTask(void *parameter);
+	static void frameTimerCallback(void *parameter);
+	static void run();
 
 	// System update functions
 	static void handleUpdate();
@@ -39,7 +39,10 @@ namespace NL
 			String fwVersion;
 			uint8_t cpuCores;
 			uint32_t cpuClock;
+			uint32_t heapSize;
 			uint32_t freeHeap;
+			uint32_t minFreeHeap;
+			uint32_t maxAllocHeap;
 			uint32_t flashSize;
 			uint32_t flashSpeed;
 			uint32_t sketchSize;
@@ -68,6 +71,15 @@ namespace NL
 			float fps;
 			uint16_t ledCount;
 			uint16_t hiddenLedCount;
+			uint32_t renderTime;
+			uint32_t transmitTime;
+			uint32_t frameJitter;
+			uint32_t maxFrameJitter;
+			uint32_t droppedFrames;
+			uint32_t ledBufferSize;
+			uint32_t ledBufferSavedSize;
+			uint32_t fseqCacheHits;
+			uint32_t fseqCacheMisses;
 		};
 
 		static void begin();
@@ -23,10 +23,12 @@
 #define CONFIGURATION_H
 
 #include <stdint.h>
-#include <vector>
+#include <utility>
 #include <tuple>
+#include <atomic>
 #include <WString.h>
 #include <FS.h>
+#include <freertos/FreeRTOS.h>
 
 #include "configuration/SystemConfiguration.h"
 #include "util/BinaryFile.h"
@@ -49,7 +51,7 @@ namespace NL
 			ERROR_FILE_READ,		   // Failed to read file
 			ERROR_FILE_WRITE,		   // Failed to write file
 			ERROR_FILE_VERSION,		   // Unmatching file version
-			ERROR_FILE_HASH			   // Unmatching file hash
+			ERROR_FILE_HASH			   // Unmatching file checksum
 		};
 
 		struct SystemConfig
@@ -130,6 +132,24 @@ namespace NL
 			bool expertMode;
 		};
 
+		struct RuntimeConfig
+		{
+			uint32_t generation;												// Generation of the configuration, incremented with each change
+			uint8_t lightSensorMode;											// Mode of the light sensor
+			float lightSensorThreshold;											// Threshold value to turn on/off the LEDs from 0.0 to 1.0
+			float lightSensorMinAmbientBrightness;								// Minimum brightness of the ambient from 0.0 to 1.0
+			float lightSensorMaxAmbientBrightness;								// Maximum brightness of the ambient from 0.0 to 1.0
+			float lightSensorMinLedBrightness;									// Minimum brightness of the LEDs from 0.0 to 1.0
+			float lightSensorMaxLedBrightness;									// Maximum brightness of the LEDs from 0.0 to 1.0
+			uint32_t lightSensorDuration;										// Time in ms after which the lights are turning off when using the motion sensor
+			float regulatorPowerLimit;											// Power limit per regulator in W
+			float regulatorHighTemperature;										// Temp in °C where brightness is reduced
+			float regulatorTemperatureRange;									// Range in °C from the high temperature until the LEDs are turned off
+			uint8_t zoneRegulatorIndex[LED_NUM_ZONES];							// Index of the regulator powering each zone
+			float zoneChannelPower[LED_NUM_ZONES][3];							// Power draw in W per channel value of each zone
+			NL::Configuration::MotionSensorCalibration motionSensorCalibration; // Calibration data of the motion sensor
+		};
+
 		struct Profile
 		{
 			String name;										   // Name of the profile
@@ -171,29 +191,103 @@ namespace NL
 		static NL::Configuration::UIConfiguration getUIConfiguration();
 		static void setUIConfiguration(const NL::Configuration::UIConfiguration &uiConfiguration);
 
+		static uint32_t getRuntimeGeneration();
+		static void getRuntimeConfig(NL::Configuration::RuntimeConfig &runtimeConfig);
+
 		static void loadDefaults();
 		static NL::Configuration::Error load();
 		static NL::Configuration::Error save();
+		static void requestSave();
+		static void discardSave();
+		static NL::Configuration::Error handleSave(const bool force = false);
+		static void closeProfileFile();
 
 	private:
 		Configuration();
 
+		static const uint8_t PROFILE_SLOT_NONE = 0xFF;
+
+		struct __attribute__((packed)) LedConfigRecord
+		{
+			uint8_t ledPin;												// Physical pin for the LED output
+			uint16_t ledCount;											// Number of LEDs
+			uint8_t type;												// Type of the animation
+			uint8_t dataSource;											// Data source of the animation
+			uint8_t speed;												// Speed of the animation
+			uint16_t offset;											// Offset for the animation
+			uint8_t brightness;											// Brightness of the LED channel
+			bool reverse;												// Reverse the animation
+			uint8_t fadeSpeed;											// Fading speed when turning on/off
+			uint8_t animationSettings[ANIMATOR_NUM_ANIMATION_SETTINGS]; // Custom settings for each animation
+			float ledVoltage;											// Voltage of the LEDs
+			uint8_t ledChannelCurrent[3];								// Current for each LED channel per LED in mA
+		};
+
+		struct __attribute__((packed)) ProfileRecord
+		{
+			NL::Configuration::SystemConfig systemConfig;				 // System configuration of the profile
+			NL::Configuration::LedConfigRecord ledConfig[LED_NUM_ZONES]; // LED configuration of the profile
+		};
+
+		struct __attribute__((packed)) ProfileFileRecord
+		{
+			char name[CONFIGURATION_PROFILE_NAME_LENGTH + 1]; // Name of the profile
+			NL::Configuration::ProfileRecord profile;		  // System and LED configuration of the profile
+			char language[CONFIGURATION_UI_VALUE_LENGTH + 1]; // Language of the UI
+			char theme[CONFIGURATION_UI_VALUE_LENGTH + 1];	  // Theme of the UI
+			bool expertMode;								  // Expert mode of the UI
+			uint32_t checksum;								  // CRC32 of all previous fields
+		};
+
+		struct ProfileCacheEntry
+		{
+			bool used;							// Entry holds a profile
+			bool changed;						// Profile was changed and must be written to the profile file
+			size_t profileIndex;				// Index of the profile
+			uint32_t lastAccess;				// Access counter for the least recently used replacement
+			NL::Configuration::Profile profile; // Cached profile
+		};
+
 		static bool initialized;
 		static FS *fileSystem;
 		static String fileName;
 		static uint16_t configurationVersion;
 
-		static size_t activeProfile;
-		static std::vector<NL::Configuration::Profile> profiles;
+		static size_t profileCount;
+		static uint8_t profileSlots[CONFIGURATION_MAX_PROFILES];
+		static uint32_t profileNameHashes[CONFIGURATION_MAX_PROFILES];
+		static size_t savedProfileCount;
+		static uint8_t savedProfileSlots[CONFIGURATION_MAX_PROFILES];
+		static File profileFile;
+		static NL::Configuration::ProfileCacheEntry profileCache[CONFIGURATION_PROFILE_CACHE_SIZE];
+		static uint32_t profileCacheAccess;
 		static NL::Configuration::WiFiConfig wifiConfig;
 		static NL::Configuration::MotionSensorCalibration motionSensorCalibration;
 		static NL::Configuration::AudioUnitConfig audioUnitConfig;
 
-		static NL::Configuration::Error loadProfileDefaults(const size_t profileIndex);
+		static bool saveRequested;
+		static uint32_t saveRequestTime;
+
+		static portMUX_TYPE runtimeConfigMux;
+		static std::atomic<uint32_t> runtimeGeneration;
+		static NL::Configuration::RuntimeConfig runtimeConfig;
+
+		static void updateRuntimeConfig();
+		static uint8_t getRegulatorIndexFromPin(const uint8_t pin);
+		static void loadProfileDefaults(NL::Configuration::Profile &profile);
 		static NL::Configuration::Error getProfileIndexByName(const String &profileName, size_t &profileIndex);
+		static uint32_t getNameHash(const String &name);
+
+		static NL::Configuration::Error getCachedProfile(const size_t profileIndex, NL::Configuration::ProfileCacheEntry *&entry);
+		static NL::Configuration::Error addCacheEntry(const size_t profileIndex, NL::Configuration::ProfileCacheEntry *&entry);
+		static void clearProfileCache();
+		static NL::Configuration::Error readProfile(const size_t profileIndex, NL::Configuration::Profile &profile);
+		static NL::Configuration::Error readProfileRecord(const uint8_t slot, NL::Configuration::Profile &profile);
+		static NL::Configuration::Error writeProfileRecord(const size_t profileIndex, const NL::Configuration::Profile &profile);
+		static NL::Configuration::Error openProfileFile();
 
-		static uint16_t getSimpleHash();
-		static uint16_t getSimpleStringHash(const String input);
+		static void packProfile(const NL::Configuration::Profile &profile, NL::Configuration::ProfileRecord &record);
+		static void unpackProfile(const NL::Configuration::ProfileRecord &record, NL::Configuration::Profile &profile);
 	};
 }
 
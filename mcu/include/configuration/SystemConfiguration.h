@@ -39,20 +39,36 @@
 #endif
 
 // SD configuration
-#define SD_CS_PIN 5			 // CS pin for the SD card
-#define SD_SPI_SPEED 4000000 // SPI data rate
-#define SD_MOUNT_POINT "/sd" // Mount point for the SD card
-#define SD_MAX_FILES 5		 // Maximum number of open files
+#define SD_CS_PIN 5						// CS pin for the SD card
+#define SD_SPI_SPEED 4000000			// SPI data rate
+#define SD_MOUNT_POINT "/sd"			// Mount point for the SD card
+#define SD_MAX_FILES 10					// Maximum number of open files, the log, the profiles and two fseq files are held open
+#define BINARY_FILE_BUFFER_SIZE 4096	// Size of the block buffer for reading and writing binary files
 
 // Logging configuration
 #define SERIAL_BAUD_RATE 115200			// Serial baud rate
-#define LOG_FILE_NAME "/system_log.txt" // File name of the log file
+#define LOG_FILE_NAME "/system_log.nlg" // File name of the log file
 #define LOG_DEFAULT_LEVEL 1 			// Default log level
+#define LOG_ROTATED_FILE_NAME "/system_log.1.nlg"	// File name of the previous log file after rotation
+#define LOG_FILE_VERSION 1							// Version of the binary log file format
+#define LOG_MAX_FILE_SIZE 262144					// Maximum size of the log file in bytes before it is rotated
+#define LOG_BUFFER_SIZE 8192						// Size of the ring buffer for log records in bytes
+#define LOG_WRITE_BUFFER_SIZE 4096					// Size of the buffer for encoded records, which is appended to the log file at once
+#define LOG_MAX_MESSAGE_LENGTH 256					// Maximum length of a log message, longer messages are cut off
+#define LOG_MAX_LINE_LENGTH 400						// Maximum length of a rendered log line, longer lines are cut off
+#define LOG_FLUSH_INTERVAL 250						// Interval in ms in which buffered log records are written to the log file
 
 // Configuration of the runtime configuration
-#define CONFIGURATION_FILE_VERSION 14		  // Version of the configuration file
-#define CONFIGURATION_FILE_NAME "/config.nli" // File name of the configuration file
-#define CONFIGURATION_MAX_PROFILES 50		  // Maximum number of profiles
+#define CONFIGURATION_FILE_VERSION 16										// Version of the configuration file
+#define CONFIGURATION_FILE_NAME "/config.nli"								// File name of the configuration file
+#define CONFIGURATION_TEMP_FILE_NAME "/config.nli.tmp"						// Temporary file, which replaces the configuration file once it was written
+#define CONFIGURATION_PROFILE_FILE_NAME "/profiles.nlp"						// File name of the file holding the profile records
+#define CONFIGURATION_MAX_PROFILES 50										// Maximum number of profiles
+#define CONFIGURATION_PROFILE_SLOTS (CONFIGURATION_MAX_PROFILES * 2 + 1)	// Number of record slots in the profile file, changed profiles are written to a free slot
+#define CONFIGURATION_PROFILE_CACHE_SIZE 4									// Number of profiles kept in memory, including the active profile
+#define CONFIGURATION_PROFILE_NAME_LENGTH 24								// Maximum length of a profile name
+#define CONFIGURATION_UI_VALUE_LENGTH 16									// Maximum length of the language and theme of the UI configuration
+#define CONFIGURATION_SAVE_DELAY 1000										// Time in ms after the last change until the configuration is saved
 
 // LED and effect configuration
 #define LED_NUM_ZONES 8 											  // Number of LED zones
@@ -68,6 +84,12 @@
 #define LED_DEFAULT_COUNTS {2, 2, 2, 2, 2, 2, 2, 2}					  // Default number of LEDs for each channel
 #define LED_DEFAULT_CHANNEL_CURRENT 16 								  // Default current per LED channel in mA
 #define LED_MAX_COUNT_PER_ZONE 250									  // Maximum number of LEDs per channel
+#define LED_MAX_ZONES_PER_DRIVER 8									  // Maximum number of zones per I2S device, more zones are spread across both devices
+#define LED_DRIVER_OUTPUT_MODE 0									  // 0 = transpose per LED in the ISR, 1 = transpose the full frame (more DMA memory, single interrupt)
+#define LED_CROSSFADE_FRAMES 15										  // Number of frames to crossfade from the old to the new animation after a reload, 0 to disable
+#if LED_NUM_ZONES > 2 * LED_MAX_ZONES_PER_DRIVER
+	#error "The LED driver supports at most two I2S devices with 8 zones each."
+#endif
 #define ANIMATOR_NUM_ANIMATION_SETTINGS 25  						  // Number of custom fields in the LED configuration
 #define ANIMATOR_DEFAULT_TYPE 0		   								  // Default animation type
 #define ANIMATOR_DEFAULT_DATA_SOURCE 0								  // Default data source of the animation
@@ -229,8 +251,36 @@
 #define STATUS_PRINT_INTERVAL 5000000	// Interval for printing the current status in µs
 #define WATCHDOG_RESET_TIME 3			// Time until a watchdog reset is triggered
 
+// Task configuration
+#define RENDER_TASK_CORE 1					// Core of the render task, which renders and outputs the LED frames
+#define RENDER_TASK_PRIORITY 5				// Priority of the render task
+#define RENDER_TASK_STACK_SIZE 8192			// Stack size of the render task in bytes
+#define SYSTEM_TASK_CORE 0					// Core of the system task, which handles sensors, web server and logging
+#define SYSTEM_TASK_PRIORITY 1				// Priority of the system task
+#define SYSTEM_TASK_STACK_SIZE 8192			// Stack size of the system task in bytes
+#define FSEQ_READER_TASK_CORE 0				// Core of the fseq reader task, which reads frames ahead of the render task
+#define FSEQ_READER_TASK_PRIORITY 2			// Priority of the fseq reader task
+#define FSEQ_READER_TASK_STACK_SIZE 4096	// Stack size of the fseq reader task in bytes
+#define FSEQ_PLAYLIST_TASK_CORE 0			// Core of the fseq playlist task, which opens the next sequence of the playlist
+#define FSEQ_PLAYLIST_TASK_PRIORITY 1		// Priority of the fseq playlist task
+#define FSEQ_PLAYLIST_TASK_STACK_SIZE 4096	// Stack size of the fseq playlist task in bytes
+#define LOG_TASK_CORE 0						// Core of the log writer task, which writes buffered log messages to the SD card
+#define LOG_TASK_PRIORITY 1					// Priority of the log writer task
+#define LOG_TASK_STACK_SIZE 4096			// Stack size of the log writer task in bytes
+
 // FSEQ configuration
-#define FSEQ_DIRECTORY "/fseq" // Directory for fseq files
+#define FSEQ_DIRECTORY "/fseq"					// Directory for fseq files
+#define FSEQ_INDEX_FILE_NAME "/fseq/.index"		// File name of the index of all fseq files
+#define FSEQ_INDEX_FILE_VERSION 1				// Version of the fseq index file
+#define FSEQ_READ_AHEAD_FRAMES 3				// Number of frames which are read ahead from the SD card
+#define FSEQ_INPUT_BUFFER_SIZE 1024				// Size of the input buffer for compressed fseq files in bytes
+#define FSEQ_MAX_FRAME_LAG 8					// Number of frames the playback may lag behind before the reader seeks forward
+#define FSEQ_CACHE_SIZE 65536					// Maximum size of a fseq animation that is played from internal RAM in bytes
+#define FSEQ_CACHE_SIZE_PSRAM 2097152			// Maximum size of a fseq animation that is played from PSRAM in bytes
+#define FSEQ_HEAP_RESERVE 32768					// Internal heap in bytes which is kept free for WiFi and the web server when allocating fseq buffers
+#define FSEQ_PLAYLIST_FILE_NAME "/playlist.nll"	// File name of the fseq playlist
+#define FSEQ_PLAYLIST_MAX_ENTRIES 32			// Maximum number of entries in the fseq playlist
+#define FSEQ_PLAYLIST_PRELOAD_TIMEOUT 5000		// Time in ms to wait for the next sequence of the playlist to be buffered
 
 // Update configuration
 #define UPDATE_DIRECTORY "/update"	  // Update folder
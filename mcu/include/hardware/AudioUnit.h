@@ -27,6 +27,8 @@
 #include <tuple>
 #include <Wire.h>
 
+#include "configuration/SystemConfiguration.h"
+
 namespace NL
 {
 	class AudioUnit
@@ -72,10 +74,11 @@ namespace NL
 
 		struct AudioAnalysis
 		{
-			uint8_t seq;												  // Sequence number
-			uint16_t volumePeak;										  // Maximum volume detected since the last cycle
-			std::vector<uint16_t> frequencyBandValues;					  // Intensity values for each frequency band
-			std::vector<NL::AudioUnit::PeakResult> frequencyBandTriggers; // Trigger for each frequency band
+			uint8_t seq;																// Sequence number
+			uint16_t volumePeak;														// Maximum volume detected since the last cycle
+			uint8_t frequencyBandCount;													// Number of valid frequency bands
+			uint16_t frequencyBandValues[AUDIO_UNIT_NUM_BANDS];							// Intensity values for each frequency band
+			NL::AudioUnit::PeakResult frequencyBandTriggers[AUDIO_UNIT_NUM_BANDS];		// Trigger for each frequency band
 		};
 
 		static NL::AudioUnit::Error begin(const uint8_t deviceAddress);
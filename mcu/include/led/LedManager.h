@@ -25,6 +25,8 @@
 #include <vector>
 #include <memory>
 #include <SD.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include "configuration/SystemConfiguration.h"
 #include "configuration/Configuration.h"
@@ -41,8 +43,10 @@
 #include "led/animator/PulseAnimator.h"
 #include "led/animator/EqualizerAnimator.h"
 
-#include "util/FileUtil.h"
+#include "util/FseqIndex.h"
+#include "util/Profiler.h"
 #include "sensor/MotionSensor.h"
+#include "sensor/SensorSnapshot.h"
 #include "hardware/AudioUnit.h"
 
 namespace NL
@@ -52,14 +56,16 @@ namespace NL
 	public:
 		enum class Error
 		{
-			OK,								// No error
-			ERROR_CONFIG_UNAVAILABLE,		// The configuration is not available
-			ERROR_INIT_LED_DRIVER,			// Failed to initialize the LED driver
-			ERROR_DRIVER_NOT_READY,			// The LED driver is not ready to send new LED data
-			ERROR_UNKNOWN_ANIMATOR_TYPE,	// The animator type is unknown
-			ERROR_FILE_NOT_FOUND,			// The animation file was not found
-			ERROR_INVALID_FSEQ,				// When a custom animation was set but the fseq file is invalid
-			ERROR_INVALID_LED_CONFIGURATION // The current LED configuration does not match the custom animation
+			OK,									// No error
+			ERROR_CONFIG_UNAVAILABLE,			// The configuration is not available
+			ERROR_INIT_LED_DRIVER,				// Failed to initialize the LED driver
+			ERROR_DRIVER_NOT_READY,				// The LED driver is not ready to send new LED data
+			ERROR_UNKNOWN_ANIMATOR_TYPE,		// The animator type is unknown
+			ERROR_FILE_NOT_FOUND,				// The animation file was not found
+			ERROR_INVALID_FSEQ,					// When a custom animation was set but the fseq file is invalid
+			ERROR_INVALID_LED_CONFIGURATION,	// The current LED configuration does not match the custom animation
+			ERROR_NO_CUSTOM_ANIMATION,			// No custom animation is loaded
+			ERROR_INVALID_POSITION				// The position is behind the end of the custom animation
 		};
 
 		static NL::LedManager::Error begin();
@@ -68,20 +74,19 @@ namespace NL
 
 		static NL::LedManager::Error reloadAnimations();
 		static void clearAnimations();
-
-		static void setAmbientBrightness(const float ambientBrightness);
+		static NL::LedManager::Error seekCustomAnimation(const uint32_t time);
+		static bool getCustomAnimationPosition(uint32_t &frameIndex, uint32_t &time);
 
 		static void setFrameInterval(const uint32_t frameInterval);
 		static uint32_t getFrameInterval();
 
-		static void setMotionSensorData(const NL::MotionSensor::MotionSensorData &motionSensorData);
-		static void setAudioAnalysis(const NL::AudioUnit::AudioAnalysis &audioAnalysis);
-
-		static void setRegulatorTemperature(const float regulatorTemperature);
-
 		static float getLedPowerDraw();
 		static size_t getLedCount();
 		static size_t getHiddenLedCount();
+		static size_t getLedBufferSize();
+
+		static uint32_t getRenderTime();
+		static uint32_t getTransmitTime();
 
 		static void render();
 		static NL::LedManager::Error waitShow(const TickType_t timeout);
@@ -91,22 +96,43 @@ namespace NL
 		LedManager();
 
 		static bool initialized;
-		static std::unique_ptr<NL::LedBuffer> ledBuffer;
+		static SemaphoreHandle_t mutex;
+		static std::vector<std::unique_ptr<NL::LedBuffer>> ledBuffer;
+		static std::vector<std::unique_ptr<NL::LedDriver>> ledDriver;
+		static size_t zonesPerDriver;
 		static std::vector<std::unique_ptr<NL::LedAnimator>> ledAnimator;
-		static std::unique_ptr<NL::FseqLoader> fseqLoader;
+		static std::unique_ptr<NL::FseqPlaylist> fseqPlaylist;
+		static NL::Profiler::Stage animatorStage[LED_NUM_ZONES];
+		static NL::Configuration::LedConfig loadedLedConfig[LED_NUM_ZONES];
+
+		static std::vector<uint8_t> crossfadeBuffer;
+		static size_t crossfadeOffset[LED_NUM_ZONES];
+		static bool crossfadeZone[LED_NUM_ZONES];
+		static uint16_t crossfadeStep;
 
 		static uint32_t frameInterval;
+		static bool fseqFrameInterval;
 		static float regulatorTemperature;
+		static NL::Configuration::RuntimeConfig runtimeConfig;
+		static float ledPowerDraw;
+		static uint32_t renderTime;
+		static bool sensorDataPending;
+
+		static void lock();
+		static void unlock();
 
+		static void applySensorData(const NL::SensorSnapshot::SensorData &sensorData);
 		static NL::LedManager::Error initLedDriver();
+		static NL::LedStrip &getLedStrip(const size_t zoneIndex);
 		static NL::LedManager::Error createAnimators();
 		static NL::LedManager::Error loadCalculatedAnimations();
-		static NL::LedManager::Error loadCustomAnimation(const String &fileName);
+		static NL::LedManager::Error loadCalculatedAnimator(const size_t zoneIndex, const NL::Configuration::LedConfig &ledConfig);
+		static NL::LedManager::Error loadCustomAnimation();
+		static void applyAnimatorSettings(const size_t zoneIndex, const NL::Configuration::LedConfig &ledConfig);
 
-		static void calculateRegulatorPowerDraw(float regulatorPower[REGULATOR_COUNT]);
-		static void limitPowerConsumption();
-		static void limitRegulatorTemperature();
-		static uint8_t getRegulatorIndexFromPin(const uint8_t pin);
+		static void startCrossfade(const bool zoneChanged[LED_NUM_ZONES]);
+		static void applyCrossfade();
+		static float applyPostProcessing();
 	};
 }
 
@@ -24,22 +24,22 @@
 
 #include <vector>
 #include "led/animator/LedAnimator.h"
-#include "util/FseqLoader.h"
+#include "util/FseqPlaylist.h"
 
 namespace NL
 {
 	class FseqAnimator : public LedAnimator
 	{
 	public:
-		FseqAnimator(NL::FseqLoader *fseqLoader, const bool loop = false);
+		FseqAnimator(NL::FseqPlaylist *fseqPlaylist, const size_t channelOffset = 0);
 		~FseqAnimator();
 
 		void init(NL::LedStrip &ledStrip);
 		void render(NL::LedStrip &ledStrip);
 
 	private:
-		NL::FseqLoader *fseqLoader;
-		bool loop;
+		NL::FseqPlaylist *fseqPlaylist;
+		size_t channelOffset;
 	};
 }
 
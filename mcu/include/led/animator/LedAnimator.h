@@ -29,6 +29,7 @@
 #include "led/driver/LedStrip.h"
 #include "sensor/MotionSensor.h"
 #include "hardware/AudioUnit.h"
+#include "sensor/SensorSnapshot.h"
 
 namespace NL
 {
@@ -75,6 +76,7 @@ namespace NL
 
 		void setAnimationBrightness(const float animationBrightness);
 		float getAnimationBrightness();
+		float getTotalBrightness();
 
 		void setAmbientBrightness(const float ambientBrightness);
 		float getAmbientBrightness();
@@ -85,11 +87,8 @@ namespace NL
 		void setReverse(const bool reverse);
 		bool getReverse();
 
-		void setMotionSensorData(const NL::MotionSensor::MotionSensorData &motionSensorData);
-		NL::MotionSensor::MotionSensorData &getMotionSensorData();
-
-		void setAudioAnalysis(const NL::AudioUnit::AudioAnalysis &audioAnalysis);
-		NL::AudioUnit::AudioAnalysis &getAudioAnalysis();
+		void setSensorData(const NL::SensorSnapshot::SensorData &sensorData);
+		const NL::SensorSnapshot::SensorData &getSensorData();
 
 		virtual void init(NL::LedStrip &ledStrip) = 0;
 		virtual void render(NL::LedStrip &ledStrip) = 0;
@@ -104,11 +103,10 @@ namespace NL
 		float fadeSpeed;
 		bool reverse;
 
-		NL::MotionSensor::MotionSensorData motionSensorData;
-		NL::AudioUnit::AudioAnalysis audioAnalysis;
+		const NL::SensorSnapshot::SensorData *sensorData;
 
 		void reversePixels(NL::LedStrip &ledStrip);
-		void applyBrightness(NL::LedStrip &ledStrip);
+		void updateBrightness();
 		static int32_t random(const int32_t min, const int32_t max);
 		static float trapezoid(float angle);
 		static float trapezoid2(float angle);
@@ -38,6 +38,8 @@ namespace NL
 
 		size_t getBufferSize();
 		uint8_t *getBuffer();
+		uint8_t *getFrontBuffer();
+		void swapBuffers();
 
 		size_t getTotalLedCount();
 		size_t getMaxLedCount();
@@ -54,7 +56,10 @@ namespace NL
 		size_t maxLedCount;
 		size_t totalHiddenLedCount;
 		size_t maxHiddenLedCount;
-		uint8_t *buffer;
+		uint8_t *buffer[2];
+		uint8_t backBufferIndex;
+
+		void assignStripBuffers();
 	};
 }
 
@@ -1,7 +1,7 @@
 /**
  * @file LedDriver.h
  * @author TheRealKasumi
- * @brief Contains a class with an LED driver for WS2812B LEDs. It support parallel output for up to 8 channels.
+ * @brief Contains a class with an LED driver for WS2812B LEDs. It support parallel output for up to 8 channels per I2S device.
  *
  * @copyright Copyright (c) 2023 TheRealKasumi
  *
@@ -27,6 +27,7 @@
 #include <rom/ets_sys.h>
 #include <rom/lldesc.h>
 #include <esp_heap_caps.h>
+#include <esp_timer.h>
 #include <soc/i2s_reg.h>
 #include <soc/i2s_struct.h>
 #include <soc/io_mux_reg.h>
@@ -35,6 +36,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
+#include "configuration/SystemConfiguration.h"
 #include "led/driver/LedBuffer.h"
 
 namespace NL
@@ -44,13 +46,15 @@ namespace NL
     public:
         enum class Error
         {
-            OK,                       // No error
-            ERROR_NO_LED_STRIPS,      // No LED strips provided
-            ERROR_NOT_INITIALIZED,    // Not initialized yet
-            ERROR_SET_PIN,            // Failed to configure the output pin
-            ERROR_ALLOCATE_INTERRUPT, // Failed to allocate the interrupt
-            ERROR_ENABLE_INTERRUPT,   // Failed to enable interrupt
-            ERROR_STILL_SENDING       // When the driver is still sending LED data
+            OK,                        // No error
+            ERROR_NO_LED_STRIPS,       // No LED strips provided
+            ERROR_NOT_INITIALIZED,     // Not initialized yet
+            ERROR_SET_PIN,             // Failed to configure the output pin
+            ERROR_ALLOCATE_INTERRUPT,  // Failed to allocate the interrupt
+            ERROR_ENABLE_INTERRUPT,    // Failed to enable interrupt
+            ERROR_STILL_SENDING,       // When the driver is still sending LED data
+            ERROR_ALLOCATE_DMA_BUFFER, // Failed to allocate the DMA buffers
+            ERROR_DEVICE_IN_USE        // The I2S device is already used by another driver
         };
 
         enum class I2SDevice : uint8_t
@@ -59,50 +63,71 @@ namespace NL
             I2S_DEV_1 = 1  // I2S Device 1
         };
 
-        static NL::LedDriver::Error begin(NL::LedBuffer &ledBuffer, const NL::LedDriver::I2SDevice i2sDeviceIdentifier = NL::LedDriver::I2SDevice::I2S_DEV_0);
-        static bool isInitialized();
-        static void end();
+        enum class OutputMode : uint8_t
+        {
+            OUTPUT_ISR = 0,  // Transpose each LED in the interrupt handler using two small ping-pong buffers
+            OUTPUT_FRAME = 1 // Transpose the full frame before sending and only interrupt at the end of the frame
+        };
 
-        static NL::LedDriver::Error isReady(const TickType_t timeout = 0);
-        static NL::LedDriver::Error showPixels(const TickType_t timeout = 0);
+        LedDriver(const NL::LedDriver::I2SDevice i2sDeviceIdentifier = NL::LedDriver::I2SDevice::I2S_DEV_0);
+        ~LedDriver();
 
-    private:
-        LedDriver();
+        NL::LedDriver::Error begin(NL::LedBuffer &ledBuffer, const NL::LedDriver::OutputMode outputMode = NL::LedDriver::OutputMode::OUTPUT_ISR);
+        bool isInitialized();
+        void end();
 
+        NL::LedDriver::Error isReady(const TickType_t timeout = 0);
+        NL::LedDriver::Error showPixels(const TickType_t timeout = 0);
+        uint32_t getTransmitTime();
+
+    private:
         struct DMABuffer
         {
             lldesc_t descriptor;
             uint8_t *buffer;
         };
 
-        static bool initialized;
-
-        static uint8_t *ledBuffer;
-        static volatile uint16_t ledIndex;
-        static volatile uint16_t ledStripCount;
-        static uint16_t ledStripLength[8];
-        static volatile uint16_t ledStripMaxLength;
-
-        static i2s_dev_t *i2sDevice;
-        static NL::LedDriver::I2SDevice i2sDeviceIdentifier;
-
-        static NL::LedDriver::DMABuffer *dmaBuffer[4];
-        static volatile uint8_t dmaBufferIndex;
-
-        static intr_handle_t interruptHandle;
-        static volatile xSemaphoreHandle semaphore;
-
-        static NL::LedDriver::Error initPin(const uint8_t outputPin, const uint8_t ledStripIndex);
-        static NL::LedDriver::Error initI2S();
-        static NL::LedDriver::Error startI2S(const NL::LedDriver::DMABuffer *startBuffer);
-        static void IRAM_ATTR resetI2S();
-        static void IRAM_ATTR stopI2S();
-        static void resetDMA();
-        static void resetFIFO();
-
-        static NL::LedDriver::DMABuffer *allocateDMABuffer(const uint32_t size);
-        static void freeDMABuffer(NL::LedDriver::DMABuffer *dmaBuffer);
-        static void initDMABuffers();
+        static bool deviceInUse[2];
+
+        bool initialized;
+
+        NL::LedBuffer *ledBuffer;
+        uint8_t *frontBuffer;
+        volatile uint16_t ledIndex;
+        volatile uint16_t ledStripCount;
+        uint16_t ledStripLength[LED_MAX_ZONES_PER_DRIVER];
+        volatile uint16_t ledStripMaxLength;
+
+        i2s_dev_t *i2sDevice;
+        NL::LedDriver::I2SDevice i2sDeviceIdentifier;
+
+        NL::LedDriver::OutputMode outputMode;
+        NL::LedDriver::DMABuffer *dmaBuffer[4];
+        volatile uint8_t dmaBufferIndex;
+        uint8_t *frameBuffer;
+        lldesc_t *frameDescriptor;
+        uint16_t frameDescriptorCount;
+
+        intr_handle_t interruptHandle;
+        volatile xSemaphoreHandle semaphore;
+
+        volatile uint32_t transmitStartTime;
+        volatile uint32_t transmitTime;
+
+        NL::LedDriver::Error initPin(const uint8_t outputPin, const uint8_t ledStripIndex);
+        NL::LedDriver::Error initI2S();
+        NL::LedDriver::Error startI2S(const NL::LedDriver::DMABuffer *startBuffer);
+        void IRAM_ATTR resetI2S();
+        void IRAM_ATTR stopI2S();
+        void resetDMA();
+        void resetFIFO();
+
+        NL::LedDriver::DMABuffer *allocateDMABuffer(const uint32_t size);
+        void freeDMABuffer(NL::LedDriver::DMABuffer *dmaBuffer);
+        void initDMABuffers();
+        NL::LedDriver::Error initFrameBuffer();
+        void freeFrameBuffer();
+        void loadFrameBuffer();
 
         static void IRAM_ATTR interruptHandler(void *args);
         static void IRAM_ATTR loadDMABuffer(uint8_t *ledBuffer, uint16_t *dmaBuffer, const uint16_t *ledStripLength, const uint16_t ledStripCount, const uint16_t ledIndex);
@@ -0,0 +1,75 @@
+/**
+ * @file LogReader.h
+ * @author TheRealKasumi
+ * @brief Contains a class to read the binary log file and render it as text.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef LOG_READER_H
+#define LOG_READER_H
+
+#include <stdint.h>
+#include <unordered_map>
+#include <algorithm>
+#include <FS.h>
+
+#include "configuration/SystemConfiguration.h"
+#include "logging/Logger.h"
+
+namespace NL
+{
+	class LogReader
+	{
+	public:
+		enum class Error
+		{
+			OK,					// No error
+			ERROR_FILE_READ,	// The file could not be read
+			ERROR_FILE_VERSION, // The file is not a log file or the version is not supported
+			ERROR_END_OF_FILE	// The end of the file was reached
+		};
+
+		LogReader(File &file);
+
+		NL::LogReader::Error begin();
+		void seek(const uint32_t position);
+		uint32_t getPosition();
+		NL::LogReader::Error readLine(char *buffer, const size_t bufferSize, size_t &length);
+
+	private:
+		struct Location
+		{
+			String file;	 // Path and name of the source file
+			String function; // Name of the function
+			uint16_t line;	 // Line in code
+		};
+
+		File &file;
+		uint32_t fileSize;
+		uint32_t position;
+		std::unordered_map<uint32_t, NL::LogReader::Location> locations;
+		std::unordered_map<uint32_t, String> texts;
+
+		bool getRecordSize(const uint32_t offset, uint32_t &size);
+		bool readLocation(const uint32_t offset, uint32_t &locationId, NL::LogReader::Location &location, uint32_t &size);
+		NL::LogReader::Location getLocation(const uint32_t locationId);
+		bool readText(const uint32_t offset, uint32_t &textId, String &text, uint32_t &size);
+		String getText(const uint32_t textId);
+	};
+}
+
+#endif
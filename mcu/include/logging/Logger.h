@@ -23,11 +23,21 @@
 #define LOGGER_H
 
 #include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <type_traits>
+#include <unordered_map>
 #include <HardwareSerial.h>
 #include <WString.h>
 #include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/ringbuf.h>
 
-#define SOURCE_LOCATION __FILE__, __func__, __LINE__
+#include "configuration/SystemConfiguration.h"
+
+#define SOURCE_LOCATION std::integral_constant<uint32_t, NL::Logger::getLocationId(__FILE__, __LINE__)>::value, __FILE__, __func__, __LINE__
 
 namespace NL
 {
@@ -43,6 +53,27 @@ namespace NL
 			ERROR = 3
 		};
 
+		enum class RecordType : uint8_t
+		{
+			MESSAGE = 0xA0,			 // Log message, the lower two bits contain the log level
+			CONSTANT_MESSAGE = 0xA4, // Log message referencing a text record, the lower two bits contain the log level
+			TEXT = 0xAE,			 // Constant message text, written once per log file before the first message referencing it
+			LOCATION = 0xAF			 // Source location, written once per log file before the first message referencing it
+		};
+
+		/**
+		 * @brief Get the id of a source location as FNV-1a hash of the file name and line.
+		 * Evaluated at compile time by {@link SOURCE_LOCATION}.
+		 * @param file path and name of the source file
+		 * @param line line in code
+		 * @param hash hash of the previous characters
+		 * @return id of the source location
+		 */
+		static constexpr uint32_t getLocationId(const char *file, const int line, const uint32_t hash = 2166136261u)
+		{
+			return *file != '\0' ? getLocationId(file + 1, line, (hash ^ static_cast<uint8_t>(*file)) * 16777619u) : (hash ^ static_cast<uint32_t>(line)) * 16777619u;
+		}
+
 		static bool begin(const NL::Logger::LogLevel minLogLevel = NL::Logger::LogLevel::INFO);
 		static bool begin(const uint32_t baudRate, const NL::Logger::LogLevel minLogLevel = NL::Logger::LogLevel::INFO);
 		static bool begin(FS *fs, const String fn, const NL::Logger::LogLevel minLogLevel = NL::Logger::LogLevel::INFO);
@@ -52,15 +83,33 @@ namespace NL
 
 		static void setMinLogLevel(const NL::Logger::LogLevel logLevel);
 
-		static void log(const NL::Logger::LogLevel logLevel, const char *file, const char *function, const int line, const String message);
+		static void log(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const String &message);
+		static void log(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const __FlashStringHelper *message);
 
 		static size_t getLogSize();
 		static void readLog(uint8_t *buffer, const size_t start, const size_t bufferSize);
 		static void clearLog();
+		static void flush();
+		static uint32_t getDroppedMessageCount();
+		static bool getLocationOffset(const uint32_t locationId, uint32_t &offset);
+		static bool getTextOffset(const uint32_t textId, uint32_t &offset);
+		static size_t formatLine(char *buffer, const size_t bufferSize, const NL::Logger::LogLevel logLevel, const uint32_t time, const char *file, const char *function, const int line, const char *message, const size_t messageLength);
 
 	private:
 		Logger();
 
+		struct Record
+		{
+			uint32_t time;		  // Time in ms since the start of the controller
+			uint32_t locationId;  // Id of the source location
+			const char *file;	  // Path and name of the source file
+			const char *function; // Name of the function
+			uint16_t line;		  // Line in code
+			uint8_t logLevel;	  // Log level of the message
+			uint16_t length;	  // Length of the message
+			const char *text;	  // Constant message text which is not copied or nullptr when the message follows the record
+		};
+
 		static bool initialized;
 		static bool logToSerial;
 		static bool logToFile;
@@ -68,9 +117,34 @@ namespace NL
 		static String fileName;
 		static NL::Logger::LogLevel minLogLevel;
 
-		static bool testOpenFile(FS *fs, const String fn);
-		static String getLogLevelString(const NL::Logger::LogLevel logLevel);
-		static String getTimeString();
+		static File logFile;
+		static RingbufHandle_t logBuffer;
+		static SemaphoreHandle_t fileMutex;
+		static TaskHandle_t writerTaskHandle;
+		static SemaphoreHandle_t writerStopped;
+		static std::atomic<bool> writerRunning;
+		static std::atomic<bool> bufferOpen;
+		static std::atomic<uint32_t> bufferUsers;
+		static std::atomic<uint32_t> droppedMessages;
+		static uint32_t reportedDroppedMessages;
+		static uint8_t *writeBuffer;
+		static size_t writeBufferSize;
+		static uint32_t fileSize;
+		static std::unordered_map<uint32_t, uint32_t> locationOffsets;
+		static std::unordered_map<uint32_t, uint32_t> textOffsets;
+
+		static bool startWriter();
+		static void stopWriter();
+		static void writerTask(void *parameter);
+		static void logMessage(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const char *message, size_t messageLength, const bool constant);
+		static void writeRecords();
+		static void writeRecord(const NL::Logger::LogLevel logLevel, const uint32_t time, const uint32_t locationId, const char *file, const char *function, const int line, const char *message, const size_t messageLength, const bool constant);
+		static uint32_t getTextId(const char *text, const size_t length);
+		static void appendWriteBuffer(const void *data, const size_t size);
+		static void flushWriteBuffer();
+		static bool openLog();
+		static void rotateLog();
+		static const char *getLogLevelString(const NL::Logger::LogLevel logLevel);
 	};
 }
 
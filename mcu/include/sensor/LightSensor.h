@@ -28,6 +28,7 @@
 #include "configuration/Configuration.h"
 #include "hardware/AnalogInput.h"
 #include "hardware/BH1750.h"
+#include "util/Profiler.h"
 
 #include "sensor/MotionSensor.h"
 
@@ -70,6 +71,7 @@ namespace NL
 		static float lastBrightnessValue;
 		static NL::MotionSensor::MotionSensorData motionData;
 		static unsigned long motionSensorTriggerTime;
+		static NL::Configuration::RuntimeConfig runtimeConfig;
 
 		static NL::LightSensor::Error getBrightnessInt(float &brightness);
 	};
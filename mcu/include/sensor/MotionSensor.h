@@ -27,6 +27,7 @@
 #include "configuration/SystemConfiguration.h"
 #include "configuration/Configuration.h"
 #include "hardware/MPU6050.h"
+#include "util/Profiler.h"
 
 namespace NL
 {
@@ -79,6 +80,7 @@ namespace NL
 		static bool initialized;
 		static NL::MotionSensor::MotionSensorData motionData;
 		static unsigned long lastMeasure;
+		static NL::Configuration::RuntimeConfig runtimeConfig;
 	};
 }
 
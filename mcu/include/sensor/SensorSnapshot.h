@@ -0,0 +1,74 @@
+/**
+ * @file SensorSnapshot.h
+ * @author TheRealKasumi
+ * @brief Contains a lock-free snapshot of the latest sensor values, written by the system task and read by the render task.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SENSOR_SNAPSHOT_H
+#define SENSOR_SNAPSHOT_H
+
+#include <stdint.h>
+#include <atomic>
+
+#include "sensor/MotionSensor.h"
+#include "hardware/AudioUnit.h"
+
+namespace NL
+{
+	class SensorSnapshot
+	{
+	public:
+		struct SensorData
+		{
+			uint32_t seq;											// Sequence number, incremented with each published snapshot
+			float ambientBrightness;								// Ambient brightness from 0.0 to 1.0
+			float regulatorTemperature;								// Regulator temperature in °C
+			NL::MotionSensor::MotionSensorData motionSensorData;	// Latest motion sensor data
+			NL::AudioUnit::AudioAnalysis audioAnalysis;				// Latest audio analysis
+		};
+
+		static void begin();
+		static void end();
+		static bool isInitialized();
+
+		static void setAmbientBrightness(const float ambientBrightness);
+		static void setRegulatorTemperature(const float regulatorTemperature);
+		static void setMotionSensorData(const NL::MotionSensor::MotionSensorData &motionSensorData);
+		static void setAudioAnalysis(const NL::AudioUnit::AudioAnalysis &audioAnalysis);
+
+		static bool fetch();
+		static const NL::SensorSnapshot::SensorData &getSensorData();
+
+	private:
+		SensorSnapshot();
+
+		static const uint8_t SLOT_MASK = 0x03;
+		static const uint8_t SLOT_NEW_DATA = 0x80;
+
+		static bool initialized;
+		static NL::SensorSnapshot::SensorData writeData;
+		static NL::SensorSnapshot::SensorData slot[3];
+		static uint8_t writeSlot;
+		static uint8_t readSlot;
+		static std::atomic<uint8_t> pendingSlot;
+
+		static void publish();
+	};
+}
+
+#endif
@@ -26,6 +26,7 @@
 
 #include "configuration/SystemConfiguration.h"
 #include "hardware/DS18B20.h"
+#include "util/Profiler.h"
 
 #if defined(HW_VERSION_2_2)
 #include "hardware/LM75BD.h"
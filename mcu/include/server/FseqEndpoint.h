@@ -23,12 +23,18 @@
 #define FSEQ_ENDPOINT_H
 
 #include <FS.h>
+#include <vector>
+#include <memory>
 #include "server/RestEndpoint.h"
 #include "configuration/SystemConfiguration.h"
 #include "configuration/Configuration.h"
 #include "logging/Logger.h"
 #include "util/FileUtil.h"
 #include "util/FseqLoader.h"
+#include "util/FseqPlaylist.h"
+#include "util/FseqValidator.h"
+#include "util/FseqIndex.h"
+#include "led/LedManager.h"
 
 namespace NL
 {
@@ -42,14 +48,20 @@ namespace NL
 
 		static FS *fileSystem;
 		static File uploadFile;
+		static std::unique_ptr<NL::FseqValidator> uploadValidator;
 
 		static void getFseqList();
 		static void postFseq();
 		static void fseqUpload();
 		static void deleteFseq();
+		static void getPosition();
+		static void postPosition();
+		static void getPlaylist();
+		static void postPlaylist();
 
 		static bool validateFileName(const String fileName);
-		static NL::FseqLoader::Error validateFseqFile(const String fileName);
+		static void rejectUpload(const String fileName, const NL::FseqLoader::Error fseqError);
+		static bool validatePlaylistEntry(const JsonObject &jsonObject);
 	};
 }
 
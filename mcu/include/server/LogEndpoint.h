@@ -26,6 +26,7 @@
 #include "configuration/SystemConfiguration.h"
 #include "server/RestEndpoint.h"
 #include "logging/Logger.h"
+#include "logging/LogReader.h"
 
 namespace NL
 {
@@ -23,6 +23,7 @@
 #define RESET_ENDPOINT_H
 
 #include "configuration/SystemConfiguration.h"
+#include "configuration/Configuration.h"
 #include "server/RestEndpoint.h"
 #include "logging/Logger.h"
 #include "update/Updater.h"
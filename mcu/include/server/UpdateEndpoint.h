@@ -24,6 +24,7 @@
 
 #include <FS.h>
 #include "configuration/SystemConfiguration.h"
+#include "configuration/Configuration.h"
 #include "server/RestEndpoint.h"
 #include "logging/Logger.h"
 #include "util/FileUtil.h"
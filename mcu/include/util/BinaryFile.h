@@ -24,6 +24,10 @@
 
 #include <Arduino.h>
 #include <FS.h>
+#include <memory>
+#include <esp32/rom/crc.h>
+
+#include "configuration/SystemConfiguration.h"
 
 namespace NL
 {
@@ -39,11 +43,12 @@ namespace NL
 			ERROR_FILE_WRITE	  // Could not write to the file
 		};
 
-		BinaryFile(FS *fileSystem);
+		BinaryFile(FS *fileSystem, const size_t bufferSize = BINARY_FILE_BUFFER_SIZE);
 		~BinaryFile();
 
 		NL::BinaryFile::Error open(const String fileName, const char *mode);
-		void close();
+		NL::BinaryFile::Error flush();
+		NL::BinaryFile::Error close();
 
 		/**
 		 * @brief Write a value to the binary file.
@@ -54,7 +59,7 @@ namespace NL
 		template <typename T>
 		NL::BinaryFile::Error write(const T value)
 		{
-			return this->file.write((uint8_t *)&value, sizeof(value)) == sizeof(value) ? NL::BinaryFile::Error::OK : NL::BinaryFile::Error::ERROR_FILE_WRITE;
+			return this->writeBytes(&value, sizeof(value));
 		}
 
 		/**
@@ -66,15 +71,24 @@ namespace NL
 		template <typename T>
 		NL::BinaryFile::Error read(T &value)
 		{
-			return this->file.read((uint8_t *)&value, sizeof(value)) == sizeof(value) ? NL::BinaryFile::Error::OK : NL::BinaryFile::Error::ERROR_FILE_READ;
+			return this->readBytes(&value, sizeof(value));
 		}
 
+		NL::BinaryFile::Error writeBytes(const void *data, const size_t size);
+		NL::BinaryFile::Error readBytes(void *data, const size_t size);
 		NL::BinaryFile::Error writeString(const String string);
 		NL::BinaryFile::Error readString(String &string);
+		uint32_t getChecksum();
 
 	private:
 		FS *fileSystem;
 		File file;
+		std::unique_ptr<uint8_t[]> buffer;
+		size_t bufferSize;
+		size_t bufferPosition;
+		size_t bufferLength;
+		bool writeMode;
+		uint32_t checksum;
 	};
 }
 
@@ -24,6 +24,7 @@
 
 #include <FS.h>
 #include <functional>
+#include <esp32/rom/crc.h>
 #include "configuration/SystemConfiguration.h"
 
 namespace NL
@@ -37,7 +38,6 @@ namespace NL
 		static bool countFiles(FS *fileSystem, const String directory, uint16_t &count, const bool includeDirs);
 		static bool listFiles(FS *fileSystem, const String directory, std::function<void(const String fileName, const size_t fileSize)> callback, const bool includeDirs);
 		static bool getFileNameFromIndex(FS *fileSystem, const String directory, const uint16_t fileIndex, String &fileName, const bool includeDirs);
-		static bool getFileNameFromIdentifier(FS *fileSystem, const String directory, const uint32_t identifier, String &fileName);
 		static bool deleteDirectory(FS *fileSystem, const String directory, const bool removeDir);
 		static bool clearRoot(FS *filesSystem);
 
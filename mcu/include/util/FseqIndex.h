@@ -0,0 +1,87 @@
+/**
+ * @file FseqIndex.h
+ * @author TheRealKasumi
+ * @brief Contains a class to keep a persistent index of the fseq files on the SD card.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef FSEQ_INDEX_H
+#define FSEQ_INDEX_H
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include <FS.h>
+
+#include "configuration/SystemConfiguration.h"
+#include "util/BinaryFile.h"
+#include "util/FileUtil.h"
+#include "util/FseqLoader.h"
+
+namespace NL
+{
+	class FseqIndex
+	{
+	public:
+		enum class Error
+		{
+			OK,					   // No error
+			ERROR_NOT_INITIALIZED, // The index was not initialized
+			ERROR_FILE_OPEN,	   // Failed to open the index file
+			ERROR_FILE_READ,	   // Failed to read the index file
+			ERROR_FILE_WRITE,	   // Failed to write the index file
+			ERROR_FILE_VERSION,	   // The version of the index file is not supported
+			ERROR_DIRECTORY		   // The fseq directory could not be read
+		};
+
+		struct Entry
+		{
+			uint32_t identifier;   // CRC32 checksum of the file content
+			String fileName;	   // Name of the file in the fseq directory
+			uint32_t fileSize;	   // Size of the file in bytes
+			uint32_t channelCount; // Number of channels per frame
+			uint32_t frameCount;   // Number of frames
+			uint8_t stepTime;	   // Time between two frames in ms
+		};
+
+		static NL::FseqIndex::Error begin(FS *fileSystem);
+		static void end();
+		static bool isInitialized();
+
+		static NL::FseqIndex::Error rebuild();
+		static NL::FseqIndex::Error addEntry(const NL::FseqIndex::Entry &entry);
+		static NL::FseqIndex::Error removeEntry(const String fileName);
+		static bool getEntry(const uint32_t identifier, NL::FseqIndex::Entry &entry);
+		static bool getEntry(const String fileName, NL::FseqIndex::Entry &entry);
+		static const std::vector<NL::FseqIndex::Entry> &getEntries();
+
+	private:
+		FseqIndex();
+
+		static bool initialized;
+		static FS *fileSystem;
+		static std::vector<NL::FseqIndex::Entry> entries;
+		static std::unordered_map<uint32_t, size_t> identifierMap;
+
+		static NL::FseqIndex::Error load();
+		static NL::FseqIndex::Error synchronize(const bool forceSave);
+		static NL::FseqIndex::Error save();
+		static void updateIdentifierMap();
+	};
+}
+
+#endif
@@ -24,8 +24,19 @@
 
 #include <stdint.h>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
+#include <esp32-hal-psram.h>
+#include <esp32/rom/miniz.h>
 
+#include "configuration/SystemConfiguration.h"
 #include "led/driver/LedStrip.h"
 
 namespace NL
@@ -44,7 +55,32 @@ namespace NL
 			ERROR_FILE_VERSION,		   // The file version is not supported
 			ERROR_HEADER_LENGTH,	   // The header length of the file is invalid
 			ERROR_INVALID_DATA_LENGTH, // The data length specified in header does not match actual data length
-			ERROR_END_OF_FILE		   // End of the file was reached
+			ERROR_END_OF_FILE,		   // End of the file was reached
+			ERROR_BUFFER_EMPTY,		   // No frame was read ahead yet
+			ERROR_READ_AHEAD,		   // The read ahead task could not be started
+			ERROR_COMPRESSION,		   // The compression type is not supported or the block index is invalid
+			ERROR_SPARSE_RANGE,		   // The sparse channel ranges are invalid
+			ERROR_CHANNEL_COUNT		   // The frames do not fit the LED configuration
+		};
+
+		enum class CompressionType : uint8_t
+		{
+			NONE = 0,
+			ZSTD = 1,
+			ZLIB = 2
+		};
+
+		struct CompressionBlock
+		{
+			uint32_t firstFrame; // Index of the first frame in the block
+			uint32_t length;	 // Compressed length of the block in bytes
+			uint32_t offset;	 // Offset of the block in the file
+		};
+
+		struct SparseRange
+		{
+			uint32_t startChannel; // First channel of the range in the output frame
+			uint32_t channelCount; // Number of channels in the range
 		};
 
 		struct FseqHeader
@@ -63,34 +99,131 @@ namespace NL
 			uint8_t gamma;
 			uint8_t colorEncoding;
 			uint16_t reserved;
+			uint8_t compressionType;
+			uint16_t compressionBlockCount;
+			uint8_t sparseRangeCount;
+			uint64_t uniqueId;
 		};
 
 		FseqLoader(FS *fileSystem);
 		~FseqLoader();
 
 		NL::FseqLoader::Error loadFromFile(const String fileName);
+		NL::FseqLoader::Error startReadAhead();
+		bool isBuffered();
 		size_t available();
 		void moveToStart();
+		NL::FseqLoader::Error seekToFrame(const uint32_t frameIndex);
+		NL::FseqLoader::Error seekToTime(const uint32_t time);
+		uint32_t getCurrentFrame();
 		void close();
 
 		FseqHeader getHeader();
-		NL::FseqLoader::Error readLedStrip(NL::LedStrip &ledStrip);
-
-		void setFillerBytes(const uint8_t fillerBytes);
-		uint8_t getFillerBytes();
+		uint32_t getFrameSize();
+		bool fitsChannelCount(const uint32_t channelCount);
+		NL::FseqLoader::Error readLedStrip(NL::LedStrip &ledStrip, const size_t channelOffset, const bool loop = true);
 
 		void setZoneCount(const uint8_t zoneCount);
 		uint8_t getZoneCount();
 
+		void setInterpolation(const bool interpolation);
+		bool getInterpolation();
+
+		uint32_t getUnderrunCount();
+		uint32_t getSkippedFrameCount();
+		uint32_t getRepeatedFrameCount();
+		bool isCached();
+
+		static uint32_t getCacheHits();
+		static uint32_t getCacheMisses();
+
+		static void blendFrames(uint8_t *output, const uint8_t *from, const uint8_t *to, const size_t size, const uint16_t alpha);
+
 	private:
+		static std::atomic<uint32_t> cacheHits;
+		static std::atomic<uint32_t> cacheMisses;
+
 		FS *fileSystem;
 		File file;
 		FseqHeader fseqHeader;
-		uint8_t fillerBytes;
+		std::vector<NL::FseqLoader::CompressionBlock> compressionBlocks;
+		std::vector<NL::FseqLoader::SparseRange> sparseRanges;
+		uint32_t frameSize;
 		uint8_t zoneCount;
 		uint8_t zoneCounter;
 
+		TaskHandle_t readerTaskHandle;
+		SemaphoreHandle_t readerStopped;
+		std::atomic<bool> readerRunning;
+		uint8_t *ringBuffer;
+		uint32_t slotFrameIndex[FSEQ_READ_AHEAD_FRAMES + 1];
+		uint32_t slotGeneration[FSEQ_READ_AHEAD_FRAMES + 1];
+		std::atomic<uint32_t> producedFrames;
+		std::atomic<uint32_t> consumedFrames;
+		std::atomic<uint32_t> generation;
+		std::atomic<uint32_t> seekFrame;
+		uint8_t *currentFrame;
+		uint32_t currentFrameIndex;
+		bool hasFrame;
+		uint32_t underrunCount;
+
+		int64_t playbackStart;
+		uint32_t playedFrames;
+		bool clockValid;
+		uint32_t skippedFrameCount;
+		uint32_t repeatedFrameCount;
+
+		bool interpolation;
+		const uint8_t *interpolationFrame;
+		uint16_t interpolationAlpha;
+
+		uint8_t *cache;
+		std::atomic<bool> cacheLoaded;
+		uint32_t cacheGeneration;
+
+		bool deltaEncoded;
+		uint16_t keyframeInterval;
+		std::vector<uint32_t> keyframeOffsets;
+		uint8_t *deltaFrame;
+		uint8_t *recordBuffer;
+		uint32_t recordBufferSize;
+		uint32_t deltaFrameIndex;
+
+		uint8_t *frameBuffer;
+		tinfl_decompressor *inflator;
+		uint8_t *dictionary;
+		uint8_t *inputBuffer;
+		size_t inputPosition;
+		size_t inputAvailable;
+		size_t dictionaryOffset;
+		size_t pendingPosition;
+		size_t pendingSize;
+		size_t blockIndex;
+		uint32_t blockRemaining;
+		bool blockDone;
+
+		static void readerTask(void *parameter);
+		void readAhead();
+		void loadCache();
+		bool nextFrame();
+		bool nextCachedFrame();
+		void advanceFrame(const bool loop);
+		void updateInterpolation(const bool loop);
+		const uint8_t *peekNextFrame(const bool loop);
+		void copyChannels(uint8_t *output, const size_t offset, const size_t size);
+		void requestSeek(const uint32_t frameIndex);
+		void stopReadAhead();
+
+		bool seekReader(const uint32_t frameIndex, uint8_t *buffer);
+		bool readFrame(uint8_t *buffer);
+		void scatterSparseFrame(uint8_t *frame);
+		bool openBlock(const size_t index);
+		bool inflate(uint8_t *buffer, size_t size);
+		bool readDeltaFrame(uint8_t *buffer);
+
 		void initFseqHeader();
+		NL::FseqLoader::Error readHeaderV2();
+		NL::FseqLoader::Error readSequenceHeader();
 		NL::FseqLoader::Error isValid();
 	};
 }
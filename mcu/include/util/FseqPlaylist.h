@@ -0,0 +1,122 @@
+/**
+ * @file FseqPlaylist.h
+ * @author TheRealKasumi
+ * @brief Contains a class to play multiple fseq files one after another without a gap.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef FSEQ_PLAYLIST_H
+#define FSEQ_PLAYLIST_H
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
+
+#include "configuration/SystemConfiguration.h"
+#include "logging/Logger.h"
+#include "led/driver/LedStrip.h"
+#include "util/BinaryFile.h"
+#include "util/FseqLoader.h"
+
+namespace NL
+{
+	class FseqPlaylist
+	{
+	public:
+		enum class Error
+		{
+			OK,						// No error
+			ERROR_FILE_OPEN,		// Failed to open the playlist file
+			ERROR_FILE_READ,		// Failed to read the playlist file
+			ERROR_FILE_WRITE,		// Failed to write the playlist file
+			ERROR_FILE_VERSION,		// The version of the playlist file is not supported
+			ERROR_EMPTY,			// The playlist has no entries
+			ERROR_TOO_MANY_ENTRIES, // The playlist has more than {@link FSEQ_PLAYLIST_MAX_ENTRIES} entries
+			ERROR_INVALID_FSEQ,		// None of the fseq files could be loaded
+			ERROR_NOT_OPEN,			// The playlist was not opened yet
+			ERROR_PLAYLIST_TASK		// The playlist task could not be started
+		};
+
+		struct Entry
+		{
+			String fileName;		  // Name of the fseq file in the fseq directory
+			uint16_t repeatCount;	  // Number of times the file is played before the next entry starts, 0 to repeat forever
+			uint16_t crossfadeFrames; // Number of frames to blend from the end of this file into the next entry
+		};
+
+		FseqPlaylist(FS *fileSystem);
+		~FseqPlaylist();
+
+		NL::FseqPlaylist::Error loadFromFile(const String fileName);
+		NL::FseqPlaylist::Error saveToFile(const String fileName);
+		NL::FseqPlaylist::Error setEntries(const std::vector<NL::FseqPlaylist::Entry> &entries);
+		std::vector<NL::FseqPlaylist::Entry> getEntries();
+
+		NL::FseqPlaylist::Error open();
+		NL::FseqPlaylist::Error start(const uint8_t zoneCount, const uint32_t channelCount);
+		void close();
+
+		NL::FseqLoader *getCurrentLoader();
+		size_t getCurrentEntry();
+		uint32_t getLateSwitchCount();
+
+		void setInterpolation(const bool interpolation);
+		uint32_t getFrameInterval();
+
+		void moveToStart();
+		NL::FseqLoader::Error seekToTime(const uint32_t time);
+		NL::FseqLoader::Error readLedStrip(NL::LedStrip &ledStrip, const size_t channelOffset);
+
+	private:
+		FS *fileSystem;
+		std::vector<NL::FseqPlaylist::Entry> entries;
+		uint8_t zoneCount;
+		uint8_t zoneCounter;
+		uint32_t channelCount;
+
+		std::unique_ptr<NL::FseqLoader> currentLoader;
+		std::unique_ptr<NL::FseqLoader> nextLoader;
+		std::unique_ptr<NL::FseqLoader> finishedLoader;
+		size_t currentEntry;
+		size_t nextEntry;
+		uint16_t passCount;
+		uint32_t lastFrameIndex;
+		uint16_t fadeAlpha;
+		uint32_t lateSwitchCount;
+		bool interpolation;
+		std::vector<uint8_t> fadeBuffer;
+
+		TaskHandle_t playlistTaskHandle;
+		SemaphoreHandle_t playlistStopped;
+		std::atomic<bool> playlistRunning;
+		std::atomic<bool> nextReady;
+
+		static void playlistTask(void *parameter);
+		void preloadNext();
+		bool openEntry(const size_t entryIndex, std::unique_ptr<NL::FseqLoader> &loader);
+		void advance();
+		void switchToNext();
+	};
+}
+
+#endif
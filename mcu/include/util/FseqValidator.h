@@ -0,0 +1,81 @@
+/**
+ * @file FseqValidator.h
+ * @author TheRealKasumi
+ * @brief Contains a class to validate fseq files while they are uploaded.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef FSEQ_VALIDATOR_H
+#define FSEQ_VALIDATOR_H
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <esp32/rom/crc.h>
+
+#include "util/FseqLoader.h"
+
+namespace NL
+{
+	class FseqValidator
+	{
+	public:
+		FseqValidator(const std::vector<uint32_t> &zoneChannelCounts);
+		~FseqValidator();
+
+		NL::FseqLoader::Error write(const uint8_t *buffer, const size_t size);
+		NL::FseqLoader::Error finish();
+
+		NL::FseqLoader::FseqHeader getHeader();
+		uint32_t getChecksum();
+		uint32_t getSize();
+
+	private:
+		std::vector<uint32_t> zoneChannelCounts;
+		NL::FseqLoader::Error error;
+		uint32_t checksum;
+		uint32_t receivedSize;
+
+		uint8_t header[32];
+		uint8_t headerLength;
+		bool sequence;
+		NL::FseqLoader::FseqHeader fseqHeader;
+		uint32_t dataOffset;
+		uint32_t indexEnd;
+
+		uint8_t record[8];
+		uint8_t recordFill;
+		uint32_t recordIndex;
+
+		bool indexComplete;
+		uint32_t frameSize;
+		uint32_t sparseChannelCount;
+		uint32_t compressedLength;
+		uint32_t lastFirstFrame;
+		uint32_t dataEnd;
+
+		NL::FseqLoader::Error consume(const uint8_t value);
+		NL::FseqLoader::Error parseHeader();
+		NL::FseqLoader::Error parseSequenceHeader();
+		NL::FseqLoader::Error parseRecord();
+		NL::FseqLoader::Error finishIndex();
+		bool fitsZones();
+	};
+}
+
+#endif
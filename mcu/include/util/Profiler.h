@@ -0,0 +1,106 @@
+/**
+ * @file Profiler.h
+ * @author TheRealKasumi
+ * @brief Contains a class to measure the execution time of the individual stages of the system using the cpu cycle counter.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <WString.h>
+#include <Esp.h>
+#include <freertos/FreeRTOS.h>
+
+namespace NL
+{
+	class Profiler
+	{
+	public:
+		enum class Stage : uint8_t
+		{
+			FRAME = 0,					   // Full frame, rendering and output
+			SENSOR_DATA = 1,			   // Applying new sensor data to the animators
+			POST_PROCESSING = 2,		   // Brightness, power and temperature limiting
+			LED_DRIVER_WAIT = 3,		   // Waiting for the LED driver and starting the output
+			AUDIO_UNIT = 4,				   // Reading the audio analysis
+			MPU6050 = 5,				   // Reading the MPU6050
+			BH1750 = 6,					   // Reading the BH1750
+			DS18B20 = 7,				   // Reading a DS18B20
+			WEB_SERVER = 8,				   // Handling web server requests
+			ANIMATOR_RAINBOW = 9,		   // Rendering of a zone by the rainbow animator, the calculated animators follow in the order of their type
+			ANIMATOR_SPARKLE = 10,		   // Rendering of a zone by the sparkle animator
+			ANIMATOR_GRADIENT = 11,		   // Rendering of a zone by the gradient animator
+			ANIMATOR_STATIC_COLOR = 12,	   // Rendering of a zone by the static color animator
+			ANIMATOR_COLOR_BAR = 13,	   // Rendering of a zone by the color bar animator
+			ANIMATOR_RAINBOW_MOTION = 14,  // Rendering of a zone by the rainbow motion animator
+			ANIMATOR_GRADIENT_MOTION = 15, // Rendering of a zone by the gradient motion animator
+			ANIMATOR_PULSE = 16,		   // Rendering of a zone by the pulse animator
+			ANIMATOR_EQUALIZER = 17,	   // Rendering of a zone by the equalizer animator
+			ANIMATOR_FSEQ = 18			   // Rendering of a zone from a fseq file
+		};
+
+		struct StageStatistics
+		{
+			uint32_t count; // Number of measurements
+			float min;		// Minimum execution time in µs
+			float avg;		// Average execution time in µs
+			float max;		// Maximum execution time in µs
+			float p99;		// 99th percentile of the execution time in µs
+		};
+
+		static const uint8_t STAGE_COUNT = 19;
+
+		static void begin();
+		static void end();
+		static bool isInitialized();
+
+		static uint32_t start();
+		static void record(const NL::Profiler::Stage stage, const uint32_t startCycles);
+		static NL::Profiler::Stage getAnimatorStage(const uint8_t animatorType);
+		static void reset();
+
+		static void getStageStatistics(const NL::Profiler::Stage stage, NL::Profiler::StageStatistics &statistics);
+		static String getStageName(const NL::Profiler::Stage stage);
+
+	private:
+		Profiler();
+
+		static const uint8_t BUCKET_COUNT = 124;
+
+		struct StageData
+		{
+			uint32_t count;
+			uint64_t sum;
+			uint32_t min;
+			uint32_t max;
+			uint32_t histogram[NL::Profiler::BUCKET_COUNT];
+		};
+
+		static bool initialized;
+		static portMUX_TYPE mux;
+		static uint32_t cpuFrequency;
+		static NL::Profiler::StageData stageData[NL::Profiler::STAGE_COUNT];
+
+		static void resetStage(NL::Profiler::StageData &data);
+		static uint8_t getBucketIndex(const uint32_t cycles);
+		static uint32_t getBucketUpperBound(const uint8_t bucketIndex);
+	};
+}
+
+#endif
@@ -24,7 +24,6 @@
 unsigned long NikoLight::lightSensorInterval = LIGHT_SENSOR_INTERVAL;
 unsigned long NikoLight::motionSensorInterval = MOTION_SENSOR_INTERVAL;
 unsigned long NikoLight::audioUnitInterval = AUDIO_UNIT_INTERVAL;
-unsigned long NikoLight::frameTimer = 0;
 unsigned long NikoLight::lightSensorTimer = 0;
 unsigned long NikoLight::motionSensorTimer = 0;
 unsigned long NikoLight::audioUnitTimer = 0;
@@ -33,8 +32,18 @@ unsigned long NikoLight::statusTimer = 0;
 unsigned long NikoLight::statusPrintTimer = 0;
 unsigned long NikoLight::webServerTimer = 0;
 
+TaskHandle_t NikoLight::renderTaskHandle = NULL;
+TaskHandle_t NikoLight::systemTaskHandle = NULL;
+esp_timer_handle_t NikoLight::frameTimerHandle = NULL;
+
+portMUX_TYPE NikoLight::counterMux = portMUX_INITIALIZER_UNLOCKED;
 uint16_t NikoLight::frameCounter = 0;
 float NikoLight::ledPowerCounter = 0.0f;
+uint32_t NikoLight::renderTimeCounter = 0;
+uint32_t NikoLight::transmitTimeCounter = 0;
+uint32_t NikoLight::frameJitterCounter = 0;
+uint32_t NikoLight::maxFrameJitter = 0;
+uint32_t NikoLight::droppedFrameCounter = 0;
 
 #ifdef HW_VERSION_2_2
 NL::LM75BD *NikoLight::lm75bd = nullptr;
@@ -54,7 +63,10 @@ void NikoLight::begin()
 	NikoLight::handleUpdate();				  // Check for system updates and install
 	NikoLight::initializeSystemInformation(); // Initialize and print the soc information
 	NikoLight::initializeConfiguration();	  // Initialize the configuration
+	NikoLight::initializeFseqIndex();		  // Initialize the index of the fseq files
 	NikoLight::initializeHardwareModules();	  // Initialize hardware modules and print information
+	NL::SensorSnapshot::begin();			  // Initialize the sensor snapshot shared with the render task
+	NL::Profiler::begin();					  // Initialize the profiler
 	NikoLight::initializeLedManager();		  // Initialize the LED manager
 	NikoLight::initializeMotionSensor();	  // Initalize the motion sensor
 	NikoLight::initializeLightSensor();		  // Initialize the light sensor
@@ -65,7 +77,7 @@ void NikoLight::begin()
 	NikoLight::initializeRestApi();			  // Iniaialize the rest api
 	NikoLight::createtWiFiNetwork();		  // Create the WiFi network for clients to connect to
 	NikoLight::initializeTimers();			  // Initialize the timers
-	NL::WatchDog::initializeTaskWatchdog();	  // Initialize the watchdog timer
+	NikoLight::initializeTasks();			  // Start the render and system task
 
 	/**
 	 * FIXME: Temporary workaround for 2.2 hardware to enable the SIC461.
@@ -212,6 +224,22 @@ void NikoLight::initializeConfiguration()
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("NikoLight configuration initialized."));
 }
 
+/**
+ * @brief Initialize and load the index of the fseq files.
+ * 		  When the index is missing or invalid, it is rebuilt from the fseq directory.
+ */
+void NikoLight::initializeFseqIndex()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Initialize fseq index."));
+	if (NL::FseqIndex::begin(&SD) != NL::FseqIndex::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The fseq index could not be loaded or rebuilt. Custom animations may not be found."));
+		return;
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, (String)F("Fseq index initialized with ") + NL::FseqIndex::getEntries().size() + F(" files."));
+}
+
 /**
  * @brief Initialize harware modules on the I²C and OneWire bus.
  * 		  If the initialization fails, the controller will restart.
@@ -526,6 +554,8 @@ void NikoLight::initializeRestApi()
 	NL::AudioUnitConfigurationEndpoint::begin();
 	NL::UIConfigurationEndpoint::init(F("/api/"));
 	NL::UIConfigurationEndpoint::begin();
+	NL::ProfilingEndpoint::init(F("/api/"));
+	NL::ProfilingEndpoint::begin();
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("REST API initialized."));
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, (String)F("Starting web server on port ") + WEB_SERVER_PORT + F("."));
@@ -540,7 +570,6 @@ void NikoLight::initializeTimers()
 {
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Initialize/reset timers."));
 	unsigned long mic = micros();
-	NikoLight::frameTimer = mic;
 	NikoLight::lightSensorTimer = mic;
 	NikoLight::motionSensorTimer = mic;
 	NikoLight::audioUnitTimer = mic;
@@ -548,10 +577,43 @@ void NikoLight::initializeTimers()
 	NikoLight::statusTimer = mic;
 	NikoLight::statusPrintTimer = mic;
 	NikoLight::webServerTimer = mic;
-	NikoLight::frameCounter = 0;
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, (String)F("Timers initialized to ") + mic + F("."));
 }
 
+/**
+ * @brief Start the render task and the system task. The render task is pinned to its own core and woken up
+ * 		  by a periodic timer, so that web requests, SD access and sensors can not delay the LED output.
+ * 		  If one of the tasks can not be started, the controller will reboot.
+ */
+void NikoLight::initializeTasks()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Initialize render and system task."));
+
+	esp_timer_create_args_t frameTimerArgs = {};
+	frameTimerArgs.callback = &NikoLight::frameTimerCallback;
+	frameTimerArgs.dispatch_method = ESP_TIMER_TASK;
+	frameTimerArgs.name = "FrameTimer";
+	if (esp_timer_create(&frameTimerArgs, &NikoLight::frameTimerHandle) != ESP_OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to create the frame timer. Rebooting."));
+		NL::Updater::reboot(F("Failed to create the frame timer."), 0);
+	}
+
+	if (xTaskCreatePinnedToCore(NikoLight::renderTask, "RenderTask", RENDER_TASK_STACK_SIZE, NULL, RENDER_TASK_PRIORITY, &NikoLight::renderTaskHandle, RENDER_TASK_CORE) != pdPASS)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to start the render task. Rebooting."));
+		NL::Updater::reboot(F("Failed to start the render task."), 0);
+	}
+
+	if (xTaskCreatePinnedToCore(NikoLight::systemTask, "SystemTask", SYSTEM_TASK_STACK_SIZE, NULL, SYSTEM_TASK_PRIORITY, &NikoLight::systemTaskHandle, SYSTEM_TASK_CORE) != pdPASS)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to start the system task. Rebooting."));
+		NL::Updater::reboot(F("Failed to start the system task."), 0);
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, (String)F("Render task started on core ") + RENDER_TASK_CORE + F(", system task started on core ") + SYSTEM_TASK_CORE + F("."));
+}
+
 /**
  * @brief Check if a system update is available for installation. In case a update package was found,
  * 		  it will be installed automatically. This function will restart the controller and will not
@@ -697,20 +759,94 @@ bool NikoLight::checkTimer(unsigned long &timer, unsigned long cycleTime)
 }
 
 /**
- * @brief Function should be called continuously from the main loop.
+ * @brief Render task, which renders and outputs a new frame each time the frame timer expires.
+ * @param parameter unused
  */
-void NikoLight::run()
+void NikoLight::renderTask(void *parameter)
 {
-	// Handle the pixel rendering and LED output
-	if (NikoLight::checkTimer(NikoLight::frameTimer, NL::LedManager::getFrameInterval()))
+	NL::WatchDog::initializeTaskWatchdog();
+
+	uint32_t frameInterval = 0;
+	int64_t lastFrameStart = 0;
+	while (true)
 	{
+		// Restart the frame timer when the frame interval was changed, for example by loading a custom animation
+		if (frameInterval != NL::LedManager::getFrameInterval())
+		{
+			frameInterval = NL::LedManager::getFrameInterval();
+			esp_timer_stop(NikoLight::frameTimerHandle);
+			esp_timer_start_periodic(NikoLight::frameTimerHandle, frameInterval);
+			lastFrameStart = 0;
+		}
+
+		// Wait for the next frame deadline, more than one expired deadline means frames were dropped
+		const uint32_t deadlineCount = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+		NL::WatchDog::resetTaskWatchdog();
+		if (deadlineCount == 0)
+		{
+			continue;
+		}
+
+		const int64_t frameStart = esp_timer_get_time();
+		const uint32_t profilerStart = NL::Profiler::start();
 		NL::LedManager::render();
 		NL::LedManager::show(portMAX_DELAY);
-		NL::LedManager::waitShow(portMAX_DELAY);
+		NL::Profiler::record(NL::Profiler::Stage::FRAME, profilerStart);
+
+		// Jitter is the deviation of the frame start from the expected deadline
+		uint32_t frameJitter = 0;
+		if (lastFrameStart > 0)
+		{
+			const int64_t deviation = frameStart - lastFrameStart - static_cast<int64_t>(frameInterval) * deadlineCount;
+			frameJitter = deviation >= 0 ? deviation : -deviation;
+		}
+		lastFrameStart = frameStart;
+
+		const float ledPowerDraw = NL::LedManager::getLedPowerDraw();
+		const uint32_t renderTime = NL::LedManager::getRenderTime();
+		const uint32_t transmitTime = NL::LedManager::getTransmitTime();
+		portENTER_CRITICAL(&NikoLight::counterMux);
 		NikoLight::frameCounter++;
-		NikoLight::ledPowerCounter += NL::LedManager::getLedPowerDraw();
+		NikoLight::ledPowerCounter += ledPowerDraw;
+		NikoLight::renderTimeCounter += renderTime;
+		NikoLight::transmitTimeCounter += transmitTime;
+		NikoLight::frameJitterCounter += frameJitter;
+		NikoLight::maxFrameJitter = frameJitter > NikoLight::maxFrameJitter ? frameJitter : NikoLight::maxFrameJitter;
+		NikoLight::droppedFrameCounter += deadlineCount - 1;
+		portEXIT_CRITICAL(&NikoLight::counterMux);
+	}
+}
+
+/**
+ * @brief System task, which continuously runs the sensors, web server and status updates.
+ * @param parameter unused
+ */
+void NikoLight::systemTask(void *parameter)
+{
+	NL::WatchDog::initializeTaskWatchdog();
+	while (true)
+	{
+		NikoLight::run();
+
+		// Give the idle task of this core a chance to run
+		vTaskDelay(1);
 	}
+}
+
+/**
+ * @brief Called by the frame timer to wake up the render task.
+ * @param parameter unused
+ */
+void NikoLight::frameTimerCallback(void *parameter)
+{
+	xTaskNotifyGive(NikoLight::renderTaskHandle);
+}
 
+/**
+ * @brief Function should be called continuously from the system task.
+ */
+void NikoLight::run()
+{
 	// Handle the light sensor
 	if (NikoLight::checkTimer(NikoLight::lightSensorTimer, NikoLight::lightSensorInterval) && NL::LightSensor::isInitialized())
 	{
@@ -718,13 +854,13 @@ void NikoLight::run()
 		const NL::LightSensor::Error lightSensorError = NL::LightSensor::getBrightness(brightness);
 		if (lightSensorError == NL::LightSensor::Error::OK)
 		{
-			NL::LedManager::setAmbientBrightness(brightness);
+			NL::SensorSnapshot::setAmbientBrightness(brightness);
 			NikoLight::lightSensorInterval = LIGHT_SENSOR_INTERVAL;
 		}
 		else
 		{
 			NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to read light sensor data. Delaying next read by 1s."));
-			NL::LedManager::setAmbientBrightness(1.0f);
+			NL::SensorSnapshot::setAmbientBrightness(1.0f);
 			NikoLight::lightSensorInterval = 1000000;
 		}
 	}
@@ -735,7 +871,7 @@ void NikoLight::run()
 		const NL::MotionSensor::Error motionSensorError = NL::MotionSensor::run();
 		if (motionSensorError == NL::MotionSensor::Error::OK)
 		{
-			NL::LedManager::setMotionSensorData(NL::MotionSensor::getMotion());
+			NL::SensorSnapshot::setMotionSensorData(NL::MotionSensor::getMotion());
 			NikoLight::motionSensorInterval = MOTION_SENSOR_INTERVAL;
 		}
 		else
@@ -749,10 +885,12 @@ void NikoLight::run()
 	if (NikoLight::checkTimer(NikoLight::audioUnitTimer, NikoLight::audioUnitInterval) && NL::AudioUnit::isInitialized())
 	{
 		NL::AudioUnit::AudioAnalysis audioAnalysis;
+		const uint32_t profilerStart = NL::Profiler::start();
 		const NL::AudioUnit::Error audioError = NL::AudioUnit::getAudioAnalysis(audioAnalysis);
+		NL::Profiler::record(NL::Profiler::Stage::AUDIO_UNIT, profilerStart);
 		if (audioError == NL::AudioUnit::Error::OK)
 		{
-			NL::LedManager::setAudioAnalysis(audioAnalysis);
+			NL::SensorSnapshot::setAudioAnalysis(audioAnalysis);
 			NikoLight::audioUnitInterval = AUDIO_UNIT_INTERVAL;
 		}
 		else
@@ -786,16 +924,43 @@ void NikoLight::run()
 		// Update the SOC information
 		NL::SystemInformation::updateSocInfo();
 
+		// Collect the frame counters from the render task
+		portENTER_CRITICAL(&NikoLight::counterMux);
+		const uint16_t frameCounter = NikoLight::frameCounter;
+		const float ledPowerCounter = NikoLight::ledPowerCounter;
+		const uint32_t renderTimeCounter = NikoLight::renderTimeCounter;
+		const uint32_t transmitTimeCounter = NikoLight::transmitTimeCounter;
+		const uint32_t frameJitterCounter = NikoLight::frameJitterCounter;
+		const uint32_t maxFrameJitter = NikoLight::maxFrameJitter;
+		const uint32_t droppedFrameCounter = NikoLight::droppedFrameCounter;
+		NikoLight::frameCounter = 0;
+		NikoLight::ledPowerCounter = 0.0f;
+		NikoLight::renderTimeCounter = 0;
+		NikoLight::transmitTimeCounter = 0;
+		NikoLight::frameJitterCounter = 0;
+		NikoLight::maxFrameJitter = 0;
+		NikoLight::droppedFrameCounter = 0;
+		portEXIT_CRITICAL(&NikoLight::counterMux);
+
 		// Update LED related information
 		NL::SystemInformation::NLInformation tlInfo = NL::SystemInformation::getNikoLightInfo();
 		tlInfo.fps = frameCounter / (STATUS_INTERVAL / 1000000.0f);
 		tlInfo.ledCount = NL::LedManager::getLedCount();
 		tlInfo.hiddenLedCount = NL::LedManager::getHiddenLedCount();
+		tlInfo.renderTime = frameCounter > 0 ? renderTimeCounter / frameCounter : 0;
+		tlInfo.transmitTime = frameCounter > 0 ? transmitTimeCounter / frameCounter : 0;
+		tlInfo.frameJitter = frameCounter > 0 ? frameJitterCounter / frameCounter : 0;
+		tlInfo.maxFrameJitter = maxFrameJitter;
+		tlInfo.droppedFrames = droppedFrameCounter;
+		tlInfo.ledBufferSize = NL::LedManager::getLedBufferSize();
+		tlInfo.ledBufferSavedSize = LED_NUM_ZONES * LED_MAX_COUNT_PER_ZONE * 3 * 2 - tlInfo.ledBufferSize;
+		tlInfo.fseqCacheHits = NL::FseqLoader::getCacheHits();
+		tlInfo.fseqCacheMisses = NL::FseqLoader::getCacheMisses();
 		NL::SystemInformation::setNikoLightInfo(tlInfo);
 
 		// Update regulator related information
 		NL::SystemInformation::HardwareInformation hwInfo = NL::SystemInformation::getHardwareInfo();
-		hwInfo.regulatorPowerDraw = ledPowerCounter / frameCounter;
+		hwInfo.regulatorPowerDraw = frameCounter > 0 ? ledPowerCounter / frameCounter : 0.0f;
 		hwInfo.regulatorCurrentDraw = hwInfo.regulatorPowerDraw / hwInfo.regulatorVoltage;
 		if (NL::TemperatureSensor::isInitialized())
 		{
@@ -809,9 +974,7 @@ void NikoLight::run()
 			hwInfo.regulatorTemperature = 0.0f;
 		}
 		NL::SystemInformation::setHardwareInfo(hwInfo);
-
-		NikoLight::frameCounter = 0;
-		NikoLight::ledPowerCounter = 0.0f;
+		NL::SensorSnapshot::setRegulatorTemperature(hwInfo.regulatorTemperature);
 	}
 
 	// Print the system status
@@ -824,11 +987,23 @@ void NikoLight::run()
 			NL::Logger::LogLevel::INFO,
 			SOURCE_LOCATION,
 			(String)F("LED Driver: ") + tlInfo.fps + F("FPS   ") +
+				F("Render: ") + tlInfo.renderTime + F("µs   ") +
+				F("Transmit: ") + tlInfo.transmitTime + F("µs   ") +
+				F("Jitter (avg/max): ") + tlInfo.frameJitter + F("/") + tlInfo.maxFrameJitter + F("µs   ") +
+				F("Dropped: ") + tlInfo.droppedFrames + F("   ") +
 				F("Average Power: ") + hwInfo.regulatorPowerDraw + F("W   ") +
 				F("Average Current: ") + hwInfo.regulatorCurrentDraw + F("A   ") +
 				F("Temperature: ") + hwInfo.regulatorTemperature + F("°C   ") +
 				F("Fan: ") + hwInfo.fanSpeed / 2.55f + F("%   ") +
-				F("Heap (free): ") + socInfo.freeHeap + F("Bytes"));
+				F("Heap (free): ") + socInfo.freeHeap + F("Bytes   ") +
+				F("Heap (min free): ") + socInfo.minFreeHeap + F("Bytes   ") +
+				F("LED buffer: ") + tlInfo.ledBufferSize + F("Bytes"));
+	}
+
+	// Save the configuration after it was changed
+	if (NL::Configuration::handleSave() != NL::Configuration::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save the configuration. Trying again later."));
 	}
 
 	// Handle web server requests
@@ -839,7 +1014,9 @@ void NikoLight::run()
 
 		// Run the server and measure execution time
 		unsigned long start = millis();
+		const uint32_t profilerStart = NL::Profiler::start();
 		NL::WebServerManager::handleRequest();
+		NL::Profiler::record(NL::Profiler::Stage::WEB_SERVER, profilerStart);
 		unsigned long executionTime = millis() - start;
 		if (executionTime > 2000)
 		{
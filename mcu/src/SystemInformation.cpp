@@ -37,7 +37,10 @@ void NL::SystemInformation::begin()
 	NL::SystemInformation::socInfo.fwVersion = FW_VERSION;
 	NL::SystemInformation::socInfo.cpuCores = 0;
 	NL::SystemInformation::socInfo.cpuClock = 0;
+	NL::SystemInformation::socInfo.heapSize = 0;
 	NL::SystemInformation::socInfo.freeHeap = 0;
+	NL::SystemInformation::socInfo.minFreeHeap = 0;
+	NL::SystemInformation::socInfo.maxAllocHeap = 0;
 	NL::SystemInformation::socInfo.flashSize = 0;
 	NL::SystemInformation::socInfo.flashSpeed = 0;
 	NL::SystemInformation::socInfo.sketchSize = 0;
@@ -59,6 +62,16 @@ void NL::SystemInformation::begin()
 
 	NL::SystemInformation::systemInfo.fps = 0;
 	NL::SystemInformation::systemInfo.ledCount = 0;
+	NL::SystemInformation::systemInfo.hiddenLedCount = 0;
+	NL::SystemInformation::systemInfo.renderTime = 0;
+	NL::SystemInformation::systemInfo.transmitTime = 0;
+	NL::SystemInformation::systemInfo.frameJitter = 0;
+	NL::SystemInformation::systemInfo.maxFrameJitter = 0;
+	NL::SystemInformation::systemInfo.droppedFrames = 0;
+	NL::SystemInformation::systemInfo.ledBufferSize = 0;
+	NL::SystemInformation::systemInfo.ledBufferSavedSize = 0;
+	NL::SystemInformation::systemInfo.fseqCacheHits = 0;
+	NL::SystemInformation::systemInfo.fseqCacheMisses = 0;
 
 	NL::SystemInformation::updateSocInfo(false);
 }
@@ -82,6 +95,8 @@ void NL::SystemInformation::updateSocInfo(const bool fast)
 	if (fast)
 	{
 		NL::SystemInformation::socInfo.freeHeap = ESP.getFreeHeap();
+		NL::SystemInformation::socInfo.minFreeHeap = ESP.getMinFreeHeap();
+		NL::SystemInformation::socInfo.maxAllocHeap = ESP.getMaxAllocHeap();
 	}
 	else
 	{
@@ -89,7 +104,10 @@ void NL::SystemInformation::updateSocInfo(const bool fast)
 		NL::SystemInformation::socInfo.chipRevision = ESP.getChipRevision();
 		NL::SystemInformation::socInfo.cpuCores = ESP.getChipCores();
 		NL::SystemInformation::socInfo.cpuClock = ESP.getCpuFreqMHz() * 1000000;
+		NL::SystemInformation::socInfo.heapSize = ESP.getHeapSize();
 		NL::SystemInformation::socInfo.freeHeap = ESP.getFreeHeap();
+		NL::SystemInformation::socInfo.minFreeHeap = ESP.getMinFreeHeap();
+		NL::SystemInformation::socInfo.maxAllocHeap = ESP.getMaxAllocHeap();
 		NL::SystemInformation::socInfo.flashSize = ESP.getFlashChipSize();
 		NL::SystemInformation::socInfo.flashSpeed = ESP.getFlashChipSpeed();
 		NL::SystemInformation::socInfo.sketchSize = ESP.getSketchSize();
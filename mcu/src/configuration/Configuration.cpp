@@ -25,11 +25,22 @@ bool NL::Configuration::initialized = false;
 FS *NL::Configuration::fileSystem;
 String NL::Configuration::fileName;
 uint16_t NL::Configuration::configurationVersion;
-size_t NL::Configuration::activeProfile;
-std::vector<NL::Configuration::Profile> NL::Configuration::profiles;
+size_t NL::Configuration::profileCount = 0;
+uint8_t NL::Configuration::profileSlots[CONFIGURATION_MAX_PROFILES];
+uint32_t NL::Configuration::profileNameHashes[CONFIGURATION_MAX_PROFILES];
+size_t NL::Configuration::savedProfileCount = 0;
+uint8_t NL::Configuration::savedProfileSlots[CONFIGURATION_MAX_PROFILES];
+File NL::Configuration::profileFile;
+NL::Configuration::ProfileCacheEntry NL::Configuration::profileCache[CONFIGURATION_PROFILE_CACHE_SIZE];
+uint32_t NL::Configuration::profileCacheAccess = 0;
 NL::Configuration::WiFiConfig NL::Configuration::wifiConfig;
 NL::Configuration::MotionSensorCalibration NL::Configuration::motionSensorCalibration;
 NL::Configuration::AudioUnitConfig NL::Configuration::audioUnitConfig;
+bool NL::Configuration::saveRequested = false;
+uint32_t NL::Configuration::saveRequestTime = 0;
+portMUX_TYPE NL::Configuration::runtimeConfigMux = portMUX_INITIALIZER_UNLOCKED;
+std::atomic<uint32_t> NL::Configuration::runtimeGeneration(0);
+NL::Configuration::RuntimeConfig NL::Configuration::runtimeConfig;
 
 /**
  * @brief Initialize the configuration.
@@ -54,7 +65,10 @@ void NL::Configuration::begin(FS *fileSystem, const String fileName)
 void NL::Configuration::end()
 {
 	NL::Configuration::initialized = false;
-	NL::Configuration::profiles.clear();
+	NL::Configuration::clearProfileCache();
+	NL::Configuration::profileCount = 0;
+	NL::Configuration::savedProfileCount = 0;
+	NL::Configuration::closeProfileFile();
 }
 
 /**
@@ -73,33 +87,48 @@ bool NL::Configuration::isInitialized()
  */
 size_t NL::Configuration::getProfileCount()
 {
-	return NL::Configuration::profiles.size();
+	return NL::Configuration::profileCount;
 }
 
 /**
  * @brief Get the profile name by the profile index.
+ * Profiles which are not cached are read from the profile file.
  * @param profileIndex index of the porfile
  * @param profileName reference to a string holding the name
  * @return OK when the profile name was read
  * @return ERROR_OUT_OF_BOUNDS when the profile index is invalid
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the profile could not be read
+ * @return ERROR_FILE_HASH when the profile record is corrupted
  */
 NL::Configuration::Error NL::Configuration::getProfileNameByIndex(const size_t profileIndex, String &profileName)
 {
-	if (profileIndex >= NL::Configuration::profiles.size())
+	if (profileIndex >= NL::Configuration::profileCount)
 	{
 		return NL::Configuration::Error::ERROR_OUT_OF_BOUNDS;
 	}
 
-	profileName = NL::Configuration::profiles.at(profileIndex).name;
+	NL::Configuration::Profile profile;
+	const NL::Configuration::Error readError = NL::Configuration::readProfile(profileIndex, profile);
+	if (readError != NL::Configuration::Error::OK)
+	{
+		return readError;
+	}
+
+	profileName = profile.name;
 	return NL::Configuration::Error::OK;
 }
 
 /**
  * @brief Get a single profile from the configuration.
+ * Profiles which are not cached are read from the profile file.
  * @param profileName name of the profile to get
  * @param profile reference to a variable holding the profile
  * @return OK when the profile was read
  * @return ERROR_PROFILE_NOT_FOUND when no profile with the given name was found
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the profile could not be read
+ * @return ERROR_FILE_HASH when the profile record is corrupted
  */
 NL::Configuration::Error NL::Configuration::getProfile(const String &profileName, NL::Configuration::Profile &profile)
 {
@@ -110,8 +139,7 @@ NL::Configuration::Error NL::Configuration::getProfile(const String &profileName
 		return findError;
 	}
 
-	profile = NL::Configuration::profiles.at(profileIndex);
-	return NL::Configuration::Error::OK;
+	return NL::Configuration::readProfile(profileIndex, profile);
 }
 
 /**
@@ -120,10 +148,12 @@ NL::Configuration::Error NL::Configuration::getProfile(const String &profileName
  * @return OK when the new profile was created
  * @return ERROR_TOO_MANY_PROFILES when the profile limited is reached
  * @return ERROR_PROFILE_NAME_EXISTS when the profile name already exists
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_WRITE when a cached profile could not be written to make room for the new profile
  */
 NL::Configuration::Error NL::Configuration::createProfile(const String &profileName)
 {
-	if (NL::Configuration::profiles.size() + 1 > CONFIGURATION_MAX_PROFILES)
+	if (NL::Configuration::profileCount + 1 > CONFIGURATION_MAX_PROFILES)
 	{
 		return NL::Configuration::Error::ERROR_TOO_MANY_PROFILES;
 	}
@@ -135,10 +165,20 @@ NL::Configuration::Error NL::Configuration::createProfile(const String &profileN
 		return NL::Configuration::Error::ERROR_PROFILE_NAME_EXISTS;
 	}
 
-	NL::Configuration::Profile profile;
-	profile.name = profileName;
-	NL::Configuration::profiles.push_back(profile);
-	NL::Configuration::loadProfileDefaults(NL::Configuration::profiles.size() - 1);
+	// The new profile is only held in the cache until it is written
+	NL::Configuration::ProfileCacheEntry *entry;
+	const NL::Configuration::Error cacheError = NL::Configuration::addCacheEntry(NL::Configuration::profileCount, entry);
+	if (cacheError != NL::Configuration::Error::OK)
+	{
+		return cacheError;
+	}
+
+	entry->changed = true;
+	entry->profile.name = profileName;
+	NL::Configuration::loadProfileDefaults(entry->profile);
+	NL::Configuration::profileSlots[NL::Configuration::profileCount] = NL::Configuration::PROFILE_SLOT_NONE;
+	NL::Configuration::profileNameHashes[NL::Configuration::profileCount] = NL::Configuration::getNameHash(profileName);
+	NL::Configuration::profileCount++;
 	return NL::Configuration::Error::OK;
 }
 
@@ -150,10 +190,14 @@ NL::Configuration::Error NL::Configuration::createProfile(const String &profileN
  * @return ERROR_TOO_MANY_PROFILES when the profile limited is reached
  * @return ERROR_PROFILE_NAME_EXISTS when the profile name already exists
  * @return ERROR_PROFILE_NOT_FOUND when no profile with the given name was found
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the existing profile could not be read
+ * @return ERROR_FILE_HASH when the record of the existing profile is corrupted
+ * @return ERROR_FILE_WRITE when a cached profile could not be written to make room for the new profile
  */
 NL::Configuration::Error NL::Configuration::cloneProfile(const String &sourceName, const String &destinationName)
 {
-	if (NL::Configuration::profiles.size() + 1 > CONFIGURATION_MAX_PROFILES)
+	if (NL::Configuration::profileCount + 1 > CONFIGURATION_MAX_PROFILES)
 	{
 		return NL::Configuration::Error::ERROR_TOO_MANY_PROFILES;
 	}
@@ -172,8 +216,20 @@ NL::Configuration::Error NL::Configuration::cloneProfile(const String &sourceNam
 		return loadError;
 	}
 
-	existingProfile.name = destinationName;
-	NL::Configuration::profiles.push_back(existingProfile);
+	// The new profile is only held in the cache until it is written
+	NL::Configuration::ProfileCacheEntry *entry;
+	const NL::Configuration::Error cacheError = NL::Configuration::addCacheEntry(NL::Configuration::profileCount, entry);
+	if (cacheError != NL::Configuration::Error::OK)
+	{
+		return cacheError;
+	}
+
+	entry->changed = true;
+	entry->profile = existingProfile;
+	entry->profile.name = destinationName;
+	NL::Configuration::profileSlots[NL::Configuration::profileCount] = NL::Configuration::PROFILE_SLOT_NONE;
+	NL::Configuration::profileNameHashes[NL::Configuration::profileCount] = NL::Configuration::getNameHash(destinationName);
+	NL::Configuration::profileCount++;
 	return NL::Configuration::Error::OK;
 }
 
@@ -184,6 +240,10 @@ NL::Configuration::Error NL::Configuration::cloneProfile(const String &sourceNam
  * @return OK when the profile was renamed
  * @return ERROR_PROFILE_NAME_EXISTS when the profile name already exists
  * @return ERROR_PROFILE_NOT_FOUND when no profile with the given name was found
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the profile could not be read
+ * @return ERROR_FILE_HASH when the profile record is corrupted
+ * @return ERROR_FILE_WRITE when a cached profile could not be written to make room for the profile
  */
 NL::Configuration::Error NL::Configuration::renameProfile(const String &profileName, const String &newProfileName)
 {
@@ -200,12 +260,22 @@ NL::Configuration::Error NL::Configuration::renameProfile(const String &profileN
 		return NL::Configuration::Error::ERROR_PROFILE_NOT_FOUND;
 	}
 
-	NL::Configuration::profiles.at(profileIndex).name = newProfileName;
+	NL::Configuration::ProfileCacheEntry *entry;
+	const NL::Configuration::Error cacheError = NL::Configuration::getCachedProfile(profileIndex, entry);
+	if (cacheError != NL::Configuration::Error::OK)
+	{
+		return cacheError;
+	}
+
+	entry->changed = true;
+	entry->profile.name = newProfileName;
+	NL::Configuration::profileNameHashes[profileIndex] = NL::Configuration::getNameHash(newProfileName);
 	return NL::Configuration::Error::OK;
 }
 
 /**
  * @brief Delete a profile by the profile name.
+ * The record stays in the profile file until the configuration is saved without it.
  * @param profileName name of the profile to delete
  * @return OK when the profile was delete
  * @return ERROR_PROFILE_IS_ACTIVE when the currently active profile is deleted
@@ -220,16 +290,37 @@ NL::Configuration::Error NL::Configuration::deleteProfile(const String &profileN
 		return findError;
 	}
 
-	if (NL::Configuration::activeProfile == profileIndex)
+	if (NL::Configuration::profileCache[0].profileIndex == profileIndex)
 	{
 		return NL::Configuration::Error::ERROR_PROFILE_IS_ACTIVE;
 	}
-	else if (NL::Configuration::activeProfile > profileIndex)
+
+	// Drop the profile from the cache and move the following profiles down by one
+	for (size_t i = 0; i < CONFIGURATION_PROFILE_CACHE_SIZE; i++)
 	{
-		NL::Configuration::activeProfile--;
+		NL::Configuration::ProfileCacheEntry &entry = NL::Configuration::profileCache[i];
+		if (!entry.used)
+		{
+			continue;
+		}
+		else if (entry.profileIndex == profileIndex)
+		{
+			entry.used = false;
+			entry.changed = false;
+			entry.profile = NL::Configuration::Profile();
+		}
+		else if (entry.profileIndex > profileIndex)
+		{
+			entry.profileIndex--;
+		}
 	}
 
-	NL::Configuration::profiles.erase(NL::Configuration::profiles.begin() + profileIndex);
+	for (size_t i = profileIndex; i + 1 < NL::Configuration::profileCount; i++)
+	{
+		NL::Configuration::profileSlots[i] = NL::Configuration::profileSlots[i + 1];
+		NL::Configuration::profileNameHashes[i] = NL::Configuration::profileNameHashes[i + 1];
+	}
+	NL::Configuration::profileCount--;
 	return NL::Configuration::Error::OK;
 }
 
@@ -239,14 +330,19 @@ NL::Configuration::Error NL::Configuration::deleteProfile(const String &profileN
  */
 String NL::Configuration::getActiveProfile()
 {
-	return NL::Configuration::profiles.at(NL::Configuration::activeProfile).name;
+	return NL::Configuration::profileCache[0].profile.name;
 }
 
 /**
  * @brief Set the active profile by the profile name.
+ * The profile is read from the profile file when it is not cached.
  * @param profileName name of the profile to activate
  * @return OK when the active profile was set
  * @return ERROR_PROFILE_NOT_FOUND when no profile with the given name was found
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the profile could not be read
+ * @return ERROR_FILE_HASH when the profile record is corrupted
+ * @return ERROR_FILE_WRITE when a cached profile could not be written to make room for the profile
  */
 NL::Configuration::Error NL::Configuration::setActiveProfile(const String &profileName)
 {
@@ -257,7 +353,20 @@ NL::Configuration::Error NL::Configuration::setActiveProfile(const String &profi
 		return findError;
 	}
 
-	NL::Configuration::activeProfile = profileIndex;
+	NL::Configuration::ProfileCacheEntry *entry;
+	const NL::Configuration::Error cacheError = NL::Configuration::getCachedProfile(profileIndex, entry);
+	if (cacheError != NL::Configuration::Error::OK)
+	{
+		return cacheError;
+	}
+
+	// The first cache entry always holds the active profile, the previous one stays cached
+	if (entry != &NL::Configuration::profileCache[0])
+	{
+		std::swap(*entry, NL::Configuration::profileCache[0]);
+	}
+
+	NL::Configuration::updateRuntimeConfig();
 	return NL::Configuration::Error::OK;
 }
 
@@ -267,7 +376,7 @@ NL::Configuration::Error NL::Configuration::setActiveProfile(const String &profi
  */
 NL::Configuration::SystemConfig NL::Configuration::getSystemConfig()
 {
-	return NL::Configuration::profiles.at(NL::Configuration::activeProfile).systemConfig;
+	return NL::Configuration::profileCache[0].profile.systemConfig;
 }
 
 /**
@@ -276,7 +385,9 @@ NL::Configuration::SystemConfig NL::Configuration::getSystemConfig()
  */
 void NL::Configuration::setSystemConfig(NL::Configuration::SystemConfig &systemConfig)
 {
-	NL::Configuration::profiles.at(NL::Configuration::activeProfile).systemConfig = systemConfig;
+	NL::Configuration::profileCache[0].profile.systemConfig = systemConfig;
+	NL::Configuration::profileCache[0].changed = true;
+	NL::Configuration::updateRuntimeConfig();
 }
 
 /**
@@ -293,7 +404,7 @@ NL::Configuration::Error NL::Configuration::getLedConfig(const uint8_t zoneIndex
 		return NL::Configuration::Error::ERROR_OUT_OF_BOUNDS;
 	}
 
-	ledConfig = NL::Configuration::profiles.at(NL::Configuration::activeProfile).ledConfig[zoneIndex];
+	ledConfig = NL::Configuration::profileCache[0].profile.ledConfig[zoneIndex];
 	return NL::Configuration::Error::OK;
 }
 
@@ -311,7 +422,9 @@ NL::Configuration::Error NL::Configuration::setLedConfig(const uint8_t zoneIndex
 		return NL::Configuration::Error::ERROR_OUT_OF_BOUNDS;
 	}
 
-	NL::Configuration::profiles.at(NL::Configuration::activeProfile).ledConfig[zoneIndex] = ledConfig;
+	NL::Configuration::profileCache[0].profile.ledConfig[zoneIndex] = ledConfig;
+	NL::Configuration::profileCache[0].changed = true;
+	NL::Configuration::updateRuntimeConfig();
 	return NL::Configuration::Error::OK;
 }
 
@@ -349,6 +462,7 @@ NL::Configuration::MotionSensorCalibration NL::Configuration::getMotionSensorCal
 void NL::Configuration::setMotionSensorCalibration(const NL::Configuration::MotionSensorCalibration &calibration)
 {
 	NL::Configuration::motionSensorCalibration = calibration;
+	NL::Configuration::updateRuntimeConfig();
 }
 
 /**
@@ -375,7 +489,7 @@ void NL::Configuration::setAudioUnitConfig(const NL::Configuration::AudioUnitCon
  */
 NL::Configuration::UIConfiguration NL::Configuration::getUIConfiguration()
 {
-	return NL::Configuration::profiles.at(NL::Configuration::activeProfile).uiConfiguration;
+	return NL::Configuration::profileCache[0].profile.uiConfiguration;
 }
 
 /**
@@ -384,7 +498,31 @@ NL::Configuration::UIConfiguration NL::Configuration::getUIConfiguration()
  */
 void NL::Configuration::setUIConfiguration(const NL::Configuration::UIConfiguration &uiConfiguration)
 {
-	NL::Configuration::profiles.at(NL::Configuration::activeProfile).uiConfiguration = uiConfiguration;
+	NL::Configuration::profileCache[0].profile.uiConfiguration = uiConfiguration;
+	NL::Configuration::profileCache[0].changed = true;
+}
+
+/**
+ * @brief Get the generation of the runtime configuration. It is incremented each time the configuration changes.
+ * This can be used to check if a cached runtime configuration is still up to date without copying it.
+ * @return generation of the runtime configuration
+ */
+uint32_t NL::Configuration::getRuntimeGeneration()
+{
+	return NL::Configuration::runtimeGeneration.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Get a copy of the runtime configuration. It contains the values of the active profile
+ * that are used at runtime, already converted into the units used by the hot path.
+ * Can be called from any task.
+ * @param runtimeConfig reference to a variable holding the runtime configuration
+ */
+void NL::Configuration::getRuntimeConfig(NL::Configuration::RuntimeConfig &runtimeConfig)
+{
+	portENTER_CRITICAL(&NL::Configuration::runtimeConfigMux);
+	runtimeConfig = NL::Configuration::runtimeConfig;
+	portEXIT_CRITICAL(&NL::Configuration::runtimeConfigMux);
 }
 
 /**
@@ -392,13 +530,19 @@ void NL::Configuration::setUIConfiguration(const NL::Configuration::UIConfigurat
  */
 void NL::Configuration::loadDefaults()
 {
-	// Create a default profile
-	NL::Configuration::activeProfile = 0;
-	NL::Configuration::Profile defaultProfile;
-	defaultProfile.name = F("Default Profile");
-	NL::Configuration::profiles.clear();
-	NL::Configuration::profiles.push_back(defaultProfile);
-	NL::Configuration::loadProfileDefaults(NL::Configuration::activeProfile);
+	// Create a default profile, it is written to the profile file with the next save
+	NL::Configuration::clearProfileCache();
+	NL::Configuration::ProfileCacheEntry &entry = NL::Configuration::profileCache[0];
+	entry.used = true;
+	entry.changed = true;
+	entry.profileIndex = 0;
+	entry.lastAccess = ++NL::Configuration::profileCacheAccess;
+	entry.profile.name = F("Default Profile");
+	NL::Configuration::loadProfileDefaults(entry.profile);
+	NL::Configuration::profileCount = 1;
+	NL::Configuration::profileSlots[0] = NL::Configuration::PROFILE_SLOT_NONE;
+	NL::Configuration::profileNameHashes[0] = NL::Configuration::getNameHash(entry.profile.name);
+	NL::Configuration::savedProfileCount = 0;
 
 	// WiFi config
 	NL::Configuration::wifiConfig.accessPointSsid = F(AP_DEFAULT_SSID);
@@ -434,19 +578,28 @@ void NL::Configuration::loadDefaults()
 		NL::Configuration::audioUnitConfig.peakDetectorConfig[i].influence = AUDIO_UNIT_DEFAULT_PD_INFLUENCE;
 		NL::Configuration::audioUnitConfig.peakDetectorConfig[i].noiseGate = AUDIO_UNIT_DEFAULT_PD_NOISE_GATE;
 	}
+
+	NL::Configuration::updateRuntimeConfig();
 }
 
 /**
  * @brief Load the configuration from a binary file.
+ * Only the active profile is read from the profile file, all other profiles are read when they are used.
  * @return OK when the file was loaded
  * @return ERROR_FILE_OPEN when the file could not be opened
  * @return ERROR_FILE_READ when the file could not be read
  * @return ERROR_FILE_VERSION when the file version does not match
- * @return ERROR_FILE_HASH when the file hash doesn't match
+ * @return ERROR_FILE_HASH when the file checksum or the record of the active profile doesn't match
  * @return ERROR_TOO_MANY_PROFILES when the configuration file contains too many profiles
  */
 NL::Configuration::Error NL::Configuration::load()
 {
+	// A power loss between removing the old and renaming the new file leaves only the temporary file
+	if (!NL::Configuration::fileSystem->exists(NL::Configuration::fileName) && NL::Configuration::fileSystem->exists(CONFIGURATION_TEMP_FILE_NAME))
+	{
+		NL::Configuration::fileSystem->rename(CONFIGURATION_TEMP_FILE_NAME, NL::Configuration::fileName);
+	}
+
 	NL::BinaryFile file(NL::Configuration::fileSystem);
 	const NL::BinaryFile::Error openError = file.open(NL::Configuration::fileName, FILE_READ);
 	if (openError != NL::BinaryFile::Error::OK)
@@ -482,76 +635,24 @@ NL::Configuration::Error NL::Configuration::load()
 	}
 
 	// Read the last active profile from the configuration file
-	if (file.read(NL::Configuration::activeProfile) != NL::BinaryFile::Error::OK)
+	uint16_t activeProfile;
+	if (file.read(activeProfile) != NL::BinaryFile::Error::OK || activeProfile >= profileCount)
 	{
+		file.close();
 		return NL::Configuration::Error::ERROR_FILE_READ;
 	}
 
-	// Read all profiles
-	NL::Configuration::profiles.resize(profileCount);
+	// Read the profile index, the profiles itself are read from the profile file when they are used
 	for (size_t i = 0; i < profileCount; i++)
 	{
-		// Get the profile
-		NL::Configuration::Profile profile = NL::Configuration::profiles.at(i);
-
-		// Profile name
 		bool readError = false;
-		readError = file.readString(profile.name) == NL::BinaryFile::Error::OK ? readError : true;
-
-		// System config
-		readError = file.read(profile.systemConfig.logLevel) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorMode) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorThreshold) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorMinAmbientBrightness) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorMaxAmbientBrightness) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorMinLedBrightness) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorMaxLedBrightness) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.lightSensorDuration) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.regulatorPowerLimit) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.regulatorHighTemperature) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.regulatorCutoffTemperature) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.fanMode) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.fanMinPwmValue) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.fanMaxPwmValue) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.fanMinTemperature) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.systemConfig.fanMaxTemperature) == NL::BinaryFile::Error::OK ? readError : true;
-
-		// LED config
-		for (uint8_t j = 0; j < LED_NUM_ZONES; j++)
-		{
-			readError = file.read(profile.ledConfig[j].ledPin) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].ledCount) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].type) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].dataSource) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].speed) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].offset) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].brightness) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].reverse) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].fadeSpeed) == NL::BinaryFile::Error::OK ? readError : true;
-			for (uint8_t k = 0; k < ANIMATOR_NUM_ANIMATION_SETTINGS; k++)
-			{
-				readError = file.read(profile.ledConfig[j].animationSettings[k]) == NL::BinaryFile::Error::OK ? readError : true;
-			}
-			readError = file.read(profile.ledConfig[j].ledVoltage) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].ledChannelCurrent[0]) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].ledChannelCurrent[1]) == NL::BinaryFile::Error::OK ? readError : true;
-			readError = file.read(profile.ledConfig[j].ledChannelCurrent[2]) == NL::BinaryFile::Error::OK ? readError : true;
-		}
-
-		// UI configuration
-		readError = file.readString(profile.uiConfiguration.language) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.readString(profile.uiConfiguration.theme) == NL::BinaryFile::Error::OK ? readError : true;
-		readError = file.read(profile.uiConfiguration.expertMode) == NL::BinaryFile::Error::OK ? readError : true;
-
-		// Check for read errors
-		if (readError)
+		readError = file.read(NL::Configuration::profileSlots[i]) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(NL::Configuration::profileNameHashes[i]) == NL::BinaryFile::Error::OK ? readError : true;
+		if (readError || NL::Configuration::profileSlots[i] >= CONFIGURATION_PROFILE_SLOTS)
 		{
 			file.close();
 			return NL::Configuration::Error::ERROR_FILE_READ;
 		}
-
-		// Update the profile
-		NL::Configuration::profiles.at(i) = profile;
 	}
 
 	// WiFi config
@@ -597,123 +698,91 @@ NL::Configuration::Error NL::Configuration::load()
 		return NL::Configuration::Error::ERROR_FILE_READ;
 	}
 
-	// Read the file hash
-	uint16_t fileHash = 0;
-	if (file.read(fileHash) != NL::BinaryFile::Error::OK)
+	// Read the file checksum
+	const uint32_t checksum = file.getChecksum();
+	uint32_t fileChecksum = 0;
+	if (file.read(fileChecksum) != NL::BinaryFile::Error::OK)
 	{
 		file.close();
 		return NL::Configuration::Error::ERROR_FILE_READ;
 	}
 
-	// Check the hash
-	if (fileHash != NL::Configuration::getSimpleHash())
+	// Check the checksum
+	if (fileChecksum != checksum)
 	{
 		file.close();
 		return NL::Configuration::Error::ERROR_FILE_HASH;
 	}
-
 	file.close();
+
+	// Read the active profile into the cache
+	NL::Configuration::clearProfileCache();
+	NL::Configuration::ProfileCacheEntry &entry = NL::Configuration::profileCache[0];
+	const NL::Configuration::Error profileError = NL::Configuration::readProfileRecord(NL::Configuration::profileSlots[activeProfile], entry.profile);
+	if (profileError != NL::Configuration::Error::OK)
+	{
+		return profileError;
+	}
+
+	entry.used = true;
+	entry.changed = false;
+	entry.profileIndex = activeProfile;
+	entry.lastAccess = ++NL::Configuration::profileCacheAccess;
+	NL::Configuration::profileCount = profileCount;
+	NL::Configuration::savedProfileCount = profileCount;
+	memcpy(NL::Configuration::savedProfileSlots, NL::Configuration::profileSlots, profileCount);
+	NL::Configuration::updateRuntimeConfig();
 	return NL::Configuration::Error::OK;
 }
 
 /**
  * @brief Save to configuration to a file.
+ * Changed profiles are written to free slots of the profile file first. The configuration is then written to a temporary file,
+ * which replaces the configuration file and references the new profile records. This way a power loss while saving can not corrupt the configuration.
+ * A temporary file which could not be written completely is removed.
  * @return OK when the file was saved
  * @return ERROR_FILE_OPEN when the file could not be opened
  * @return ERROR_FILE_WRITE when the file could not be written
  */
 NL::Configuration::Error NL::Configuration::save()
 {
-	NL::BinaryFile file(NL::Configuration::fileSystem);
-	const NL::BinaryFile::Error openError = file.open(NL::Configuration::fileName, FILE_WRITE);
-	if (openError != NL::BinaryFile::Error::OK)
+	// Write the changed profiles
+	for (size_t i = 0; i < CONFIGURATION_PROFILE_CACHE_SIZE; i++)
 	{
-		return NL::Configuration::Error::ERROR_FILE_OPEN;
+		NL::Configuration::ProfileCacheEntry &entry = NL::Configuration::profileCache[i];
+		if (entry.used && entry.changed)
+		{
+			const NL::Configuration::Error writeError = NL::Configuration::writeProfileRecord(entry.profileIndex, entry.profile);
+			if (writeError != NL::Configuration::Error::OK)
+			{
+				return writeError;
+			}
+			entry.changed = false;
+		}
 	}
 
-	// Write the configuration file version
-	if (file.write(NL::Configuration::configurationVersion) != NL::BinaryFile::Error::OK)
+	NL::BinaryFile file(NL::Configuration::fileSystem);
+	const NL::BinaryFile::Error openError = file.open(CONFIGURATION_TEMP_FILE_NAME, FILE_WRITE);
+	if (openError != NL::BinaryFile::Error::OK)
 	{
-		return NL::Configuration::Error::ERROR_FILE_WRITE;
+		NL::Configuration::fileSystem->remove(CONFIGURATION_TEMP_FILE_NAME);
+		return NL::Configuration::Error::ERROR_FILE_OPEN;
 	}
 
-	// Write the number of profiles
-	if (file.write(static_cast<uint16_t>(NL::Configuration::profiles.size())) != NL::BinaryFile::Error::OK)
-	{
-		return NL::Configuration::Error::ERROR_FILE_WRITE;
-	}
+	// Write the configuration file version, the number of profiles and the last active profile
+	bool writeError = false;
+	writeError = file.write(NL::Configuration::configurationVersion) == NL::BinaryFile::Error::OK ? writeError : true;
+	writeError = file.write(static_cast<uint16_t>(NL::Configuration::profileCount)) == NL::BinaryFile::Error::OK ? writeError : true;
+	writeError = file.write(static_cast<uint16_t>(NL::Configuration::profileCache[0].profileIndex)) == NL::BinaryFile::Error::OK ? writeError : true;
 
-	// Write the last active profile
-	if (file.write(NL::Configuration::activeProfile) != NL::BinaryFile::Error::OK)
+	// Write the profile index
+	for (size_t i = 0; i < NL::Configuration::profileCount; i++)
 	{
-		return NL::Configuration::Error::ERROR_FILE_WRITE;
-	}
-
-	// Write all profiles to the configuration file
-	for (size_t i = 0; i < NL::Configuration::profiles.size(); i++)
-	{
-		// Get the profile
-		NL::Configuration::Profile profile = NL::Configuration::profiles.at(i);
-
-		// Profile name
-		bool writeError = false;
-		writeError = file.writeString(profile.name) == NL::BinaryFile::Error::OK ? writeError : true;
-
-		// System cofiguration
-		writeError = file.write(static_cast<uint8_t>(profile.systemConfig.logLevel)) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(static_cast<uint8_t>(profile.systemConfig.lightSensorMode)) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.lightSensorThreshold) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.lightSensorMinAmbientBrightness) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.lightSensorMaxAmbientBrightness) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.lightSensorMinLedBrightness) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.lightSensorMaxLedBrightness) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.lightSensorDuration) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.regulatorPowerLimit) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.regulatorHighTemperature) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.regulatorCutoffTemperature) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.fanMode) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.fanMinPwmValue) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.fanMaxPwmValue) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.fanMinTemperature) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.systemConfig.fanMaxTemperature) == NL::BinaryFile::Error::OK ? writeError : true;
-
-		// LED configuration
-		for (uint8_t j = 0; j < LED_NUM_ZONES; j++)
-		{
-			writeError = file.write(profile.ledConfig[j].ledPin) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].ledCount) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].type) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].dataSource) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].speed) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].offset) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].brightness) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].reverse) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].fadeSpeed) == NL::BinaryFile::Error::OK ? writeError : true;
-			for (uint8_t k = 0; k < ANIMATOR_NUM_ANIMATION_SETTINGS; k++)
-			{
-				writeError = file.write(profile.ledConfig[j].animationSettings[k]) == NL::BinaryFile::Error::OK ? writeError : true;
-			}
-			writeError = file.write(profile.ledConfig[j].ledVoltage) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].ledChannelCurrent[0]) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].ledChannelCurrent[1]) == NL::BinaryFile::Error::OK ? writeError : true;
-			writeError = file.write(profile.ledConfig[j].ledChannelCurrent[2]) == NL::BinaryFile::Error::OK ? writeError : true;
-		}
-
-		// UI configuration
-		writeError = file.writeString(profile.uiConfiguration.language) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.writeString(profile.uiConfiguration.theme) == NL::BinaryFile::Error::OK ? writeError : true;
-		writeError = file.write(profile.uiConfiguration.expertMode) == NL::BinaryFile::Error::OK ? writeError : true;
-
-		// Check for write errors
-		if (writeError)
-		{
-			file.close();
-			return NL::Configuration::Error::ERROR_FILE_WRITE;
-		}
+		writeError = file.write(NL::Configuration::profileSlots[i]) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(NL::Configuration::profileNameHashes[i]) == NL::BinaryFile::Error::OK ? writeError : true;
 	}
 
 	// WiFi configuration
-	bool writeError = false;
 	writeError = file.writeString(NL::Configuration::wifiConfig.accessPointSsid) == NL::BinaryFile::Error::OK ? writeError : true;
 	writeError = file.writeString(NL::Configuration::wifiConfig.accessPointPassword) == NL::BinaryFile::Error::OK ? writeError : true;
 	writeError = file.write(NL::Configuration::wifiConfig.accessPointChannel) == NL::BinaryFile::Error::OK ? writeError : true;
@@ -748,29 +817,136 @@ NL::Configuration::Error NL::Configuration::save()
 		writeError = file.write(NL::Configuration::audioUnitConfig.peakDetectorConfig[i].noiseGate) == NL::BinaryFile::Error::OK ? writeError : true;
 	}
 
-	// Write the hash
-	writeError = file.write(NL::Configuration::getSimpleHash()) == NL::BinaryFile::Error::OK ? writeError : true;
+	// Write the checksum
+	writeError = file.write(file.getChecksum()) == NL::BinaryFile::Error::OK ? writeError : true;
 
-	file.close();
-	return !writeError ? NL::Configuration::Error::OK : NL::Configuration::Error::ERROR_FILE_WRITE;
+	// Buffered data is written when closing the file
+	writeError = file.close() == NL::BinaryFile::Error::OK ? writeError : true;
+	if (writeError)
+	{
+		NL::Configuration::fileSystem->remove(CONFIGURATION_TEMP_FILE_NAME);
+		return NL::Configuration::Error::ERROR_FILE_WRITE;
+	}
+
+	// Replace the configuration file, a complete temporary file is kept when the rename fails and is used by the next load
+	NL::Configuration::fileSystem->remove(NL::Configuration::fileName);
+	if (!NL::Configuration::fileSystem->rename(CONFIGURATION_TEMP_FILE_NAME, NL::Configuration::fileName))
+	{
+		return NL::Configuration::Error::ERROR_FILE_WRITE;
+	}
+
+	// Slots which are no longer referenced by the configuration file can now be reused
+	NL::Configuration::savedProfileCount = NL::Configuration::profileCount;
+	memcpy(NL::Configuration::savedProfileSlots, NL::Configuration::profileSlots, NL::Configuration::profileCount);
+	return NL::Configuration::Error::OK;
 }
 
 /**
- * @brief Load the default, profile depending settings for the currently selected profile.
- * @param profileIndex index of the profile to reset
- * @return OK when the profile was reset
- * @return ERROR_OUT_OF_BOUNDS when the profile index is invalid
+ * @brief Mark the configuration as changed. It is saved by {@link NL::Configuration::handleSave} after
+ * {@link CONFIGURATION_SAVE_DELAY} ms without further changes, so quick changes are saved only once.
+ */
+void NL::Configuration::requestSave()
+{
+	NL::Configuration::saveRequested = true;
+	NL::Configuration::saveRequestTime = millis();
+}
+
+/**
+ * @brief Discard a requested save, for example because the configuration file is deleted.
  */
-NL::Configuration::Error NL::Configuration::loadProfileDefaults(const size_t profileIndex)
+void NL::Configuration::discardSave()
 {
-	if (profileIndex >= NL::Configuration::profiles.size())
+	NL::Configuration::saveRequested = false;
+}
+
+/**
+ * @brief Save the configuration when it was changed and no further changes happened for {@link CONFIGURATION_SAVE_DELAY} ms.
+ * When saving fails, it is tried again after the delay. Must be called from the same task which changes the configuration.
+ * @param force save a requested change right away
+ * @return OK when the configuration was saved or nothing needs to be saved
+ * @return ERROR_FILE_OPEN when the file could not be opened
+ * @return ERROR_FILE_WRITE when the file could not be written
+ */
+NL::Configuration::Error NL::Configuration::handleSave(const bool force)
+{
+	if (!NL::Configuration::saveRequested)
 	{
-		return NL::Configuration::Error::ERROR_OUT_OF_BOUNDS;
+		return NL::Configuration::Error::OK;
+	}
+
+	if (!force && millis() - NL::Configuration::saveRequestTime < CONFIGURATION_SAVE_DELAY)
+	{
+		return NL::Configuration::Error::OK;
+	}
+
+	const NL::Configuration::Error saveError = NL::Configuration::save();
+	if (saveError != NL::Configuration::Error::OK)
+	{
+		NL::Configuration::requestSave();
+		return saveError;
+	}
+
+	NL::Configuration::saveRequested = false;
+	return NL::Configuration::Error::OK;
+}
+
+/**
+ * @brief Pack the system and LED configuration of a profile into a record without padding.
+ * The record has the same layout as the individual fields in the configuration file.
+ * @param profile profile to pack
+ * @param record reference to the record
+ */
+void NL::Configuration::packProfile(const NL::Configuration::Profile &profile, NL::Configuration::ProfileRecord &record)
+{
+	record.systemConfig = profile.systemConfig;
+	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		record.ledConfig[i].ledPin = profile.ledConfig[i].ledPin;
+		record.ledConfig[i].ledCount = profile.ledConfig[i].ledCount;
+		record.ledConfig[i].type = profile.ledConfig[i].type;
+		record.ledConfig[i].dataSource = profile.ledConfig[i].dataSource;
+		record.ledConfig[i].speed = profile.ledConfig[i].speed;
+		record.ledConfig[i].offset = profile.ledConfig[i].offset;
+		record.ledConfig[i].brightness = profile.ledConfig[i].brightness;
+		record.ledConfig[i].reverse = profile.ledConfig[i].reverse;
+		record.ledConfig[i].fadeSpeed = profile.ledConfig[i].fadeSpeed;
+		memcpy(record.ledConfig[i].animationSettings, profile.ledConfig[i].animationSettings, ANIMATOR_NUM_ANIMATION_SETTINGS);
+		record.ledConfig[i].ledVoltage = profile.ledConfig[i].ledVoltage;
+		memcpy(record.ledConfig[i].ledChannelCurrent, profile.ledConfig[i].ledChannelCurrent, 3);
 	}
+}
 
-	// Get the currently active profile
-	NL::Configuration::Profile profile = NL::Configuration::profiles.at(profileIndex);
+/**
+ * @brief Unpack the system and LED configuration of a profile from a record.
+ * @param record record to unpack
+ * @param profile reference to the profile
+ */
+void NL::Configuration::unpackProfile(const NL::Configuration::ProfileRecord &record, NL::Configuration::Profile &profile)
+{
+	profile.systemConfig = record.systemConfig;
+	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		profile.ledConfig[i].ledPin = record.ledConfig[i].ledPin;
+		profile.ledConfig[i].ledCount = record.ledConfig[i].ledCount;
+		profile.ledConfig[i].type = record.ledConfig[i].type;
+		profile.ledConfig[i].dataSource = record.ledConfig[i].dataSource;
+		profile.ledConfig[i].speed = record.ledConfig[i].speed;
+		profile.ledConfig[i].offset = record.ledConfig[i].offset;
+		profile.ledConfig[i].brightness = record.ledConfig[i].brightness;
+		profile.ledConfig[i].reverse = record.ledConfig[i].reverse;
+		profile.ledConfig[i].fadeSpeed = record.ledConfig[i].fadeSpeed;
+		memcpy(profile.ledConfig[i].animationSettings, record.ledConfig[i].animationSettings, ANIMATOR_NUM_ANIMATION_SETTINGS);
+		profile.ledConfig[i].ledVoltage = record.ledConfig[i].ledVoltage;
+		memcpy(profile.ledConfig[i].ledChannelCurrent, record.ledConfig[i].ledChannelCurrent, 3);
+	}
+}
 
+/**
+ * @brief Load the default, profile depending settings into a profile. The name of the profile is kept.
+ * @param profile reference to the profile
+ */
+void NL::Configuration::loadProfileDefaults(NL::Configuration::Profile &profile)
+{
 	// System config
 	profile.systemConfig.logLevel = LOG_DEFAULT_LEVEL;
 	profile.systemConfig.lightSensorMode = LIGHT_SENSOR_DEFAULT_MODE;
@@ -818,14 +994,78 @@ NL::Configuration::Error NL::Configuration::loadProfileDefaults(const size_t pro
 	profile.uiConfiguration.language = UI_DEFAULT_LANGUAGE;
 	profile.uiConfiguration.theme = UI_DEFAULT_THEME;
 	profile.uiConfiguration.expertMode = UI_DEFAULT_EXPERT;
+}
 
-	// Update the currently active profile
-	NL::Configuration::profiles.at(profileIndex) = profile;
-	return NL::Configuration::Error::OK;
+/**
+ * @brief Rebuild the runtime configuration from the active profile and publish it with a new generation.
+ * All values are precomputed into the units used by the render and sensor hot path.
+ */
+void NL::Configuration::updateRuntimeConfig()
+{
+	if (!NL::Configuration::profileCache[0].used)
+	{
+		return;
+	}
+
+	const NL::Configuration::Profile &profile = NL::Configuration::profileCache[0].profile;
+	NL::Configuration::RuntimeConfig config;
+	config.generation = NL::Configuration::runtimeGeneration.load(std::memory_order_relaxed) + 1;
+
+	// Light sensor
+	config.lightSensorMode = profile.systemConfig.lightSensorMode;
+	config.lightSensorThreshold = profile.systemConfig.lightSensorThreshold / 255.0f;
+	config.lightSensorMinAmbientBrightness = profile.systemConfig.lightSensorMinAmbientBrightness / 255.0f;
+	config.lightSensorMaxAmbientBrightness = profile.systemConfig.lightSensorMaxAmbientBrightness / 255.0f;
+	config.lightSensorMinLedBrightness = profile.systemConfig.lightSensorMinLedBrightness / 255.0f;
+	config.lightSensorMaxLedBrightness = profile.systemConfig.lightSensorMaxLedBrightness / 255.0f;
+	config.lightSensorDuration = profile.systemConfig.lightSensorDuration * 5000L;
+
+	// Regulator
+	config.regulatorPowerLimit = static_cast<float>(profile.systemConfig.regulatorPowerLimit) / REGULATOR_COUNT;
+	config.regulatorHighTemperature = profile.systemConfig.regulatorHighTemperature;
+	config.regulatorTemperatureRange = static_cast<float>(profile.systemConfig.regulatorCutoffTemperature) - profile.systemConfig.regulatorHighTemperature;
+
+	// LED zones
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		const NL::Configuration::LedConfig &ledConfig = profile.ledConfig[i];
+		config.zoneRegulatorIndex[i] = NL::Configuration::getRegulatorIndexFromPin(ledConfig.ledPin);
+		for (uint8_t j = 0; j < 3; j++)
+		{
+			config.zoneChannelPower[i][j] = ledConfig.ledChannelCurrent[j] * ledConfig.ledVoltage / 1000.0f / 255.0f;
+		}
+	}
+
+	// Motion sensor
+	config.motionSensorCalibration = NL::Configuration::motionSensorCalibration;
+
+	portENTER_CRITICAL(&NL::Configuration::runtimeConfigMux);
+	NL::Configuration::runtimeConfig = config;
+	portEXIT_CRITICAL(&NL::Configuration::runtimeConfigMux);
+	NL::Configuration::runtimeGeneration.store(config.generation, std::memory_order_release);
+}
+
+/**
+ * @brief Get the regulator index by providing the pin number.
+ * @param pin physical pin number
+ * @return regulator index
+ */
+uint8_t NL::Configuration::getRegulatorIndexFromPin(const uint8_t pin)
+{
+	const uint8_t regulatorMap[LED_NUM_ZONES][2] = REGULATOR_ZONE_MAPPING;
+	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		if (regulatorMap[i][0] == pin)
+		{
+			return regulatorMap[i][1];
+		}
+	}
+	return 0;
 }
 
 /**
  * @brief Get the index of a profile by the profile name.
+ * Only profiles with a matching name hash are read to compare the name.
  * @param profileName name of the profile
  * @param profileIndex reference variable holding the index
  * @return OK when the profile was found
@@ -833,9 +1073,16 @@ NL::Configuration::Error NL::Configuration::loadProfileDefaults(const size_t pro
  */
 NL::Configuration::Error NL::Configuration::getProfileIndexByName(const String &profileName, size_t &profileIndex)
 {
-	for (size_t i = 0; i < NL::Configuration::profiles.size(); i++)
+	const uint32_t nameHash = NL::Configuration::getNameHash(profileName);
+	for (size_t i = 0; i < NL::Configuration::profileCount; i++)
 	{
-		if (NL::Configuration::profiles.at(i).name == profileName)
+		if (NL::Configuration::profileNameHashes[i] != nameHash)
+		{
+			continue;
+		}
+
+		NL::Configuration::Profile profile;
+		if (NL::Configuration::readProfile(i, profile) == NL::Configuration::Error::OK && profile.name == profileName)
 		{
 			profileIndex = i;
 			return NL::Configuration::Error::OK;
@@ -845,125 +1092,277 @@ NL::Configuration::Error NL::Configuration::getProfileIndexByName(const String &
 }
 
 /**
- * @brief Calculate a very simple hash to check the config file.
- * @return uint16_t 2 byte hash
+ * @brief Calculate the hash of a profile name, which is used to find profiles without reading them.
+ * @param name name of the profile
+ * @return hash of the name
  */
-uint16_t NL::Configuration::getSimpleHash()
+uint32_t NL::Configuration::getNameHash(const String &name)
 {
-	uint16_t hash = 7;
+	return crc32_le(0, reinterpret_cast<const uint8_t *>(name.c_str()), name.length());
+}
 
-	// Configuration file version
-	hash = hash * 31 + NL::Configuration::configurationVersion;
+/**
+ * @brief Get a profile from the cache. When it is not cached, it is read from the profile file
+ * and replaces the least recently used profile in the cache. The active profile is never replaced.
+ * @param profileIndex index of the profile
+ * @param entry reference to a pointer holding the cache entry
+ * @return OK when the profile is cached
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the profile could not be read
+ * @return ERROR_FILE_HASH when the profile record is corrupted
+ * @return ERROR_FILE_WRITE when the replaced profile was changed and could not be written
+ */
+NL::Configuration::Error NL::Configuration::getCachedProfile(const size_t profileIndex, NL::Configuration::ProfileCacheEntry *&entry)
+{
+	for (size_t i = 0; i < CONFIGURATION_PROFILE_CACHE_SIZE; i++)
+	{
+		if (NL::Configuration::profileCache[i].used && NL::Configuration::profileCache[i].profileIndex == profileIndex)
+		{
+			entry = &NL::Configuration::profileCache[i];
+			entry->lastAccess = ++NL::Configuration::profileCacheAccess;
+			return NL::Configuration::Error::OK;
+		}
+	}
 
-	// Configuration profile count
-	hash = hash * 31 + NL::Configuration::profiles.size();
+	const NL::Configuration::Error cacheError = NL::Configuration::addCacheEntry(profileIndex, entry);
+	if (cacheError != NL::Configuration::Error::OK)
+	{
+		return cacheError;
+	}
+
+	const NL::Configuration::Error readError = NL::Configuration::readProfileRecord(NL::Configuration::profileSlots[profileIndex], entry->profile);
+	if (readError != NL::Configuration::Error::OK)
+	{
+		entry->used = false;
+		return readError;
+	}
 
-	// Configuration active profile
-	hash = hash * 31 + NL::Configuration::activeProfile;
+	return NL::Configuration::Error::OK;
+}
+
+/**
+ * @brief Add a profile to the cache by replacing a free or the least recently used entry.
+ * A changed profile is written to the profile file before its entry is replaced.
+ * @param profileIndex index of the profile
+ * @param entry reference to a pointer holding the new cache entry
+ * @return OK when the entry was added
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_WRITE when the replaced profile was changed and could not be written
+ */
+NL::Configuration::Error NL::Configuration::addCacheEntry(const size_t profileIndex, NL::Configuration::ProfileCacheEntry *&entry)
+{
+	// The first entry holds the active profile and is never replaced
+	NL::Configuration::ProfileCacheEntry *replacedEntry = &NL::Configuration::profileCache[1];
+	for (size_t i = 1; i < CONFIGURATION_PROFILE_CACHE_SIZE; i++)
+	{
+		if (!NL::Configuration::profileCache[i].used)
+		{
+			replacedEntry = &NL::Configuration::profileCache[i];
+			break;
+		}
+		else if (NL::Configuration::profileCache[i].lastAccess < replacedEntry->lastAccess)
+		{
+			replacedEntry = &NL::Configuration::profileCache[i];
+		}
+	}
 
-	// Run over all profiles
-	for (size_t i = 0; i < NL::Configuration::profiles.size(); i++)
+	if (replacedEntry->used && replacedEntry->changed)
 	{
-		// Get the profile
-		NL::Configuration::Profile profile = NL::Configuration::profiles.at(i);
+		const NL::Configuration::Error writeError = NL::Configuration::writeProfileRecord(replacedEntry->profileIndex, replacedEntry->profile);
+		if (writeError != NL::Configuration::Error::OK)
+		{
+			return writeError;
+		}
 
-		// Profile name
-		hash = hash * 31 + NL::Configuration::getSimpleStringHash(profile.name);
+		// The profile index now references the new record
+		NL::Configuration::requestSave();
+	}
 
-		// System configuration
-		hash = hash * 31 + profile.systemConfig.logLevel;
-		hash = hash * 31 + profile.systemConfig.lightSensorMode;
-		hash = hash * 31 + profile.systemConfig.lightSensorThreshold;
-		hash = hash * 31 + profile.systemConfig.lightSensorMinAmbientBrightness;
-		hash = hash * 31 + profile.systemConfig.lightSensorMaxAmbientBrightness;
-		hash = hash * 31 + profile.systemConfig.lightSensorMinLedBrightness;
-		hash = hash * 31 + profile.systemConfig.lightSensorMaxLedBrightness;
-		hash = hash * 31 + profile.systemConfig.regulatorPowerLimit;
-		hash = hash * 31 + profile.systemConfig.regulatorHighTemperature;
-		hash = hash * 31 + profile.systemConfig.regulatorCutoffTemperature;
-		hash = hash * 31 + profile.systemConfig.fanMode;
-		hash = hash * 31 + profile.systemConfig.fanMinPwmValue;
-		hash = hash * 31 + profile.systemConfig.fanMaxPwmValue;
-		hash = hash * 31 + profile.systemConfig.fanMinTemperature;
-		hash = hash * 31 + profile.systemConfig.fanMaxTemperature;
+	replacedEntry->used = true;
+	replacedEntry->changed = false;
+	replacedEntry->profileIndex = profileIndex;
+	replacedEntry->lastAccess = ++NL::Configuration::profileCacheAccess;
+	entry = replacedEntry;
+	return NL::Configuration::Error::OK;
+}
 
-		// LED configuration
-		for (uint8_t j = 0; j < LED_NUM_ZONES; j++)
+/**
+ * @brief Remove all profiles from the cache.
+ */
+void NL::Configuration::clearProfileCache()
+{
+	for (size_t i = 0; i < CONFIGURATION_PROFILE_CACHE_SIZE; i++)
+	{
+		NL::Configuration::profileCache[i].used = false;
+		NL::Configuration::profileCache[i].changed = false;
+		NL::Configuration::profileCache[i].profile = NL::Configuration::Profile();
+	}
+}
+
+/**
+ * @brief Read a profile from the cache or, when it is not cached, from the profile file without adding it to the cache.
+ * @param profileIndex index of the profile
+ * @param profile reference to a variable holding the profile
+ * @return OK when the profile was read
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the profile could not be read
+ * @return ERROR_FILE_HASH when the profile record is corrupted
+ */
+NL::Configuration::Error NL::Configuration::readProfile(const size_t profileIndex, NL::Configuration::Profile &profile)
+{
+	for (size_t i = 0; i < CONFIGURATION_PROFILE_CACHE_SIZE; i++)
+	{
+		if (NL::Configuration::profileCache[i].used && NL::Configuration::profileCache[i].profileIndex == profileIndex)
 		{
-			hash = hash * 31 + profile.ledConfig[j].ledPin;
-			hash = hash * 31 + profile.ledConfig[j].ledCount;
-			hash = hash * 31 + profile.ledConfig[j].type;
-			hash = hash * 31 + profile.ledConfig[j].dataSource;
-			hash = hash * 31 + profile.ledConfig[j].speed;
-			hash = hash * 31 + profile.ledConfig[j].offset;
-			hash = hash * 31 + profile.ledConfig[j].brightness;
-			hash = hash * 31 + profile.ledConfig[j].reverse;
-			hash = hash * 31 + profile.ledConfig[j].fadeSpeed;
-			for (uint8_t k = 0; k < ANIMATOR_NUM_ANIMATION_SETTINGS; k++)
-			{
-				hash = hash * 31 + profile.ledConfig[j].animationSettings[k];
-			}
-			hash = hash * 31 + profile.ledConfig[j].ledVoltage;
-			hash = hash * 31 + profile.ledConfig[j].ledChannelCurrent[0];
-			hash = hash * 31 + profile.ledConfig[j].ledChannelCurrent[1];
-			hash = hash * 31 + profile.ledConfig[j].ledChannelCurrent[2];
+			profile = NL::Configuration::profileCache[i].profile;
+			return NL::Configuration::Error::OK;
 		}
+	}
 
-		// UI configuration
-		hash = hash * 32 + NL::Configuration::getSimpleStringHash(profile.uiConfiguration.language);
-		hash = hash * 32 + NL::Configuration::getSimpleStringHash(profile.uiConfiguration.theme);
-		hash = hash * 32 + profile.uiConfiguration.expertMode;
+	return NL::Configuration::readProfileRecord(NL::Configuration::profileSlots[profileIndex], profile);
+}
+
+/**
+ * @brief Read a single profile record from the profile file.
+ * @param slot slot of the record in the profile file
+ * @param profile reference to a variable holding the profile
+ * @return OK when the profile was read
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_READ when the record could not be read
+ * @return ERROR_FILE_HASH when the checksum of the record doesn't match
+ */
+NL::Configuration::Error NL::Configuration::readProfileRecord(const uint8_t slot, NL::Configuration::Profile &profile)
+{
+	if (slot >= CONFIGURATION_PROFILE_SLOTS)
+	{
+		return NL::Configuration::Error::ERROR_FILE_READ;
 	}
 
-	// WiFi configuration
-	hash = hash * 31 + NL::Configuration::getSimpleStringHash(NL::Configuration::wifiConfig.accessPointSsid);
-	hash = hash * 31 + NL::Configuration::getSimpleStringHash(NL::Configuration::wifiConfig.accessPointPassword);
-	hash = hash * 31 + NL::Configuration::wifiConfig.accessPointChannel;
-	hash = hash * 31 + NL::Configuration::wifiConfig.accessPointHidden;
-	hash = hash * 31 + NL::Configuration::wifiConfig.accessPointMaxConnections;
-	hash = hash * 31 + NL::Configuration::getSimpleStringHash(NL::Configuration::wifiConfig.wifiSsid);
-	hash = hash * 31 + NL::Configuration::getSimpleStringHash(NL::Configuration::wifiConfig.wifiPassword);
+	const NL::Configuration::Error openError = NL::Configuration::openProfileFile();
+	if (openError != NL::Configuration::Error::OK)
+	{
+		return openError;
+	}
 
-	// Motion sensor calibration
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.accXRaw;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.accYRaw;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.accZRaw;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.gyroXRaw;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.gyroYRaw;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.gyroZRaw;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.accXG;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.accYG;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.accZG;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.gyroXDeg;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.gyroYDeg;
-	hash = hash * 31 + NL::Configuration::motionSensorCalibration.gyroZDeg;
+	NL::Configuration::ProfileFileRecord record;
+	if (!NL::Configuration::profileFile.seek(slot * sizeof(record)) || NL::Configuration::profileFile.read(reinterpret_cast<uint8_t *>(&record), sizeof(record)) != sizeof(record))
+	{
+		return NL::Configuration::Error::ERROR_FILE_READ;
+	}
 
-	// Audio unit configuration
-	hash = hash * 31 + NL::Configuration::audioUnitConfig.noiseThreshold;
-	for (size_t i = 0; i < AUDIO_UNIT_NUM_BANDS; i++)
+	if (record.checksum != crc32_le(0, reinterpret_cast<const uint8_t *>(&record), sizeof(record) - sizeof(record.checksum)))
 	{
-		hash = hash * 31 + NL::Configuration::audioUnitConfig.frequencyBandIndex[i].first;
-		hash = hash * 31 + NL::Configuration::audioUnitConfig.frequencyBandIndex[i].second;
-		hash = hash * 31 + NL::Configuration::audioUnitConfig.peakDetectorConfig[i].historySize;
-		hash = hash * 31 + NL::Configuration::audioUnitConfig.peakDetectorConfig[i].threshold;
-		hash = hash * 31 + NL::Configuration::audioUnitConfig.peakDetectorConfig[i].influence;
-		hash = hash * 31 + NL::Configuration::audioUnitConfig.peakDetectorConfig[i].noiseGate;
+		return NL::Configuration::Error::ERROR_FILE_HASH;
 	}
 
-	return hash;
+	record.name[CONFIGURATION_PROFILE_NAME_LENGTH] = '\0';
+	record.language[CONFIGURATION_UI_VALUE_LENGTH] = '\0';
+	record.theme[CONFIGURATION_UI_VALUE_LENGTH] = '\0';
+	profile.name = record.name;
+	NL::Configuration::unpackProfile(record.profile, profile);
+	profile.uiConfiguration.firmware = FW_VERSION;
+	profile.uiConfiguration.language = record.language;
+	profile.uiConfiguration.theme = record.theme;
+	profile.uiConfiguration.expertMode = record.expertMode;
+	return NL::Configuration::Error::OK;
 }
 
 /**
- * @brief Create a very simple hash based on a string.
- * @param input input string
- * @return uint16_t 2 byte hash
+ * @brief Write a profile to a free slot of the profile file and reference it from the profile index.
+ * A slot is free when it is neither referenced by the profile index nor by the saved configuration file.
+ * This way the records of the saved configuration stay intact until it is replaced.
+ * @param profileIndex index of the profile
+ * @param profile profile to write
+ * @return OK when the profile was written
+ * @return ERROR_FILE_OPEN when the profile file could not be opened
+ * @return ERROR_FILE_WRITE when the record could not be written
  */
-uint16_t NL::Configuration::getSimpleStringHash(const String input)
+NL::Configuration::Error NL::Configuration::writeProfileRecord(const size_t profileIndex, const NL::Configuration::Profile &profile)
 {
-	uint16_t hash = 7;
-	for (uint16_t i = 0; i < input.length(); i++)
+	const NL::Configuration::Error openError = NL::Configuration::openProfileFile();
+	if (openError != NL::Configuration::Error::OK)
 	{
-		hash = hash * 31 + input.charAt(i);
+		return openError;
 	}
-	return hash;
+
+	// Find a free slot
+	bool slotUsed[CONFIGURATION_PROFILE_SLOTS] = {false};
+	for (size_t i = 0; i < NL::Configuration::profileCount; i++)
+	{
+		if (NL::Configuration::profileSlots[i] < CONFIGURATION_PROFILE_SLOTS)
+		{
+			slotUsed[NL::Configuration::profileSlots[i]] = true;
+		}
+	}
+	for (size_t i = 0; i < NL::Configuration::savedProfileCount; i++)
+	{
+		slotUsed[NL::Configuration::savedProfileSlots[i]] = true;
+	}
+
+	uint8_t slot = NL::Configuration::PROFILE_SLOT_NONE;
+	for (uint8_t i = 0; i < CONFIGURATION_PROFILE_SLOTS; i++)
+	{
+		if (!slotUsed[i])
+		{
+			slot = i;
+			break;
+		}
+	}
+
+	if (slot == NL::Configuration::PROFILE_SLOT_NONE)
+	{
+		return NL::Configuration::Error::ERROR_FILE_WRITE;
+	}
+
+	// Build the record, strings are stored zero terminated with a fixed size
+	NL::Configuration::ProfileFileRecord record;
+	memset(&record, 0, sizeof(record));
+	strncpy(record.name, profile.name.c_str(), CONFIGURATION_PROFILE_NAME_LENGTH);
+	NL::Configuration::packProfile(profile, record.profile);
+	strncpy(record.language, profile.uiConfiguration.language.c_str(), CONFIGURATION_UI_VALUE_LENGTH);
+	strncpy(record.theme, profile.uiConfiguration.theme.c_str(), CONFIGURATION_UI_VALUE_LENGTH);
+	record.expertMode = profile.uiConfiguration.expertMode;
+	record.checksum = crc32_le(0, reinterpret_cast<const uint8_t *>(&record), sizeof(record) - sizeof(record.checksum));
+
+	if (!NL::Configuration::profileFile.seek(slot * sizeof(record)) || NL::Configuration::profileFile.write(reinterpret_cast<const uint8_t *>(&record), sizeof(record)) != sizeof(record))
+	{
+		return NL::Configuration::Error::ERROR_FILE_WRITE;
+	}
+	NL::Configuration::profileFile.flush();
+
+	NL::Configuration::profileSlots[profileIndex] = slot;
+	return NL::Configuration::Error::OK;
+}
+
+/**
+ * @brief Close the profile file, for example because it is deleted. It is opened again on the next access.
+ */
+void NL::Configuration::closeProfileFile()
+{
+	if (NL::Configuration::profileFile)
+	{
+		NL::Configuration::profileFile.close();
+	}
+}
+
+/**
+ * @brief Open the profile file for reading and writing when it is not open yet. The file is created when it doesn't exist.
+ * @return OK when the file is open
+ * @return ERROR_FILE_OPEN when the file could not be opened
+ */
+NL::Configuration::Error NL::Configuration::openProfileFile()
+{
+	if (NL::Configuration::profileFile)
+	{
+		return NL::Configuration::Error::OK;
+	}
+
+	const char *mode = NL::Configuration::fileSystem->exists(CONFIGURATION_PROFILE_FILE_NAME) ? "r+" : "w+";
+	NL::Configuration::profileFile = NL::Configuration::fileSystem->open(CONFIGURATION_PROFILE_FILE_NAME, mode);
+	if (!NL::Configuration::profileFile)
+	{
+		return NL::Configuration::Error::ERROR_FILE_OPEN;
+	}
+
+	return NL::Configuration::Error::OK;
 }
\ No newline at end of file
@@ -99,9 +99,15 @@ uint8_t NL::AudioUnit::getFrequencyBandCount()
  * @param audioAnalysis reference to a variable holding the audio analysis
  * @return OK when the data was read
  * @return ERROR_IIC_COMMUNICATION when there was a communication error
+ * @return ERROR_INVALID_ARGUMENT when the unit provides more frequency bands than supported
  */
 NL::AudioUnit::Error NL::AudioUnit::getAudioAnalysis(NL::AudioUnit::AudioAnalysis &audioAnalysis)
 {
+	if (NL::AudioUnit::frequencyBandCount > AUDIO_UNIT_NUM_BANDS)
+	{
+		return NL::AudioUnit::Error::ERROR_INVALID_ARGUMENT;
+	}
+
 	if (NL::AudioUnit::deviceFunction != 4)
 	{
 		NL::AudioUnit::deviceFunction = 4;
@@ -121,23 +127,22 @@ NL::AudioUnit::Error NL::AudioUnit::getAudioAnalysis(NL::AudioUnit::AudioAnalysi
 		return NL::AudioUnit::Error::ERROR_IIC_COMMUNICATION;
 	}
 
-	audioAnalysis.frequencyBandValues.resize(NL::AudioUnit::frequencyBandCount);
+	audioAnalysis.frequencyBandCount = NL::AudioUnit::frequencyBandCount;
 	Wire.readBytes(reinterpret_cast<uint8_t *>(&audioAnalysis.seq), sizeof(audioAnalysis.seq));
 	Wire.readBytes(reinterpret_cast<uint8_t *>(&audioAnalysis.volumePeak), sizeof(audioAnalysis.volumePeak));
-	Wire.readBytes(reinterpret_cast<uint8_t *>(audioAnalysis.frequencyBandValues.data()), audioAnalysis.frequencyBandValues.size() * sizeof(uint16_t));
+	Wire.readBytes(reinterpret_cast<uint8_t *>(audioAnalysis.frequencyBandValues), NL::AudioUnit::frequencyBandCount * sizeof(uint16_t));
 
-	audioAnalysis.frequencyBandTriggers.resize(NL::AudioUnit::frequencyBandCount);
 	for (uint8_t i = 0; i < NL::AudioUnit::frequencyBandCount; i++)
 	{
 		uint8_t trigger;
 		uint16_t values[4];
 		Wire.readBytes(reinterpret_cast<uint8_t *>(&trigger), sizeof(trigger));
 		Wire.readBytes(reinterpret_cast<uint8_t *>(&values), sizeof(values));
-		audioAnalysis.frequencyBandTriggers.at(i).trigger = (NL::AudioUnit::Trigger)trigger;
-		audioAnalysis.frequencyBandTriggers.at(i).value = values[0];
-		audioAnalysis.frequencyBandTriggers.at(i).mean = values[1];
-		audioAnalysis.frequencyBandTriggers.at(i).standardDeviation = values[2];
-		audioAnalysis.frequencyBandTriggers.at(i).triggerThreshold = values[3];
+		audioAnalysis.frequencyBandTriggers[i].trigger = (NL::AudioUnit::Trigger)trigger;
+		audioAnalysis.frequencyBandTriggers[i].value = values[0];
+		audioAnalysis.frequencyBandTriggers[i].mean = values[1];
+		audioAnalysis.frequencyBandTriggers[i].standardDeviation = values[2];
+		audioAnalysis.frequencyBandTriggers[i].triggerThreshold = values[3];
 	}
 
 	return NL::AudioUnit::Error::OK;
@@ -23,14 +23,29 @@
 #include "led/LedManager.h"
 
 bool NL::LedManager::initialized = false;
-std::unique_ptr<NL::LedBuffer> NL::LedManager::ledBuffer;
+SemaphoreHandle_t NL::LedManager::mutex = NULL;
+std::vector<std::unique_ptr<NL::LedBuffer>> NL::LedManager::ledBuffer;
+std::vector<std::unique_ptr<NL::LedDriver>> NL::LedManager::ledDriver;
+size_t NL::LedManager::zonesPerDriver;
 std::vector<std::unique_ptr<NL::LedAnimator>> NL::LedManager::ledAnimator;
-std::unique_ptr<NL::FseqLoader> NL::LedManager::fseqLoader;
+std::unique_ptr<NL::FseqPlaylist> NL::LedManager::fseqPlaylist;
+NL::Profiler::Stage NL::LedManager::animatorStage[LED_NUM_ZONES];
+NL::Configuration::LedConfig NL::LedManager::loadedLedConfig[LED_NUM_ZONES];
+std::vector<uint8_t> NL::LedManager::crossfadeBuffer;
+size_t NL::LedManager::crossfadeOffset[LED_NUM_ZONES];
+bool NL::LedManager::crossfadeZone[LED_NUM_ZONES];
+uint16_t NL::LedManager::crossfadeStep;
 uint32_t NL::LedManager::frameInterval;
+bool NL::LedManager::fseqFrameInterval;
 float NL::LedManager::regulatorTemperature;
+NL::Configuration::RuntimeConfig NL::LedManager::runtimeConfig;
+float NL::LedManager::ledPowerDraw;
+uint32_t NL::LedManager::renderTime;
+bool NL::LedManager::sensorDataPending;
 
 /**
  * @brief Start the LED manager.
+ * All public functions are guarded by a mutex, so animations can be reloaded from another task while rendering.
  * @return OK when the LED manager was initialized
  * @return ERROR_CONFIG_UNAVAILABLE when the configuration was not initialized
  */
@@ -38,13 +53,24 @@ NL::LedManager::Error NL::LedManager::begin()
 {
 	NL::LedManager::initialized = false;
 	NL::LedManager::frameInterval = FRAME_INTERVAL;
+	NL::LedManager::fseqFrameInterval = false;
+	NL::LedManager::zonesPerDriver = LED_MAX_ZONES_PER_DRIVER;
 	NL::LedManager::regulatorTemperature = 0.0f;
+	NL::LedManager::ledPowerDraw = 0.0f;
+	NL::LedManager::renderTime = 0;
+	NL::LedManager::sensorDataPending = true;
+	NL::LedManager::crossfadeStep = LED_CROSSFADE_FRAMES;
+	if (NL::LedManager::mutex == NULL)
+	{
+		NL::LedManager::mutex = xSemaphoreCreateRecursiveMutex();
+	}
 
 	if (!NL::Configuration::isInitialized())
 	{
 		return NL::LedManager::Error::ERROR_CONFIG_UNAVAILABLE;
 	}
 
+	NL::Configuration::getRuntimeConfig(NL::LedManager::runtimeConfig);
 	NL::LedManager::initialized = true;
 	return NL::LedManager::Error::OK;
 }
@@ -68,7 +94,11 @@ bool NL::LedManager::isInitialized()
 }
 
 /**
- * @brief Clear and create new LED data and animators from the configuration.
+ * @brief Reload the LED data and animators from the configuration.
+ * The LED driver and buffers are only recreated when the pins or LED counts were changed.
+ * Otherwise only the animators with a changed type or animation settings are replaced,
+ * while all other animators are reconfigured and keep their state.
+ * Replaced zones are crossfaded from the last shown frame to the new animation.
  * @return OK when the animation were reloaded
  * @return ERROR_INIT_LED_DRIVER when the LED data could not be created
  * @return ERROR_UNKNOWN_ANIMATOR_TYPE when one of the animator types is unknown
@@ -78,21 +108,85 @@ bool NL::LedManager::isInitialized()
  */
 NL::LedManager::Error NL::LedManager::reloadAnimations()
 {
-	NL::LedManager::clearAnimations();
+	NL::LedManager::lock();
+	NL::Configuration::LedConfig ledConfig[LED_NUM_ZONES];
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		NL::Configuration::getLedConfig(i, ledConfig[i]);
+	}
 
-	const NL::LedManager::Error ledDataError = NL::LedManager::initLedDriver();
-	if (ledDataError != NL::LedManager::Error::OK)
+	// The LED driver and buffers must only be recreated when the topology was changed
+	bool topologyChanged = NL::LedManager::ledDriver.size() == 0;
+	for (size_t i = 0; i < LED_NUM_ZONES && !topologyChanged; i++)
 	{
-		return ledDataError;
+		topologyChanged = ledConfig[i].ledPin != NL::LedManager::loadedLedConfig[i].ledPin || ledConfig[i].ledCount != NL::LedManager::loadedLedConfig[i].ledCount;
 	}
 
-	const NL::LedManager::Error animatorError = NL::LedManager::createAnimators();
-	if (animatorError != NL::LedManager::Error::OK)
+	NL::LedManager::Error error = NL::LedManager::Error::OK;
+	if (topologyChanged)
 	{
-		return animatorError;
+		NL::LedManager::clearAnimations();
+		error = NL::LedManager::initLedDriver();
 	}
 
-	return NL::LedManager::Error::OK;
+	// Custom animations share one fseq playlist, so they are always loaded as a whole
+	bool customAnimation = NL::LedManager::fseqPlaylist != nullptr;
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		customAnimation = customAnimation || ledConfig[i].type == 255;
+	}
+	const bool reloadAll = topologyChanged || customAnimation || NL::LedManager::ledAnimator.size() != LED_NUM_ZONES;
+	bool zoneChanged[LED_NUM_ZONES];
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		zoneChanged[i] = reloadAll ||
+						 ledConfig[i].type != NL::LedManager::loadedLedConfig[i].type ||
+						 std::memcmp(ledConfig[i].animationSettings, NL::LedManager::loadedLedConfig[i].animationSettings, ANIMATOR_NUM_ANIMATION_SETTINGS) != 0;
+	}
+
+	if (error == NL::LedManager::Error::OK && !topologyChanged)
+	{
+		NL::LedManager::startCrossfade(zoneChanged);
+	}
+
+	if (error == NL::LedManager::Error::OK && reloadAll)
+	{
+		NL::LedManager::ledAnimator.clear();
+		NL::LedManager::fseqPlaylist.reset();
+		error = NL::LedManager::createAnimators();
+	}
+	else if (error == NL::LedManager::Error::OK)
+	{
+		for (size_t i = 0; i < LED_NUM_ZONES && error == NL::LedManager::Error::OK; i++)
+		{
+			if (zoneChanged[i])
+			{
+				error = NL::LedManager::loadCalculatedAnimator(i, ledConfig[i]);
+			}
+			else
+			{
+				NL::LedManager::applyAnimatorSettings(i, ledConfig[i]);
+			}
+		}
+	}
+
+	// A failed reload leaves no partial state behind, the next reload will start from scratch
+	if (error == NL::LedManager::Error::OK)
+	{
+		for (size_t i = 0; i < LED_NUM_ZONES; i++)
+		{
+			NL::LedManager::loadedLedConfig[i] = ledConfig[i];
+		}
+	}
+	else
+	{
+		NL::LedManager::clearAnimations();
+	}
+
+	// New animators must receive the latest sensor data before they are rendered
+	NL::LedManager::sensorDataPending = true;
+	NL::LedManager::unlock();
+	return error;
 }
 
 /**
@@ -100,22 +194,58 @@ NL::LedManager::Error NL::LedManager::reloadAnimations()
  */
 void NL::LedManager::clearAnimations()
 {
-	NL::LedDriver::end();
-	NL::LedManager::ledBuffer.reset();
+	NL::LedManager::lock();
+	NL::LedManager::ledDriver.clear();
+	NL::LedManager::ledBuffer.clear();
 	NL::LedManager::ledAnimator.clear();
-	NL::LedManager::fseqLoader.reset();
+	NL::LedManager::fseqPlaylist.reset();
+	NL::LedManager::crossfadeBuffer.clear();
+	NL::LedManager::crossfadeBuffer.shrink_to_fit();
+	NL::LedManager::crossfadeStep = LED_CROSSFADE_FRAMES;
+	NL::LedManager::unlock();
 }
 
 /**
- * @brief Set the current ambient brightness for all underlying LED animators.
- * @param ambientBrightness ambient brightness from 0.0 to 1.0
+ * @brief Continue the custom animation from the given time. When a playlist is played, the current entry is seeked.
+ * @param time time since the start of the animation in ms
+ * @return OK when the animation continues from the given time
+ * @return ERROR_NO_CUSTOM_ANIMATION when no custom animation is loaded
+ * @return ERROR_INVALID_POSITION when the time is behind the end of the animation
  */
-void NL::LedManager::setAmbientBrightness(const float ambientBrightness)
+NL::LedManager::Error NL::LedManager::seekCustomAnimation(const uint32_t time)
 {
-	for (size_t i = 0; i < NL::LedManager::ledAnimator.size(); i++)
+	NL::LedManager::lock();
+	if (!NL::LedManager::fseqPlaylist)
+	{
+		NL::LedManager::unlock();
+		return NL::LedManager::Error::ERROR_NO_CUSTOM_ANIMATION;
+	}
+
+	const NL::FseqLoader::Error fseqError = NL::LedManager::fseqPlaylist->seekToTime(time);
+	NL::LedManager::unlock();
+	return fseqError == NL::FseqLoader::Error::OK ? NL::LedManager::Error::OK : NL::LedManager::Error::ERROR_INVALID_POSITION;
+}
+
+/**
+ * @brief Get the current position of the custom animation. When a playlist is played, this is the position in the current entry.
+ * @param frameIndex reference to a variable holding the index of the current frame
+ * @param time reference to a variable holding the time of the current frame in ms
+ * @return true when a custom animation is loaded
+ * @return false when no custom animation is loaded
+ */
+bool NL::LedManager::getCustomAnimationPosition(uint32_t &frameIndex, uint32_t &time)
+{
+	NL::LedManager::lock();
+	if (!NL::LedManager::fseqPlaylist)
 	{
-		NL::LedManager::ledAnimator.at(i)->setAmbientBrightness(ambientBrightness);
+		NL::LedManager::unlock();
+		return false;
 	}
+
+	frameIndex = NL::LedManager::fseqPlaylist->getCurrentLoader()->getCurrentFrame();
+	time = frameIndex * NL::LedManager::fseqPlaylist->getCurrentLoader()->getHeader().stepTime;
+	NL::LedManager::unlock();
+	return true;
 }
 
 /**
@@ -138,98 +268,134 @@ uint32_t NL::LedManager::getFrameInterval()
 }
 
 /**
- * @brief Set the current motion sensor data.
- * @param motionSensorData motion sensor data
+ * @brief Get the total power draw of all LEDs that has been calculated for the last rendered frame.
+ * @return total power draw in W
  */
-void NL::LedManager::setMotionSensorData(const NL::MotionSensor::MotionSensorData &motionSensorData)
+float NL::LedManager::getLedPowerDraw()
 {
-	for (size_t i = 0; i < NL::LedManager::ledAnimator.size(); i++)
-	{
-		NL::LedManager::ledAnimator.at(i)->setMotionSensorData(motionSensorData);
-	}
+	return NL::LedManager::ledPowerDraw;
 }
 
 /**
- * @brief Set the current audio analysis data.
- * @param audioAnalysis audio analysis data
+ * @brief Get the total number of visible LEDs.
+ * @return total number of LEDs
  */
-void NL::LedManager::setAudioAnalysis(const NL::AudioUnit::AudioAnalysis &audioAnalysis)
+size_t NL::LedManager::getLedCount()
 {
-	for (size_t i = 0; i < NL::LedManager::ledAnimator.size(); i++)
+	NL::LedManager::lock();
+	size_t ledCount = 0;
+	for (size_t i = 0; i < NL::LedManager::ledBuffer.size(); i++)
 	{
-		NL::LedManager::ledAnimator.at(i)->setAudioAnalysis(audioAnalysis);
+		ledCount += NL::LedManager::ledBuffer.at(i)->getTotalLedCount();
 	}
+	NL::LedManager::unlock();
+	return ledCount;
 }
 
 /**
- * @brief Set the regulator temperature. Once a critical temperature is reached, the brightness will be reduced.
- * @param regulatorTemperature temperature of the generator in degree celsius.
+ * @brief Get the total number of LEDs.
+ * @return total number of LEDs
  */
-void NL::LedManager::setRegulatorTemperature(const float regulatorTemperature)
+size_t NL::LedManager::getHiddenLedCount()
 {
-	NL::LedManager::regulatorTemperature = regulatorTemperature;
+	NL::LedManager::lock();
+	size_t hiddenLedCount = 0;
+	for (size_t i = 0; i < NL::LedManager::ledBuffer.size(); i++)
+	{
+		hiddenLedCount += NL::LedManager::ledBuffer.at(i)->getTotalHiddenLedCount();
+	}
+	NL::LedManager::unlock();
+	return hiddenLedCount;
 }
 
 /**
- * @brief Get the total power draw of all LEDs that has been calculated.
- * @return total power draw in W
+ * @brief Get the memory used for the LED pixel data in bytes, including the front and back buffer.
+ * @return size of all LED buffers in bytes
  */
-float NL::LedManager::getLedPowerDraw()
+size_t NL::LedManager::getLedBufferSize()
 {
-	float regulatorPower[REGULATOR_COUNT];
-	NL::LedManager::calculateRegulatorPowerDraw(regulatorPower);
-
-	float sum = 0.0f;
-	for (uint8_t i = 0; i < REGULATOR_COUNT; i++)
+	NL::LedManager::lock();
+	size_t bufferSize = 0;
+	for (size_t i = 0; i < NL::LedManager::ledBuffer.size(); i++)
 	{
-		sum += regulatorPower[i];
+		bufferSize += NL::LedManager::ledBuffer.at(i)->getBufferSize() * 2;
 	}
-	return sum;
+	NL::LedManager::unlock();
+	return bufferSize;
 }
 
 /**
- * @brief Get the total number of visible LEDs.
- * @return total number of LEDs
+ * @brief Get the time it took to render the last frame.
+ * @return render time in µs
  */
-size_t NL::LedManager::getLedCount()
+uint32_t NL::LedManager::getRenderTime()
 {
-	if (NL::LedManager::ledBuffer != nullptr)
-	{
-		return NL::LedManager::ledBuffer->getTotalLedCount();
-	}
-	return 0;
+	return NL::LedManager::renderTime;
 }
 
 /**
- * @brief Get the total number of LEDs.
- * @return total number of LEDs
+ * @brief Get the time it took to send out the last frame to the LEDs.
+ * All LED drivers are running in parallel, so this is the time of the slowest one.
+ * @return transmit time in µs
  */
-size_t NL::LedManager::getHiddenLedCount()
+uint32_t NL::LedManager::getTransmitTime()
 {
-	if (NL::LedManager::ledBuffer != nullptr)
+	NL::LedManager::lock();
+	uint32_t transmitTime = 0;
+	for (size_t i = 0; i < NL::LedManager::ledDriver.size(); i++)
 	{
-		return NL::LedManager::ledBuffer->getTotalHiddenLedCount();
+		const uint32_t driverTransmitTime = NL::LedManager::ledDriver.at(i)->getTransmitTime();
+		transmitTime = driverTransmitTime > transmitTime ? driverTransmitTime : transmitTime;
 	}
-	return 0;
+	NL::LedManager::unlock();
+	return transmitTime;
 }
 
 /**
- * @brief Render all LEDs using their animators.
+ * @brief Render all LEDs into the back buffer using their animators.
+ * This can be done while the previous frame is still being sent out by the LED driver.
  */
 void NL::LedManager::render()
 {
-	if (NL::LedManager::ledBuffer == nullptr || !NL::LedDriver::isInitialized())
+	NL::LedManager::lock();
+	if (NL::LedManager::ledDriver.size() == 0 || NL::LedManager::ledAnimator.size() != LED_NUM_ZONES)
 	{
+		NL::LedManager::unlock();
 		return;
 	}
 
-	for (size_t i = 0; i < NL::LedManager::ledBuffer->getLedStripCount(); i++)
+	const unsigned long start = micros();
+	uint32_t profilerStart = NL::Profiler::start();
+	if (NL::SensorSnapshot::fetch() || NL::LedManager::sensorDataPending)
+	{
+		NL::LedManager::applySensorData(NL::SensorSnapshot::getSensorData());
+		NL::LedManager::sensorDataPending = false;
+		NL::Profiler::record(NL::Profiler::Stage::SENSOR_DATA, profilerStart);
+	}
+
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		profilerStart = NL::Profiler::start();
+		NL::LedManager::ledAnimator.at(i)->render(NL::LedManager::getLedStrip(i));
+		NL::Profiler::record(NL::LedManager::animatorStage[i], profilerStart);
+	}
+
+	// The entries of a playlist can have different frame intervals
+	if (NL::LedManager::fseqPlaylist && NL::LedManager::fseqFrameInterval)
 	{
-		NL::LedManager::ledAnimator.at(i)->render(NL::LedManager::ledBuffer->getLedStrip(i));
+		NL::LedManager::setFrameInterval(NL::LedManager::fseqPlaylist->getFrameInterval());
 	}
 
-	NL::LedManager::limitPowerConsumption();
-	NL::LedManager::limitRegulatorTemperature();
+	// The power draw is cached, after the next swap the LED strips will point to the other buffer
+	profilerStart = NL::Profiler::start();
+	NL::LedManager::ledPowerDraw = NL::LedManager::applyPostProcessing();
+	if (NL::LedManager::crossfadeStep < LED_CROSSFADE_FRAMES)
+	{
+		NL::LedManager::applyCrossfade();
+	}
+	NL::Profiler::record(NL::Profiler::Stage::POST_PROCESSING, profilerStart);
+	NL::LedManager::renderTime = micros() - start;
+	NL::LedManager::unlock();
 }
 
 /**
@@ -240,67 +406,133 @@ void NL::LedManager::render()
  */
 NL::LedManager::Error NL::LedManager::waitShow(const TickType_t timeout)
 {
-	if (!NL::LedDriver::isInitialized())
+	NL::LedManager::lock();
+	if (NL::LedManager::ledDriver.size() == 0)
 	{
+		NL::LedManager::unlock();
 		return NL::LedManager::Error::ERROR_DRIVER_NOT_READY;
 	}
 
-	const NL::LedDriver::Error driverError = NL::LedDriver::isReady(timeout);
-	if (driverError != NL::LedDriver::Error::OK)
+	for (size_t i = 0; i < NL::LedManager::ledDriver.size(); i++)
 	{
-		return NL::LedManager::Error::ERROR_DRIVER_NOT_READY;
+		const NL::LedDriver::Error driverError = NL::LedManager::ledDriver.at(i)->isReady(timeout);
+		if (driverError != NL::LedDriver::Error::OK)
+		{
+			NL::LedManager::unlock();
+			return NL::LedManager::Error::ERROR_DRIVER_NOT_READY;
+		}
 	}
 
+	NL::LedManager::unlock();
 	return NL::LedManager::Error::OK;
 }
 
 /**
- * @brief Async send out the current LED data via the LED driver.
+ * @brief Async send out the rendered LED data via the LED driver.
+ * Waits until the previous frame was sent out, then swaps the front and back buffer.
  * @param timeout cpu cycles until a timeout will happen when data is still being send
  * @return OK when the data is being sent
  * @return ERROR_DRIVER_NOT_READY when the driver is not ready to send new data
  */
 NL::LedManager::Error NL::LedManager::show(const TickType_t timeout)
 {
-	if (NL::LedManager::ledBuffer == nullptr || !NL::LedDriver::isInitialized())
+	NL::LedManager::lock();
+	if (NL::LedManager::ledDriver.size() == 0)
 	{
+		NL::LedManager::unlock();
 		return NL::LedManager::Error::ERROR_DRIVER_NOT_READY;
 	}
 
-	const NL::LedDriver::Error driverError = NL::LedDriver::showPixels(timeout);
-	if (driverError != NL::LedDriver::Error::OK)
+	const uint32_t profilerStart = NL::Profiler::start();
+	for (size_t i = 0; i < NL::LedManager::ledDriver.size(); i++)
 	{
-		return NL::LedManager::Error::ERROR_DRIVER_NOT_READY;
+		const NL::LedDriver::Error driverError = NL::LedManager::ledDriver.at(i)->showPixels(timeout);
+		if (driverError != NL::LedDriver::Error::OK)
+		{
+			NL::LedManager::unlock();
+			return NL::LedManager::Error::ERROR_DRIVER_NOT_READY;
+		}
 	}
+	NL::Profiler::record(NL::Profiler::Stage::LED_DRIVER_WAIT, profilerStart);
 
+	NL::LedManager::unlock();
 	return NL::LedManager::Error::OK;
 }
 
 /**
- * @brief Initialize the LED driver, buffer and output channels.
+ * @brief Lock the LED manager for the current task. Can be called recursively.
+ */
+void NL::LedManager::lock()
+{
+	xSemaphoreTakeRecursive(NL::LedManager::mutex, portMAX_DELAY);
+}
+
+/**
+ * @brief Unlock the LED manager.
+ */
+void NL::LedManager::unlock()
+{
+	xSemaphoreGiveRecursive(NL::LedManager::mutex);
+}
+
+/**
+ * @brief Pass the latest sensor data to all LED animators.
+ * The animators only keep a reference, which stays valid until the next snapshot is fetched.
+ * @param sensorData latest sensor data
+ */
+void NL::LedManager::applySensorData(const NL::SensorSnapshot::SensorData &sensorData)
+{
+	NL::LedManager::regulatorTemperature = sensorData.regulatorTemperature;
+	for (size_t i = 0; i < NL::LedManager::ledAnimator.size(); i++)
+	{
+		NL::LedManager::ledAnimator.at(i)->setAmbientBrightness(sensorData.ambientBrightness);
+		NL::LedManager::ledAnimator.at(i)->setSensorData(sensorData);
+	}
+}
+
+/**
+ * @brief Initialize the LED drivers, buffers and output channels.
+ * Each I2S device can drive up to 8 zones. When more zones are used, they are spread evenly across both devices.
  * @return OK when the LED data was created
  * @return ERROR_INIT_LED_DRIVER when the LED data could not be created
  */
 NL::LedManager::Error NL::LedManager::initLedDriver()
 {
-	std::vector<NL::LedStrip> ledStrips;
-	for (size_t i = 0; i < LED_NUM_ZONES; i++)
-	{
-		NL::Configuration::LedConfig ledConfig;
-		NL::Configuration::getLedConfig(i, ledConfig);
-		ledStrips.push_back(NL::LedStrip(ledConfig.ledPin, ledConfig.ledCount, LED_MAX_COUNT_PER_ZONE));
-	}
+	const size_t driverCount = (LED_NUM_ZONES + LED_MAX_ZONES_PER_DRIVER - 1) / LED_MAX_ZONES_PER_DRIVER;
+	NL::LedManager::zonesPerDriver = (LED_NUM_ZONES + driverCount - 1) / driverCount;
 
-	NL::LedManager::ledBuffer.reset(new NL::LedBuffer(ledStrips));
-	NL::LedDriver::Error driverError = NL::LedDriver::begin(*NL::LedManager::ledBuffer);
-	if (driverError != NL::LedDriver::Error::OK)
+	for (size_t i = 0; i < driverCount; i++)
 	{
-		return NL::LedManager::Error::ERROR_INIT_LED_DRIVER;
+		std::vector<NL::LedStrip> ledStrips;
+		for (size_t j = i * NL::LedManager::zonesPerDriver; j < LED_NUM_ZONES && j < (i + 1) * NL::LedManager::zonesPerDriver; j++)
+		{
+			NL::Configuration::LedConfig ledConfig;
+			NL::Configuration::getLedConfig(j, ledConfig);
+			ledStrips.push_back(NL::LedStrip(ledConfig.ledPin, ledConfig.ledCount, LED_MAX_COUNT_PER_ZONE));
+		}
+
+		NL::LedManager::ledBuffer.push_back(std::unique_ptr<NL::LedBuffer>(new NL::LedBuffer(ledStrips)));
+		NL::LedManager::ledDriver.push_back(std::unique_ptr<NL::LedDriver>(new NL::LedDriver(static_cast<NL::LedDriver::I2SDevice>(i))));
+		const NL::LedDriver::Error driverError = NL::LedManager::ledDriver.back()->begin(*NL::LedManager::ledBuffer.back(), static_cast<NL::LedDriver::OutputMode>(LED_DRIVER_OUTPUT_MODE));
+		if (driverError != NL::LedDriver::Error::OK)
+		{
+			return NL::LedManager::Error::ERROR_INIT_LED_DRIVER;
+		}
 	}
 
 	return NL::LedManager::Error::OK;
 }
 
+/**
+ * @brief Get the LED strip of a zone from the LED buffer of the responsible LED driver.
+ * @param zoneIndex index of the zone
+ * @return reference to the LED strip
+ */
+NL::LedStrip &NL::LedManager::getLedStrip(const size_t zoneIndex)
+{
+	return NL::LedManager::ledBuffer.at(zoneIndex / NL::LedManager::zonesPerDriver)->getLedStrip(zoneIndex % NL::LedManager::zonesPerDriver);
+}
+
 /**
  * @brief Create the LED animators based on the configuration.
  * @return OK when the animators were created
@@ -311,31 +543,49 @@ NL::LedManager::Error NL::LedManager::initLedDriver()
  */
 NL::LedManager::Error NL::LedManager::createAnimators()
 {
-	// Custom animations will be used when the first animator type is set to 255
-	// The used file identifier is set by the custom fields [10-13]
+	// Custom animations will be used for all zones with the animator type set to 255
+	// The used file identifier is set by the custom fields [20-23] of the first of these zones
+	// When the custom field 19 of this zone is set to 1, the fseq playlist is played instead of a single file
 	// Field 14 is reserved to store the previous, calculated animation type
 	NL::Configuration::LedConfig ledConfig;
-	NL::Configuration::getLedConfig(0, ledConfig);
+	bool customAnimation = false;
+	for (size_t i = 0; i < LED_NUM_ZONES && !customAnimation; i++)
+	{
+		NL::Configuration::getLedConfig(i, ledConfig);
+		customAnimation = ledConfig.type == 255;
+	}
 
-	const bool customAnimation = ledConfig.type == 255;
-	uint32_t identifier = 0;
-	std::memcpy(&identifier, &ledConfig.animationSettings[20], sizeof(identifier));
 	if (!customAnimation)
 	{
 		return NL::LedManager::loadCalculatedAnimations();
 	}
-	else
+
+	NL::LedManager::fseqPlaylist.reset(new NL::FseqPlaylist(&SD));
+	if (ledConfig.animationSettings[19] == 1)
 	{
-		String fileName;
-		if (NL::FileUtil::getFileNameFromIdentifier(&SD, FSEQ_DIRECTORY, identifier, fileName) && fileName.length() > 0)
+		if (NL::LedManager::fseqPlaylist->loadFromFile(FSEQ_PLAYLIST_FILE_NAME) != NL::FseqPlaylist::Error::OK)
 		{
-			return NL::LedManager::loadCustomAnimation(fileName);
+			NL::LedManager::fseqPlaylist.reset();
+			return NL::LedManager::Error::ERROR_FILE_NOT_FOUND;
 		}
-		else
+	}
+	else
+	{
+		uint32_t identifier = 0;
+		std::memcpy(&identifier, &ledConfig.animationSettings[20], sizeof(identifier));
+
+		// A single file is played as a playlist with only one entry, which is repeated forever
+		NL::FseqIndex::Entry entry;
+		if (!NL::FseqIndex::getEntry(identifier, entry))
 		{
+			NL::LedManager::fseqPlaylist.reset();
 			return NL::LedManager::Error::ERROR_FILE_NOT_FOUND;
 		}
+		NL::LedManager::fseqPlaylist->setEntries({{entry.fileName, 0, 0}});
 	}
+	NL::LedManager::fseqPlaylist->setInterpolation(ledConfig.animationSettings[18] == 1);
+
+	return NL::LedManager::loadCustomAnimation();
 }
 
 /**
@@ -352,266 +602,369 @@ NL::LedManager::Error NL::LedManager::loadCalculatedAnimations()
 		NL::Configuration::LedConfig ledConfig;
 		NL::Configuration::getLedConfig(i, ledConfig);
 
-		// Rainbow type
-		if (ledConfig.type == 0)
+		const NL::LedManager::Error error = NL::LedManager::loadCalculatedAnimator(i, ledConfig);
+		if (error != NL::LedManager::Error::OK)
 		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::RainbowAnimator((NL::RainbowAnimator::RainbowMode)ledConfig.animationSettings[0]));
+			return error;
 		}
+	}
+	return NL::LedManager::Error::OK;
+}
 
-		// Sparkle type
-		else if (ledConfig.type == 1)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::SparkleAnimator(
-				static_cast<NL::SparkleAnimator::SpawnPosition>(ledConfig.animationSettings[0]),
-				ledConfig.animationSettings[7] / 2 + 1,
-				NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
-				ledConfig.animationSettings[8] / 5120.0f,
-				ledConfig.animationSettings[9] / 2560.0f,
-				ledConfig.animationSettings[10] / 255.0f,
-				ledConfig.animationSettings[11] / 1024.0f,
-				ledConfig.animationSettings[12] / 255.0f,
-				ledConfig.animationSettings[13] / 255.0f,
-				ledConfig.animationSettings[14] / 255.0f,
-				ledConfig.animationSettings[15] / 5120.0f,
-				ledConfig.animationSettings[16] / 2560.0f,
-				ledConfig.animationSettings[17],
-				ledConfig.animationSettings[18]));
-		}
+/**
+ * @brief Create and initialize the animator of a single zone for a calculated animation.
+ * @param zoneIndex index of the zone
+ * @param ledConfig LED configuration of the zone
+ * @return OK when the calcualted animator was loaded
+ * @return ERROR_UNKNOWN_ANIMATOR_TYPE when the animator type is unknown
+ */
+NL::LedManager::Error NL::LedManager::loadCalculatedAnimator(const size_t zoneIndex, const NL::Configuration::LedConfig &ledConfig)
+{
+	// Rainbow type
+	if (ledConfig.type == 0)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::RainbowAnimator((NL::RainbowAnimator::RainbowMode)ledConfig.animationSettings[0]));
+	}
 
-		// Gradient type
-		else if (ledConfig.type == 2)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::GradientAnimator(
-				static_cast<NL::GradientAnimator::GradientMode>(ledConfig.animationSettings[0]),
-				NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
-				NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6])));
-		}
+	// Sparkle type
+	else if (ledConfig.type == 1)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::SparkleAnimator(
+			static_cast<NL::SparkleAnimator::SpawnPosition>(ledConfig.animationSettings[0]),
+			ledConfig.animationSettings[7] / 2 + 1,
+			NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
+			ledConfig.animationSettings[8] / 5120.0f,
+			ledConfig.animationSettings[9] / 2560.0f,
+			ledConfig.animationSettings[10] / 255.0f,
+			ledConfig.animationSettings[11] / 1024.0f,
+			ledConfig.animationSettings[12] / 255.0f,
+			ledConfig.animationSettings[13] / 255.0f,
+			ledConfig.animationSettings[14] / 255.0f,
+			ledConfig.animationSettings[15] / 5120.0f,
+			ledConfig.animationSettings[16] / 2560.0f,
+			ledConfig.animationSettings[17],
+			ledConfig.animationSettings[18]));
+	}
 
-		// Static color type
-		else if (ledConfig.type == 3)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::StaticColorAnimator(NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3])));
-		}
+	// Gradient type
+	else if (ledConfig.type == 2)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::GradientAnimator(
+			static_cast<NL::GradientAnimator::GradientMode>(ledConfig.animationSettings[0]),
+			NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
+			NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6])));
+	}
 
-		// Color bar type
-		else if (ledConfig.type == 4)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::ColorBarAnimator(
-				static_cast<NL::ColorBarAnimator::ColorBarMode>(ledConfig.animationSettings[0]),
-				NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
-				NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6])));
-		}
+	// Static color type
+	else if (ledConfig.type == 3)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::StaticColorAnimator(NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3])));
+	}
 
-		// Rainbow motion type
-		else if (ledConfig.type == 5)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::RainbowAnimatorMotion(static_cast<NL::RainbowAnimatorMotion::RainbowMode>(ledConfig.animationSettings[0])));
-		}
+	// Color bar type
+	else if (ledConfig.type == 4)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::ColorBarAnimator(
+			static_cast<NL::ColorBarAnimator::ColorBarMode>(ledConfig.animationSettings[0]),
+			NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
+			NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6])));
+	}
 
-		// Gradient motion type
-		else if (ledConfig.type == 6)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::GradientAnimatorMotion(
-				static_cast<NL::GradientAnimatorMotion::GradientMode>(ledConfig.animationSettings[0]),
-				NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
-				NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6])));
-		}
+	// Rainbow motion type
+	else if (ledConfig.type == 5)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::RainbowAnimatorMotion(static_cast<NL::RainbowAnimatorMotion::RainbowMode>(ledConfig.animationSettings[0])));
+	}
 
-		// Pulse type
-		else if (ledConfig.type == 7)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::PulseAnimator(
-				static_cast<NL::PulseAnimator::PulseMode>(ledConfig.animationSettings[0]),
-				NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
-				ledConfig.animationSettings[9] / 512.0f,
-				ledConfig.animationSettings[18]));
-		}
+	// Gradient motion type
+	else if (ledConfig.type == 6)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::GradientAnimatorMotion(
+			static_cast<NL::GradientAnimatorMotion::GradientMode>(ledConfig.animationSettings[0]),
+			NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
+			NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6])));
+	}
 
-		// Equalizer type
-		else if (ledConfig.type == 8)
-		{
-			NL::LedManager::ledAnimator.at(i).reset(new NL::EqualizerAnimator(
-				NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
-				NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6]),
-				ledConfig.animationSettings[7],
-				ledConfig.animationSettings[8] / 255.0f,
-				ledConfig.animationSettings[18]));
-		}
+	// Pulse type
+	else if (ledConfig.type == 7)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::PulseAnimator(
+			static_cast<NL::PulseAnimator::PulseMode>(ledConfig.animationSettings[0]),
+			NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
+			ledConfig.animationSettings[9] / 512.0f,
+			ledConfig.animationSettings[18]));
+	}
 
-		// Unknown type
-		else
-		{
-			return NL::LedManager::Error::ERROR_UNKNOWN_ANIMATOR_TYPE;
-		}
+	// Equalizer type
+	else if (ledConfig.type == 8)
+	{
+		NL::LedManager::ledAnimator.at(zoneIndex).reset(new NL::EqualizerAnimator(
+			NL::Pixel(ledConfig.animationSettings[1], ledConfig.animationSettings[2], ledConfig.animationSettings[3]),
+			NL::Pixel(ledConfig.animationSettings[4], ledConfig.animationSettings[5], ledConfig.animationSettings[6]),
+			ledConfig.animationSettings[7],
+			ledConfig.animationSettings[8] / 255.0f,
+			ledConfig.animationSettings[18]));
+	}
 
-		NL::LedManager::ledAnimator.at(i)->setDataSource(static_cast<NL::LedAnimator::DataSource>(ledConfig.dataSource));
-		NL::LedManager::ledAnimator.at(i)->setSpeed(ledConfig.speed);
-		NL::LedManager::ledAnimator.at(i)->setOffset(ledConfig.offset);
-		NL::LedManager::ledAnimator.at(i)->setAnimationBrightness(ledConfig.brightness / 255.0f);
-		NL::LedManager::ledAnimator.at(i)->setFadeSpeed(ledConfig.fadeSpeed / 4096.0f);
-		NL::LedManager::ledAnimator.at(i)->setReverse(ledConfig.reverse);
-		NL::LedManager::ledAnimator.at(i)->init(NL::LedManager::ledBuffer->getLedStrip(i));
+	// Unknown type
+	else
+	{
+		return NL::LedManager::Error::ERROR_UNKNOWN_ANIMATOR_TYPE;
 	}
+
+	NL::LedManager::animatorStage[zoneIndex] = NL::Profiler::getAnimatorStage(ledConfig.type);
+	NL::LedManager::applyAnimatorSettings(zoneIndex, ledConfig);
+	NL::LedManager::ledAnimator.at(zoneIndex)->init(NL::LedManager::getLedStrip(zoneIndex));
 	return NL::LedManager::Error::OK;
 }
 
 /**
- * @brief Load a custom animator and play the animation from the fseq loader.
- * @param fileName name of the fseq file to load
+ * @brief Load a custom animator and play the animation from the fseq playlist.
+ * When the first file of the playlist contains the channels of all LEDs, all zones will play the custom animation.
+ * When it only contains the channels of the zones with the animator type set to 255, only these zones play the
+ * custom animation and the other zones use their calculated animators. Only the custom zones read from the SD card.
+ * All other files of the playlist must use the same layout.
  * @return OK when the custom animation was loaded
  * @return ERROR_INVALID_FSEQ when a custom animation was set but the fseq file is invalid
  * @return ERROR_INVALID_LED_CONFIGURATION when the LED configuration is invalid for the custom animation
+ * @return ERROR_UNKNOWN_ANIMATOR_TYPE when the animator type of a calculated zone is unknown
  */
-NL::LedManager::Error NL::LedManager::loadCustomAnimation(const String &fileName)
+NL::LedManager::Error NL::LedManager::loadCustomAnimation()
 {
-	NL::LedManager::fseqLoader.reset(new NL::FseqLoader(&SD));
-	const NL::FseqLoader::Error fseqError = NL::LedManager::fseqLoader->loadFromFile(FSEQ_DIRECTORY + (String)F("/") + fileName);
-	if (fseqError != NL::FseqLoader::Error::OK)
+	if (NL::LedManager::fseqPlaylist->open() != NL::FseqPlaylist::Error::OK)
 	{
-		NL::LedManager::fseqLoader.reset();
+		NL::LedManager::fseqPlaylist.reset();
 		return NL::LedManager::Error::ERROR_INVALID_FSEQ;
 	}
 
-	const uint32_t channelCount = NL::LedManager::getLedCount() * 3;
-	const uint32_t roundedChannelCount = channelCount % 4 ? channelCount + (4 - channelCount % 4) : channelCount;
-	const uint8_t fillerBytes = roundedChannelCount - channelCount;
-	if (NL::LedManager::fseqLoader->getHeader().channelCount != roundedChannelCount)
+	NL::Configuration::LedConfig ledConfig[LED_NUM_ZONES];
+	uint32_t channelCount = 0;
+	uint32_t customChannelCount = 0;
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		NL::Configuration::getLedConfig(i, ledConfig[i]);
+		channelCount += ledConfig[i].ledCount * 3;
+		customChannelCount += ledConfig[i].type == 255 ? ledConfig[i].ledCount * 3 : 0;
+	}
+
+	bool customZone[LED_NUM_ZONES];
+	uint8_t customZoneCount = 0;
+	NL::FseqLoader *fseqLoader = NL::LedManager::fseqPlaylist->getCurrentLoader();
+	const bool allZones = fseqLoader->fitsChannelCount(channelCount);
+	if (!allZones && !fseqLoader->fitsChannelCount(customChannelCount))
 	{
+		NL::LedManager::fseqPlaylist.reset();
 		return NL::LedManager::Error::ERROR_INVALID_LED_CONFIGURATION;
 	}
-	NL::LedManager::fseqLoader->setFillerBytes(fillerBytes);
-	NL::LedManager::fseqLoader->setZoneCount(LED_NUM_ZONES);
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		customZone[i] = allZones || ledConfig[i].type == 255;
+		customZoneCount += customZone[i] ? 1 : 0;
+	}
+
+	if (NL::LedManager::fseqPlaylist->start(customZoneCount, allZones ? channelCount : customChannelCount) != NL::FseqPlaylist::Error::OK)
+	{
+		NL::LedManager::fseqPlaylist.reset();
+		return NL::LedManager::Error::ERROR_INVALID_FSEQ;
+	}
 
-	NL::LedManager::setFrameInterval(static_cast<uint32_t>(NL::LedManager::fseqLoader->getHeader().stepTime) * 1000);
+	// Calculated zones must keep their speed, so a mixed animation is rendered with the native frame interval
+	// The fseq zones follow the playback time, which repeats frames of files with a lower frame rate
+	NL::LedManager::fseqFrameInterval = customZoneCount == LED_NUM_ZONES;
+	NL::LedManager::setFrameInterval(NL::LedManager::fseqFrameInterval ? NL::LedManager::fseqPlaylist->getFrameInterval() : FRAME_INTERVAL);
 
+	// The custom zones are stored one after another in the frame
 	NL::LedManager::ledAnimator.resize(LED_NUM_ZONES);
+	size_t channelOffset = 0;
 	for (size_t i = 0; i < NL::LedManager::ledAnimator.size(); i++)
 	{
-		NL::Configuration::LedConfig ledConfig;
-		NL::Configuration::getLedConfig(i, ledConfig);
-
-		NL::LedManager::ledAnimator.at(i).reset(new NL::FseqAnimator(NL::LedManager::fseqLoader.get(), true));
-		NL::LedManager::ledAnimator.at(i)->setDataSource(static_cast<NL::LedAnimator::DataSource>(ledConfig.dataSource));
-		NL::LedManager::ledAnimator.at(i)->setSpeed(ledConfig.speed);
-		NL::LedManager::ledAnimator.at(i)->setOffset(ledConfig.offset);
-		NL::LedManager::ledAnimator.at(i)->setAnimationBrightness(ledConfig.brightness / 255.0f);
-		NL::LedManager::ledAnimator.at(i)->setFadeSpeed(ledConfig.fadeSpeed / 4096.0f);
-		NL::LedManager::ledAnimator.at(i)->setReverse(ledConfig.reverse);
-		NL::LedManager::ledAnimator.at(i)->init(NL::LedManager::ledBuffer->getLedStrip(i));
+		if (customZone[i])
+		{
+			NL::LedManager::ledAnimator.at(i).reset(new NL::FseqAnimator(NL::LedManager::fseqPlaylist.get(), channelOffset));
+			NL::LedManager::animatorStage[i] = NL::Profiler::Stage::ANIMATOR_FSEQ;
+			NL::LedManager::applyAnimatorSettings(i, ledConfig[i]);
+			NL::LedManager::ledAnimator.at(i)->init(NL::LedManager::getLedStrip(i));
+			channelOffset += ledConfig[i].ledCount * 3;
+		}
+		else
+		{
+			const NL::LedManager::Error error = NL::LedManager::loadCalculatedAnimator(i, ledConfig[i]);
+			if (error != NL::LedManager::Error::OK)
+			{
+				return error;
+			}
+		}
 	}
 	return NL::LedManager::Error::OK;
 }
 
 /**
- * @brief Calculate the total power draw from each regulator using the current frame.
- * @param regulatorPower array containing the power draw per regulator after the call
+ * @brief Apply the general animator settings of a zone. This will not reset the state of the animator.
+ * @param zoneIndex index of the zone
+ * @param ledConfig LED configuration of the zone
  */
-void NL::LedManager::calculateRegulatorPowerDraw(float regulatorPower[REGULATOR_COUNT])
+void NL::LedManager::applyAnimatorSettings(const size_t zoneIndex, const NL::Configuration::LedConfig &ledConfig)
 {
-	for (uint8_t i = 0; i < REGULATOR_COUNT; i++)
+	NL::LedManager::ledAnimator.at(zoneIndex)->setDataSource(static_cast<NL::LedAnimator::DataSource>(ledConfig.dataSource));
+	NL::LedManager::ledAnimator.at(zoneIndex)->setSpeed(ledConfig.speed);
+	NL::LedManager::ledAnimator.at(zoneIndex)->setOffset(ledConfig.offset);
+	NL::LedManager::ledAnimator.at(zoneIndex)->setAnimationBrightness(ledConfig.brightness / 255.0f);
+	NL::LedManager::ledAnimator.at(zoneIndex)->setFadeSpeed(ledConfig.fadeSpeed / 4096.0f);
+	NL::LedManager::ledAnimator.at(zoneIndex)->setReverse(ledConfig.reverse);
+}
+
+/**
+ * @brief Start a crossfade for the changed zones by keeping a copy of the last shown frame.
+ * Must only be called while the LED buffers are kept.
+ * @param zoneChanged true for each zone that gets a new animator
+ */
+void NL::LedManager::startCrossfade(const bool zoneChanged[LED_NUM_ZONES])
+{
+	NL::LedManager::crossfadeStep = LED_CROSSFADE_FRAMES;
+	if (LED_CROSSFADE_FRAMES == 0 || NL::LedManager::ledAnimator.size() != LED_NUM_ZONES)
 	{
-		regulatorPower[i] = 0.0f;
+		return;
 	}
 
-	for (size_t i = 0; i < NL::LedManager::ledBuffer->getLedStripCount(); i++)
+	size_t crossfadeSize = 0;
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
 	{
-		NL::LedStrip ledStrip = NL::LedManager::ledBuffer->getLedStrip(i);
-		NL::Configuration::LedConfig ledConfig;
-		NL::Configuration::getLedConfig(i, ledConfig);
+		NL::LedManager::crossfadeZone[i] = zoneChanged[i];
+		NL::LedManager::crossfadeOffset[i] = crossfadeSize;
+		crossfadeSize += zoneChanged[i] ? NL::LedManager::getLedStrip(i).getLedCount() * 3 : 0;
+	}
+	if (crossfadeSize == 0)
+	{
+		return;
+	}
 
-		float zoneCurrent = 0.0f;
-		for (size_t j = 0; j < ledStrip.getLedCount(); j++)
+	// The front buffer holds the last shown frame, the zones have the same layout in both buffers
+	NL::LedManager::crossfadeBuffer.resize(crossfadeSize);
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		if (NL::LedManager::crossfadeZone[i])
 		{
-			zoneCurrent += ledConfig.ledChannelCurrent[0] * ledStrip.getPixel(j).red / 255.0f;
-			zoneCurrent += ledConfig.ledChannelCurrent[1] * ledStrip.getPixel(j).green / 255.0f;
-			zoneCurrent += ledConfig.ledChannelCurrent[2] * ledStrip.getPixel(j).blue / 255.0f;
+			NL::LedBuffer &ledBuffer = *NL::LedManager::ledBuffer.at(i / NL::LedManager::zonesPerDriver);
+			NL::LedStrip &ledStrip = NL::LedManager::getLedStrip(i);
+			const size_t stripOffset = ledStrip.getBuffer() - ledBuffer.getBuffer();
+			std::memcpy(&NL::LedManager::crossfadeBuffer.at(NL::LedManager::crossfadeOffset[i]), ledBuffer.getFrontBuffer() + stripOffset, ledStrip.getLedCount() * 3);
 		}
-
-		const uint8_t regulatorIndex = NL::LedManager::getRegulatorIndexFromPin(ledConfig.ledPin);
-		regulatorPower[regulatorIndex] += zoneCurrent * ledConfig.ledVoltage / 1000.0f;
 	}
+	NL::LedManager::crossfadeStep = 0;
 }
 
 /**
- * @brief Limit the power consumption of the current frame to the maxumim system power.
+ * @brief Blend the next step of the crossfade from the old frame into the rendered frame.
  */
-void NL::LedManager::limitPowerConsumption()
+void NL::LedManager::applyCrossfade()
 {
-	float regulatorPower[REGULATOR_COUNT];
-	NL::LedManager::calculateRegulatorPowerDraw(regulatorPower);
-
-	const NL::Configuration::SystemConfig systemConfig = NL::Configuration::getSystemConfig();
-	for (size_t i = 0; i < NL::LedManager::ledBuffer->getLedStripCount(); i++)
+	NL::LedManager::crossfadeStep++;
+	const uint16_t alpha = NL::LedManager::crossfadeStep * 256 / (LED_CROSSFADE_FRAMES + 1);
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
 	{
-		NL::LedStrip ledStrip = NL::LedManager::ledBuffer->getLedStrip(i);
-		NL::Configuration::LedConfig ledConfig;
-		NL::Configuration::getLedConfig(i, ledConfig);
-
-		const uint8_t regulatorIndex = NL::LedManager::getRegulatorIndexFromPin(ledConfig.ledPin);
-		float multiplicator = (static_cast<float>(systemConfig.regulatorPowerLimit) / REGULATOR_COUNT) / regulatorPower[regulatorIndex];
-		if (multiplicator < 0.0f)
-		{
-			multiplicator = 0.0f;
-		}
-		else if (multiplicator > 1.0f)
+		if (!NL::LedManager::crossfadeZone[i])
 		{
-			multiplicator = 1.0f;
+			continue;
 		}
 
-		for (size_t j = 0; j < ledStrip.getLedCount(); j++)
+		NL::LedStrip &ledStrip = NL::LedManager::getLedStrip(i);
+		uint8_t *buffer = ledStrip.getBuffer();
+		const uint8_t *oldBuffer = &NL::LedManager::crossfadeBuffer.at(NL::LedManager::crossfadeOffset[i]);
+		const size_t channelCount = ledStrip.getLedCount() * 3;
+		for (size_t j = 0; j < channelCount; j++)
 		{
-			NL::Pixel pixel = ledStrip.getPixel(j);
-			pixel.red *= multiplicator;
-			pixel.green *= multiplicator;
-			pixel.blue *= multiplicator;
-			ledStrip.setPixel(pixel, j);
+			buffer[j] = (buffer[j] * alpha + oldBuffer[j] * (256 - alpha)) >> 8;
 		}
 	}
+
+	if (NL::LedManager::crossfadeStep >= LED_CROSSFADE_FRAMES)
+	{
+		NL::LedManager::crossfadeBuffer.clear();
+		NL::LedManager::crossfadeBuffer.shrink_to_fit();
+	}
 }
 
 /**
- * @brief Limit the regulator temperature by reducing the LED brightness once the high temperature is reached.
+ * @brief Apply the brightness, power limit and temperature limit to all zones in a single pass.
+ * The raw channel sums of each zone are used to estimate the power draw per regulator.
+ * From this a combined 8.8 fixed-point scale is calculated per zone and applied to the pixel data.
+ * @return estimated power draw of all LEDs after post-processing in W
  */
-void NL::LedManager::limitRegulatorTemperature()
+float NL::LedManager::applyPostProcessing()
 {
-	float multiplicator = 1.0f - (NL::LedManager::regulatorTemperature - NL::Configuration::getSystemConfig().regulatorHighTemperature) / (NL::Configuration::getSystemConfig().regulatorCutoffTemperature - NL::Configuration::getSystemConfig().regulatorHighTemperature);
-	if (multiplicator < 0.0f)
+	// Only copy the runtime configuration when it was changed
+	if (NL::LedManager::runtimeConfig.generation != NL::Configuration::getRuntimeGeneration())
+	{
+		NL::Configuration::getRuntimeConfig(NL::LedManager::runtimeConfig);
+	}
+	const NL::Configuration::RuntimeConfig &config = NL::LedManager::runtimeConfig;
+
+	float thermalScale = 1.0f - (NL::LedManager::regulatorTemperature - config.regulatorHighTemperature) / config.regulatorTemperatureRange;
+	if (thermalScale < 0.0f)
+	{
+		thermalScale = 0.0f;
+	}
+	else if (thermalScale > 1.0f)
 	{
-		multiplicator = 0.0f;
+		thermalScale = 1.0f;
 	}
-	else if (multiplicator > 1.0f)
+
+	// Estimate the power draw of each zone from the raw channel sums and the zone brightness
+	float zonePower[LED_NUM_ZONES];
+	float zoneBrightness[LED_NUM_ZONES];
+	float regulatorPower[REGULATOR_COUNT];
+	for (uint8_t i = 0; i < REGULATOR_COUNT; i++)
 	{
-		multiplicator = 1.0f;
+		regulatorPower[i] = 0.0f;
 	}
 
-	for (size_t i = 0; i < NL::LedManager::ledBuffer->getLedStripCount(); i++)
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
 	{
-		NL::LedStrip ledStrip = NL::LedManager::ledBuffer->getLedStrip(i);
-		for (size_t j = 0; j < ledStrip.getLedCount(); j++)
+		NL::LedStrip &ledStrip = NL::LedManager::getLedStrip(i);
+		const uint8_t *buffer = ledStrip.getBuffer();
+		const size_t channelCount = ledStrip.getLedCount() * 3;
+		uint32_t channelSum[3] = {0, 0, 0};
+		for (size_t j = 0; j < channelCount; j += 3)
 		{
-			NL::Pixel pixel = ledStrip.getPixel(j);
-			pixel.red *= multiplicator;
-			pixel.green *= multiplicator;
-			pixel.blue *= multiplicator;
-			ledStrip.setPixel(pixel, j);
+			channelSum[0] += buffer[j];
+			channelSum[1] += buffer[j + 1];
+			channelSum[2] += buffer[j + 2];
 		}
+
+		zoneBrightness[i] = NL::LedManager::ledAnimator.at(i)->getTotalBrightness();
+		zonePower[i] = (config.zoneChannelPower[i][0] * channelSum[0] + config.zoneChannelPower[i][1] * channelSum[1] + config.zoneChannelPower[i][2] * channelSum[2]) * zoneBrightness[i];
+		regulatorPower[config.zoneRegulatorIndex[i]] += zonePower[i];
 	}
-}
 
-/**
- * @brief Get the regulator index by providing the pin number.
- * @param pin physical pin number
- * @return regulator index
- */
-uint8_t NL::LedManager::getRegulatorIndexFromPin(const uint8_t pin)
-{
-	const uint8_t regulatorMap[LED_NUM_ZONES][2] = REGULATOR_ZONE_MAPPING;
-	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	// Combine brightness, power limit and temperature limit into one scale per zone and apply it
+	float totalPower = 0.0f;
+	for (size_t i = 0; i < LED_NUM_ZONES; i++)
 	{
-		if (regulatorMap[i][0] == pin)
+		float powerScale = config.regulatorPowerLimit / regulatorPower[config.zoneRegulatorIndex[i]];
+		if (powerScale < 0.0f)
+		{
+			powerScale = 0.0f;
+		}
+		else if (powerScale > 1.0f)
 		{
-			return regulatorMap[i][1];
+			powerScale = 1.0f;
+		}
+
+		const uint16_t scale = static_cast<uint16_t>(zoneBrightness[i] * powerScale * thermalScale * 256.0f + 0.5f);
+		totalPower += zonePower[i] * powerScale * thermalScale;
+		if (scale >= 256)
+		{
+			continue;
+		}
+
+		NL::LedStrip &ledStrip = NL::LedManager::getLedStrip(i);
+		uint8_t *buffer = ledStrip.getBuffer();
+		const size_t channelCount = ledStrip.getLedCount() * 3;
+		for (size_t j = 0; j < channelCount; j++)
+		{
+			buffer[j] = (buffer[j] * scale) >> 8;
 		}
 	}
-	return 0;
+
+	return totalPower;
 }
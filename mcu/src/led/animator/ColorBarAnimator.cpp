@@ -126,7 +126,7 @@ void NL::ColorBarAnimator::render(NL::LedStrip &ledStrip)
 		this->angle += 360.0f;
 	}
 
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
 
 /**
@@ -88,14 +88,14 @@ void NL::EqualizerAnimator::render(NL::LedStrip &ledStrip)
 	if (this->getDataSource() == NL::LedAnimator::DataSource::DS_AUDIO_FREQUENCY_VALUE)
 	{
 		// Check the sequence number
-		const NL::AudioUnit::AudioAnalysis audioAnalysis = this->getAudioAnalysis();
-		if (audioAnalysis.frequencyBandTriggers.size() == AUDIO_UNIT_NUM_BANDS && audioAnalysis.seq != this->audioSequence)
+		const NL::AudioUnit::AudioAnalysis &audioAnalysis = this->getSensorData().audioAnalysis;
+		if (audioAnalysis.frequencyBandCount == AUDIO_UNIT_NUM_BANDS && audioAnalysis.seq != this->audioSequence)
 		{
 			this->audioSequence = audioAnalysis.seq;
 			for (size_t i = 0; i < AUDIO_UNIT_NUM_BANDS; i++)
 			{
 				// Determine the peak value from all frequency bands
-				const uint16_t peak = audioAnalysis.frequencyBandValues.at(i);
+				const uint16_t peak = audioAnalysis.frequencyBandValues[i];
 				if (this->frequencyBandMask & (0B10000000 >> i))
 				{
 					// Update the volume when the peak is higher
@@ -208,5 +208,5 @@ void NL::EqualizerAnimator::render(NL::LedStrip &ledStrip)
 	}
 
 	// Apply the brightness settings
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
@@ -23,13 +23,13 @@
 
 /**
  * @brief Create a new instance of {@link NL::FseqAnimator}.
- * @param fseqLoader reference to a {@link NL::FseqLoader} instance
- * @param loop if set to true, the animation will loop
+ * @param fseqPlaylist reference to a {@link NL::FseqPlaylist} instance
+ * @param channelOffset offset of the first channel of the zone in the fseq frame
  */
-NL::FseqAnimator::FseqAnimator(NL::FseqLoader *fseqLoader, const bool loop)
+NL::FseqAnimator::FseqAnimator(NL::FseqPlaylist *fseqPlaylist, const size_t channelOffset)
 {
-	this->fseqLoader = fseqLoader;
-	this->loop = loop;
+	this->fseqPlaylist = fseqPlaylist;
+	this->channelOffset = channelOffset;
 }
 
 /**
@@ -45,7 +45,7 @@ NL::FseqAnimator::~FseqAnimator()
  */
 void NL::FseqAnimator::init(NL::LedStrip &ledStrip)
 {
-	this->fseqLoader->moveToStart();
+	this->fseqPlaylist->moveToStart();
 	for (size_t i = 0; i < ledStrip.getLedCount(); i++)
 	{
 		ledStrip.setPixel(NL::Pixel::ColorCode::Black, i);
@@ -53,24 +53,12 @@ void NL::FseqAnimator::init(NL::LedStrip &ledStrip)
 }
 
 /**
- * @brief Render the values from the fseq file to the vector holding the LED pixel data
+ * @brief Render the values from the fseq playlist to the vector holding the LED pixel data
  * @param ledStrip LED strip with the pixel data
  */
 void NL::FseqAnimator::render(NL::LedStrip &ledStrip)
 {
-	if (this->fseqLoader->available() < ledStrip.getLedCount())
-	{
-		if (this->loop)
-		{
-			this->fseqLoader->moveToStart();
-		}
-		else
-		{
-			return;
-		}
-	}
-
-	const NL::FseqLoader::Error fseqError = this->fseqLoader->readLedStrip(ledStrip);
+	const NL::FseqLoader::Error fseqError = this->fseqPlaylist->readLedStrip(ledStrip, this->channelOffset);
 	if (fseqError != NL::FseqLoader::Error::OK)
 	{
 		for (size_t i = 0; i < ledStrip.getLedCount(); i++)
@@ -83,5 +71,5 @@ void NL::FseqAnimator::render(NL::LedStrip &ledStrip)
 	{
 		this->reversePixels(ledStrip);
 	}
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
@@ -133,5 +133,5 @@ void NL::GradientAnimator::render(NL::LedStrip &ledStrip)
 	{
 		this->reversePixels(ledStrip);
 	}
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
@@ -133,7 +133,7 @@ void NL::GradientAnimatorMotion::render(NL::LedStrip &ledStrip)
 	{
 		this->reversePixels(ledStrip);
 	}
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
 
 /**
@@ -145,43 +145,43 @@ float NL::GradientAnimatorMotion::getMotionOffset()
 	float motionValue = 0.0f;
 	if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ACC_X_G)
 	{
-		motionValue = this->motionSensorData.accXG;
+		motionValue = this->sensorData->motionSensorData.accXG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ACC_Y_G)
 	{
-		motionValue = this->motionSensorData.accYG;
+		motionValue = this->sensorData->motionSensorData.accYG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ACC_Z_G)
 	{
-		motionValue = this->motionSensorData.accZG;
+		motionValue = this->sensorData->motionSensorData.accZG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_GY_X_DEG)
 	{
-		motionValue = this->motionSensorData.gyroXDeg / 30.0f;
+		motionValue = this->sensorData->motionSensorData.gyroXDeg / 30.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_GY_Y_DEG)
 	{
-		motionValue = this->motionSensorData.gyroYDeg / 30.0f;
+		motionValue = this->sensorData->motionSensorData.gyroYDeg / 30.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_GY_Z_DEG)
 	{
-		motionValue = this->motionSensorData.gyroZDeg / 30.0f;
+		motionValue = this->sensorData->motionSensorData.gyroZDeg / 30.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_PITCH)
 	{
-		motionValue = this->motionSensorData.pitch / 30.0f;
+		motionValue = this->sensorData->motionSensorData.pitch / 30.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ROLL)
 	{
-		motionValue = this->motionSensorData.roll / 30.0f;
+		motionValue = this->sensorData->motionSensorData.roll / 30.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ROLL_COMPENSATED_ACC_X_G)
 	{
-		motionValue = this->motionSensorData.rollCompensatedAccXG;
+		motionValue = this->sensorData->motionSensorData.rollCompensatedAccXG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_PITCH_COMPENSATED_ACC_Y_G)
 	{
-		motionValue = this->motionSensorData.pitchCompensatedAccYG;
+		motionValue = this->sensorData->motionSensorData.pitchCompensatedAccYG;
 	}
 	else
 	{
@@ -34,19 +34,7 @@ NL::LedAnimator::LedAnimator()
 	this->smoothedAmbBrightness = 0.0f;
 	this->fadeSpeed = 1.0f;
 	this->reverse = false;
-
-	this->motionSensorData.accXRaw = 0;
-	this->motionSensorData.accYRaw = 0;
-	this->motionSensorData.accZRaw = 0;
-	this->motionSensorData.gyroXRaw = 0;
-	this->motionSensorData.gyroYRaw = 0;
-	this->motionSensorData.gyroZRaw = 0;
-	this->motionSensorData.accXG = 0;
-	this->motionSensorData.accYG = 0;
-	this->motionSensorData.accZG = 0;
-	this->motionSensorData.gyroXDeg = 0;
-	this->motionSensorData.gyroYDeg = 0;
-	this->motionSensorData.gyroZDeg = 0;
+	this->sensorData = &NL::SensorSnapshot::getSensorData();
 }
 
 /**
@@ -136,6 +124,15 @@ float NL::LedAnimator::getAnimationBrightness()
 	return this->animationBrightness;
 }
 
+/**
+ * @brief Get the total brightness, combined from the animation brightness and smoothed ambient brightness.
+ * @return total brightness from 0.0 to 1.0
+ */
+float NL::LedAnimator::getTotalBrightness()
+{
+	return this->animationBrightness * this->smoothedAmbBrightness;
+}
+
 /**
  * @brief Set the ambient brightness.
  * @param ambientBrightness ambient brightness from 0.0 to 1.0
@@ -208,39 +205,22 @@ bool NL::LedAnimator::getReverse()
 }
 
 /**
- * @brief Set the motion sensor data.
- * @param motionSensorData motion sensor data
- */
-void NL::LedAnimator::setMotionSensorData(const NL::MotionSensor::MotionSensorData &motionSensorData)
-{
-	this->motionSensorData = motionSensorData;
-}
-
-/**
- * @brief Get the currently set motion sensor data.
- * @return currently set motion sensor data
- */
-NL::MotionSensor::MotionSensorData &NL::LedAnimator::getMotionSensorData()
-{
-	return this->motionSensorData;
-}
-
-/**
- * @brief Set the audio analysis data to be used by an animator.
- * @param audioAnalysis audio analysis
+ * @brief Set the sensor data to be used by the animator. The data is not copied,
+ * so it must stay valid until new sensor data is set.
+ * @param sensorData sensor data snapshot
  */
-void NL::LedAnimator::setAudioAnalysis(const NL::AudioUnit::AudioAnalysis &audioAnalysis)
+void NL::LedAnimator::setSensorData(const NL::SensorSnapshot::SensorData &sensorData)
 {
-	this->audioAnalysis = audioAnalysis;
+	this->sensorData = &sensorData;
 }
 
 /**
- * @brief Get the audio analysis data.
- * @return audio analysis data
+ * @brief Get the sensor data used by the animator.
+ * @return sensor data snapshot
  */
-NL::AudioUnit::AudioAnalysis &NL::LedAnimator::getAudioAnalysis()
+const NL::SensorSnapshot::SensorData &NL::LedAnimator::getSensorData()
 {
-	return this->audioAnalysis;
+	return *this->sensorData;
 }
 
 /**
@@ -259,10 +239,10 @@ void NL::LedAnimator::reversePixels(NL::LedStrip &ledStrip)
 }
 
 /**
- * @brief Apply the brightness settings to all pixels.
- * @param ledStrip LED strip with the pixel data
+ * @brief Step the smoothed ambient brightness towards the ambient brightness.
+ * The brightness itself is applied by the LED manager during post-processing.
  */
-void NL::LedAnimator::applyBrightness(NL::LedStrip &ledStrip)
+void NL::LedAnimator::updateBrightness()
 {
 	if (this->smoothedAmbBrightness < this->ambientBrightness)
 	{
@@ -280,16 +260,6 @@ void NL::LedAnimator::applyBrightness(NL::LedStrip &ledStrip)
 			this->smoothedAmbBrightness = this->ambientBrightness;
 		}
 	}
-
-	const float totalBrightness = this->animationBrightness * this->smoothedAmbBrightness;
-	for (size_t i = 0; i < ledStrip.getLedCount(); i++)
-	{
-		NL::Pixel pixel = ledStrip.getPixel(i);
-		pixel.red *= totalBrightness;
-		pixel.green *= totalBrightness;
-		pixel.blue *= totalBrightness;
-		ledStrip.setPixel(pixel, i);
-	}
 }
 
 /**
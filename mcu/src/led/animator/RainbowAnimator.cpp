@@ -90,7 +90,7 @@ void NL::RainbowAnimator::render(NL::LedStrip &ledStrip)
 		ledStrip.setPixel(NL::Pixel(this->trapezoid(redAngle) * 255.0f, this->trapezoid(greenAngle) * 255.0f, this->trapezoid(blueAngle) * 255.0f), i);
 	}
 
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 
 	if (this->reverse)
 	{
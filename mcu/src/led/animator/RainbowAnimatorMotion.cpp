@@ -89,7 +89,7 @@ void NL::RainbowAnimatorMotion::render(NL::LedStrip &ledStrip)
 		ledStrip.setPixel(NL::Pixel(this->trapezoid(redAngle) * 255.0f, this->trapezoid(greenAngle) * 255.0f, this->trapezoid(blueAngle) * 255.0f), i);
 	}
 
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 
 	const float speed = this->getMotionSpeed();
 	if (this->reverse)
@@ -120,43 +120,43 @@ float NL::RainbowAnimatorMotion::getMotionSpeed()
 	float speed = this->speed / 15.0f;
 	if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ACC_X_G)
 	{
-		speed *= this->motionSensorData.accXG;
+		speed *= this->sensorData->motionSensorData.accXG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ACC_Y_G)
 	{
-		speed *= this->motionSensorData.accYG;
+		speed *= this->sensorData->motionSensorData.accYG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ACC_Z_G)
 	{
-		speed *= this->motionSensorData.accZG;
+		speed *= this->sensorData->motionSensorData.accZG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_GY_X_DEG)
 	{
-		speed *= this->motionSensorData.gyroXDeg / 20.0f;
+		speed *= this->sensorData->motionSensorData.gyroXDeg / 20.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_GY_Y_DEG)
 	{
-		speed *= this->motionSensorData.gyroYDeg / 20.0f;
+		speed *= this->sensorData->motionSensorData.gyroYDeg / 20.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_GY_Z_DEG)
 	{
-		speed *= this->motionSensorData.gyroZDeg / 20.0f;
+		speed *= this->sensorData->motionSensorData.gyroZDeg / 20.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_PITCH)
 	{
-		speed *= this->motionSensorData.pitch / 20.0f;
+		speed *= this->sensorData->motionSensorData.pitch / 20.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ROLL)
 	{
-		speed *= this->motionSensorData.roll / 20.0f;
+		speed *= this->sensorData->motionSensorData.roll / 20.0f;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_PITCH_COMPENSATED_ACC_Y_G)
 	{
-		speed *= this->motionSensorData.pitchCompensatedAccYG;
+		speed *= this->sensorData->motionSensorData.pitchCompensatedAccYG;
 	}
 	else if (this->getDataSource() == NL::LedAnimator::DataSource::DS_MOTION_ROLL_COMPENSATED_ACC_X_G)
 	{
-		speed *= this->motionSensorData.rollCompensatedAccXG;
+		speed *= this->sensorData->motionSensorData.rollCompensatedAccXG;
 	}
 	else
 	{
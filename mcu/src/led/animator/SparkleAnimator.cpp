@@ -118,15 +118,15 @@ void NL::SparkleAnimator::render(NL::LedStrip &ledStrip)
 	if (this->getDataSource() == NL::LedAnimator::DataSource::DS_AUDIO_FREQUENCY_TRIGGER)
 	{
 		// Get the audio frequency analysis
-		const NL::AudioUnit::AudioAnalysis audioAnalysis = this->getAudioAnalysis();
-		if (audioAnalysis.frequencyBandTriggers.size() == AUDIO_UNIT_NUM_BANDS && audioAnalysis.seq != this->audioSequence)
+		const NL::AudioUnit::AudioAnalysis &audioAnalysis = this->getSensorData().audioAnalysis;
+		if (audioAnalysis.frequencyBandCount == AUDIO_UNIT_NUM_BANDS && audioAnalysis.seq != this->audioSequence)
 		{
 			// Check the sequency number
 			this->audioSequence = audioAnalysis.seq;
 			for (size_t i = 0; i < AUDIO_UNIT_NUM_BANDS; i++)
 			{
 				// Spawn new sparks depending on the band mask and the tigger status
-				if (this->frequencyBandMask & (0B10000000 >> i) && audioAnalysis.frequencyBandTriggers.at(i).trigger == NL::AudioUnit::Trigger::TRIGGER_RISING)
+				if (this->frequencyBandMask & (0B10000000 >> i) && audioAnalysis.frequencyBandTriggers[i].trigger == NL::AudioUnit::Trigger::TRIGGER_RISING)
 				{
 					this->spawnSparks(ledStrip);
 				}
@@ -219,7 +219,7 @@ void NL::SparkleAnimator::render(NL::LedStrip &ledStrip)
 	{
 		this->reversePixels(ledStrip);
 	}
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
 
 /**
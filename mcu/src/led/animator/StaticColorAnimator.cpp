@@ -60,5 +60,5 @@ void NL::StaticColorAnimator::render(NL::LedStrip &ledStrip)
 		ledStrip.setPixel(this->color, i);
 	}
 
-	this->applyBrightness(ledStrip);
+	this->updateBrightness();
 }
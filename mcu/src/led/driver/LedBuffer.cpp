@@ -44,19 +44,19 @@ NL::LedBuffer::LedBuffer(const std::vector<NL::LedStrip> &ledStrips)
 		this->maxHiddenLedCount = hiddenLedCount > this->maxHiddenLedCount ? hiddenLedCount : this->maxHiddenLedCount;
 	}
 
-	const size_t bufferSize = this->totalHiddenLedCount * 3;
-	this->buffer = new uint8_t[bufferSize];
-	for (size_t i = 0; i < bufferSize; i++)
+	// Only the visible LEDs are stored, hidden LEDs are sent out as black by the LED driver
+	const size_t bufferSize = this->totalLedCount * 3;
+	for (uint8_t i = 0; i < 2; i++)
 	{
-		this->buffer[i] = 0;
+		this->buffer[i] = new uint8_t[bufferSize];
+		for (size_t j = 0; j < bufferSize; j++)
+		{
+			this->buffer[i][j] = 0;
+		}
 	}
 
-	uint8_t *ptr = this->buffer;
-	for (size_t i = 0; i < this->ledStrips.size(); i++)
-	{
-		this->ledStrips.at(i).setBuffer(ptr);
-		ptr += this->ledStrips.at(i).getHiddenLedCount() * 3;
-	}
+	this->backBufferIndex = 0;
+	this->assignStripBuffers();
 }
 
 /**
@@ -64,10 +64,13 @@ NL::LedBuffer::LedBuffer(const std::vector<NL::LedStrip> &ledStrips)
  */
 NL::LedBuffer::~LedBuffer()
 {
-	if (this->buffer != nullptr)
+	for (uint8_t i = 0; i < 2; i++)
 	{
-		delete[] this->buffer;
-		this->buffer = nullptr;
+		if (this->buffer[i] != nullptr)
+		{
+			delete[] this->buffer[i];
+			this->buffer[i] = nullptr;
+		}
 	}
 }
 
@@ -81,12 +84,32 @@ size_t NL::LedBuffer::getBufferSize()
 }
 
 /**
- * @brief Get the base pointer to the LED buffer.
- * @return pointer to the LED buffer
+ * @brief Get the base pointer to the back buffer. This is the buffer the animators are rendering to.
+ * @return pointer to the back buffer
  */
 uint8_t *NL::LedBuffer::getBuffer()
 {
-	return this->buffer;
+	return this->buffer[this->backBufferIndex];
+}
+
+/**
+ * @brief Get the base pointer to the front buffer. This is the buffer the LED driver is sending out.
+ * @return pointer to the front buffer
+ */
+uint8_t *NL::LedBuffer::getFrontBuffer()
+{
+	return this->buffer[this->backBufferIndex ^ 1];
+}
+
+/**
+ * @brief Swap the front and back buffer. The rendered frame becomes the front buffer
+ * and the LED strips will point to the new back buffer.
+ * Must only be called while the LED driver is not sending data.
+ */
+void NL::LedBuffer::swapBuffers()
+{
+	this->backBufferIndex ^= 1;
+	this->assignStripBuffers();
 }
 
 /**
@@ -143,3 +166,16 @@ NL::LedStrip &NL::LedBuffer::getLedStrip(const size_t index)
 {
 	return this->ledStrips.at(index);
 }
+
+/**
+ * @brief Assign the back buffer to the LED strips.
+ */
+void NL::LedBuffer::assignStripBuffers()
+{
+	uint8_t *ptr = this->buffer[this->backBufferIndex];
+	for (size_t i = 0; i < this->ledStrips.size(); i++)
+	{
+		this->ledStrips.at(i).setBuffer(ptr);
+		ptr += this->ledStrips.at(i).getLedCount() * 3;
+	}
+}
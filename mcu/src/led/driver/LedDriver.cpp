@@ -1,73 +1,110 @@
 #include "led/driver/LedDriver.h"
 
-bool NL::LedDriver::initialized = false;
-uint8_t *NL::LedDriver::ledBuffer;
-volatile uint16_t NL::LedDriver::ledIndex;
-volatile uint16_t NL::LedDriver::ledStripCount;
-uint16_t NL::LedDriver::ledStripLength[8];
-volatile uint16_t NL::LedDriver::ledStripMaxLength;
-i2s_dev_t *NL::LedDriver::i2sDevice;
-NL::LedDriver::I2SDevice NL::LedDriver::i2sDeviceIdentifier;
-NL::LedDriver::DMABuffer *NL::LedDriver::dmaBuffer[4];
-volatile uint8_t NL::LedDriver::dmaBufferIndex;
-intr_handle_t NL::LedDriver::interruptHandle;
-volatile xSemaphoreHandle NL::LedDriver::semaphore;
+bool NL::LedDriver::deviceInUse[2] = {false, false};
+
+/**
+ * @brief Create a new instance of {@link NL::LedDriver}.
+ * @param i2sDeviceIdentifier I2S device to use
+ */
+NL::LedDriver::LedDriver(const NL::LedDriver::I2SDevice i2sDeviceIdentifier)
+{
+    this->initialized = false;
+    this->ledBuffer = nullptr;
+    this->frontBuffer = nullptr;
+    this->ledIndex = 0;
+    this->ledStripCount = 0;
+    std::memset(reinterpret_cast<uint8_t *>(this->ledStripLength), 0, sizeof(this->ledStripLength));
+    this->ledStripMaxLength = 0;
+    this->i2sDevice = nullptr;
+    this->i2sDeviceIdentifier = i2sDeviceIdentifier;
+    this->outputMode = NL::LedDriver::OutputMode::OUTPUT_ISR;
+    std::memset(reinterpret_cast<uint8_t *>(this->dmaBuffer), 0, sizeof(this->dmaBuffer));
+    this->dmaBufferIndex = 0;
+    this->frameBuffer = nullptr;
+    this->frameDescriptor = nullptr;
+    this->frameDescriptorCount = 0;
+    this->interruptHandle = nullptr;
+    this->semaphore = NULL;
+    this->transmitStartTime = 0;
+    this->transmitTime = 0;
+}
+
+/**
+ * @brief Destroy the {@link NL::LedDriver} instance and free resources.
+ */
+NL::LedDriver::~LedDriver()
+{
+    this->end();
+}
 
 /**
  * @brief Initialize and start the LED driver.
  * @param ledBuffer reference to the LED buffer
- * @param i2sDevice I2S device to use
+ * @param outputMode transpose the LED data per LED in the interrupt handler or once per frame
  * @return OK when the LED driver was initialized
  * @return ERROR_NO_LED_STRIPS when no LED data was provided
+ * @return ERROR_DEVICE_IN_USE when the I2S device is already used by another driver
  * @return ERROR_SET_PIN when the pin could not be configured
  * @return ERROR_ALLOCATE_INTERRUPT when the interrupt could not be allocated
+ * @return ERROR_ALLOCATE_DMA_BUFFER when the frame buffer could not be allocated
  */
-NL::LedDriver::Error NL::LedDriver::begin(NL::LedBuffer &ledBuffer, const NL::LedDriver::I2SDevice i2sDeviceIdentifier)
+NL::LedDriver::Error NL::LedDriver::begin(NL::LedBuffer &ledBuffer, const NL::LedDriver::OutputMode outputMode)
 {
-    if (ledBuffer.getLedStripCount() == 0 || ledBuffer.getMaxHiddenLedCount() < 8)
+    if (ledBuffer.getLedStripCount() == 0 || ledBuffer.getLedStripCount() > LED_MAX_ZONES_PER_DRIVER || ledBuffer.getMaxHiddenLedCount() < 8)
     {
         return NL::LedDriver::Error::ERROR_NO_LED_STRIPS;
     }
 
-    NL::LedDriver::initialized = false;
-    NL::LedDriver::ledBuffer = nullptr;
-    NL::LedDriver::ledIndex = 0;
-    NL::LedDriver::ledStripCount = 0;
-    std::memset(reinterpret_cast<uint8_t *>(NL::LedDriver::ledStripLength), 0, sizeof(ledStripLength));
-    NL::LedDriver::ledStripMaxLength = 0;
-    NL::LedDriver::i2sDevice = nullptr;
-    NL::LedDriver::i2sDeviceIdentifier = NL::LedDriver::I2SDevice::I2S_DEV_0;
-    std::memset(reinterpret_cast<uint8_t *>(NL::LedDriver::dmaBuffer), 0, sizeof(NL::LedDriver::dmaBuffer));
-    NL::LedDriver::dmaBufferIndex = 0;
-    NL::LedDriver::interruptHandle = nullptr;
-    NL::LedDriver::semaphore = NULL;
+    const uint8_t deviceIndex = static_cast<uint8_t>(this->i2sDeviceIdentifier);
+    if (NL::LedDriver::deviceInUse[deviceIndex])
+    {
+        return NL::LedDriver::Error::ERROR_DEVICE_IN_USE;
+    }
 
+    this->initialized = false;
+    this->outputMode = outputMode;
     for (size_t i = 0; i < ledBuffer.getLedStripCount(); i++)
     {
-        const NL::LedDriver::Error pinError = NL::LedDriver::initPin(ledBuffer.getLedStrip(i).getLedPin(), i);
+        const NL::LedDriver::Error pinError = this->initPin(ledBuffer.getLedStrip(i).getLedPin(), i);
         if (pinError != NL::LedDriver::Error::OK)
         {
             return pinError;
         }
-        NL::LedDriver::ledStripLength[i] = ledBuffer.getLedStrip(i).getHiddenLedCount();
+        this->ledStripLength[i] = ledBuffer.getLedStrip(i).getLedCount();
     }
 
-    NL::LedDriver::ledBuffer = ledBuffer.getBuffer();
-    NL::LedDriver::ledStripCount = ledBuffer.getLedStripCount();
-    NL::LedDriver::ledStripMaxLength = ledBuffer.getMaxHiddenLedCount();
-    NL::LedDriver::i2sDeviceIdentifier = i2sDeviceIdentifier;
-    NL::LedDriver::i2sDeviceIdentifier = i2sDeviceIdentifier;
-    NL::LedDriver::semaphore = xSemaphoreCreateBinary();
-    xSemaphoreGive(NL::LedDriver::semaphore);
+    this->ledBuffer = &ledBuffer;
+    this->frontBuffer = ledBuffer.getFrontBuffer();
+    this->ledStripCount = ledBuffer.getLedStripCount();
+    this->ledStripMaxLength = ledBuffer.getMaxHiddenLedCount();
 
-    const NL::LedDriver::Error i2sError = NL::LedDriver::initI2S();
+    const NL::LedDriver::Error i2sError = this->initI2S();
     if (i2sError != NL::LedDriver::Error::OK)
     {
         return i2sError;
     }
-    NL::LedDriver::initDMABuffers();
+    this->initDMABuffers();
+
+    if (this->outputMode == NL::LedDriver::OutputMode::OUTPUT_FRAME)
+    {
+        const NL::LedDriver::Error frameBufferError = this->initFrameBuffer();
+        if (frameBufferError != NL::LedDriver::Error::OK)
+        {
+            esp_intr_free(this->interruptHandle);
+            for (uint8_t i = 0; i < 4; i++)
+            {
+                this->freeDMABuffer(this->dmaBuffer[i]);
+                this->dmaBuffer[i] = nullptr;
+            }
+            return frameBufferError;
+        }
+    }
+
+    this->semaphore = xSemaphoreCreateBinary();
+    xSemaphoreGive(this->semaphore);
 
-    NL::LedDriver::initialized = true;
+    NL::LedDriver::deviceInUse[deviceIndex] = true;
+    this->initialized = true;
     return NL::LedDriver::Error::OK;
 }
 
@@ -78,7 +115,7 @@ NL::LedDriver::Error NL::LedDriver::begin(NL::LedBuffer &ledBuffer, const NL::Le
  */
 bool NL::LedDriver::isInitialized()
 {
-    return NL::LedDriver::initialized;
+    return this->initialized;
 }
 
 /**
@@ -86,18 +123,20 @@ bool NL::LedDriver::isInitialized()
  */
 void NL::LedDriver::end()
 {
-    if (NL::LedDriver::initialized)
+    if (this->initialized)
     {
-        xSemaphoreTake(NL::LedDriver::semaphore, portMAX_DELAY);
-        xSemaphoreGive(NL::LedDriver::semaphore);
-        vSemaphoreDelete(semaphore);
-        esp_intr_free(interruptHandle);
-
-        NL::LedDriver::initialized = false;
-        NL::LedDriver::freeDMABuffer(dmaBuffer[0]);
-        NL::LedDriver::freeDMABuffer(dmaBuffer[1]);
-        NL::LedDriver::freeDMABuffer(dmaBuffer[2]);
-        NL::LedDriver::freeDMABuffer(dmaBuffer[3]);
+        xSemaphoreTake(this->semaphore, portMAX_DELAY);
+        xSemaphoreGive(this->semaphore);
+        vSemaphoreDelete(this->semaphore);
+        esp_intr_free(this->interruptHandle);
+
+        this->initialized = false;
+        this->freeDMABuffer(this->dmaBuffer[0]);
+        this->freeDMABuffer(this->dmaBuffer[1]);
+        this->freeDMABuffer(this->dmaBuffer[2]);
+        this->freeDMABuffer(this->dmaBuffer[3]);
+        this->freeFrameBuffer();
+        NL::LedDriver::deviceInUse[static_cast<uint8_t>(this->i2sDeviceIdentifier)] = false;
     }
 }
 
@@ -110,22 +149,23 @@ void NL::LedDriver::end()
  */
 NL::LedDriver::Error NL::LedDriver::isReady(const TickType_t timeout)
 {
-    if (!NL::LedDriver::initialized)
+    if (!this->initialized)
     {
         return NL::LedDriver::Error::ERROR_NOT_INITIALIZED;
     }
 
-    if (xSemaphoreTake(NL::LedDriver::semaphore, timeout) != pdTRUE)
+    if (xSemaphoreTake(this->semaphore, timeout) != pdTRUE)
     {
         return NL::LedDriver::Error::ERROR_STILL_SENDING;
     }
 
-    xSemaphoreGive(NL::LedDriver::semaphore);
+    xSemaphoreGive(this->semaphore);
     return NL::LedDriver::Error::OK;
 }
 
 /**
- * @brief Prepare the DMA buffers and send the data to the LED strips (async).
+ * @brief Swap the front and back buffer, prepare the DMA buffers and send the data to the LED strips (async).
+ * After the call, the animators can render the next frame into the back buffer while the current frame is sent out.
  * @param timeout cpu cycles until a timeout will occur when the output is not finished yet
  * @return OK when the LED data is being processed
  * @return ERROR_NOT_INITIALIZED when the LED driver was not properly initialized yet
@@ -134,25 +174,39 @@ NL::LedDriver::Error NL::LedDriver::isReady(const TickType_t timeout)
  */
 NL::LedDriver::Error NL::LedDriver::showPixels(const TickType_t timeout)
 {
-    if (!NL::LedDriver::initialized)
+    if (!this->initialized)
     {
         return NL::LedDriver::Error::ERROR_NOT_INITIALIZED;
     }
 
-    if (xSemaphoreTake(NL::LedDriver::semaphore, timeout) != pdTRUE)
+    if (xSemaphoreTake(this->semaphore, timeout) != pdTRUE)
     {
         return NL::LedDriver::Error::ERROR_STILL_SENDING;
     }
 
-    NL::LedDriver::ledIndex = 0;
-    NL::LedDriver::dmaBufferIndex = 1;
-    NL::LedDriver::dmaBuffer[0]->descriptor.qe.stqe_next = &(dmaBuffer[1]->descriptor);
-    NL::LedDriver::dmaBuffer[1]->descriptor.qe.stqe_next = &(dmaBuffer[0]->descriptor);
-    NL::LedDriver::dmaBuffer[2]->descriptor.qe.stqe_next = &(dmaBuffer[0]->descriptor);
-    NL::LedDriver::dmaBuffer[3]->descriptor.qe.stqe_next = 0;
-    NL::LedDriver::loadDMABuffer(NL::LedDriver::ledBuffer, reinterpret_cast<uint16_t *>(NL::LedDriver::dmaBuffer[0]->buffer), NL::LedDriver::ledStripLength, NL::LedDriver::ledStripCount, NL::LedDriver::ledIndex);
+    // The output is idle while holding the semaphore, so the buffers can be swapped safely
+    this->ledBuffer->swapBuffers();
+    this->frontBuffer = this->ledBuffer->getFrontBuffer();
+
+    if (this->outputMode == NL::LedDriver::OutputMode::OUTPUT_FRAME)
+    {
+        this->loadFrameBuffer();
+        this->dmaBuffer[2]->descriptor.qe.stqe_next = &(this->frameDescriptor[0]);
+        this->dmaBuffer[3]->descriptor.qe.stqe_next = 0;
+    }
+    else
+    {
+        this->ledIndex = 0;
+        this->dmaBufferIndex = 1;
+        this->dmaBuffer[0]->descriptor.qe.stqe_next = &(this->dmaBuffer[1]->descriptor);
+        this->dmaBuffer[1]->descriptor.qe.stqe_next = &(this->dmaBuffer[0]->descriptor);
+        this->dmaBuffer[2]->descriptor.qe.stqe_next = &(this->dmaBuffer[0]->descriptor);
+        this->dmaBuffer[3]->descriptor.qe.stqe_next = 0;
+        NL::LedDriver::loadDMABuffer(this->frontBuffer, reinterpret_cast<uint16_t *>(this->dmaBuffer[0]->buffer), this->ledStripLength, this->ledStripCount, this->ledIndex);
+    }
 
-    NL::LedDriver::Error startError = NL::LedDriver::startI2S(dmaBuffer[2]);
+    this->transmitStartTime = static_cast<uint32_t>(esp_timer_get_time());
+    NL::LedDriver::Error startError = this->startI2S(this->dmaBuffer[2]);
     if (startError != NL::LedDriver::Error::OK)
     {
         return startError;
@@ -161,6 +215,15 @@ NL::LedDriver::Error NL::LedDriver::showPixels(const TickType_t timeout)
     return NL::LedDriver::Error::OK;
 }
 
+/**
+ * @brief Get the time it took to send out the last frame.
+ * @return transmit time in µs
+ */
+uint32_t NL::LedDriver::getTransmitTime()
+{
+    return this->transmitTime;
+}
+
 /**
  * @brief Initialize an output pin.
  * @param outputPin pin number of the output pin
@@ -175,7 +238,7 @@ NL::LedDriver::Error NL::LedDriver::initPin(const uint8_t outputPin, const uint8
     {
         return NL::LedDriver::Error::ERROR_SET_PIN;
     }
-    gpio_matrix_out(outputPin, (NL::LedDriver::i2sDeviceIdentifier == NL::LedDriver::I2SDevice::I2S_DEV_0 ? I2S0O_DATA_OUT0_IDX : I2S1O_DATA_OUT0_IDX) + ledStripIndex + 8, false, false);
+    gpio_matrix_out(outputPin, (this->i2sDeviceIdentifier == NL::LedDriver::I2SDevice::I2S_DEV_0 ? I2S0O_DATA_OUT0_IDX : I2S1O_DATA_OUT0_IDX) + ledStripIndex + 8, false, false);
     return NL::LedDriver::Error::OK;
 }
 
@@ -187,50 +250,50 @@ NL::LedDriver::Error NL::LedDriver::initPin(const uint8_t outputPin, const uint8
 NL::LedDriver::Error NL::LedDriver::initI2S()
 {
     uint8_t interruptSource;
-    if (NL::LedDriver::i2sDeviceIdentifier == NL::LedDriver::I2SDevice::I2S_DEV_0)
+    if (this->i2sDeviceIdentifier == NL::LedDriver::I2SDevice::I2S_DEV_0)
     {
-        NL::LedDriver::i2sDevice = &I2S0;
+        this->i2sDevice = &I2S0;
         periph_module_enable(PERIPH_I2S0_MODULE);
         interruptSource = ETS_I2S0_INTR_SOURCE;
     }
     else
     {
-        NL::LedDriver::i2sDevice = &I2S1;
+        this->i2sDevice = &I2S1;
         periph_module_enable(PERIPH_I2S1_MODULE);
         interruptSource = ETS_I2S1_INTR_SOURCE;
     }
 
-    NL::LedDriver::resetI2S();
-    NL::LedDriver::resetDMA();
-    NL::LedDriver::resetFIFO();
-
-    NL::LedDriver::i2sDevice->conf.tx_right_first = 0;
-    NL::LedDriver::i2sDevice->conf2.val = 0;
-    NL::LedDriver::i2sDevice->conf2.lcd_en = 1;
-    NL::LedDriver::i2sDevice->conf2.lcd_tx_wrx2_en = 1;
-    NL::LedDriver::i2sDevice->conf2.lcd_tx_sdx2_en = 0;
-    NL::LedDriver::i2sDevice->sample_rate_conf.val = 0;
-    NL::LedDriver::i2sDevice->sample_rate_conf.tx_bits_mod = 16;
-    NL::LedDriver::i2sDevice->clkm_conf.val = 0;
-    NL::LedDriver::i2sDevice->clkm_conf.clka_en = 0;
-    NL::LedDriver::i2sDevice->clkm_conf.clkm_div_a = 3;
-    NL::LedDriver::i2sDevice->clkm_conf.clkm_div_b = 1;
-    NL::LedDriver::i2sDevice->clkm_conf.clkm_div_num = 33;
-    NL::LedDriver::i2sDevice->fifo_conf.val = 0;
-    NL::LedDriver::i2sDevice->fifo_conf.tx_fifo_mod_force_en = 1;
-    NL::LedDriver::i2sDevice->fifo_conf.tx_fifo_mod = 1;
-    NL::LedDriver::i2sDevice->fifo_conf.tx_data_num = 32;
-    NL::LedDriver::i2sDevice->fifo_conf.dscr_en = 1;
-    NL::LedDriver::i2sDevice->sample_rate_conf.tx_bck_div_num = 1;
-    NL::LedDriver::i2sDevice->conf1.val = 0;
-    NL::LedDriver::i2sDevice->conf1.tx_stop_en = 0;
-    NL::LedDriver::i2sDevice->conf1.tx_pcm_bypass = 1;
-    NL::LedDriver::i2sDevice->conf_chan.val = 0;
-    NL::LedDriver::i2sDevice->conf_chan.tx_chan_mod = 1;
-    NL::LedDriver::i2sDevice->timing.val = 0;
-    NL::LedDriver::i2sDevice->int_ena.val = 0;
-
-    if (esp_intr_alloc(interruptSource, ESP_INTR_FLAG_INTRDISABLED | ESP_INTR_FLAG_LEVEL3 | ESP_INTR_FLAG_IRAM, &NL::LedDriver::interruptHandler, NULL, &NL::LedDriver::interruptHandle) != ESP_OK)
+    this->resetI2S();
+    this->resetDMA();
+    this->resetFIFO();
+
+    this->i2sDevice->conf.tx_right_first = 0;
+    this->i2sDevice->conf2.val = 0;
+    this->i2sDevice->conf2.lcd_en = 1;
+    this->i2sDevice->conf2.lcd_tx_wrx2_en = 1;
+    this->i2sDevice->conf2.lcd_tx_sdx2_en = 0;
+    this->i2sDevice->sample_rate_conf.val = 0;
+    this->i2sDevice->sample_rate_conf.tx_bits_mod = 16;
+    this->i2sDevice->clkm_conf.val = 0;
+    this->i2sDevice->clkm_conf.clka_en = 0;
+    this->i2sDevice->clkm_conf.clkm_div_a = 3;
+    this->i2sDevice->clkm_conf.clkm_div_b = 1;
+    this->i2sDevice->clkm_conf.clkm_div_num = 33;
+    this->i2sDevice->fifo_conf.val = 0;
+    this->i2sDevice->fifo_conf.tx_fifo_mod_force_en = 1;
+    this->i2sDevice->fifo_conf.tx_fifo_mod = 1;
+    this->i2sDevice->fifo_conf.tx_data_num = 32;
+    this->i2sDevice->fifo_conf.dscr_en = 1;
+    this->i2sDevice->sample_rate_conf.tx_bck_div_num = 1;
+    this->i2sDevice->conf1.val = 0;
+    this->i2sDevice->conf1.tx_stop_en = 0;
+    this->i2sDevice->conf1.tx_pcm_bypass = 1;
+    this->i2sDevice->conf_chan.val = 0;
+    this->i2sDevice->conf_chan.tx_chan_mod = 1;
+    this->i2sDevice->timing.val = 0;
+    this->i2sDevice->int_ena.val = 0;
+
+    if (esp_intr_alloc(interruptSource, ESP_INTR_FLAG_INTRDISABLED | ESP_INTR_FLAG_LEVEL3 | ESP_INTR_FLAG_IRAM, &NL::LedDriver::interruptHandler, this, &this->interruptHandle) != ESP_OK)
     {
         return NL::LedDriver::Error::ERROR_ALLOCATE_INTERRUPT;
     }
@@ -246,23 +309,23 @@ NL::LedDriver::Error NL::LedDriver::initI2S()
  */
 NL::LedDriver::Error NL::LedDriver::startI2S(const NL::LedDriver::DMABuffer *startBuffer)
 {
-    NL::LedDriver::resetI2S();
-
-    NL::LedDriver::i2sDevice->lc_conf.val = I2S_OUT_DATA_BURST_EN | I2S_OUTDSCR_BURST_EN | I2S_OUT_DATA_BURST_EN;
-    NL::LedDriver::i2sDevice->out_link.addr = reinterpret_cast<uint32_t>(&(startBuffer->descriptor));
-    NL::LedDriver::i2sDevice->out_link.start = 1;
-    NL::LedDriver::i2sDevice->int_clr.val = NL::LedDriver::i2sDevice->int_raw.val;
-    NL::LedDriver::i2sDevice->int_clr.val = NL::LedDriver::i2sDevice->int_raw.val;
-    NL::LedDriver::i2sDevice->int_ena.val = 0;
-    NL::LedDriver::i2sDevice->int_ena.out_eof = 1;
-    NL::LedDriver::i2sDevice->int_ena.out_total_eof = 1;
-
-    if (esp_intr_enable(NL::LedDriver::interruptHandle) != ESP_OK)
+    this->resetI2S();
+
+    this->i2sDevice->lc_conf.val = I2S_OUT_DATA_BURST_EN | I2S_OUTDSCR_BURST_EN | I2S_OUT_DATA_BURST_EN;
+    this->i2sDevice->out_link.addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&(startBuffer->descriptor)));
+    this->i2sDevice->out_link.start = 1;
+    this->i2sDevice->int_clr.val = this->i2sDevice->int_raw.val;
+    this->i2sDevice->int_clr.val = this->i2sDevice->int_raw.val;
+    this->i2sDevice->int_ena.val = 0;
+    this->i2sDevice->int_ena.out_eof = this->outputMode == NL::LedDriver::OutputMode::OUTPUT_ISR;
+    this->i2sDevice->int_ena.out_total_eof = 1;
+
+    if (esp_intr_enable(this->interruptHandle) != ESP_OK)
     {
         return NL::LedDriver::Error::ERROR_ENABLE_INTERRUPT;
     }
 
-    NL::LedDriver::i2sDevice->conf.tx_start = 1;
+    this->i2sDevice->conf.tx_start = 1;
     return NL::LedDriver::Error::OK;
 }
 
@@ -272,11 +335,11 @@ NL::LedDriver::Error NL::LedDriver::startI2S(const NL::LedDriver::DMABuffer *sta
 void IRAM_ATTR NL::LedDriver::resetI2S()
 {
     const unsigned long lcConfigResetFlage = I2S_IN_RST_M | I2S_OUT_RST_M | I2S_AHBM_RST_M | I2S_AHBM_FIFO_RST_M;
-    NL::LedDriver::i2sDevice->lc_conf.val |= lcConfigResetFlage;
-    NL::LedDriver::i2sDevice->lc_conf.val &= ~lcConfigResetFlage;
+    this->i2sDevice->lc_conf.val |= lcConfigResetFlage;
+    this->i2sDevice->lc_conf.val &= ~lcConfigResetFlage;
     const uint32_t configResetFlags = I2S_RX_RESET_M | I2S_RX_FIFO_RESET_M | I2S_TX_RESET_M | I2S_TX_FIFO_RESET_M;
-    NL::LedDriver::i2sDevice->conf.val |= configResetFlags;
-    NL::LedDriver::i2sDevice->conf.val &= ~configResetFlags;
+    this->i2sDevice->conf.val |= configResetFlags;
+    this->i2sDevice->conf.val &= ~configResetFlags;
 }
 
 /**
@@ -284,14 +347,14 @@ void IRAM_ATTR NL::LedDriver::resetI2S()
  */
 void IRAM_ATTR NL::LedDriver::stopI2S()
 {
-    if (esp_intr_disable(NL::LedDriver::interruptHandle) != ESP_OK)
+    if (esp_intr_disable(this->interruptHandle) != ESP_OK)
     {
         // Idk...
     }
 
-    NL::LedDriver::i2sDevice->conf.tx_start = 0;
-    // while (NL::LedDriver::i2sDevice->conf.tx_start == 1);
-    resetI2S();
+    this->i2sDevice->conf.tx_start = 0;
+    // while (this->i2sDevice->conf.tx_start == 1);
+    this->resetI2S();
     ets_delay_us(30);
 }
 
@@ -300,8 +363,8 @@ void IRAM_ATTR NL::LedDriver::stopI2S()
  */
 void NL::LedDriver::resetDMA()
 {
-    NL::LedDriver::i2sDevice->lc_conf.out_rst = 1;
-    NL::LedDriver::i2sDevice->lc_conf.out_rst = 0;
+    this->i2sDevice->lc_conf.out_rst = 1;
+    this->i2sDevice->lc_conf.out_rst = 0;
 }
 
 /**
@@ -309,8 +372,8 @@ void NL::LedDriver::resetDMA()
  */
 void NL::LedDriver::resetFIFO()
 {
-    NL::LedDriver::i2sDevice->conf.tx_fifo_reset = 1;
-    NL::LedDriver::i2sDevice->conf.tx_fifo_reset = 0;
+    this->i2sDevice->conf.tx_fifo_reset = 1;
+    this->i2sDevice->conf.tx_fifo_reset = 0;
 }
 
 /**
@@ -351,61 +414,148 @@ void NL::LedDriver::freeDMABuffer(NL::LedDriver::DMABuffer *dmaBuffer)
  */
 void NL::LedDriver::initDMABuffers()
 {
-    NL::LedDriver::dmaBuffer[0] = NL::LedDriver::allocateDMABuffer(3 * 8 * 2 * 3);
-    NL::LedDriver::dmaBuffer[1] = NL::LedDriver::allocateDMABuffer(3 * 8 * 2 * 3);
-    NL::LedDriver::dmaBuffer[2] = NL::LedDriver::allocateDMABuffer(3 * 8 * 2 * 3);
-    NL::LedDriver::dmaBuffer[3] = NL::LedDriver::allocateDMABuffer(3 * 8 * 2 * 3 * 4);
+    this->dmaBuffer[0] = this->allocateDMABuffer(3 * 8 * 2 * 3);
+    this->dmaBuffer[1] = this->allocateDMABuffer(3 * 8 * 2 * 3);
+    this->dmaBuffer[2] = this->allocateDMABuffer(3 * 8 * 2 * 3);
+    this->dmaBuffer[3] = this->allocateDMABuffer(3 * 8 * 2 * 3 * 4);
 
     for (uint8_t i = 0; i < 2; i++)
     {
         for (uint8_t j = 0; j < 3 * 8 / 2; j++)
         {
-            uint16_t *buffer = reinterpret_cast<uint16_t *>(NL::LedDriver::dmaBuffer[i]->buffer);
+            uint16_t *buffer = reinterpret_cast<uint16_t *>(this->dmaBuffer[i]->buffer);
             buffer[j * 6 + 1] = 0xffff;
             buffer[j * 6 + 2] = 0xffff;
         }
     }
 }
 
+/**
+ * @brief Allocate the DMA buffer for a full frame and split it into a linked list of descriptors.
+ * Each LED takes 3 * 8 * 3 16 bit words. The high part of each bit is constant and only written once.
+ * @return OK when the frame buffer was allocated
+ * @return ERROR_ALLOCATE_DMA_BUFFER when there is not enough DMA capable memory
+ */
+NL::LedDriver::Error NL::LedDriver::initFrameBuffer()
+{
+    const uint32_t ledSize = 3 * 8 * 2 * 3;
+    const uint32_t frameSize = this->ledStripMaxLength * ledSize;
+    const uint32_t descriptorSize = (4095 / ledSize) * ledSize;
+
+    this->frameDescriptorCount = frameSize / descriptorSize + (frameSize % descriptorSize ? 1 : 0);
+    this->frameBuffer = reinterpret_cast<uint8_t *>(heap_caps_malloc(frameSize, MALLOC_CAP_DMA));
+    this->frameDescriptor = reinterpret_cast<lldesc_t *>(heap_caps_malloc(this->frameDescriptorCount * sizeof(lldesc_t), MALLOC_CAP_DMA));
+    if (this->frameBuffer == nullptr || this->frameDescriptor == nullptr)
+    {
+        this->freeFrameBuffer();
+        return NL::LedDriver::Error::ERROR_ALLOCATE_DMA_BUFFER;
+    }
+
+    std::memset(this->frameBuffer, 0, frameSize);
+    for (uint16_t i = 0; i < this->ledStripMaxLength; i++)
+    {
+        uint16_t *buffer = reinterpret_cast<uint16_t *>(this->frameBuffer + i * ledSize);
+        for (uint8_t j = 0; j < 3 * 8 / 2; j++)
+        {
+            buffer[j * 6 + 1] = 0xffff;
+            buffer[j * 6 + 2] = 0xffff;
+        }
+    }
+
+    for (uint16_t i = 0; i < this->frameDescriptorCount; i++)
+    {
+        const uint32_t offset = i * descriptorSize;
+        const uint32_t size = frameSize - offset < descriptorSize ? frameSize - offset : descriptorSize;
+        lldesc_t &descriptor = this->frameDescriptor[i];
+        descriptor.length = size;
+        descriptor.size = size;
+        descriptor.owner = 1;
+        descriptor.sosf = 1;
+        descriptor.buf = this->frameBuffer + offset;
+        descriptor.offset = 0;
+        descriptor.empty = 0;
+        descriptor.eof = 0;
+        descriptor.qe.stqe_next = i + 1 < this->frameDescriptorCount ? &(this->frameDescriptor[i + 1]) : &(this->dmaBuffer[3]->descriptor);
+    }
+
+    return NL::LedDriver::Error::OK;
+}
+
+/**
+ * @brief Free the full frame DMA buffer and its descriptors.
+ */
+void NL::LedDriver::freeFrameBuffer()
+{
+    if (this->frameBuffer != nullptr)
+    {
+        heap_caps_free(this->frameBuffer);
+        this->frameBuffer = nullptr;
+    }
+    if (this->frameDescriptor != nullptr)
+    {
+        heap_caps_free(this->frameDescriptor);
+        this->frameDescriptor = nullptr;
+    }
+    this->frameDescriptorCount = 0;
+}
+
+/**
+ * @brief Transpose the full front buffer into the frame DMA buffer.
+ * This is running in the context of the calling task, so no interrupts are required while sending.
+ */
+void NL::LedDriver::loadFrameBuffer()
+{
+    uint16_t *buffer = reinterpret_cast<uint16_t *>(this->frameBuffer);
+    for (uint16_t i = 0; i < this->ledStripMaxLength; i++)
+    {
+        NL::LedDriver::loadDMABuffer(this->frontBuffer, buffer + i * 3 * 8 * 3, this->ledStripLength, this->ledStripCount, i);
+    }
+}
+
 /**
  * @brief Interrupt handler is called once a buffer was sent. It will then preload the next buffer.
- * @param args arguments, currently not used
+ * @param args pointer to the {@link NL::LedDriver} instance which owns the interrupt
  */
 void IRAM_ATTR NL::LedDriver::interruptHandler(void *args)
 {
-    if (GET_PERI_REG_BITS(I2S_INT_ST_REG(static_cast<uint8_t>(NL::LedDriver::i2sDeviceIdentifier)), I2S_OUT_EOF_INT_ST_V, I2S_OUT_EOF_INT_ST_S))
+    NL::LedDriver *ledDriver = static_cast<NL::LedDriver *>(args);
+    const uint8_t deviceIndex = static_cast<uint8_t>(ledDriver->i2sDeviceIdentifier);
+    if (GET_PERI_REG_BITS(I2S_INT_ST_REG(deviceIndex), I2S_OUT_EOF_INT_ST_V, I2S_OUT_EOF_INT_ST_S))
     {
-        NL::LedDriver::ledIndex++;
-        if (NL::LedDriver::ledIndex < NL::LedDriver::ledStripMaxLength)
+        ledDriver->ledIndex++;
+        if (ledDriver->ledIndex < ledDriver->ledStripMaxLength)
         {
-            loadDMABuffer(NL::LedDriver::ledBuffer, reinterpret_cast<uint16_t *>(NL::LedDriver::dmaBuffer[NL::LedDriver::dmaBufferIndex]->buffer), NL::LedDriver::ledStripLength, NL::LedDriver::ledStripCount, NL::LedDriver::ledIndex);
+            NL::LedDriver::loadDMABuffer(ledDriver->frontBuffer, reinterpret_cast<uint16_t *>(ledDriver->dmaBuffer[ledDriver->dmaBufferIndex]->buffer), ledDriver->ledStripLength, ledDriver->ledStripCount, ledDriver->ledIndex);
 
-            if (NL::LedDriver::ledIndex == NL::LedDriver::ledStripMaxLength - 3)
+            if (ledDriver->ledIndex == ledDriver->ledStripMaxLength - 3)
             {
-                NL::LedDriver::dmaBuffer[NL::LedDriver::dmaBufferIndex]->descriptor.qe.stqe_next = &(NL::LedDriver::dmaBuffer[3]->descriptor);
+                ledDriver->dmaBuffer[ledDriver->dmaBufferIndex]->descriptor.qe.stqe_next = &(ledDriver->dmaBuffer[3]->descriptor);
             }
-            NL::LedDriver::dmaBufferIndex = (NL::LedDriver::dmaBufferIndex + 1) % 2;
+            ledDriver->dmaBufferIndex = (ledDriver->dmaBufferIndex + 1) % 2;
         }
     }
 
-    if (GET_PERI_REG_BITS(I2S_INT_ST_REG(static_cast<uint8_t>(NL::LedDriver::i2sDeviceIdentifier)), I2S_OUT_TOTAL_EOF_INT_ST_V, I2S_OUT_TOTAL_EOF_INT_ST_S))
+    if (GET_PERI_REG_BITS(I2S_INT_ST_REG(deviceIndex), I2S_OUT_TOTAL_EOF_INT_ST_V, I2S_OUT_TOTAL_EOF_INT_ST_S))
     {
-        NL::LedDriver::stopI2S();
+        ledDriver->stopI2S();
+        ledDriver->transmitTime = static_cast<uint32_t>(esp_timer_get_time()) - ledDriver->transmitStartTime;
         portBASE_TYPE hpTaskAwoken = pdFALSE;
-        xSemaphoreGiveFromISR(NL::LedDriver::semaphore, &hpTaskAwoken);
+        xSemaphoreGiveFromISR(ledDriver->semaphore, &hpTaskAwoken);
         if (hpTaskAwoken == pdTRUE)
         {
             portYIELD_FROM_ISR(hpTaskAwoken);
         }
     }
-    REG_WRITE(I2S_INT_CLR_REG(0), (REG_READ(I2S_INT_RAW_REG(0)) & 0xffffffc0) | 0x3f);
+    REG_WRITE(I2S_INT_CLR_REG(deviceIndex), (REG_READ(I2S_INT_RAW_REG(deviceIndex)) & 0xffffffc0) | 0x3f);
 }
 
 /**
  * @brief Preload a DMA buffer from the LED pixel data.
+ * The LED strips are stored back to back in the LED buffer, so the length of each strip is also its stride.
+ * LEDs behind the end of a strip are sent out as black.
  * @param ledBuffer led buffer with the pixel data
  * @param dmaBuffer DMA buffer to fill
- * @param ledStripLength length of the individual LED strips
+ * @param ledStripLength number of visible LEDs of the individual LED strips
  * @param ledStripCount number of LED strips
  * @param ledIndex the current LED index
  */
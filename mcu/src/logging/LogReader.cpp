@@ -0,0 +1,359 @@
+/**
+ * @file LogReader.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NL::LogReader}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "logging/LogReader.h"
+
+/**
+ * @brief Create a new instance of {@link NL::LogReader}.
+ * @param file log file opened for reading
+ */
+NL::LogReader::LogReader(File &file) : file(file)
+{
+	this->fileSize = 0;
+	this->position = 0;
+}
+
+/**
+ * @brief Check the file header and move to the first record.
+ * @return OK when the file is a supported log file
+ * @return ERROR_FILE_READ when the file could not be read
+ * @return ERROR_FILE_VERSION when the file is not a log file or the version is not supported
+ */
+NL::LogReader::Error NL::LogReader::begin()
+{
+	this->fileSize = this->file.size();
+	uint8_t header[5];
+	if (!this->file.seek(0) || this->file.read(header, sizeof(header)) != sizeof(header))
+	{
+		return NL::LogReader::Error::ERROR_FILE_READ;
+	}
+
+	if (memcmp(header, "NLLG", 4) != 0 || header[4] != LOG_FILE_VERSION)
+	{
+		return NL::LogReader::Error::ERROR_FILE_VERSION;
+	}
+
+	this->position = sizeof(header);
+	return NL::LogReader::Error::OK;
+}
+
+/**
+ * @brief Move to the first record which starts at or after the given position.
+ * A position is accepted as record start when the record and the record following it are valid.
+ * @param position offset in the log file
+ */
+void NL::LogReader::seek(uint32_t position)
+{
+	position = std::max<uint32_t>(position, 5);
+	for (; position < this->fileSize; position++)
+	{
+		uint32_t size = 0;
+		uint32_t nextSize = 0;
+		if (this->getRecordSize(position, size) && (position + size == this->fileSize || this->getRecordSize(position + size, nextSize)))
+		{
+			break;
+		}
+	}
+	this->position = std::min(position, this->fileSize);
+}
+
+/**
+ * @brief Get the current position in the log file.
+ * @return offset of the next record
+ */
+uint32_t NL::LogReader::getPosition()
+{
+	return this->position;
+}
+
+/**
+ * @brief Read the next message from the log file and render it as text line.
+ * Location and text records are remembered for the following messages.
+ * Broken records are skipped.
+ * @param buffer buffer for the log line
+ * @param bufferSize size of the buffer
+ * @param length length of the log line
+ * @return OK when a line was read
+ * @return ERROR_END_OF_FILE when there are no more messages
+ */
+NL::LogReader::Error NL::LogReader::readLine(char *buffer, const size_t bufferSize, size_t &length)
+{
+	while (this->position < this->fileSize)
+	{
+		uint8_t header[13];
+		if (!this->file.seek(this->position) || this->file.read(header, 1) != 1)
+		{
+			return NL::LogReader::Error::ERROR_FILE_READ;
+		}
+
+		if (header[0] == static_cast<uint8_t>(NL::Logger::RecordType::LOCATION))
+		{
+			uint32_t locationId = 0;
+			uint32_t size = 0;
+			NL::LogReader::Location location;
+			if (this->readLocation(this->position, locationId, location, size))
+			{
+				this->locations[locationId] = location;
+				this->position += size;
+			}
+			else
+			{
+				this->seek(this->position + 1);
+			}
+		}
+		else if (header[0] == static_cast<uint8_t>(NL::Logger::RecordType::TEXT))
+		{
+			uint32_t textId = 0;
+			uint32_t size = 0;
+			String text;
+			if (this->readText(this->position, textId, text, size))
+			{
+				this->texts[textId] = text;
+				this->position += size;
+			}
+			else
+			{
+				this->seek(this->position + 1);
+			}
+		}
+		else if ((header[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::CONSTANT_MESSAGE) && this->file.read(header + 1, 12) == 12)
+		{
+			if (this->position + 13 > this->fileSize)
+			{
+				this->seek(this->position + 1);
+				continue;
+			}
+
+			const uint32_t time = header[1] | header[2] << 8 | header[3] << 16 | static_cast<uint32_t>(header[4]) << 24;
+			const uint32_t locationId = header[5] | header[6] << 8 | header[7] << 16 | static_cast<uint32_t>(header[8]) << 24;
+			const uint32_t textId = header[9] | header[10] << 8 | header[11] << 16 | static_cast<uint32_t>(header[12]) << 24;
+			this->position += 13;
+			const NL::LogReader::Location location = this->getLocation(locationId);
+			const String text = this->getText(textId);
+			length = NL::Logger::formatLine(buffer, bufferSize, static_cast<NL::Logger::LogLevel>(header[0] & 0x03), time, location.file.c_str(), location.function.c_str(), location.line, text.c_str(), text.length());
+			return NL::LogReader::Error::OK;
+		}
+		else if ((header[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::MESSAGE) && this->file.read(header + 1, 10) == 10)
+		{
+			char message[LOG_MAX_MESSAGE_LENGTH];
+			const uint32_t time = header[1] | header[2] << 8 | header[3] << 16 | static_cast<uint32_t>(header[4]) << 24;
+			const uint32_t locationId = header[5] | header[6] << 8 | header[7] << 16 | static_cast<uint32_t>(header[8]) << 24;
+			const uint16_t messageLength = header[9] | header[10] << 8;
+			if (messageLength > LOG_MAX_MESSAGE_LENGTH || this->position + 11 + messageLength > this->fileSize || this->file.read((uint8_t *)message, messageLength) != messageLength)
+			{
+				this->seek(this->position + 1);
+				continue;
+			}
+
+			this->position += 11 + messageLength;
+			const NL::LogReader::Location location = this->getLocation(locationId);
+			length = NL::Logger::formatLine(buffer, bufferSize, static_cast<NL::Logger::LogLevel>(header[0] & 0x03), time, location.file.c_str(), location.function.c_str(), location.line, message, messageLength);
+			return NL::LogReader::Error::OK;
+		}
+		else
+		{
+			this->seek(this->position + 1);
+		}
+	}
+
+	return NL::LogReader::Error::ERROR_END_OF_FILE;
+}
+
+/**
+ * @brief Get the size of the record at the given offset.
+ * @param offset offset of the record in the log file
+ * @param size reference to the variable which will hold the size
+ * @return true when there is a valid record
+ * @return false when there is no valid record
+ */
+bool NL::LogReader::getRecordSize(const uint32_t offset, uint32_t &size)
+{
+	uint8_t header[11];
+	if (!this->file.seek(offset) || this->file.read(header, 1) != 1)
+	{
+		return false;
+	}
+
+	if (header[0] == static_cast<uint8_t>(NL::Logger::RecordType::LOCATION) && this->file.read(header + 1, 7) == 7)
+	{
+		uint8_t functionLength = 0;
+		if (!this->file.seek(offset + 8 + header[7]) || this->file.read(&functionLength, 1) != 1)
+		{
+			return false;
+		}
+		size = 9 + header[7] + functionLength;
+	}
+	else if (header[0] == static_cast<uint8_t>(NL::Logger::RecordType::TEXT) && this->file.read(header + 1, 6) == 6)
+	{
+		const uint16_t textLength = header[5] | header[6] << 8;
+		if (textLength > LOG_MAX_MESSAGE_LENGTH)
+		{
+			return false;
+		}
+		size = 7 + textLength;
+	}
+	else if ((header[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::CONSTANT_MESSAGE))
+	{
+		size = 13;
+	}
+	else if ((header[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::MESSAGE) && this->file.read(header + 1, 10) == 10)
+	{
+		const uint16_t messageLength = header[9] | header[10] << 8;
+		if (messageLength > LOG_MAX_MESSAGE_LENGTH)
+		{
+			return false;
+		}
+		size = 11 + messageLength;
+	}
+	else
+	{
+		return false;
+	}
+
+	return offset + size <= this->fileSize;
+}
+
+/**
+ * @brief Read a location record.
+ * @param offset offset of the record in the log file
+ * @param locationId reference to the variable which will hold the id of the location
+ * @param location reference to the variable which will hold the location
+ * @param size reference to the variable which will hold the size of the record
+ * @return true when the location was read
+ * @return false when there is no valid location record
+ */
+bool NL::LogReader::readLocation(const uint32_t offset, uint32_t &locationId, NL::LogReader::Location &location, uint32_t &size)
+{
+	uint8_t header[8];
+	char text[UINT8_MAX + 1];
+	if (!this->file.seek(offset) || this->file.read(header, sizeof(header)) != sizeof(header) || header[0] != static_cast<uint8_t>(NL::Logger::RecordType::LOCATION))
+	{
+		return false;
+	}
+
+	const uint8_t fileLength = header[7];
+	if (this->file.read((uint8_t *)text, fileLength) != fileLength)
+	{
+		return false;
+	}
+	text[fileLength] = '\0';
+	location.file = text;
+
+	uint8_t functionLength = 0;
+	if (this->file.read(&functionLength, 1) != 1 || this->file.read((uint8_t *)text, functionLength) != functionLength)
+	{
+		return false;
+	}
+	text[functionLength] = '\0';
+	location.function = text;
+
+	locationId = header[1] | header[2] << 8 | header[3] << 16 | static_cast<uint32_t>(header[4]) << 24;
+	location.line = header[5] | header[6] << 8;
+	size = 9 + fileLength + functionLength;
+	return offset + size <= this->fileSize;
+}
+
+/**
+ * @brief Get a source location by its id.
+ * When the location record was not read yet, its offset is requested from the {@link NL::Logger}.
+ * @param locationId id of the source location
+ * @return source location or the id as hex string when the location is unknown
+ */
+NL::LogReader::Location NL::LogReader::getLocation(const uint32_t locationId)
+{
+	const std::unordered_map<uint32_t, NL::LogReader::Location>::const_iterator cached = this->locations.find(locationId);
+	if (cached != this->locations.end())
+	{
+		return cached->second;
+	}
+
+	NL::LogReader::Location location;
+	uint32_t offset = 0;
+	uint32_t id = 0;
+	uint32_t size = 0;
+	if (!NL::Logger::getLocationOffset(locationId, offset) || !this->readLocation(offset, id, location, size) || id != locationId)
+	{
+		location.file = (String)F("0x") + String(locationId, HEX);
+		location.function = F("unknown");
+		location.line = 0;
+	}
+
+	this->locations[locationId] = location;
+	return location;
+}
+
+/**
+ * @brief Read a text record.
+ * @param offset offset of the record in the log file
+ * @param textId reference to the variable which will hold the id of the text
+ * @param text reference to the variable which will hold the text
+ * @param size reference to the variable which will hold the size of the record
+ * @return true when the text was read
+ * @return false when there is no valid text record
+ */
+bool NL::LogReader::readText(const uint32_t offset, uint32_t &textId, String &text, uint32_t &size)
+{
+	uint8_t header[7];
+	char buffer[LOG_MAX_MESSAGE_LENGTH + 1];
+	if (!this->file.seek(offset) || this->file.read(header, sizeof(header)) != sizeof(header) || header[0] != static_cast<uint8_t>(NL::Logger::RecordType::TEXT))
+	{
+		return false;
+	}
+
+	const uint16_t textLength = header[5] | header[6] << 8;
+	if (textLength > LOG_MAX_MESSAGE_LENGTH || this->file.read((uint8_t *)buffer, textLength) != textLength)
+	{
+		return false;
+	}
+	buffer[textLength] = '\0';
+	text = buffer;
+
+	textId = header[1] | header[2] << 8 | header[3] << 16 | static_cast<uint32_t>(header[4]) << 24;
+	size = 7 + textLength;
+	return offset + size <= this->fileSize;
+}
+
+/**
+ * @brief Get the text of a constant message by its id.
+ * When the text record was not read yet, its offset is requested from the {@link NL::Logger}.
+ * @param textId id of the text
+ * @return text or the id as hex string when the text is unknown
+ */
+String NL::LogReader::getText(const uint32_t textId)
+{
+	const std::unordered_map<uint32_t, String>::const_iterator cached = this->texts.find(textId);
+	if (cached != this->texts.end())
+	{
+		return cached->second;
+	}
+
+	String text;
+	uint32_t offset = 0;
+	uint32_t id = 0;
+	uint32_t size = 0;
+	if (!NL::Logger::getTextOffset(textId, offset) || !this->readText(offset, id, text, size) || id != textId)
+	{
+		text = (String)F("unknown text 0x") + String(textId, HEX);
+	}
+
+	this->texts[textId] = text;
+	return text;
+}
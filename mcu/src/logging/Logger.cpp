@@ -28,6 +28,22 @@ FS *NL::Logger::fileSystem;
 String NL::Logger::fileName;
 NL::Logger::LogLevel NL::Logger::minLogLevel;
 
+File NL::Logger::logFile = File();
+RingbufHandle_t NL::Logger::logBuffer = NULL;
+SemaphoreHandle_t NL::Logger::fileMutex = NULL;
+TaskHandle_t NL::Logger::writerTaskHandle = NULL;
+SemaphoreHandle_t NL::Logger::writerStopped = NULL;
+std::atomic<bool> NL::Logger::writerRunning(false);
+std::atomic<bool> NL::Logger::bufferOpen(false);
+std::atomic<uint32_t> NL::Logger::bufferUsers(0);
+std::atomic<uint32_t> NL::Logger::droppedMessages(0);
+uint32_t NL::Logger::reportedDroppedMessages = 0;
+uint8_t *NL::Logger::writeBuffer = nullptr;
+size_t NL::Logger::writeBufferSize = 0;
+uint32_t NL::Logger::fileSize = 0;
+std::unordered_map<uint32_t, uint32_t> NL::Logger::locationOffsets;
+std::unordered_map<uint32_t, uint32_t> NL::Logger::textOffsets;
+
 /**
  * @brief Initialiize the {@link NL::Logger}.
  * @param minLogLevel optional parameter to set the minimum log level
@@ -35,6 +51,7 @@ NL::Logger::LogLevel NL::Logger::minLogLevel;
  */
 bool NL::Logger::begin(const NL::Logger::LogLevel minLogLevel)
 {
+	NL::Logger::stopWriter();
 	NL::Logger::initialized = true;
 	NL::Logger::logToSerial = false;
 	NL::Logger::logToFile = false;
@@ -52,6 +69,7 @@ bool NL::Logger::begin(const NL::Logger::LogLevel minLogLevel)
  */
 bool NL::Logger::begin(const uint32_t baudRate, const NL::Logger::LogLevel minLogLevel)
 {
+	NL::Logger::stopWriter();
 	Serial.begin(baudRate);
 	NL::Logger::initialized = true;
 	NL::Logger::logToSerial = true;
@@ -72,12 +90,13 @@ bool NL::Logger::begin(const uint32_t baudRate, const NL::Logger::LogLevel minLo
  */
 bool NL::Logger::begin(FS *fs, const String fn, const NL::Logger::LogLevel minLogLevel)
 {
-	NL::Logger::initialized = testOpenFile(fs, fn);
+	NL::Logger::stopWriter();
 	NL::Logger::logToSerial = false;
 	NL::Logger::logToFile = true;
 	NL::Logger::fileSystem = fs;
 	NL::Logger::fileName = fn;
 	NL::Logger::minLogLevel = minLogLevel;
+	NL::Logger::initialized = NL::Logger::startWriter();
 	return NL::Logger::initialized;
 }
 
@@ -92,21 +111,23 @@ bool NL::Logger::begin(FS *fs, const String fn, const NL::Logger::LogLevel minLo
  */
 bool NL::Logger::begin(uint32_t baudRate, FS *fs, const String fn, const NL::Logger::LogLevel minLogLevel)
 {
+	NL::Logger::stopWriter();
 	Serial.begin(baudRate);
-	NL::Logger::initialized = testOpenFile(fs, fn);
 	NL::Logger::logToSerial = true;
 	NL::Logger::logToFile = true;
 	NL::Logger::fileSystem = fs;
 	NL::Logger::fileName = fn;
 	NL::Logger::minLogLevel = minLogLevel;
+	NL::Logger::initialized = NL::Logger::startWriter();
 	return NL::Logger::initialized;
 }
 
 /**
- * @brief Stop the logger.
+ * @brief Stop the logger. Buffered messages are written to the log file before.
  */
 void NL::Logger::end()
 {
+	NL::Logger::stopWriter();
 	NL::Logger::initialized = false;
 	NL::Logger::logToSerial = false;
 	NL::Logger::logToFile = false;
@@ -137,41 +158,31 @@ void NL::Logger::setMinLogLevel(const NL::Logger::LogLevel logLevel)
 /**
  * @brief Log a message depending on the log level, source and message.
  * @param logLevel log level for the message
+ * @param locationId id of the source location
  * @param file path and name of the source file
  * @param function name of the function
  * @param current line in code
  * @param message message text
  */
-void NL::Logger::log(const NL::Logger::LogLevel logLevel, const char *file, const char *function, const int line, const String message)
+void NL::Logger::log(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const String &message)
 {
-	if (!NL::Logger::initialized)
-	{
-		return;
-	}
-
-	if (logLevel < minLogLevel)
-	{
-		return;
-	}
-
-	const String logString = getTimeString() + F(" [") + getLogLevelString(logLevel) + F("] (") + String(file) + F(") (") + String(function) + F(") (") + String(line) + F("): ") + message + F("\r\n");
-
-	if (logToSerial)
-	{
-		Serial.print(logString);
-	}
-
-	if (logToFile)
-	{
+	NL::Logger::logMessage(logLevel, locationId, file, function, line, message.c_str(), message.length(), false);
+}
 
-		File logFile = fileSystem->open(fileName, FILE_APPEND);
-		if (!logFile || logFile.isDirectory())
-		{
-			return;
-		}
-		logFile.write((uint8_t *)logString.c_str(), logString.length());
-		logFile.close();
-	}
+/**
+ * @brief Log a constant message depending on the log level and source. The message is not copied into a {@link String}.
+ * The text is written once per log file and referenced by its id.
+ * @param logLevel log level for the message
+ * @param locationId id of the source location
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message constant message text
+ */
+void NL::Logger::log(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const __FlashStringHelper *message)
+{
+	const char *text = reinterpret_cast<const char *>(message);
+	NL::Logger::logMessage(logLevel, locationId, file, function, line, text, strlen(text), true);
 }
 
 /**
@@ -240,113 +251,619 @@ void NL::Logger::clearLog()
 		return;
 	}
 
-	if (!logToFile)
+	if (!logToFile || NL::Logger::fileMutex == NULL)
 	{
 		return;
 	}
 
+	xSemaphoreTake(NL::Logger::fileMutex, portMAX_DELAY);
+	NL::Logger::flushWriteBuffer();
+	NL::Logger::logFile.close();
 	fileSystem->remove(fileName);
+	NL::Logger::openLog();
+	xSemaphoreGive(NL::Logger::fileMutex);
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Log file was cleared."));
 }
 
 /**
- * @brief Test if a file can be opened.
- * @return true when file can be opened
- * @return false when file can not be opened
+ * @brief Write all buffered messages to the log file right away.
+ * Should be called before the controller is restarted, so the last messages are not lost.
  */
-bool NL::Logger::testOpenFile(FS *fs, const String fn)
+void NL::Logger::flush()
 {
-	if (fs != nullptr)
+	if (!logToFile || NL::Logger::fileMutex == NULL)
+	{
+		return;
+	}
+
+	xSemaphoreTake(NL::Logger::fileMutex, portMAX_DELAY);
+	NL::Logger::writeRecords();
+	xSemaphoreGive(NL::Logger::fileMutex);
+}
+
+/**
+ * @brief Get the number of messages which were dropped because the ring buffer was full.
+ * @return number of dropped messages since the logger was started
+ */
+uint32_t NL::Logger::getDroppedMessageCount()
+{
+	return NL::Logger::droppedMessages.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the offset of the location record for a source location in the current log file.
+ * @param locationId id of the source location
+ * @param offset reference to the variable which will hold the offset
+ * @return true when the location was written to the current log file
+ * @return false when the location is unknown
+ */
+bool NL::Logger::getLocationOffset(const uint32_t locationId, uint32_t &offset)
+{
+	if (NL::Logger::fileMutex == NULL)
+	{
+		return false;
+	}
+
+	xSemaphoreTake(NL::Logger::fileMutex, portMAX_DELAY);
+	const std::unordered_map<uint32_t, uint32_t>::const_iterator location = NL::Logger::locationOffsets.find(locationId);
+	const bool found = location != NL::Logger::locationOffsets.end();
+	if (found)
+	{
+		offset = location->second;
+	}
+	xSemaphoreGive(NL::Logger::fileMutex);
+	return found;
+}
+
+/**
+ * @brief Get the offset of the text record for a constant message in the current log file.
+ * @param textId id of the text
+ * @param offset reference to the variable which will hold the offset
+ * @return true when the text was written to the current log file
+ * @return false when the text is unknown
+ */
+bool NL::Logger::getTextOffset(const uint32_t textId, uint32_t &offset)
+{
+	if (NL::Logger::fileMutex == NULL)
+	{
+		return false;
+	}
+
+	xSemaphoreTake(NL::Logger::fileMutex, portMAX_DELAY);
+	const std::unordered_map<uint32_t, uint32_t>::const_iterator text = NL::Logger::textOffsets.find(textId);
+	const bool found = text != NL::Logger::textOffsets.end();
+	if (found)
+	{
+		offset = text->second;
+	}
+	xSemaphoreGive(NL::Logger::fileMutex);
+	return found;
+}
+
+/**
+ * @brief Open the log file and start the background task which writes the buffered records.
+ * The log file is kept open while the logger is running.
+ * @return true when the writer was started
+ * @return false when the file could not be opened or the task could not be started
+ */
+bool NL::Logger::startWriter()
+{
+	if (NL::Logger::fileSystem == nullptr)
+	{
+		return false;
+	}
+
+	if (!NL::Logger::openLog())
+	{
+		return false;
+	}
+
+	NL::Logger::writeBuffer = (uint8_t *)malloc(LOG_WRITE_BUFFER_SIZE);
+	NL::Logger::writeBufferSize = 0;
+	NL::Logger::logBuffer = xRingbufferCreate(LOG_BUFFER_SIZE, RINGBUF_TYPE_NOSPLIT);
+	NL::Logger::fileMutex = xSemaphoreCreateMutex();
+	NL::Logger::writerStopped = xSemaphoreCreateBinary();
+	NL::Logger::droppedMessages = 0;
+	NL::Logger::reportedDroppedMessages = 0;
+	NL::Logger::writerRunning = true;
+	if (NL::Logger::writeBuffer == nullptr || NL::Logger::logBuffer == NULL || NL::Logger::fileMutex == NULL || NL::Logger::writerStopped == NULL || xTaskCreatePinnedToCore(NL::Logger::writerTask, "LogWriterTask", LOG_TASK_STACK_SIZE, NULL, LOG_TASK_PRIORITY, &NL::Logger::writerTaskHandle, LOG_TASK_CORE) != pdPASS)
+	{
+		NL::Logger::writerRunning = false;
+		NL::Logger::writerTaskHandle = NULL;
+		NL::Logger::stopWriter();
+		return false;
+	}
+
+	NL::Logger::bufferOpen = true;
+	return true;
+}
+
+/**
+ * @brief Stop adding records to the ring buffer, stop the background task, write the remaining messages and close the log file.
+ * The ring buffer is only deleted after all tasks which were adding a record are done.
+ */
+void NL::Logger::stopWriter()
+{
+	// Wait for the tasks which are adding a record right now, no new records are added afterwards
+	NL::Logger::bufferOpen = false;
+	while (NL::Logger::bufferUsers.load() > 0)
+	{
+		vTaskDelay(1);
+	}
+
+	if (NL::Logger::writerTaskHandle != NULL)
+	{
+		NL::Logger::writerRunning = false;
+		xSemaphoreTake(NL::Logger::writerStopped, portMAX_DELAY);
+		NL::Logger::writerTaskHandle = NULL;
+	}
+
+	RingbufHandle_t logBuffer = NL::Logger::logBuffer;
+	NL::Logger::logBuffer = NULL;
+	if (logBuffer != NULL)
+	{
+		vRingbufferDelete(logBuffer);
+	}
+	if (NL::Logger::fileMutex != NULL)
+	{
+		vSemaphoreDelete(NL::Logger::fileMutex);
+		NL::Logger::fileMutex = NULL;
+	}
+	if (NL::Logger::writerStopped != NULL)
+	{
+		vSemaphoreDelete(NL::Logger::writerStopped);
+		NL::Logger::writerStopped = NULL;
+	}
+	if (NL::Logger::writeBuffer != nullptr)
+	{
+		free(NL::Logger::writeBuffer);
+		NL::Logger::writeBuffer = nullptr;
+	}
+	NL::Logger::writeBufferSize = 0;
+	NL::Logger::locationOffsets.clear();
+	NL::Logger::textOffsets.clear();
+	NL::Logger::logFile.close();
+}
+
+/**
+ * @brief Entry point of the writer task.
+ * The buffered records are written in large batches every {@link LOG_FLUSH_INTERVAL} ms.
+ * @param parameter unused
+ */
+void NL::Logger::writerTask(void *parameter)
+{
+	(void)parameter;
+	while (NL::Logger::writerRunning.load(std::memory_order_acquire))
+	{
+		vTaskDelay(pdMS_TO_TICKS(LOG_FLUSH_INTERVAL));
+		xSemaphoreTake(NL::Logger::fileMutex, portMAX_DELAY);
+		NL::Logger::writeRecords();
+		xSemaphoreGive(NL::Logger::fileMutex);
+	}
+
+	xSemaphoreTake(NL::Logger::fileMutex, portMAX_DELAY);
+	NL::Logger::writeRecords();
+	xSemaphoreGive(NL::Logger::fileMutex);
+	xSemaphoreGive(NL::Logger::writerStopped);
+	vTaskDelete(NULL);
+}
+
+/**
+ * @brief Log a message. Mirrors the message to the serial interface and puts it as binary record into the ring buffer.
+ * This never blocks the caller. When the ring buffer is full, the message is dropped and counted.
+ * @param logLevel log level for the message
+ * @param locationId id of the source location
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message message text
+ * @param messageLength length of the message, longer than {@link LOG_MAX_MESSAGE_LENGTH} is cut off
+ * @param constant true when the message is constant, it is then referenced instead of copied
+ */
+void NL::Logger::logMessage(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const char *message, size_t messageLength, const bool constant)
+{
+	if (!NL::Logger::initialized)
+	{
+		return;
+	}
+
+	if (logLevel < minLogLevel)
+	{
+		return;
+	}
+
+	if (messageLength > LOG_MAX_MESSAGE_LENGTH)
 	{
-		File logFile = fs->open(fn, FILE_APPEND);
-		if (logFile)
+		messageLength = LOG_MAX_MESSAGE_LENGTH;
+	}
+	const uint32_t time = millis();
+
+	if (logToSerial)
+	{
+		char logLine[LOG_MAX_LINE_LENGTH];
+		const size_t length = NL::Logger::formatLine(logLine, sizeof(logLine), logLevel, time, file, function, line, message, messageLength);
+		Serial.write((uint8_t *)logLine, length);
+	}
+
+	// The ring buffer is only deleted when no task is using it and the buffer is closed
+	NL::Logger::bufferUsers.fetch_add(1);
+	if (logToFile && NL::Logger::bufferOpen.load())
+	{
+		void *item = nullptr;
+		if (xRingbufferSendAcquire(NL::Logger::logBuffer, &item, sizeof(NL::Logger::Record) + (constant ? 0 : messageLength), 0) != pdTRUE)
 		{
-			logFile.close();
-			return true;
+			NL::Logger::droppedMessages.fetch_add(1, std::memory_order_relaxed);
+			NL::Logger::bufferUsers.fetch_sub(1);
+			return;
 		}
+
+		NL::Logger::Record *record = static_cast<NL::Logger::Record *>(item);
+		record->time = time;
+		record->locationId = locationId;
+		record->file = file;
+		record->function = function;
+		record->line = line;
+		record->logLevel = static_cast<uint8_t>(logLevel);
+		record->length = messageLength;
+		record->text = constant ? message : nullptr;
+		if (!constant)
+		{
+			memcpy(record + 1, message, messageLength);
+		}
+		xRingbufferSendComplete(NL::Logger::logBuffer, item);
+	}
+	NL::Logger::bufferUsers.fetch_sub(1);
+}
+
+/**
+ * @brief Write all records from the ring buffer to the log file and rotate it when it became too large.
+ * Dropped messages are reported in the log file. Must be called while holding the file mutex.
+ */
+void NL::Logger::writeRecords()
+{
+	RingbufHandle_t logBuffer = NL::Logger::logBuffer;
+	if (logBuffer == NULL || NL::Logger::writeBuffer == nullptr)
+	{
+		return;
 	}
 
-	return false;
+	bool written = false;
+	size_t size = 0;
+	NL::Logger::Record *record = static_cast<NL::Logger::Record *>(xRingbufferReceive(logBuffer, &size, 0));
+	while (record != nullptr)
+	{
+		const bool constant = record->text != nullptr;
+		NL::Logger::writeRecord(static_cast<NL::Logger::LogLevel>(record->logLevel), record->time, record->locationId, record->file, record->function, record->line, constant ? record->text : (const char *)(record + 1), record->length, constant);
+		vRingbufferReturnItem(logBuffer, record);
+		written = true;
+		record = static_cast<NL::Logger::Record *>(xRingbufferReceive(logBuffer, &size, 0));
+	}
+
+	const uint32_t droppedMessages = NL::Logger::droppedMessages.load(std::memory_order_relaxed);
+	if (droppedMessages != NL::Logger::reportedDroppedMessages)
+	{
+		char message[64];
+		const int length = snprintf(message, sizeof(message), "%u log messages were dropped.", static_cast<unsigned int>(droppedMessages - NL::Logger::reportedDroppedMessages));
+		NL::Logger::writeRecord(NL::Logger::LogLevel::WARN, millis(), SOURCE_LOCATION, message, length, false);
+		NL::Logger::reportedDroppedMessages = droppedMessages;
+		written = true;
+	}
+
+	if (written)
+	{
+		NL::Logger::flushWriteBuffer();
+		NL::Logger::logFile.flush();
+		if (NL::Logger::fileSize > LOG_MAX_FILE_SIZE)
+		{
+			NL::Logger::rotateLog();
+		}
+	}
 }
 
 /**
- * @brief Get the {@link String} representation of the {@link NL::Logger::LogLevel}.
- * @param logLevel log level
- * @return {@link String} representation of the {@link NL::Logger::LogLevel}
+ * @brief Encode a message into the write buffer.
+ * The source location and the text of a constant message are written once per log file, before the first message referencing them.
+ * @param logLevel log level for the message
+ * @param time time in ms since the start of the controller
+ * @param locationId id of the source location
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message message text
+ * @param messageLength length of the message
+ * @param constant true when the message is constant and is referenced by its text id
  */
-String NL::Logger::getLogLevelString(const NL::Logger::LogLevel logLevel)
+void NL::Logger::writeRecord(const NL::Logger::LogLevel logLevel, const uint32_t time, const uint32_t locationId, const char *file, const char *function, const int line, const char *message, const size_t messageLength, const bool constant)
 {
-	if (logLevel == NL::Logger::LogLevel::DEBUG)
+	if (NL::Logger::locationOffsets.find(locationId) == NL::Logger::locationOffsets.end())
 	{
-		return F("DEBUG");
+		const uint8_t fileLength = std::min<size_t>(strlen(file), UINT8_MAX);
+		const uint8_t functionLength = std::min<size_t>(strlen(function), UINT8_MAX);
+		const uint8_t locationHeader[] = {
+			static_cast<uint8_t>(NL::Logger::RecordType::LOCATION),
+			static_cast<uint8_t>(locationId),
+			static_cast<uint8_t>(locationId >> 8),
+			static_cast<uint8_t>(locationId >> 16),
+			static_cast<uint8_t>(locationId >> 24),
+			static_cast<uint8_t>(line),
+			static_cast<uint8_t>(line >> 8),
+			fileLength};
+
+		NL::Logger::locationOffsets[locationId] = NL::Logger::fileSize + NL::Logger::writeBufferSize;
+		NL::Logger::appendWriteBuffer(locationHeader, sizeof(locationHeader));
+		NL::Logger::appendWriteBuffer(file, fileLength);
+		NL::Logger::appendWriteBuffer(&functionLength, sizeof(functionLength));
+		NL::Logger::appendWriteBuffer(function, functionLength);
 	}
-	else if (logLevel == NL::Logger::LogLevel::INFO)
+
+	if (constant)
 	{
-		return F("INFO");
+		const uint32_t textId = NL::Logger::getTextId(message, messageLength);
+		if (NL::Logger::textOffsets.find(textId) == NL::Logger::textOffsets.end())
+		{
+			const uint8_t textHeader[] = {
+				static_cast<uint8_t>(NL::Logger::RecordType::TEXT),
+				static_cast<uint8_t>(textId),
+				static_cast<uint8_t>(textId >> 8),
+				static_cast<uint8_t>(textId >> 16),
+				static_cast<uint8_t>(textId >> 24),
+				static_cast<uint8_t>(messageLength),
+				static_cast<uint8_t>(messageLength >> 8)};
+
+			NL::Logger::textOffsets[textId] = NL::Logger::fileSize + NL::Logger::writeBufferSize;
+			NL::Logger::appendWriteBuffer(textHeader, sizeof(textHeader));
+			NL::Logger::appendWriteBuffer(message, messageLength);
+		}
+
+		const uint8_t constantHeader[] = {
+			static_cast<uint8_t>(static_cast<uint8_t>(NL::Logger::RecordType::CONSTANT_MESSAGE) | static_cast<uint8_t>(logLevel)),
+			static_cast<uint8_t>(time),
+			static_cast<uint8_t>(time >> 8),
+			static_cast<uint8_t>(time >> 16),
+			static_cast<uint8_t>(time >> 24),
+			static_cast<uint8_t>(locationId),
+			static_cast<uint8_t>(locationId >> 8),
+			static_cast<uint8_t>(locationId >> 16),
+			static_cast<uint8_t>(locationId >> 24),
+			static_cast<uint8_t>(textId),
+			static_cast<uint8_t>(textId >> 8),
+			static_cast<uint8_t>(textId >> 16),
+			static_cast<uint8_t>(textId >> 24)};
+		NL::Logger::appendWriteBuffer(constantHeader, sizeof(constantHeader));
+		return;
 	}
-	else if (logLevel == NL::Logger::LogLevel::WARN)
+
+	const uint8_t messageHeader[] = {
+		static_cast<uint8_t>(static_cast<uint8_t>(NL::Logger::RecordType::MESSAGE) | static_cast<uint8_t>(logLevel)),
+		static_cast<uint8_t>(time),
+		static_cast<uint8_t>(time >> 8),
+		static_cast<uint8_t>(time >> 16),
+		static_cast<uint8_t>(time >> 24),
+		static_cast<uint8_t>(locationId),
+		static_cast<uint8_t>(locationId >> 8),
+		static_cast<uint8_t>(locationId >> 16),
+		static_cast<uint8_t>(locationId >> 24),
+		static_cast<uint8_t>(messageLength),
+		static_cast<uint8_t>(messageLength >> 8)};
+	NL::Logger::appendWriteBuffer(messageHeader, sizeof(messageHeader));
+	NL::Logger::appendWriteBuffer(message, messageLength);
+}
+
+/**
+ * @brief Get the id of a constant message text as FNV-1a hash of its content.
+ * The id does not depend on the address of the text, so it is stable across firmware updates.
+ * @param text message text, does not need to be null terminated
+ * @param length length of the text
+ * @return id of the text
+ */
+uint32_t NL::Logger::getTextId(const char *text, const size_t length)
+{
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < length; i++)
 	{
-		return F("WARN");
+		hash = (hash ^ static_cast<uint8_t>(text[i])) * 16777619u;
 	}
-	else if (logLevel == NL::Logger::LogLevel::ERROR)
+	return hash;
+}
+
+/**
+ * @brief Append data to the write buffer. The buffer is written to the log file when it is full.
+ * @param data data to append
+ * @param size size of the data, must not be larger than {@link LOG_WRITE_BUFFER_SIZE}
+ */
+void NL::Logger::appendWriteBuffer(const void *data, const size_t size)
+{
+	if (NL::Logger::writeBufferSize + size > LOG_WRITE_BUFFER_SIZE)
 	{
-		return F("ERROR");
+		NL::Logger::flushWriteBuffer();
 	}
 
-	return F("UNKNOWN");
+	memcpy(NL::Logger::writeBuffer + NL::Logger::writeBufferSize, data, size);
+	NL::Logger::writeBufferSize += size;
 }
 
 /**
- * @brief Get a formatted time {@link String} based on the system time.
- * @return {@link String} representation of the system time
+ * @brief Write the write buffer to the log file in a single append.
  */
-String NL::Logger::getTimeString()
+void NL::Logger::flushWriteBuffer()
 {
-	unsigned long milli = millis();
-	const unsigned long hour = milli / 3600000;
-	milli = milli - 3600000 * hour;
-	const unsigned long min = milli / 60000;
-	milli = milli - 60000 * min;
-	const unsigned long sec = milli / 1000;
-	milli = milli - 1000 * sec;
+	if (NL::Logger::writeBufferSize == 0)
+	{
+		return;
+	}
 
-	String timeString = String();
-	if (hour < 10)
+	NL::Logger::logFile.write(NL::Logger::writeBuffer, NL::Logger::writeBufferSize);
+	NL::Logger::fileSize += NL::Logger::writeBufferSize;
+	NL::Logger::writeBufferSize = 0;
+}
+
+/**
+ * @brief Open the log file for appending. A new file starts with the file header.
+ * An existing file is scanned for the location and text records, so they are not written again.
+ * A file with an unknown format is deleted and a file with a broken record is rotated.
+ * @return true when the log file was opened
+ * @return false when the log file could not be opened
+ */
+bool NL::Logger::openLog()
+{
+	NL::Logger::locationOffsets.clear();
+	NL::Logger::textOffsets.clear();
+	NL::Logger::fileSize = 0;
+
+	bool valid = true;
+	File file = NL::Logger::fileSystem->open(NL::Logger::fileName, FILE_READ);
+	if (file && !file.isDirectory() && file.size() > 0)
 	{
-		timeString = timeString + F("0") + hour + F(":");
+		uint8_t header[5];
+		if (file.read(header, sizeof(header)) != sizeof(header) || memcmp(header, "NLLG", 4) != 0 || header[4] != LOG_FILE_VERSION)
+		{
+			file.close();
+			NL::Logger::fileSystem->remove(NL::Logger::fileName);
+		}
+		else
+		{
+			uint32_t position = sizeof(header);
+			const uint32_t size = file.size();
+			while (valid && position < size)
+			{
+				uint8_t recordHeader[13];
+				if (file.read(recordHeader, 1) != 1)
+				{
+					valid = false;
+				}
+				else if (recordHeader[0] == static_cast<uint8_t>(NL::Logger::RecordType::LOCATION) && file.read(recordHeader + 1, 7) == 7)
+				{
+					const uint32_t locationId = recordHeader[1] | recordHeader[2] << 8 | recordHeader[3] << 16 | static_cast<uint32_t>(recordHeader[4]) << 24;
+					uint8_t functionLength = 0;
+					valid = file.seek(position + 8 + recordHeader[7]) && file.read(&functionLength, 1) == 1;
+					NL::Logger::locationOffsets[locationId] = position;
+					position += 9 + recordHeader[7] + functionLength;
+				}
+				else if (recordHeader[0] == static_cast<uint8_t>(NL::Logger::RecordType::TEXT) && file.read(recordHeader + 1, 6) == 6)
+				{
+					const uint32_t textId = recordHeader[1] | recordHeader[2] << 8 | recordHeader[3] << 16 | static_cast<uint32_t>(recordHeader[4]) << 24;
+					NL::Logger::textOffsets[textId] = position;
+					position += 7 + (recordHeader[5] | recordHeader[6] << 8);
+				}
+				else if ((recordHeader[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::MESSAGE) && file.read(recordHeader + 1, 10) == 10)
+				{
+					position += 11 + (recordHeader[9] | recordHeader[10] << 8);
+				}
+				else if ((recordHeader[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::CONSTANT_MESSAGE) && file.read(recordHeader + 1, 12) == 12)
+				{
+					position += 13;
+				}
+				else
+				{
+					valid = false;
+				}
+				valid = valid && position <= size && file.seek(position);
+			}
+			file.close();
+		}
 	}
 	else
 	{
-		timeString = timeString + hour + F(":");
+		file.close();
 	}
-	if (min < 10)
+
+	if (!valid)
 	{
-		timeString = timeString + F("0") + min + F(":");
+		NL::Logger::locationOffsets.clear();
+		NL::Logger::textOffsets.clear();
+		NL::Logger::fileSystem->remove(LOG_ROTATED_FILE_NAME);
+		NL::Logger::fileSystem->rename(NL::Logger::fileName, LOG_ROTATED_FILE_NAME);
 	}
-	else
+
+	NL::Logger::logFile = NL::Logger::fileSystem->open(NL::Logger::fileName, FILE_APPEND);
+	if (!NL::Logger::logFile || NL::Logger::logFile.isDirectory())
 	{
-		timeString = timeString + min + F(":");
+		NL::Logger::logFile.close();
+		return false;
 	}
-	if (sec < 10)
+
+	NL::Logger::fileSize = NL::Logger::logFile.size();
+	if (NL::Logger::fileSize == 0)
 	{
-		timeString = timeString + F("0") + sec + F(":");
+		const uint8_t header[] = {'N', 'L', 'L', 'G', LOG_FILE_VERSION};
+		NL::Logger::fileSize = NL::Logger::logFile.write(header, sizeof(header));
 	}
-	else
+
+	return NL::Logger::fileSize > 0;
+}
+
+/**
+ * @brief Move the log file to {@link LOG_ROTATED_FILE_NAME} and start a new one. The previous rotated file is deleted.
+ */
+void NL::Logger::rotateLog()
+{
+	NL::Logger::logFile.close();
+	NL::Logger::fileSystem->remove(LOG_ROTATED_FILE_NAME);
+	NL::Logger::fileSystem->rename(NL::Logger::fileName, LOG_ROTATED_FILE_NAME);
+	NL::Logger::openLog();
+}
+
+/**
+ * @brief Format a message as text line. Lines which do not fit into the buffer are cut off.
+ * @param buffer buffer for the log line
+ * @param bufferSize size of the buffer
+ * @param logLevel log level for the message
+ * @param time time in ms since the start of the controller
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message message text, does not need to be null terminated
+ * @param messageLength length of the message
+ * @return length of the log line without the terminating null
+ */
+size_t NL::Logger::formatLine(char *buffer, const size_t bufferSize, const NL::Logger::LogLevel logLevel, const uint32_t time, const char *file, const char *function, const int line, const char *message, const size_t messageLength)
+{
+	unsigned long milli = time;
+	const unsigned long hour = milli / 3600000;
+	milli = milli - 3600000 * hour;
+	const unsigned long min = milli / 60000;
+	milli = milli - 60000 * min;
+	const unsigned long sec = milli / 1000;
+	milli = milli - 1000 * sec;
+
+	const int length = snprintf(buffer, bufferSize, "%02lu:%02lu:%02lu:%03lu [%s] (%s) (%s) (%d): %.*s\r\n", hour, min, sec, milli, NL::Logger::getLogLevelString(logLevel), file, function, line, static_cast<int>(messageLength), message);
+	if (length < 0)
+	{
+		return 0;
+	}
+	else if (static_cast<size_t>(length) >= bufferSize)
 	{
-		timeString = timeString + sec + F(":");
+		buffer[bufferSize - 3] = '\r';
+		buffer[bufferSize - 2] = '\n';
+		return bufferSize - 1;
 	}
-	if (milli < 10)
+
+	return length;
+}
+
+/**
+ * @brief Get the string representation of the {@link NL::Logger::LogLevel}.
+ * @param logLevel log level
+ * @return string representation of the {@link NL::Logger::LogLevel}
+ */
+const char *NL::Logger::getLogLevelString(const NL::Logger::LogLevel logLevel)
+{
+	if (logLevel == NL::Logger::LogLevel::DEBUG)
 	{
-		timeString = timeString + F("00") + milli;
+		return "DEBUG";
 	}
-	else if (milli < 100)
+	else if (logLevel == NL::Logger::LogLevel::INFO)
 	{
-		timeString = timeString = timeString + F("0") + milli;
+		return "INFO";
 	}
-	else
+	else if (logLevel == NL::Logger::LogLevel::WARN)
 	{
-		timeString = timeString + milli;
+		return "WARN";
+	}
+	else if (logLevel == NL::Logger::LogLevel::ERROR)
+	{
+		return "ERROR";
 	}
 
-	return timeString;
-}
\ No newline at end of file
+	return "UNKNOWN";
+}
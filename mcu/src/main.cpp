@@ -30,9 +30,9 @@ void setup()
 }
 
 /**
- * @brief Main loop runs as long as the controller is active.
+ * @brief The main loop is not used, the work is done by the render and system task.
  */
 void loop()
 {
-	NikoLight::run();
+	vTaskDelete(NULL);
 }
\ No newline at end of file
@@ -25,6 +25,7 @@ bool NL::LightSensor::initialized = false;
 float NL::LightSensor::lastBrightnessValue;
 NL::MotionSensor::MotionSensorData NL::LightSensor::motionData;
 unsigned long NL::LightSensor::motionSensorTriggerTime;
+NL::Configuration::RuntimeConfig NL::LightSensor::runtimeConfig;
 
 /**
  * @brief Start the light sensor.
@@ -111,15 +112,20 @@ NL::LightSensor::Error NL::LightSensor::getBrightness(float &brightness)
  */
 NL::LightSensor::Error NL::LightSensor::getBrightnessInt(float &brightness)
 {
-	const NL::Configuration::SystemConfig systemConfig = NL::Configuration::getSystemConfig();
+	if (NL::LightSensor::runtimeConfig.generation != NL::Configuration::getRuntimeGeneration())
+	{
+		NL::Configuration::getRuntimeConfig(NL::LightSensor::runtimeConfig);
+	}
+
+	const NL::Configuration::RuntimeConfig &config = NL::LightSensor::runtimeConfig;
 	const float antiFlickerThreshold = 0.002f;
-	const NL::LightSensor::LightSensorMode lightSensorMode = (NL::LightSensor::LightSensorMode)systemConfig.lightSensorMode;
-	const float threshold = systemConfig.lightSensorThreshold / 255.0f;
-	const float minAmbientBrightness = systemConfig.lightSensorMinAmbientBrightness / 255.0f;
-	const float maxAmbientBrightness = systemConfig.lightSensorMaxAmbientBrightness / 255.0f;
-	const float minLedBrightness = systemConfig.lightSensorMinLedBrightness / 255.0f;
-	const float maxLedBrightness = systemConfig.lightSensorMaxLedBrightness / 255.0f;
-	const uint8_t duration = systemConfig.lightSensorDuration;
+	const NL::LightSensor::LightSensorMode lightSensorMode = (NL::LightSensor::LightSensorMode)config.lightSensorMode;
+	const float threshold = config.lightSensorThreshold;
+	const float minAmbientBrightness = config.lightSensorMinAmbientBrightness;
+	const float maxAmbientBrightness = config.lightSensorMaxAmbientBrightness;
+	const float minLedBrightness = config.lightSensorMinLedBrightness;
+	const float maxLedBrightness = config.lightSensorMaxLedBrightness;
+	const uint32_t duration = config.lightSensorDuration;
 
 	// Always off
 	if (lightSensorMode == NL::LightSensor::LightSensorMode::ALWAYS_OFF)
@@ -220,7 +226,10 @@ NL::LightSensor::Error NL::LightSensor::getBrightnessInt(float &brightness)
 		}
 
 		float lux = 0.0f;
-		if (NL::BH1750::getLux(lux) != NL::BH1750::Error::OK)
+		const uint32_t profilerStart = NL::Profiler::start();
+		const NL::BH1750::Error bh1750Error = NL::BH1750::getLux(lux);
+		NL::Profiler::record(NL::Profiler::Stage::BH1750, profilerStart);
+		if (bh1750Error != NL::BH1750::Error::OK)
 		{
 			brightness = 0.0f;
 			return NL::LightSensor::Error::ERROR_BH1750_UNAVAILABLE;
@@ -254,7 +263,10 @@ NL::LightSensor::Error NL::LightSensor::getBrightnessInt(float &brightness)
 		}
 
 		float lux = 0.0f;
-		if (NL::BH1750::getLux(lux) != NL::BH1750::Error::OK)
+		const uint32_t profilerStart = NL::Profiler::start();
+		const NL::BH1750::Error bh1750Error = NL::BH1750::getLux(lux);
+		NL::Profiler::record(NL::Profiler::Stage::BH1750, profilerStart);
+		if (bh1750Error != NL::BH1750::Error::OK)
 		{
 			brightness = 0.0f;
 			return NL::LightSensor::Error::ERROR_BH1750_UNAVAILABLE;
@@ -316,7 +328,7 @@ NL::LightSensor::Error NL::LightSensor::getBrightnessInt(float &brightness)
 			brightness = 1.0f;
 			NL::LightSensor::motionSensorTriggerTime = millis();
 		}
-		else if (millis() - NL::LightSensor::motionSensorTriggerTime > duration * 5000L)
+		else if (millis() - NL::LightSensor::motionSensorTriggerTime > duration)
 		{
 			brightness = 0.0f;
 		}
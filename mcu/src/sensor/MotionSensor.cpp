@@ -24,6 +24,7 @@
 bool NL::MotionSensor::initialized = false;
 NL::MotionSensor::MotionSensorData NL::MotionSensor::motionData;
 unsigned long NL::MotionSensor::lastMeasure;
+NL::Configuration::RuntimeConfig NL::MotionSensor::runtimeConfig;
 
 /**
  * @brief Initialize the motion sensor and set the scales.
@@ -105,12 +106,20 @@ bool NL::MotionSensor::isInitialized()
 NL::MotionSensor::Error NL::MotionSensor::run()
 {
 	NL::MPU6050::MPU6050MotionData sensorData;
-	if (NL::MPU6050::getData(sensorData) != NL::MPU6050::Error::OK)
+	const uint32_t profilerStart = NL::Profiler::start();
+	const NL::MPU6050::Error mpuError = NL::MPU6050::getData(sensorData);
+	NL::Profiler::record(NL::Profiler::Stage::MPU6050, profilerStart);
+	if (mpuError != NL::MPU6050::Error::OK)
 	{
 		return NL::MotionSensor::Error::ERROR_MPU6050_UNAVIALBLE;
 	}
 
-	const NL::Configuration::MotionSensorCalibration calibrationData = NL::Configuration::getMotionSensorCalibration();
+	if (NL::MotionSensor::runtimeConfig.generation != NL::Configuration::getRuntimeGeneration())
+	{
+		NL::Configuration::getRuntimeConfig(NL::MotionSensor::runtimeConfig);
+	}
+
+	const NL::Configuration::MotionSensorCalibration &calibrationData = NL::MotionSensor::runtimeConfig.motionSensorCalibration;
 	const unsigned long timeStep = NL::MotionSensor::lastMeasure == 0 ? 0.0f : (micros() - NL::MotionSensor::lastMeasure);
 	const float timeScale = timeStep / 1000000.0f;
 	NL::MotionSensor::lastMeasure = micros();
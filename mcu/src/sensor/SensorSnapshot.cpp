@@ -0,0 +1,146 @@
+/**
+ * @file SensorSnapshot.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NL::SensorSnapshot}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "sensor/SensorSnapshot.h"
+
+bool NL::SensorSnapshot::initialized = false;
+NL::SensorSnapshot::SensorData NL::SensorSnapshot::writeData;
+NL::SensorSnapshot::SensorData NL::SensorSnapshot::slot[3];
+uint8_t NL::SensorSnapshot::writeSlot = 0;
+uint8_t NL::SensorSnapshot::readSlot = 1;
+std::atomic<uint8_t> NL::SensorSnapshot::pendingSlot(2);
+
+/**
+ * @brief Start the sensor snapshot with default values.
+ * The snapshot is a triple buffer. The writer and reader each own one slot and exchange it
+ * with the pending slot, so neither side has to wait for the other. A fetched snapshot is
+ * immutable until the next fetch, so readers can keep a reference to it without copying.
+ */
+void NL::SensorSnapshot::begin()
+{
+	NL::SensorSnapshot::writeData.seq = 0;
+	NL::SensorSnapshot::writeData.ambientBrightness = 1.0f;
+	NL::SensorSnapshot::writeData.regulatorTemperature = 0.0f;
+	NL::SensorSnapshot::writeData.motionSensorData = NL::MotionSensor::MotionSensorData();
+	NL::SensorSnapshot::writeData.audioAnalysis = NL::AudioUnit::AudioAnalysis();
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		NL::SensorSnapshot::slot[i] = NL::SensorSnapshot::writeData;
+	}
+	NL::SensorSnapshot::writeSlot = 0;
+	NL::SensorSnapshot::readSlot = 1;
+	NL::SensorSnapshot::pendingSlot.store(2 | NL::SensorSnapshot::SLOT_NEW_DATA);
+	NL::SensorSnapshot::initialized = true;
+}
+
+/**
+ * @brief Stop the sensor snapshot.
+ */
+void NL::SensorSnapshot::end()
+{
+	NL::SensorSnapshot::initialized = false;
+}
+
+/**
+ * @brief Check if the sensor snapshot is initialized.
+ * @return true when initialized
+ * @return false when not initialized
+ */
+bool NL::SensorSnapshot::isInitialized()
+{
+	return NL::SensorSnapshot::initialized;
+}
+
+/**
+ * @brief Publish a new ambient brightness. Must only be called by the writing task.
+ * @param ambientBrightness ambient brightness from 0.0 to 1.0
+ */
+void NL::SensorSnapshot::setAmbientBrightness(const float ambientBrightness)
+{
+	NL::SensorSnapshot::writeData.ambientBrightness = ambientBrightness;
+	NL::SensorSnapshot::publish();
+}
+
+/**
+ * @brief Publish a new regulator temperature. Must only be called by the writing task.
+ * @param regulatorTemperature regulator temperature in °C
+ */
+void NL::SensorSnapshot::setRegulatorTemperature(const float regulatorTemperature)
+{
+	NL::SensorSnapshot::writeData.regulatorTemperature = regulatorTemperature;
+	NL::SensorSnapshot::publish();
+}
+
+/**
+ * @brief Publish new motion sensor data. Must only be called by the writing task.
+ * @param motionSensorData motion sensor data
+ */
+void NL::SensorSnapshot::setMotionSensorData(const NL::MotionSensor::MotionSensorData &motionSensorData)
+{
+	NL::SensorSnapshot::writeData.motionSensorData = motionSensorData;
+	NL::SensorSnapshot::publish();
+}
+
+/**
+ * @brief Publish a new audio analysis. Must only be called by the writing task.
+ * @param audioAnalysis audio analysis data
+ */
+void NL::SensorSnapshot::setAudioAnalysis(const NL::AudioUnit::AudioAnalysis &audioAnalysis)
+{
+	NL::SensorSnapshot::writeData.audioAnalysis = audioAnalysis;
+	NL::SensorSnapshot::publish();
+}
+
+/**
+ * @brief Fetch the latest published sensor data. Must only be called by the reading task.
+ * @return true when new data was fetched
+ * @return false when there was no new data since the last fetch
+ */
+bool NL::SensorSnapshot::fetch()
+{
+	if (!(NL::SensorSnapshot::pendingSlot.load(std::memory_order_relaxed) & NL::SensorSnapshot::SLOT_NEW_DATA))
+	{
+		return false;
+	}
+
+	NL::SensorSnapshot::readSlot = NL::SensorSnapshot::pendingSlot.exchange(NL::SensorSnapshot::readSlot, std::memory_order_acq_rel) & NL::SensorSnapshot::SLOT_MASK;
+	return true;
+}
+
+/**
+ * @brief Get the sensor data fetched by the last call to {@link NL::SensorSnapshot::fetch}.
+ * Must only be called by the reading task. The data will not change until the next fetch.
+ * @return reference to the sensor data
+ */
+const NL::SensorSnapshot::SensorData &NL::SensorSnapshot::getSensorData()
+{
+	return NL::SensorSnapshot::slot[NL::SensorSnapshot::readSlot];
+}
+
+/**
+ * @brief Copy the working data into the writer slot and exchange it with the pending slot.
+ */
+void NL::SensorSnapshot::publish()
+{
+	NL::SensorSnapshot::writeData.seq++;
+	NL::SensorSnapshot::slot[NL::SensorSnapshot::writeSlot] = NL::SensorSnapshot::writeData;
+	NL::SensorSnapshot::writeSlot = NL::SensorSnapshot::pendingSlot.exchange(NL::SensorSnapshot::writeSlot | NL::SensorSnapshot::SLOT_NEW_DATA, std::memory_order_acq_rel) & NL::SensorSnapshot::SLOT_MASK;
+}
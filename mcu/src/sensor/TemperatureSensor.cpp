@@ -107,7 +107,10 @@ NL::TemperatureSensor::Error NL::TemperatureSensor::getMinTemperature(float &tem
 	for (size_t i = 0; i < NL::DS18B20::getNumSensors(); i++)
 	{
 		float currentTemp;
-		if (NL::DS18B20::getTemperature(currentTemp, i) != NL::DS18B20::Error::OK)
+		const uint32_t profilerStart = NL::Profiler::start();
+		const NL::DS18B20::Error ds18b20Error = NL::DS18B20::getTemperature(currentTemp, i);
+		NL::Profiler::record(NL::Profiler::Stage::DS18B20, profilerStart);
+		if (ds18b20Error != NL::DS18B20::Error::OK)
 		{
 			return NL::TemperatureSensor::Error::ERROR_DS18B20_UNAVAILABLE;
 		}
@@ -153,7 +156,10 @@ NL::TemperatureSensor::Error NL::TemperatureSensor::getMaxTemperature(float &tem
 	for (size_t i = 0; i < NL::DS18B20::getNumSensors(); i++)
 	{
 		float currentTemp = 0.0f;
-		if (NL::DS18B20::getTemperature(currentTemp, i) != NL::DS18B20::Error::OK)
+		const uint32_t profilerStart = NL::Profiler::start();
+		const NL::DS18B20::Error ds18b20Error = NL::DS18B20::getTemperature(currentTemp, i);
+		NL::Profiler::record(NL::Profiler::Stage::DS18B20, profilerStart);
+		if (ds18b20Error != NL::DS18B20::Error::OK)
 		{
 			return NL::TemperatureSensor::Error::ERROR_DS18B20_UNAVAILABLE;
 		}
@@ -207,7 +213,10 @@ NL::TemperatureSensor::Error NL::TemperatureSensor::getAverageTemperature(float
 	for (size_t i = 0; i < NL::DS18B20::getNumSensors(); i++)
 	{
 		float currentTemp = 0.0f;
-		if (NL::DS18B20::getTemperature(currentTemp, i) != NL::DS18B20::Error::OK)
+		const uint32_t profilerStart = NL::Profiler::start();
+		const NL::DS18B20::Error ds18b20Error = NL::DS18B20::getTemperature(currentTemp, i);
+		NL::Profiler::record(NL::Profiler::Stage::DS18B20, profilerStart);
+		if (ds18b20Error != NL::DS18B20::Error::OK)
 		{
 			return NL::TemperatureSensor::Error::ERROR_DS18B20_UNAVAILABLE;
 		}
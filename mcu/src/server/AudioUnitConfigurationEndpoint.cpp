@@ -153,25 +153,7 @@ void NL::AudioUnitConfigurationEndpoint::patchAudioUnitConfig()
 	}
 
 	NL::Configuration::setAudioUnitConfig(config);
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save audio unit configuration. The configuration file could not be opened."));
-		NL::AudioUnitConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save audio unit configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save audio unit configuration. The configuration file could not be written."));
-		NL::AudioUnitConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save audio unit configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save audio unit configuration."));
-		NL::AudioUnitConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save audio unit configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	// Convert the configuration and apply it to the audio unit
 	NL::AudioUnit::AudioUnitConfig audioUnitConfig;
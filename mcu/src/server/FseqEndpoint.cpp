@@ -24,6 +24,7 @@
 // Initialize
 FS *NL::FseqEndpoint::fileSystem = nullptr;
 File NL::FseqEndpoint::uploadFile = File();
+std::unique_ptr<NL::FseqValidator> NL::FseqEndpoint::uploadValidator = nullptr;
 
 /**
  * @brief Add all request handler for this {@link NL::RestEndpoint} to the {@link NL::WebServerManager}.
@@ -36,6 +37,10 @@ void NL::FseqEndpoint::begin(FS *_fileSystem)
 	NL::WebServerManager::addRequestHandler((getBaseUri() + F("fseq")).c_str(), http_method::HTTP_GET, NL::FseqEndpoint::getFseqList);
 	NL::WebServerManager::addUploadRequestHandler((getBaseUri() + F("fseq")).c_str(), http_method::HTTP_POST, NL::FseqEndpoint::postFseq, NL::FseqEndpoint::fseqUpload);
 	NL::WebServerManager::addRequestHandler((getBaseUri() + F("fseq")).c_str(), http_method::HTTP_DELETE, NL::FseqEndpoint::deleteFseq);
+	NL::WebServerManager::addRequestHandler((getBaseUri() + F("fseq/position")).c_str(), http_method::HTTP_GET, NL::FseqEndpoint::getPosition);
+	NL::WebServerManager::addRequestHandler((getBaseUri() + F("fseq/position")).c_str(), http_method::HTTP_POST, NL::FseqEndpoint::postPosition);
+	NL::WebServerManager::addRequestHandler((getBaseUri() + F("fseq/playlist")).c_str(), http_method::HTTP_GET, NL::FseqEndpoint::getPlaylist);
+	NL::WebServerManager::addRequestHandler((getBaseUri() + F("fseq/playlist")).c_str(), http_method::HTTP_POST, NL::FseqEndpoint::postPlaylist);
 }
 
 /**
@@ -47,31 +52,17 @@ void NL::FseqEndpoint::getFseqList()
 	DynamicJsonDocument jsonDoc(4096);
 	const JsonArray fileList = jsonDoc.createNestedArray(F("fileList"));
 
-	if (!NL::FileUtil::listFiles(
-			fileSystem, FSEQ_DIRECTORY, [jsonDoc, fileList](const String fileName, const size_t fileSize)
-			{ 
-				if(!jsonDoc.overflowed()) 
-				{
-					JsonObject object = fileList.createNestedObject();
-					object[F("fileName")] = fileName;
-					object[F("fileSize")] = fileSize;
-
-					uint32_t fileId;
-					if(NL::FileUtil::getFileIdentifier(fileSystem, FSEQ_DIRECTORY + (String)F("/") + fileName, fileId))
-					{
-						object[F("fileId")] = fileId;
-					}
-					else 
-					{
-						NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to get file identifier."));	
-						object[F("fileId")] = 0;
-					}
-				} },
-			false))
-	{
-		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to list files."));
-		NL::FseqEndpoint::sendSimpleResponse(500, F("The file list could not be read."));
-		return;
+	// The list is served from the index, so no file has to be opened
+	const std::vector<NL::FseqIndex::Entry> &entries = NL::FseqIndex::getEntries();
+	for (size_t i = 0; i < entries.size() && !jsonDoc.overflowed(); i++)
+	{
+		JsonObject object = fileList.createNestedObject();
+		object[F("fileName")] = entries.at(i).fileName;
+		object[F("fileSize")] = entries.at(i).fileSize;
+		object[F("fileId")] = entries.at(i).identifier;
+		object[F("channelCount")] = entries.at(i).channelCount;
+		object[F("frameCount")] = entries.at(i).frameCount;
+		object[F("stepTime")] = entries.at(i).stepTime;
 	}
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
@@ -89,6 +80,8 @@ void NL::FseqEndpoint::postFseq()
 
 /**
  * @brief Upload a new fseq files to the controller.
+ * The file is validated while it is received, so invalid files are rejected with the first chunks. The checksum
+ * of the content is calculated on the fly and stored as file identifier.
  */
 void NL::FseqEndpoint::fseqUpload()
 {
@@ -124,9 +117,26 @@ void NL::FseqEndpoint::fseqUpload()
 			NL::FseqEndpoint::sendSimpleResponse(500, F("Failed to write to file for upload."));
 			return;
 		}
+
+		// The file can be played on all zones or only on some of them, so the channels of each zone are checked
+		std::vector<uint32_t> zoneChannelCounts;
+		for (size_t i = 0; i < LED_NUM_ZONES; i++)
+		{
+			NL::Configuration::LedConfig ledConfig;
+			NL::Configuration::getLedConfig(i, ledConfig);
+			zoneChannelCounts.push_back(ledConfig.ledCount * 3);
+		}
+		NL::FseqEndpoint::uploadValidator.reset(new NL::FseqValidator(zoneChannelCounts));
 	}
 	else if (upload.status == UPLOAD_FILE_WRITE && NL::FseqEndpoint::uploadFile)
 	{
+		const NL::FseqLoader::Error fseqError = NL::FseqEndpoint::uploadValidator->write(upload.buf, upload.currentSize);
+		if (fseqError != NL::FseqLoader::Error::OK)
+		{
+			NL::FseqEndpoint::rejectUpload(fileName, fseqError);
+			return;
+		}
+
 		if (NL::FseqEndpoint::uploadFile.write(upload.buf, upload.currentSize) != upload.currentSize)
 		{
 			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to write chunk to file. Not all bytes were written."));
@@ -134,52 +144,22 @@ void NL::FseqEndpoint::fseqUpload()
 			return;
 		}
 	}
-	else if (upload.status == UPLOAD_FILE_END)
+	else if (upload.status == UPLOAD_FILE_END && NL::FseqEndpoint::uploadFile)
 	{
-		NL::FseqEndpoint::uploadFile.close();
-		NL::FseqLoader::Error fseqError = NL::FseqEndpoint::validateFseqFile((String)FSEQ_DIRECTORY + F("/") + fileName);
-
-		if (fseqError == NL::FseqLoader::Error::ERROR_FILE_TOO_SMALL)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The uploaded fseq file is invalid because it is too small. File will be deleted."));
-			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
-			NL::FseqEndpoint::sendSimpleResponse(400, F("The uploaded fseq file is invalid because it is too small. File will be deleted."));
-			return;
-		}
-		else if (fseqError == NL::FseqLoader::Error::ERROR_MAGIC_NUMBERS)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The uploaded fseq file is not a valid fseq file. File will be deleted."));
-			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
-			NL::FseqEndpoint::sendSimpleResponse(400, F("The uploaded fseq file is not a valid fseq file. File will be deleted."));
-			return;
-		}
-		else if (fseqError == NL::FseqLoader::Error::ERROR_FILE_VERSION)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The uploaded fseq file has a invalid version. File will be deleted."));
-			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
-			NL::FseqEndpoint::sendSimpleResponse(400, F("The uploaded fseq file has a invalid version. File will be deleted."));
-			return;
-		}
-		else if (fseqError == NL::FseqLoader::Error::ERROR_HEADER_LENGTH)
+		const NL::FseqLoader::Error fseqError = NL::FseqEndpoint::uploadValidator->finish();
+		if (fseqError != NL::FseqLoader::Error::OK)
 		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The uploaded fseq file has a invalid header length. File will be deleted."));
-			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
-			NL::FseqEndpoint::sendSimpleResponse(400, F("The uploaded fseq file has a invalid header length. File will be deleted."));
-			return;
-		}
-		else if (fseqError == NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The uploaded fseq file has a invalid data length. File will be deleted."));
-			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
-			NL::FseqEndpoint::sendSimpleResponse(400, F("The uploaded fseq file has a invalid data length. File will be deleted."));
+			NL::FseqEndpoint::rejectUpload(fileName, fseqError);
 			return;
 		}
-		else if (fseqError != NL::FseqLoader::Error::OK)
+
+		NL::FseqEndpoint::uploadFile.close();
+		const NL::FseqLoader::FseqHeader fseqHeader = NL::FseqEndpoint::uploadValidator->getHeader();
+		const NL::FseqIndex::Entry entry = {NL::FseqEndpoint::uploadValidator->getChecksum(), fileName, NL::FseqEndpoint::uploadValidator->getSize(), fseqHeader.channelCount, fseqHeader.frameCount, fseqHeader.stepTime};
+		NL::FseqEndpoint::uploadValidator.reset();
+		if (NL::FseqIndex::addEntry(entry) != NL::FseqIndex::Error::OK)
 		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The uploaded fseq file is invalid and will be deleted."));
-			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
-			NL::FseqEndpoint::sendSimpleResponse(400, F("The uploaded fseq file is invalid and will be deleted."));
-			return;
+			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to add the fseq file to the index."));
 		}
 	}
 	else if (upload.status == UPLOAD_FILE_ABORTED)
@@ -188,6 +168,7 @@ void NL::FseqEndpoint::fseqUpload()
 		{
 			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Upload was aborted, file will be deleted."));
 			NL::FseqEndpoint::uploadFile.close();
+			NL::FseqEndpoint::uploadValidator.reset();
 			NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
 			NL::FseqEndpoint::sendSimpleResponse(400, F("Upload was aborted by the client. The data was dropped."));
 		}
@@ -215,21 +196,20 @@ void NL::FseqEndpoint::deleteFseq()
 		return;
 	}
 
+	// The file of the custom animation is selected by the first zone with the animator type set to 255
 	NL::Configuration::LedConfig ledConfig;
-	NL::Configuration::getLedConfig(0, ledConfig);
-	if (ledConfig.type == 255)
+	bool customAnimation = false;
+	for (size_t i = 0; i < LED_NUM_ZONES && !customAnimation; i++)
 	{
-		uint32_t idFile = 0;
+		NL::Configuration::getLedConfig(i, ledConfig);
+		customAnimation = ledConfig.type == 255;
+	}
+	if (customAnimation)
+	{
+		NL::FseqIndex::Entry entry;
 		uint32_t idConfig = 0;
-		if (!NL::FileUtil::getFileIdentifier(NL::FseqEndpoint::fileSystem, FSEQ_DIRECTORY + (String)F("/") + fileName, idFile))
-		{
-			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to calculate file identifier."));
-			NL::FseqEndpoint::sendSimpleResponse(500, F("Failed to calculate file identifier."));
-			return;
-		}
-
 		memcpy(&idConfig, &ledConfig.animationSettings[20], sizeof(idConfig));
-		if (idFile == idConfig)
+		if (NL::FseqIndex::getEntry(fileName, entry) && entry.identifier == idConfig)
 		{
 			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Can not delete a fseq file that is currently used."));
 			NL::FseqEndpoint::sendSimpleResponse(400, F("Can not delete a fseq file that is currently used."));
@@ -237,6 +217,22 @@ void NL::FseqEndpoint::deleteFseq()
 		}
 	}
 
+	// Files of the playlist are opened in the background while it is played
+	NL::FseqPlaylist fseqPlaylist(NL::FseqEndpoint::fileSystem);
+	if (fseqPlaylist.loadFromFile(FSEQ_PLAYLIST_FILE_NAME) == NL::FseqPlaylist::Error::OK)
+	{
+		const std::vector<NL::FseqPlaylist::Entry> entries = fseqPlaylist.getEntries();
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (entries.at(i).fileName == fileName)
+			{
+				NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Can not delete a fseq file that is part of the playlist."));
+				NL::FseqEndpoint::sendSimpleResponse(400, F("Can not delete a fseq file that is part of the playlist."));
+				return;
+			}
+		}
+	}
+
 	if (!fileSystem->remove(FSEQ_DIRECTORY + (String)F("/") + fileName))
 	{
 		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to delete file."));
@@ -244,10 +240,199 @@ void NL::FseqEndpoint::deleteFseq()
 		return;
 	}
 
+	if (NL::FseqIndex::removeEntry(fileName) != NL::FseqIndex::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to remove the fseq file from the index."));
+	}
+
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
 	NL::FseqEndpoint::sendSimpleResponse(200, F("File deleted."));
 }
 
+/**
+ * @brief Return the current position of the custom animation.
+ */
+void NL::FseqEndpoint::getPosition()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to get the position of the custom animation."));
+	uint32_t frameIndex = 0;
+	uint32_t time = 0;
+	if (!NL::LedManager::getCustomAnimationPosition(frameIndex, time))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("No custom animation is playing."));
+		NL::FseqEndpoint::sendSimpleResponse(404, F("No custom animation is playing."));
+		return;
+	}
+
+	DynamicJsonDocument jsonDoc(256);
+	JsonObject position = jsonDoc.createNestedObject(F("position"));
+	position[F("frame")] = frameIndex;
+	position[F("time")] = time;
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
+	NL::FseqEndpoint::sendJsonDocument(200, F("Here is the current position of the animation."), jsonDoc);
+}
+
+/**
+ * @brief Play the custom animation from a position given in ms by the time parameter.
+ */
+void NL::FseqEndpoint::postPosition()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to play the custom animation from a position."));
+	if (!NL::FseqEndpoint::webServer->hasArg(F("time")) || NL::FseqEndpoint::webServer->arg(F("time")).length() == 0)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The time parameter must not be empty."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The time parameter must not be empty."));
+		return;
+	}
+
+	const long time = NL::FseqEndpoint::webServer->arg(F("time")).toInt();
+	if (time < 0)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The time parameter must not be negative."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The time parameter must not be negative."));
+		return;
+	}
+
+	const NL::LedManager::Error ledManagerError = NL::LedManager::seekCustomAnimation(time);
+	if (ledManagerError == NL::LedManager::Error::ERROR_NO_CUSTOM_ANIMATION)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("No custom animation is playing."));
+		NL::FseqEndpoint::sendSimpleResponse(404, F("No custom animation is playing."));
+		return;
+	}
+	else if (ledManagerError != NL::LedManager::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The position is behind the end of the animation."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The position is behind the end of the animation."));
+		return;
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Custom animation continues from the requested position."));
+	NL::FseqEndpoint::sendSimpleResponse(200, F("Jumping to the requested position!"));
+}
+
+/**
+ * @brief Return the fseq playlist. The list is empty when no playlist was saved yet.
+ */
+void NL::FseqEndpoint::getPlaylist()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to get the fseq playlist."));
+	NL::FseqPlaylist fseqPlaylist(NL::FseqEndpoint::fileSystem);
+	const NL::FseqPlaylist::Error playlistError = fseqPlaylist.loadFromFile(FSEQ_PLAYLIST_FILE_NAME);
+	if (playlistError != NL::FseqPlaylist::Error::OK && playlistError != NL::FseqPlaylist::Error::ERROR_FILE_OPEN)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The fseq playlist could not be read."));
+		NL::FseqEndpoint::sendSimpleResponse(500, F("The fseq playlist could not be read."));
+		return;
+	}
+
+	DynamicJsonDocument jsonDoc(4096);
+	const JsonArray playlist = jsonDoc.createNestedArray(F("playlist"));
+	const std::vector<NL::FseqPlaylist::Entry> entries = fseqPlaylist.getEntries();
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		JsonObject entry = playlist.createNestedObject();
+		entry[F("fileName")] = entries.at(i).fileName;
+		entry[F("repeatCount")] = entries.at(i).repeatCount;
+		entry[F("crossfadeFrames")] = entries.at(i).crossfadeFrames;
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
+	NL::FseqEndpoint::sendJsonDocument(200, F("Here is your playlist. Let's get this party started!"), jsonDoc);
+}
+
+/**
+ * @brief Replace the fseq playlist. When the playlist is currently played, the animations are reloaded.
+ */
+void NL::FseqEndpoint::postPlaylist()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to update the fseq playlist."));
+	if (!NL::FseqEndpoint::webServer->hasHeader(F("content-type")) || NL::FseqEndpoint::webServer->header(F("content-type")) != F("application/json"))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The content type must be \"application/json\"."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The content type must be \"application/json\"."));
+		return;
+	}
+
+	if (!NL::FseqEndpoint::webServer->hasArg(F("plain")))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("There must be a valid json body with the playlist."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("There must be a valid json body with the playlist."));
+		return;
+	}
+
+	const String body = NL::FseqEndpoint::webServer->arg(F("plain"));
+	if (body.length() == 0 || body.length() > 4096)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The body must not be empty and the maximum length is 4096 bytes."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The body must not be empty and the maximum length is 4096 bytes."));
+		return;
+	}
+
+	DynamicJsonDocument jsonDoc(4096);
+	if (!NL::FseqEndpoint::parseJsonDocument(jsonDoc, body))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The body could not be parsed. The json is invalid."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The body could not be parsed. The json is invalid."));
+		return;
+	}
+
+	if (!jsonDoc[F("playlist")].is<JsonArray>())
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The json must contain a \"playlist\" array."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The json must contain a \"playlist\" array."));
+		return;
+	}
+
+	const JsonArray playlist = jsonDoc[F("playlist")].as<JsonArray>();
+	if (playlist.size() == 0 || playlist.size() > FSEQ_PLAYLIST_MAX_ENTRIES)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("The playlist must contain between 1 and ") + FSEQ_PLAYLIST_MAX_ENTRIES + F(" entries."));
+		NL::FseqEndpoint::sendSimpleResponse(400, (String)F("The playlist must contain between 1 and ") + FSEQ_PLAYLIST_MAX_ENTRIES + F(" entries."));
+		return;
+	}
+
+	std::vector<NL::FseqPlaylist::Entry> entries;
+	for (size_t i = 0; i < playlist.size(); i++)
+	{
+		const JsonObject entry = playlist[i].as<JsonObject>();
+		if (!NL::FseqEndpoint::validatePlaylistEntry(entry))
+		{
+			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The validation of the playlist failed."));
+			return;
+		}
+		entries.push_back({entry[F("fileName")].as<String>(), entry[F("repeatCount")].as<uint16_t>(), entry[F("crossfadeFrames")].as<uint16_t>()});
+	}
+
+	NL::FseqPlaylist fseqPlaylist(NL::FseqEndpoint::fileSystem);
+	fseqPlaylist.setEntries(entries);
+	if (fseqPlaylist.saveToFile(FSEQ_PLAYLIST_FILE_NAME) != NL::FseqPlaylist::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save the fseq playlist."));
+		NL::FseqEndpoint::sendSimpleResponse(500, F("Failed to save the fseq playlist."));
+		return;
+	}
+
+	// The playlist is played when the custom field 19 of the first zone with the animator type set to 255 is set to 1
+	NL::Configuration::LedConfig ledConfig;
+	bool customAnimation = false;
+	for (size_t i = 0; i < LED_NUM_ZONES && !customAnimation; i++)
+	{
+		NL::Configuration::getLedConfig(i, ledConfig);
+		customAnimation = ledConfig.type == 255;
+	}
+	if (customAnimation && ledConfig.animationSettings[19] == 1 && NL::LedManager::reloadAnimations() != NL::LedManager::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The fseq playlist was saved but can not be played with the current LED configuration."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The fseq playlist was saved but can not be played with the current LED configuration."));
+		return;
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Fseq playlist saved. Sending the response."));
+	NL::FseqEndpoint::sendSimpleResponse(200, F("Playlist saved! I already picked my favorite song."));
+}
+
 /**
  * @brief Validate the file name and check for invalid characters.
  * @param fileName received name of the file
@@ -277,22 +462,89 @@ bool NL::FseqEndpoint::validateFileName(const String fileName)
 }
 
 /**
- * @brief Validate a fseq file by using the {@link NL::FseqLoader}.
- * @param fileName full path and name of the file to check
- * @return NL::FseqLoader::OK when the file was loaded and is valid
- * @return NL::FseqLoader::ERROR_FILE_NOT_FOUND when the file was not found
- * @return NL::FseqLoader::ERROR_FILE_IS_DIR when the file is a directory
- * @return NL::FseqLoader::ERROR_FILE_TOO_SMALL when the file is too small to be valid
- * @return NL::FseqLoader::ERROR_FILE_READ when the file could not be read
- * @return NL::FseqLoader::ERROR_MAGIC_NUMBERS when the magic numbers do not match
- * @return NL::FseqLoader::ERROR_FILE_VERSION  when the file version is unsupported
- * @return NL::FseqLoader::ERROR_HEADER_LENGTH when the header length is invalid
- * @return NL::FseqLoader::ERROR_INVALID_DATA_LENGTH when the data length does not match the length specified in header
+ * @brief Stop an upload because the fseq file is invalid. The partial file will be deleted.
+ * @param fileName name of the uploaded file
+ * @param fseqError reason why the file is invalid
  */
-NL::FseqLoader::Error NL::FseqEndpoint::validateFseqFile(const String fileName)
+void NL::FseqEndpoint::rejectUpload(const String fileName, const NL::FseqLoader::Error fseqError)
 {
-	NL::FseqLoader fseqLoader(NL::FseqEndpoint::fileSystem);
-	const NL::FseqLoader::Error fseqError = fseqLoader.loadFromFile(fileName);
-	fseqLoader.close();
-	return fseqError;
-}
\ No newline at end of file
+	NL::FseqEndpoint::uploadFile.close();
+	NL::FseqEndpoint::uploadValidator.reset();
+	NL::FseqEndpoint::fileSystem->remove((String)FSEQ_DIRECTORY + F("/") + fileName);
+
+	String message = F("The uploaded fseq file is invalid and will be deleted.");
+	if (fseqError == NL::FseqLoader::Error::ERROR_FILE_TOO_SMALL)
+	{
+		message = F("The uploaded fseq file is invalid because it is too small. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_MAGIC_NUMBERS)
+	{
+		message = F("The uploaded fseq file is not a valid fseq file. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_FILE_VERSION)
+	{
+		message = F("The uploaded fseq file has a invalid version. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_HEADER_LENGTH)
+	{
+		message = F("The uploaded fseq file has a invalid header length. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH)
+	{
+		message = F("The uploaded fseq file has a invalid data length. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_COMPRESSION)
+	{
+		message = F("The uploaded fseq file uses an unsupported compression. Only uncompressed and zlib files are supported. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_SPARSE_RANGE)
+	{
+		message = F("The uploaded fseq file has invalid sparse channel ranges. File will be deleted.");
+	}
+	else if (fseqError == NL::FseqLoader::Error::ERROR_CHANNEL_COUNT)
+	{
+		message = F("The channel count of the uploaded fseq file does not fit the LED configuration. File will be deleted.");
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, message);
+	NL::FseqEndpoint::sendSimpleResponse(400, message);
+}
+
+/**
+ * @brief Validate if a playlist entry is valid and the fseq file exists.
+ * @param jsonObject json object holding the playlist entry
+ * @return true when valid
+ * @return false when invalid
+ */
+bool NL::FseqEndpoint::validatePlaylistEntry(const JsonObject &jsonObject)
+{
+	if (!jsonObject[F("fileName")].is<String>() || !NL::FseqEndpoint::validateFileName(jsonObject[F("fileName")].as<String>()))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The \"fileName\" field must be a valid file name."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The \"fileName\" field must be a valid file name."));
+		return false;
+	}
+
+	if (!NL::FileUtil::fileExists(NL::FseqEndpoint::fileSystem, (String)FSEQ_DIRECTORY + F("/") + jsonObject[F("fileName")].as<String>()))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("The file \"") + jsonObject[F("fileName")].as<String>() + F("\" was not found."));
+		NL::FseqEndpoint::sendSimpleResponse(404, (String)F("The file \"") + jsonObject[F("fileName")].as<String>() + F("\" was not found."));
+		return false;
+	}
+
+	if (!jsonObject[F("repeatCount")].is<uint16_t>())
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The \"repeatCount\" field must be of type \"uint16\"."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The \"repeatCount\" field must be of type \"uint16\"."));
+		return false;
+	}
+
+	if (!jsonObject[F("crossfadeFrames")].is<uint16_t>())
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The \"crossfadeFrames\" field must be of type \"uint16\"."));
+		NL::FseqEndpoint::sendSimpleResponse(400, F("The \"crossfadeFrames\" field must be of type \"uint16\"."));
+		return false;
+	}
+
+	return true;
+}
@@ -176,25 +176,7 @@ void NL::LedConfigurationEndpoint::patchLedConfig()
 		NL::Configuration::setLedConfig(i, config[i]);
 	}
 
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save LED configuration. The configuration file could not be opened."));
-		NL::LedConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save LED configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save LED configuration. The configuration file could not be written."));
-		NL::LedConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save LED configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save LED configuration."));
-		NL::LedConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save LED configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	const NL::LedManager::Error ledManagerError = NL::LedManager::reloadAnimations();
 	if (ledManagerError == NL::LedManager::Error::ERROR_INIT_LED_DRIVER)
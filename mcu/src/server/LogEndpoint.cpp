@@ -68,6 +68,7 @@ void NL::LogEndpoint::getLogSize()
 
 /**
  * @brief Get a section of the log file, determinded by the paremters start and count in bytes.
+ * The binary records starting in this section are rendered as text.
  */
 void NL::LogEndpoint::getLog()
 {
@@ -105,23 +106,37 @@ void NL::LogEndpoint::getLog()
 		return;
 	}
 
-	NL::LogEndpoint::webServer->setContentLength(count);
+	NL::LogReader logReader(file);
+	if (logReader.begin() != NL::LogReader::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to read log file because the format is invalid."));
+		file.close();
+		NL::LogEndpoint::sendSimpleResponse(500, F("Failed to read log file because the format is invalid."));
+		return;
+	}
+
+	// The length of the rendered text is not known in advance
+	NL::LogEndpoint::webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
 	NL::LogEndpoint::webServer->send(200, F("text/plain"), String());
 
-	file.seek(start);
-	uint8_t buffer[512];
-	size_t sentBytes = 0;
-	while (sentBytes < count)
+	logReader.seek(start);
+	char buffer[1024];
+	size_t bufferSize = 0;
+	size_t lineLength = 0;
+	while (logReader.getPosition() < start + count && logReader.readLine(buffer + bufferSize, LOG_MAX_LINE_LENGTH, lineLength) == NL::LogReader::Error::OK)
 	{
-		size_t chunkSize = count - sentBytes;
-		if (chunkSize > 512)
+		bufferSize += lineLength;
+		if (bufferSize + LOG_MAX_LINE_LENGTH > sizeof(buffer))
 		{
-			chunkSize = 512;
+			NL::LogEndpoint::webServer->sendContent(buffer, bufferSize);
+			bufferSize = 0;
 		}
-		chunkSize = file.read(buffer, chunkSize);
-		NL::LogEndpoint::webServer->sendContent_P((char *)buffer, chunkSize);
-		sentBytes += chunkSize;
 	}
+	if (bufferSize > 0)
+	{
+		NL::LogEndpoint::webServer->sendContent(buffer, bufferSize);
+	}
+	NL::LogEndpoint::webServer->sendContent(String());
 
 	file.close();
 }
@@ -135,25 +135,7 @@ void NL::MotionSensorEndpoint::patchCalibrationData()
 	motionSensorCalibration.gyroZDeg = calibration[F("gyroZDeg")].as<float>();
 
 	NL::Configuration::setMotionSensorCalibration(motionSensorCalibration);
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save motion sensor calibration. The configuration file could not be opened."));
-		NL::MotionSensorEndpoint::sendSimpleResponse(500, F("Failed to save motion sensor calibration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save motion sensor calibration. The configuration file could not be written."));
-		NL::MotionSensorEndpoint::sendSimpleResponse(500, F("Failed to save motion sensor calibration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save motion sensor calibration."));
-		NL::MotionSensorEndpoint::sendSimpleResponse(500, F("Failed to save motion sensor calibration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Calibration data saved. Sending the response."));
 	NL::MotionSensorEndpoint::sendSimpleResponse(200, F("I saved the motion data calibration for you. I want a cookie..."));
@@ -206,13 +188,7 @@ void NL::MotionSensorEndpoint::runCalibration()
 		return;
 	}
 
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save motion sensor calibration data."));
-		NL::MotionSensorEndpoint::sendSimpleResponse(500, F("Failed to save motion sensor calibration data."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Calibration data saved. Sending the response."));
 	NL::MotionSensorEndpoint::sendSimpleResponse(200, F("I calibrated the motion sensor for you."));
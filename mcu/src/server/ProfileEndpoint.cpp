@@ -135,25 +135,7 @@ void NL::ProfileEndpoint::patchActiveProfile()
 		return;
 	}
 
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be opened."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be written."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	const NL::LedManager::Error ledManagerError = NL::LedManager::reloadAnimations();
 	if (ledManagerError == NL::LedManager::Error::ERROR_INIT_LED_DRIVER)
@@ -217,7 +199,12 @@ void NL::ProfileEndpoint::getProfiles()
 	for (size_t i = 0; i < NL::Configuration::getProfileCount(); i++)
 	{
 		String profileName;
-		NL::Configuration::getProfileNameByIndex(i, profileName);
+		if (NL::Configuration::getProfileNameByIndex(i, profileName) != NL::Configuration::Error::OK)
+		{
+			NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to read the profile list."));
+			NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to read the profile list."));
+			return;
+		}
 		profileArray.add(profileName);
 	}
 
@@ -311,25 +298,7 @@ void NL::ProfileEndpoint::postProfile()
 		return;
 	}
 
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be opened."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be written."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
 	NL::ProfileEndpoint::sendSimpleResponse(200, F("Oki, I created a new profile for you."));
@@ -442,25 +411,7 @@ void NL::ProfileEndpoint::cloneProfile()
 		return;
 	}
 
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be opened."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be written."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
 	NL::ProfileEndpoint::sendSimpleResponse(200, F("Oki, I cloned the profile for you."));
@@ -514,25 +465,7 @@ void NL::ProfileEndpoint::deleteProfile()
 		return;
 	}
 
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be opened."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration. The configuration file could not be written."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save configuration."));
-		NL::ProfileEndpoint::sendSimpleResponse(500, F("Failed to save configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
 	NL::ProfileEndpoint::sendSimpleResponse(200, F("Oki, I deleted the profile for you."));
@@ -546,7 +479,7 @@ void NL::ProfileEndpoint::deleteProfile()
  */
 bool NL::ProfileEndpoint::validateProfileName(const String &profileName)
 {
-	if (profileName.length() < 3 || profileName.length() > 24)
+	if (profileName.length() < 3 || profileName.length() > CONFIGURATION_PROFILE_NAME_LENGTH)
 	{
 		return false;
 	}
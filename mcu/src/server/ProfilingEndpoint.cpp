@@ -0,0 +1,82 @@
+/**
+ * @file ProfilingEndpoint.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of a REST endpoint to read and reset the profiling data.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "server/ProfilingEndpoint.h"
+
+/**
+ * @brief Add all request handler for this {@link NL::RestEndpoint} to the {@link NL::WebServerManager}.
+ */
+void NL::ProfilingEndpoint::begin()
+{
+	NL::WebServerManager::addRequestHandler((getBaseUri() + F("profiling")).c_str(), http_method::HTTP_GET, NL::ProfilingEndpoint::getProfilingData);
+	NL::WebServerManager::addRequestHandler((getBaseUri() + F("profiling")).c_str(), http_method::HTTP_DELETE, NL::ProfilingEndpoint::resetProfilingData);
+}
+
+/**
+ * @brief Return the execution time statistics of all profiled stages to the client.
+ */
+void NL::ProfilingEndpoint::getProfilingData()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to get the profiling data."));
+	if (!NL::Profiler::isInitialized())
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("The profiler was not initialized. Can not access."));
+		NL::ProfilingEndpoint::sendSimpleResponse(500, F("The profiler was not initialized. Can not access."));
+		return;
+	}
+
+	DynamicJsonDocument jsonDoc(4096);
+	const JsonObject profiling = jsonDoc.createNestedObject(F("profiling"));
+	for (uint8_t i = 0; i < NL::Profiler::STAGE_COUNT; i++)
+	{
+		const NL::Profiler::Stage stage = static_cast<NL::Profiler::Stage>(i);
+		NL::Profiler::StageStatistics statistics;
+		NL::Profiler::getStageStatistics(stage, statistics);
+
+		const JsonObject stageObject = profiling.createNestedObject(NL::Profiler::getStageName(stage));
+		stageObject[F("count")] = statistics.count;
+		stageObject[F("min")] = statistics.min;
+		stageObject[F("avg")] = statistics.avg;
+		stageObject[F("max")] = statistics.max;
+		stageObject[F("p99")] = statistics.p99;
+	}
+
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
+	NL::ProfilingEndpoint::sendJsonDocument(200, F("Here is where my time goes."), jsonDoc);
+}
+
+/**
+ * @brief Reset the profiling data of all stages.
+ */
+void NL::ProfilingEndpoint::resetProfilingData()
+{
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to reset the profiling data."));
+	if (!NL::Profiler::isInitialized())
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("The profiler was not initialized. Can not access."));
+		NL::ProfilingEndpoint::sendSimpleResponse(500, F("The profiler was not initialized. Can not access."));
+		return;
+	}
+
+	NL::Profiler::reset();
+	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
+	NL::ProfilingEndpoint::sendSimpleResponse(200, F("Profiling data was reset."));
+}
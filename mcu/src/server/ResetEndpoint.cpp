@@ -40,6 +40,12 @@ void NL::ResetEndpoint::handleSoftReset()
 {
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to execute a soft reset."));
 	NL::ResetEndpoint::sendSimpleResponse(200, F("I will reboot for you in 3 seconds."));
+
+	if (NL::Configuration::handleSave(true) != NL::Configuration::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save the configuration before the reboot."));
+	}
+
 	NL::Updater::reboot(F("Soft Reset"), 3000);
 }
 
@@ -51,6 +57,10 @@ void NL::ResetEndpoint::handleHardReset()
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Received request to execute a hard reset."));
 	NL::ResetEndpoint::sendSimpleResponse(200, F("I will reset my configuration and then reboot for you in 3 seconds."));
 
+	NL::Configuration::discardSave();
+	NL::Configuration::closeProfileFile();
+	NL::ResetEndpoint::fileSystem->remove(CONFIGURATION_TEMP_FILE_NAME);
+	NL::ResetEndpoint::fileSystem->remove(CONFIGURATION_PROFILE_FILE_NAME);
 	if (!NL::ResetEndpoint::fileSystem->remove(CONFIGURATION_FILE_NAME))
 	{
 		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("Failed to remove configuration. This might be normal if it was not saved before."));
@@ -142,25 +142,7 @@ void NL::SystemConfigurationEndpoint::patchSystemConfig()
 	config.fanMaxTemperature = configuration[F("fanMaxTemperature")].as<uint8_t>();
 
 	NL::Configuration::setSystemConfig(config);
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save system configuration. The configuration file could not be opened."));
-		NL::SystemConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save system configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save system configuration. The configuration file could not be written."));
-		NL::SystemConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save system configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save system configuration."));
-		NL::SystemConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save system configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::setMinLogLevel((NL::Logger::LogLevel)NL::Configuration::getSystemConfig().logLevel);
 
@@ -42,7 +42,7 @@ void NL::SystemInformationEndpoint::getSystemInformation()
 		return;
 	}
 
-	DynamicJsonDocument jsonDoc(1024);
+	DynamicJsonDocument jsonDoc(2048);
 
 	const JsonObject socInfo = jsonDoc.createNestedObject(F("socInfo"));
 	socInfo[F("chipModel")] = NL::SystemInformation::getSocInfo().chipModel;
@@ -50,7 +50,10 @@ void NL::SystemInformationEndpoint::getSystemInformation()
 	socInfo[F("fwVersion")] = NL::SystemInformation::getSocInfo().fwVersion;
 	socInfo[F("cpuCores")] = NL::SystemInformation::getSocInfo().cpuCores;
 	socInfo[F("cpuClock")] = NL::SystemInformation::getSocInfo().cpuClock;
+	socInfo[F("heapSize")] = NL::SystemInformation::getSocInfo().heapSize;
 	socInfo[F("freeHeap")] = NL::SystemInformation::getSocInfo().freeHeap;
+	socInfo[F("minFreeHeap")] = NL::SystemInformation::getSocInfo().minFreeHeap;
+	socInfo[F("maxAllocHeap")] = NL::SystemInformation::getSocInfo().maxAllocHeap;
 	socInfo[F("flashSize")] = NL::SystemInformation::getSocInfo().flashSize;
 	socInfo[F("flashSpeed")] = NL::SystemInformation::getSocInfo().flashSpeed;
 	socInfo[F("sketchSize")] = NL::SystemInformation::getSocInfo().sketchSize;
@@ -75,6 +78,15 @@ void NL::SystemInformationEndpoint::getSystemInformation()
 	tlSystemInfo[F("fps")] = NL::SystemInformation::getNikoLightInfo().fps;
 	tlSystemInfo[F("ledCount")] = NL::SystemInformation::getNikoLightInfo().ledCount;
 	tlSystemInfo[F("hiddenLedCount")] = NL::SystemInformation::getNikoLightInfo().hiddenLedCount;
+	tlSystemInfo[F("renderTime")] = NL::SystemInformation::getNikoLightInfo().renderTime;
+	tlSystemInfo[F("transmitTime")] = NL::SystemInformation::getNikoLightInfo().transmitTime;
+	tlSystemInfo[F("frameJitter")] = NL::SystemInformation::getNikoLightInfo().frameJitter;
+	tlSystemInfo[F("maxFrameJitter")] = NL::SystemInformation::getNikoLightInfo().maxFrameJitter;
+	tlSystemInfo[F("droppedFrames")] = NL::SystemInformation::getNikoLightInfo().droppedFrames;
+	tlSystemInfo[F("ledBufferSize")] = NL::SystemInformation::getNikoLightInfo().ledBufferSize;
+	tlSystemInfo[F("ledBufferSavedSize")] = NL::SystemInformation::getNikoLightInfo().ledBufferSavedSize;
+	tlSystemInfo[F("fseqCacheHits")] = NL::SystemInformation::getNikoLightInfo().fseqCacheHits;
+	tlSystemInfo[F("fseqCacheMisses")] = NL::SystemInformation::getNikoLightInfo().fseqCacheMisses;
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("Sending the response."));
 	NL::SystemInformationEndpoint::sendJsonDocument(200, F("Here is my current status."), jsonDoc);
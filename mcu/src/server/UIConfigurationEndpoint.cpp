@@ -118,25 +118,7 @@ void NL::UIConfigurationEndpoint::patchUIConfig()
 	uiConfiguration.expertMode = uiConfig[F("expertMode")].as<bool>();
 
 	NL::Configuration::setUIConfiguration(uiConfiguration);
-	const NL::Configuration::Error configSaveError = NL::Configuration::save();
-	if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save ui configuration. The configuration file could not be opened."));
-		NL::UIConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save ui configuration. The configuration file could not be opened."));
-		return;
-	}
-	else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save ui configuration. The configuration file could not be written."));
-		NL::UIConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save ui configuration. The configuration file could not be written."));
-		return;
-	}
-	else if (configSaveError != NL::Configuration::Error::OK)
-	{
-		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save ui configuration."));
-		NL::UIConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save ui configuration."));
-		return;
-	}
+	NL::Configuration::requestSave();
 
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("UI configuration saved. Sending the response."));
 	NL::UIConfigurationEndpoint::sendSimpleResponse(200, F("Configuration saved! Thank you for telling me your personal preferences! Now I know you even better."));
@@ -157,6 +139,13 @@ bool NL::UIConfigurationEndpoint::validateUIConfig(const JsonObject &jsonObject)
 		return false;
 	}
 
+	if (jsonObject[F("language")].as<String>().length() > CONFIGURATION_UI_VALUE_LENGTH)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("The \"language\" field must not be longer than ") + CONFIGURATION_UI_VALUE_LENGTH + F(" characters."));
+		NL::UIConfigurationEndpoint::sendSimpleResponse(400, (String)F("The \"language\" field must not be longer than ") + CONFIGURATION_UI_VALUE_LENGTH + F(" characters."));
+		return false;
+	}
+
 	if (!jsonObject[F("theme")].is<String>())
 	{
 		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The \"theme\" field must be of type \"string\"."));
@@ -164,6 +153,13 @@ bool NL::UIConfigurationEndpoint::validateUIConfig(const JsonObject &jsonObject)
 		return false;
 	}
 
+	if (jsonObject[F("theme")].as<String>().length() > CONFIGURATION_UI_VALUE_LENGTH)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("The \"theme\" field must not be longer than ") + CONFIGURATION_UI_VALUE_LENGTH + F(" characters."));
+		NL::UIConfigurationEndpoint::sendSimpleResponse(400, (String)F("The \"theme\" field must not be longer than ") + CONFIGURATION_UI_VALUE_LENGTH + F(" characters."));
+		return false;
+	}
+
 	if (!jsonObject[F("expertMode")].is<bool>())
 	{
 		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The \"expertMode\" field must be of type \"boolean\"."));
@@ -53,6 +53,12 @@ void NL::UpdateEndpoint::postPackage()
 		NL::UpdateEndpoint::uploadFile.close();
 	}
 
+	// Save pending configuration changes before the reboot
+	if (NL::Configuration::handleSave(true) != NL::Configuration::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save the configuration before the reboot."));
+	}
+
 	// Reboot the controller, update will be installed after the reboot
 	NL::Updater::reboot(F("Update"), 3000);
 }
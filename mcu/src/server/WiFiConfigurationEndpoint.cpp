@@ -133,25 +133,7 @@ void NL::WiFiConfigurationEndpoint::patchWiFiConfig()
 	if (NL::WiFiConfigurationEndpoint::hasChanged(config))
 	{
 		NL::Configuration::setWiFiConfig(config);
-		const NL::Configuration::Error configSaveError = NL::Configuration::save();
-		if (configSaveError == NL::Configuration::Error::ERROR_FILE_OPEN)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save WiFi configuration. The configuration file could not be opened."));
-			NL::WiFiConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save WiFi configuration. The configuration file could not be opened."));
-			return;
-		}
-		else if (configSaveError == NL::Configuration::Error::ERROR_FILE_WRITE)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save WiFi configuration. The configuration file could not be written."));
-			NL::WiFiConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save WiFi configuration. The configuration file could not be written."));
-			return;
-		}
-		else if (configSaveError != NL::Configuration::Error::OK)
-		{
-			NL::Logger::log(NL::Logger::LogLevel::ERROR, SOURCE_LOCATION, F("Failed to save WiFi configuration."));
-			NL::WiFiConfigurationEndpoint::sendSimpleResponse(500, F("Failed to save WiFi configuration."));
-			return;
-		}
+		NL::Configuration::requestSave();
 
 		const NL::WiFiManager::Error wifiError = NL::WiFiManager::startAccessPoint(NL::Configuration::getWiFiConfig().accessPointSsid.c_str(), NL::Configuration::getWiFiConfig().accessPointPassword.c_str(), NL::Configuration::getWiFiConfig().accessPointChannel, false, NL::Configuration::getWiFiConfig().accessPointMaxConnections);
 		if (wifiError == NL::WiFiManager::Error::ERROR_START_AP)
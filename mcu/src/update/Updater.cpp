@@ -86,6 +86,7 @@ void NL::Updater::reboot(const String reason, const uint16_t rebootDelay)
 	NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, (String)F("Rebooting controller in ") + String(rebootDelay / 1000.0f) + F(" seconds for reason: ") + reason);
 	if (rebootDelay == 0)
 	{
+		NL::Logger::flush();
 		ESP.restart();
 	}
 	else
@@ -166,6 +167,7 @@ void NL::Updater::rebootInt(void *params)
 	delete paramPtr;
 
 	delay(rebootDelay);
+	NL::Logger::flush();
 	ESP.restart();
 	vTaskDelete(NULL);
 }
@@ -23,11 +23,22 @@
 
 /**
  * @brief Create a new instance of {@link NL::BinaryFile}.
+ * Reads and writes are collected in a buffer, so the file is accessed in large blocks.
  * @param fileSystem file system to use
+ * @param bufferSize size of the buffer in bytes, 0 to access the file directly
  */
-NL::BinaryFile::BinaryFile(FS *fileSystem)
+NL::BinaryFile::BinaryFile(FS *fileSystem, const size_t bufferSize)
 {
 	this->fileSystem = fileSystem;
+	this->bufferSize = bufferSize;
+	this->bufferPosition = 0;
+	this->bufferLength = 0;
+	this->writeMode = false;
+	this->checksum = 0;
+	if (bufferSize > 0)
+	{
+		this->buffer.reset(new uint8_t[bufferSize]);
+	}
 }
 
 /**
@@ -35,10 +46,7 @@ NL::BinaryFile::BinaryFile(FS *fileSystem)
  */
 NL::BinaryFile::~BinaryFile()
 {
-	if (this->file)
-	{
-		this->file.close();
-	}
+	this->close();
 }
 
 /**
@@ -51,6 +59,10 @@ NL::BinaryFile::~BinaryFile()
  */
 NL::BinaryFile::Error NL::BinaryFile::open(const String fileName, const char *mode)
 {
+	this->bufferPosition = 0;
+	this->bufferLength = 0;
+	this->writeMode = mode[0] != 'r';
+	this->checksum = 0;
 	this->file = this->fileSystem->open(fileName, mode);
 	if (!this->file)
 	{
@@ -66,14 +78,111 @@ NL::BinaryFile::Error NL::BinaryFile::open(const String fileName, const char *mo
 }
 
 /**
- * @brief Close the file when it was opened.
+ * @brief Write the buffered data to the file.
+ * @return OK when the data was written
+ * @return ERROR_FILE_WRITE when the data could not be written
  */
-void NL::BinaryFile::close()
+NL::BinaryFile::Error NL::BinaryFile::flush()
 {
-	if (this->file)
+	if (!this->writeMode || this->bufferPosition == 0)
 	{
-		this->file.close();
+		return NL::BinaryFile::Error::OK;
 	}
+
+	const size_t size = this->bufferPosition;
+	this->bufferPosition = 0;
+	return this->file.write(this->buffer.get(), size) == size ? NL::BinaryFile::Error::OK : NL::BinaryFile::Error::ERROR_FILE_WRITE;
+}
+
+/**
+ * @brief Close the file when it was opened. Buffered data is written before.
+ * @return OK when the file was closed
+ * @return ERROR_FILE_WRITE when the buffered data could not be written
+ */
+NL::BinaryFile::Error NL::BinaryFile::close()
+{
+	if (!this->file)
+	{
+		return NL::BinaryFile::Error::OK;
+	}
+
+	const NL::BinaryFile::Error flushError = this->flush();
+	this->file.close();
+	return flushError;
+}
+
+/**
+ * @brief Write a block of data to the binary file.
+ * Small blocks are collected in the buffer, blocks larger than the buffer are written directly.
+ * @param data data to write
+ * @param size size of the data in bytes
+ * @return OK when data was written
+ * @return ERROR_FILE_WRITE when data could not be written
+ */
+NL::BinaryFile::Error NL::BinaryFile::writeBytes(const void *data, const size_t size)
+{
+	this->checksum = crc32_le(this->checksum, (const uint8_t *)data, size);
+	if (this->bufferPosition + size > this->bufferSize)
+	{
+		const NL::BinaryFile::Error flushError = this->flush();
+		if (flushError != NL::BinaryFile::Error::OK)
+		{
+			return flushError;
+		}
+
+		if (size >= this->bufferSize)
+		{
+			return this->file.write((const uint8_t *)data, size) == size ? NL::BinaryFile::Error::OK : NL::BinaryFile::Error::ERROR_FILE_WRITE;
+		}
+	}
+
+	memcpy(this->buffer.get() + this->bufferPosition, data, size);
+	this->bufferPosition += size;
+	return NL::BinaryFile::Error::OK;
+}
+
+/**
+ * @brief Read a block of data from the binary file.
+ * The buffer is refilled in blocks of the buffer size, large blocks are read directly.
+ * @param data buffer for the data
+ * @param size size of the data in bytes
+ * @return OK when data was read
+ * @return ERROR_FILE_READ when data could not be read
+ */
+NL::BinaryFile::Error NL::BinaryFile::readBytes(void *data, const size_t size)
+{
+	uint8_t *output = (uint8_t *)data;
+	size_t remaining = size;
+	while (remaining > 0)
+	{
+		if (this->bufferPosition == this->bufferLength)
+		{
+			if (remaining >= this->bufferSize)
+			{
+				if (this->file.read(output, remaining) != remaining)
+				{
+					return NL::BinaryFile::Error::ERROR_FILE_READ;
+				}
+				break;
+			}
+
+			this->bufferPosition = 0;
+			this->bufferLength = this->file.read(this->buffer.get(), this->bufferSize);
+			if (this->bufferLength == 0)
+			{
+				return NL::BinaryFile::Error::ERROR_FILE_READ;
+			}
+		}
+
+		const size_t chunkSize = std::min(remaining, this->bufferLength - this->bufferPosition);
+		memcpy(output, this->buffer.get() + this->bufferPosition, chunkSize);
+		this->bufferPosition += chunkSize;
+		output += chunkSize;
+		remaining -= chunkSize;
+	}
+
+	this->checksum = crc32_le(this->checksum, (const uint8_t *)data, size);
+	return NL::BinaryFile::Error::OK;
 }
 
 /**
@@ -91,16 +200,7 @@ NL::BinaryFile::Error NL::BinaryFile::writeString(const String string)
 		return writeLenError;
 	}
 
-	for (uint16_t i = 0; i < length; i++)
-	{
-		const NL::BinaryFile::Error writeCharError = this->write(string.charAt(i));
-		if (writeCharError != NL::BinaryFile::Error::OK)
-		{
-			return writeCharError;
-		}
-	}
-
-	return NL::BinaryFile::Error::OK;
+	return this->writeBytes(string.c_str(), length);
 }
 
 /**
@@ -120,16 +220,28 @@ NL::BinaryFile::Error NL::BinaryFile::readString(String &string)
 
 	string.clear();
 	string.reserve(length);
-	for (uint16_t i = 0; i < length; i++)
+	char chunk[65];
+	while (length > 0)
 	{
-		char c;
-		const NL::BinaryFile::Error readCharError = this->read(c);
-		if (readCharError != NL::BinaryFile::Error::OK)
+		const uint16_t chunkSize = std::min<uint16_t>(length, sizeof(chunk) - 1);
+		const NL::BinaryFile::Error readChunkError = this->readBytes(chunk, chunkSize);
+		if (readChunkError != NL::BinaryFile::Error::OK)
 		{
-			return readCharError;
+			return readChunkError;
 		}
-		string += c;
+		chunk[chunkSize] = '\0';
+		string += chunk;
+		length -= chunkSize;
 	}
 
 	return NL::BinaryFile::Error::OK;
 }
+
+/**
+ * @brief Get the CRC32 checksum of all data written or read since the file was opened.
+ * @return CRC32 checksum
+ */
+uint32_t NL::BinaryFile::getChecksum()
+{
+	return this->checksum;
+}
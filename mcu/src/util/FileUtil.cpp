@@ -70,7 +70,9 @@ bool NL::FileUtil::directoryExists(FS *fileSystem, const String path)
 }
 
 /**
- * @brief Calculate a identifier for a file based on it's properties and content.
+ * @brief Calculate the identifier of a file, which is the CRC32 checksum of it's content.
+ * It is equal to the checksum which the {@link NL::FseqValidator} calculates while a file is uploaded.
+ * The whole file is read, so the identifiers of fseq files should be taken from the {@link NL::FseqIndex}.
  * @param fileSystem where the file is located
  * @param fileName full path and name of the file
  * @param identifier reference to the variable holding the identifier
@@ -90,13 +92,14 @@ bool NL::FileUtil::getFileIdentifier(FS *fileSystem, const String fileName, uint
 		return false;
 	}
 
-	identifier = 7;
-	for (uint16_t i = 0; i < fileName.length(); i++)
+	uint8_t buffer[512];
+	identifier = 0;
+	size_t length = file.read(buffer, sizeof(buffer));
+	while (length > 0)
 	{
-		identifier = identifier * 31 + static_cast<uint8_t>(fileName[i]);
+		identifier = crc32_le(identifier, buffer, length);
+		length = file.read(buffer, sizeof(buffer));
 	}
-	identifier = identifier * 31 + file.size();
-	identifier = identifier * 31 + file.getLastWrite();
 
 	file.close();
 	return true;
@@ -177,11 +180,7 @@ bool NL::FileUtil::listFiles(FS *fileSystem, const String directory, std::functi
 		{
 			if (includeDirs || !file.isDirectory())
 			{
-				uint32_t id = 0;
-				if (NL::FileUtil::getFileIdentifier(fileSystem, directory + F("/") + file.name(), id))
-				{
-					callback(file.name(), file.size());
-				}
+				callback(file.name(), file.size());
 			}
 			file.close();
 		}
@@ -247,59 +246,6 @@ bool NL::FileUtil::getFileNameFromIndex(FS *fileSystem, const String directory,
 	return true;
 }
 
-/**
- * @brief Get the file name from a file located in the targe directory with a matching identifier.
- * @param fileSystem where the file should be located
- * @param directory where to look for the file
- * @param identifier id of the file
- * @param fileName reference variable holding the found file name
- * @return true when the search was successful
- * @return false when there was an error
- */
-bool NL::FileUtil::getFileNameFromIdentifier(FS *fileSystem, const String directory, const uint32_t identifier, String &fileName)
-{
-	File dir = fileSystem->open(directory, FILE_READ);
-	if (!dir)
-	{
-		return false;
-	}
-	else if (!dir.isDirectory())
-	{
-		dir.close();
-		return false;
-	}
-
-	bool hasNext = true;
-	while (hasNext)
-	{
-		File file = dir.openNextFile(FILE_READ);
-		if (file)
-		{
-			if (!file.isDirectory())
-			{
-				uint32_t id = 0;
-				if (NL::FileUtil::getFileIdentifier(fileSystem, directory + F("/") + file.name(), id))
-				{
-					if (id == identifier)
-					{
-						fileName = file.name();
-						hasNext = false;
-					}
-				}
-			}
-			file.close();
-		}
-		else
-		{
-			fileName.clear();
-			hasNext = false;
-		}
-	}
-
-	dir.close();
-	return true;
-}
-
 /**
  * @brief Recursively delete a directory with all it's contents.
  * @param fileSystem where the root directory is located
@@ -325,7 +271,7 @@ bool NL::FileUtil::deleteDirectory(FS *fileSystem, const String directory, const
 		}
 		name = directory == F("/") ? (String)F("/") + name : directory + F("/") + name;
 
-		if (name == LOG_FILE_NAME || name == CONFIGURATION_FILE_NAME || name == FSEQ_DIRECTORY || name == UPDATE_DIRECTORY)
+		if (name == LOG_FILE_NAME || name == LOG_ROTATED_FILE_NAME || name == CONFIGURATION_FILE_NAME || name == CONFIGURATION_TEMP_FILE_NAME || name == CONFIGURATION_PROFILE_FILE_NAME || name == FSEQ_PLAYLIST_FILE_NAME || name == FSEQ_DIRECTORY || name == UPDATE_DIRECTORY)
 		{
 			continue;
 		}
@@ -0,0 +1,373 @@
+/**
+ * @file FseqIndex.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NL::FseqIndex}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "util/FseqIndex.h"
+
+bool NL::FseqIndex::initialized = false;
+FS *NL::FseqIndex::fileSystem = nullptr;
+std::vector<NL::FseqIndex::Entry> NL::FseqIndex::entries;
+std::unordered_map<uint32_t, size_t> NL::FseqIndex::identifierMap;
+
+/**
+ * @brief Initialize the index and load it from the SD card.
+ * Files which were copied to or removed from the {@link FSEQ_DIRECTORY} directly are detected by their name and size.
+ * Only new or changed files are opened. When the index file is missing or invalid, it is rebuilt.
+ * This should only be called at boot, because it must not run while the animations are loaded.
+ * @param fileSystem file system where the fseq files are stored
+ * @return OK when the index was loaded or rebuilt
+ * @return ERROR_DIRECTORY when the fseq directory could not be read
+ * @return ERROR_FILE_OPEN when the updated index could not be saved
+ * @return ERROR_FILE_WRITE when the updated index could not be saved
+ */
+NL::FseqIndex::Error NL::FseqIndex::begin(FS *fileSystem)
+{
+	NL::FseqIndex::initialized = true;
+	NL::FseqIndex::fileSystem = fileSystem;
+	NL::FseqIndex::entries.clear();
+	NL::FseqIndex::identifierMap.clear();
+
+	if (!NL::FileUtil::directoryExists(fileSystem, FSEQ_DIRECTORY))
+	{
+		fileSystem->mkdir(FSEQ_DIRECTORY);
+	}
+
+	if (NL::FseqIndex::load() != NL::FseqIndex::Error::OK)
+	{
+		return NL::FseqIndex::rebuild();
+	}
+	return NL::FseqIndex::synchronize(false);
+}
+
+/**
+ * @brief Deinitialize the index.
+ */
+void NL::FseqIndex::end()
+{
+	NL::FseqIndex::initialized = false;
+	NL::FseqIndex::entries.clear();
+	NL::FseqIndex::identifierMap.clear();
+}
+
+/**
+ * @brief Check if the index was initialized.
+ * @return true when initialized
+ * @return false when not initialized
+ */
+bool NL::FseqIndex::isInitialized()
+{
+	return NL::FseqIndex::initialized;
+}
+
+/**
+ * @brief Rebuild the index from the files in the {@link FSEQ_DIRECTORY}.
+ * Every file is read once to calculate its identifier and to read its header. Hidden files, like the index itself, are skipped.
+ * The identifier is the checksum of the full content, so uploaded files keep the identifier they got from the {@link NL::FseqValidator}.
+ * This must not be called while the animations are loaded, because it blocks for each file on the SD card.
+ * @return OK when the index was rebuilt and saved
+ * @return ERROR_NOT_INITIALIZED when the index was not initialized
+ * @return ERROR_DIRECTORY when the fseq directory could not be read
+ * @return ERROR_FILE_OPEN when the index file could not be opened
+ * @return ERROR_FILE_WRITE when the index file could not be written
+ */
+NL::FseqIndex::Error NL::FseqIndex::rebuild()
+{
+	if (!NL::FseqIndex::initialized)
+	{
+		return NL::FseqIndex::Error::ERROR_NOT_INITIALIZED;
+	}
+
+	NL::FseqIndex::entries.clear();
+	return NL::FseqIndex::synchronize(true);
+}
+
+/**
+ * @brief Add a file to the index and save it. An existing entry with the same file name is replaced.
+ * @param entry entry of the new file
+ * @return OK when the entry was added
+ * @return ERROR_NOT_INITIALIZED when the index was not initialized
+ * @return ERROR_FILE_OPEN when the index file could not be opened
+ * @return ERROR_FILE_WRITE when the index file could not be written
+ */
+NL::FseqIndex::Error NL::FseqIndex::addEntry(const NL::FseqIndex::Entry &entry)
+{
+	if (!NL::FseqIndex::initialized)
+	{
+		return NL::FseqIndex::Error::ERROR_NOT_INITIALIZED;
+	}
+
+	bool replaced = false;
+	for (size_t i = 0; i < NL::FseqIndex::entries.size() && !replaced; i++)
+	{
+		if (NL::FseqIndex::entries.at(i).fileName == entry.fileName)
+		{
+			NL::FseqIndex::entries.at(i) = entry;
+			replaced = true;
+		}
+	}
+	if (!replaced)
+	{
+		NL::FseqIndex::entries.push_back(entry);
+	}
+
+	NL::FseqIndex::updateIdentifierMap();
+	return NL::FseqIndex::save();
+}
+
+/**
+ * @brief Remove a file from the index and save it.
+ * @param fileName name of the file in the fseq directory
+ * @return OK when the entry was removed or did not exist
+ * @return ERROR_NOT_INITIALIZED when the index was not initialized
+ * @return ERROR_FILE_OPEN when the index file could not be opened
+ * @return ERROR_FILE_WRITE when the index file could not be written
+ */
+NL::FseqIndex::Error NL::FseqIndex::removeEntry(const String fileName)
+{
+	if (!NL::FseqIndex::initialized)
+	{
+		return NL::FseqIndex::Error::ERROR_NOT_INITIALIZED;
+	}
+
+	for (size_t i = 0; i < NL::FseqIndex::entries.size(); i++)
+	{
+		if (NL::FseqIndex::entries.at(i).fileName == fileName)
+		{
+			NL::FseqIndex::entries.erase(NL::FseqIndex::entries.begin() + i);
+			NL::FseqIndex::updateIdentifierMap();
+			return NL::FseqIndex::save();
+		}
+	}
+
+	return NL::FseqIndex::Error::OK;
+}
+
+/**
+ * @brief Find a file by its identifier. The SD card is not accessed.
+ * @param identifier identifier of the file
+ * @param entry reference to the entry of the file
+ * @return true when the file was found
+ * @return false when no file has the identifier
+ */
+bool NL::FseqIndex::getEntry(const uint32_t identifier, NL::FseqIndex::Entry &entry)
+{
+	const std::unordered_map<uint32_t, size_t>::const_iterator iterator = NL::FseqIndex::identifierMap.find(identifier);
+	if (iterator == NL::FseqIndex::identifierMap.end())
+	{
+		return false;
+	}
+
+	entry = NL::FseqIndex::entries.at(iterator->second);
+	return true;
+}
+
+/**
+ * @brief Find a file by its name.
+ * @param fileName name of the file in the fseq directory
+ * @param entry reference to the entry of the file
+ * @return true when the file was found
+ * @return false when the file is not in the index
+ */
+bool NL::FseqIndex::getEntry(const String fileName, NL::FseqIndex::Entry &entry)
+{
+	for (size_t i = 0; i < NL::FseqIndex::entries.size(); i++)
+	{
+		if (NL::FseqIndex::entries.at(i).fileName == fileName)
+		{
+			entry = NL::FseqIndex::entries.at(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Get all files of the index.
+ * @return list of entries
+ */
+const std::vector<NL::FseqIndex::Entry> &NL::FseqIndex::getEntries()
+{
+	return NL::FseqIndex::entries;
+}
+
+/**
+ * @brief Load the index from the {@link FSEQ_INDEX_FILE_NAME}.
+ * @return OK when the index was loaded
+ * @return ERROR_FILE_OPEN when the file could not be opened
+ * @return ERROR_FILE_READ when the file could not be read
+ * @return ERROR_FILE_VERSION when the file version is not supported
+ */
+NL::FseqIndex::Error NL::FseqIndex::load()
+{
+	NL::BinaryFile file(NL::FseqIndex::fileSystem);
+	if (file.open(FSEQ_INDEX_FILE_NAME, FILE_READ) != NL::BinaryFile::Error::OK)
+	{
+		return NL::FseqIndex::Error::ERROR_FILE_OPEN;
+	}
+
+	uint8_t fileVersion = 0;
+	uint16_t entryCount = 0;
+	if (file.read(fileVersion) != NL::BinaryFile::Error::OK || file.read(entryCount) != NL::BinaryFile::Error::OK)
+	{
+		file.close();
+		return NL::FseqIndex::Error::ERROR_FILE_READ;
+	}
+	else if (fileVersion != FSEQ_INDEX_FILE_VERSION)
+	{
+		file.close();
+		return NL::FseqIndex::Error::ERROR_FILE_VERSION;
+	}
+
+	bool readError = false;
+	std::vector<NL::FseqIndex::Entry> entries(entryCount);
+	for (size_t i = 0; i < entries.size() && !readError; i++)
+	{
+		readError = file.read(entries.at(i).identifier) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.readString(entries.at(i).fileName) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(entries.at(i).fileSize) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(entries.at(i).channelCount) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(entries.at(i).frameCount) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(entries.at(i).stepTime) == NL::BinaryFile::Error::OK ? readError : true;
+	}
+	file.close();
+
+	if (readError)
+	{
+		return NL::FseqIndex::Error::ERROR_FILE_READ;
+	}
+
+	NL::FseqIndex::entries = entries;
+	NL::FseqIndex::updateIdentifierMap();
+	return NL::FseqIndex::Error::OK;
+}
+
+/**
+ * @brief Compare the index with the files in the {@link FSEQ_DIRECTORY} and save it when it changed.
+ * Entries are kept when a file with the same name and size exists. Only new or changed files are read to calculate their checksum.
+ * Invalid files are listed as well, so they can still be deleted.
+ * @param forceSave true to save the index even when it did not change
+ * @return OK when the index is up to date
+ * @return ERROR_DIRECTORY when the fseq directory could not be read
+ * @return ERROR_FILE_OPEN when the index file could not be opened
+ * @return ERROR_FILE_WRITE when the index file could not be written
+ */
+NL::FseqIndex::Error NL::FseqIndex::synchronize(const bool forceSave)
+{
+	File dir = NL::FseqIndex::fileSystem->open(FSEQ_DIRECTORY, FILE_READ);
+	if (!dir || !dir.isDirectory())
+	{
+		dir.close();
+		return NL::FseqIndex::Error::ERROR_DIRECTORY;
+	}
+
+	std::vector<std::pair<String, uint32_t>> files;
+	File file = dir.openNextFile(FILE_READ);
+	while (file)
+	{
+		const String fileName = file.name();
+		if (!file.isDirectory() && !fileName.startsWith(F(".")))
+		{
+			files.push_back(std::make_pair(fileName, file.size()));
+		}
+		file.close();
+		file = dir.openNextFile(FILE_READ);
+	}
+	dir.close();
+
+	bool changed = forceSave || files.size() != NL::FseqIndex::entries.size();
+	std::vector<NL::FseqIndex::Entry> entries;
+	entries.reserve(files.size());
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		NL::FseqIndex::Entry entry;
+		if (NL::FseqIndex::getEntry(files.at(i).first, entry) && entry.fileSize == files.at(i).second)
+		{
+			entries.push_back(entry);
+			continue;
+		}
+
+		const String fullFileName = FSEQ_DIRECTORY + (String)F("/") + files.at(i).first;
+		entry = {0, files.at(i).first, files.at(i).second, 0, 0, 0};
+		if (!NL::FileUtil::getFileIdentifier(NL::FseqIndex::fileSystem, fullFileName, entry.identifier))
+		{
+			continue;
+		}
+
+		NL::FseqLoader fseqLoader(NL::FseqIndex::fileSystem);
+		if (fseqLoader.loadFromFile(fullFileName) == NL::FseqLoader::Error::OK)
+		{
+			entry.channelCount = fseqLoader.getHeader().channelCount;
+			entry.frameCount = fseqLoader.getHeader().frameCount;
+			entry.stepTime = fseqLoader.getHeader().stepTime;
+		}
+		fseqLoader.close();
+
+		entries.push_back(entry);
+		changed = true;
+	}
+
+	NL::FseqIndex::entries = entries;
+	NL::FseqIndex::updateIdentifierMap();
+	return changed ? NL::FseqIndex::save() : NL::FseqIndex::Error::OK;
+}
+
+/**
+ * @brief Save the index to the {@link FSEQ_INDEX_FILE_NAME}.
+ * @return OK when the index was saved
+ * @return ERROR_FILE_OPEN when the file could not be opened
+ * @return ERROR_FILE_WRITE when the file could not be written
+ */
+NL::FseqIndex::Error NL::FseqIndex::save()
+{
+	NL::BinaryFile file(NL::FseqIndex::fileSystem);
+	if (file.open(FSEQ_INDEX_FILE_NAME, FILE_WRITE) != NL::BinaryFile::Error::OK)
+	{
+		return NL::FseqIndex::Error::ERROR_FILE_OPEN;
+	}
+
+	bool writeError = false;
+	writeError = file.write(static_cast<uint8_t>(FSEQ_INDEX_FILE_VERSION)) == NL::BinaryFile::Error::OK ? writeError : true;
+	writeError = file.write(static_cast<uint16_t>(NL::FseqIndex::entries.size())) == NL::BinaryFile::Error::OK ? writeError : true;
+	for (size_t i = 0; i < NL::FseqIndex::entries.size(); i++)
+	{
+		writeError = file.write(NL::FseqIndex::entries.at(i).identifier) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.writeString(NL::FseqIndex::entries.at(i).fileName) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(NL::FseqIndex::entries.at(i).fileSize) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(NL::FseqIndex::entries.at(i).channelCount) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(NL::FseqIndex::entries.at(i).frameCount) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(NL::FseqIndex::entries.at(i).stepTime) == NL::BinaryFile::Error::OK ? writeError : true;
+	}
+	writeError = file.close() == NL::BinaryFile::Error::OK ? writeError : true;
+
+	return writeError ? NL::FseqIndex::Error::ERROR_FILE_WRITE : NL::FseqIndex::Error::OK;
+}
+
+/**
+ * @brief Map the identifiers to the position of their entry. When two files have the same content, the first one is used.
+ */
+void NL::FseqIndex::updateIdentifierMap()
+{
+	NL::FseqIndex::identifierMap.clear();
+	for (size_t i = 0; i < NL::FseqIndex::entries.size(); i++)
+	{
+		NL::FseqIndex::identifierMap.emplace(NL::FseqIndex::entries.at(i).identifier, i);
+	}
+}
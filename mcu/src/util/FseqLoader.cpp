@@ -21,6 +21,9 @@
  */
 #include "util/FseqLoader.h"
 
+std::atomic<uint32_t> NL::FseqLoader::cacheHits(0);
+std::atomic<uint32_t> NL::FseqLoader::cacheMisses(0);
+
 /**
  * @brief Create a new instance of {@link NL::FseqLoader::FseqLoader}
  * @param fileSystem file system from which the file should be loaded
@@ -29,9 +32,54 @@ NL::FseqLoader::FseqLoader(FS *fileSystem)
 {
 	this->fileSystem = fileSystem;
 	this->initFseqHeader();
-	this->fillerBytes = 0;
 	this->zoneCount = 1;
 	this->zoneCounter = 0;
+
+	this->readerTaskHandle = NULL;
+	this->readerStopped = xSemaphoreCreateBinary();
+	this->readerRunning = false;
+	this->ringBuffer = nullptr;
+	this->producedFrames = 0;
+	this->consumedFrames = 0;
+	this->generation = 0;
+	this->seekFrame = 0;
+	this->currentFrame = nullptr;
+	this->currentFrameIndex = 0;
+	this->hasFrame = false;
+	this->underrunCount = 0;
+
+	this->playbackStart = 0;
+	this->playedFrames = 0;
+	this->clockValid = false;
+	this->skippedFrameCount = 0;
+	this->repeatedFrameCount = 0;
+
+	this->interpolation = false;
+	this->interpolationFrame = nullptr;
+	this->interpolationAlpha = 0;
+
+	this->cache = nullptr;
+	this->cacheLoaded = false;
+	this->cacheGeneration = 0;
+
+	this->frameSize = 0;
+	this->frameBuffer = nullptr;
+	this->inflator = nullptr;
+	this->dictionary = nullptr;
+	this->inputBuffer = nullptr;
+	this->inputPosition = 0;
+	this->inputAvailable = 0;
+	this->dictionaryOffset = 0;
+	this->pendingPosition = 0;
+	this->pendingSize = 0;
+	this->blockIndex = 0;
+	this->blockRemaining = 0;
+	this->blockDone = false;
+
+	this->deltaFrame = nullptr;
+	this->recordBuffer = nullptr;
+	this->recordBufferSize = 0;
+	this->deltaFrameIndex = 0;
 }
 
 /**
@@ -40,10 +88,17 @@ NL::FseqLoader::FseqLoader(FS *fileSystem)
 NL::FseqLoader::~FseqLoader()
 {
 	this->close();
+	if (this->readerStopped != NULL)
+	{
+		vSemaphoreDelete(this->readerStopped);
+		this->readerStopped = NULL;
+	}
 }
 
 /**
- * @brief Load a fseq version 1.0 file from the file system and check if it's valid.
+ * @brief Load a fseq version 1.0 or 2.x file from the file system and check if it's valid.
+ * Version 2 files can be uncompressed or zlib compressed and can contain sparse channel ranges.
+ * NikoLight sequence files, which are identified by "NLSQ", are loaded as well.
  * @param fileName full name and path of the fseq file
  * @return OK when the file was loaded and is valid
  * @return ERROR_FILE_NOT_FOUND when the file was not found
@@ -53,10 +108,13 @@ NL::FseqLoader::~FseqLoader()
  * @return ERROR_MAGIC_NUMBERS when the magic numbers do not match
  * @return ERROR_FILE_VERSION  when the file version is unsupported
  * @return ERROR_HEADER_LENGTH when the header length is invalid
- * @return ERROR_INVALID_DATA_LENGTH when the data length does not match the length specified in header
+ * @return ERROR_INVALID_DATA_LENGTH when the file has no frames or the data length does not match the length specified in header
+ * @return ERROR_COMPRESSION when the compression type is not supported or the block index is invalid
+ * @return ERROR_SPARSE_RANGE when the sparse channel ranges are invalid
  */
 NL::FseqLoader::Error NL::FseqLoader::loadFromFile(const String fileName)
 {
+	this->close();
 	this->file = this->fileSystem->open(fileName, FILE_READ);
 	if (!this->file)
 	{
@@ -76,6 +134,19 @@ NL::FseqLoader::Error NL::FseqLoader::loadFromFile(const String fileName)
 	bool readError = false;
 	this->initFseqHeader();
 	readError = this->file.readBytes((char *)&this->fseqHeader.identifier[0], 4) != 4 ? true : readError;
+	if (!readError && std::memcmp(this->fseqHeader.identifier, "NLSQ", 4) == 0)
+	{
+		const NL::FseqLoader::Error sequenceError = this->readSequenceHeader();
+		if (sequenceError != NL::FseqLoader::Error::OK)
+		{
+			this->file.close();
+			return sequenceError;
+		}
+
+		this->moveToStart();
+		return NL::FseqLoader::Error::OK;
+	}
+
 	readError = this->file.readBytes((char *)&this->fseqHeader.channelDataOffset, 2) != 2 ? true : readError;
 	readError = this->file.readBytes((char *)&this->fseqHeader.minorVersion, 1) != 1 ? true : readError;
 	readError = this->file.readBytes((char *)&this->fseqHeader.majorVersion, 1) != 1 ? true : readError;
@@ -84,17 +155,42 @@ NL::FseqLoader::Error NL::FseqLoader::loadFromFile(const String fileName)
 	readError = this->file.readBytes((char *)&this->fseqHeader.frameCount, 4) != 4 ? true : readError;
 	readError = this->file.readBytes((char *)&this->fseqHeader.stepTime, 1) != 1 ? true : readError;
 	readError = this->file.readBytes((char *)&this->fseqHeader.flags, 1) != 1 ? true : readError;
-	readError = this->file.readBytes((char *)&this->fseqHeader.universeCount, 2) != 2 ? true : readError;
-	readError = this->file.readBytes((char *)&this->fseqHeader.universeSize, 2) != 2 ? true : readError;
-	readError = this->file.readBytes((char *)&this->fseqHeader.gamma, 1) != 1 ? true : readError;
-	readError = this->file.readBytes((char *)&this->fseqHeader.colorEncoding, 1) != 1 ? true : readError;
-	readError = this->file.readBytes((char *)&this->fseqHeader.reserved, 2) != 2 ? true : readError;
+	if (this->fseqHeader.majorVersion == 2)
+	{
+		uint8_t compression = 0;
+		uint8_t blockCount = 0;
+		readError = this->file.readBytes((char *)&compression, 1) != 1 ? true : readError;
+		readError = this->file.readBytes((char *)&blockCount, 1) != 1 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.sparseRangeCount, 1) != 1 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.reserved, 1) != 1 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.uniqueId, 8) != 8 ? true : readError;
+		this->fseqHeader.compressionType = compression & 0x0F;
+		this->fseqHeader.compressionBlockCount = ((compression & 0xF0) << 4) | blockCount;
+	}
+	else
+	{
+		readError = this->file.readBytes((char *)&this->fseqHeader.universeCount, 2) != 2 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.universeSize, 2) != 2 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.gamma, 1) != 1 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.colorEncoding, 1) != 1 ? true : readError;
+		readError = this->file.readBytes((char *)&this->fseqHeader.reserved, 2) != 2 ? true : readError;
+	}
 	if (readError)
 	{
 		this->file.close();
 		return NL::FseqLoader::Error::ERROR_FILE_READ;
 	}
 
+	if (this->fseqHeader.majorVersion == 2)
+	{
+		const NL::FseqLoader::Error headerError = this->readHeaderV2();
+		if (headerError != NL::FseqLoader::Error::OK)
+		{
+			this->file.close();
+			return headerError;
+		}
+	}
+
 	const NL::FseqLoader::Error validationError = this->isValid();
 	if (validationError != NL::FseqLoader::Error::OK)
 	{
@@ -107,31 +203,186 @@ NL::FseqLoader::Error NL::FseqLoader::loadFromFile(const String fileName)
 }
 
 /**
- * @brief Return the number of remaining pixels in the file.
- * @return size_t number of pixels available to read
+ * @brief Start a background task, which reads the frames ahead into a ring buffer.
+ * Each frame is read with a single bulk read, so SD card latency spikes will not stall the render task.
+ * Animations which fit into {@link FSEQ_CACHE_SIZE} or {@link FSEQ_CACHE_SIZE_PSRAM} when PSRAM is available, are loaded once
+ * and played from RAM. The SD card is idle during the playback of a cached animation.
+ * A cache in internal RAM is only used when {@link FSEQ_HEAP_RESERVE} bytes are left for WiFi and the web server.
+ * Otherwise the animation is streamed through the ring buffer.
+ * @return OK when the read ahead task was started
+ * @return ERROR_FILE_NOT_FOUND when no file is loaded
+ * @return ERROR_READ_AHEAD when there is not enough heap for the buffers or the read ahead task could not be started
+ */
+NL::FseqLoader::Error NL::FseqLoader::startReadAhead()
+{
+	if (!this->file)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_NOT_FOUND;
+	}
+	else if (this->readerTaskHandle != NULL)
+	{
+		return NL::FseqLoader::Error::OK;
+	}
+
+	const size_t cacheSize = this->frameSize * this->fseqHeader.frameCount;
+	const bool psram = psramFound();
+	const bool cacheFits = psram ? cacheSize <= FSEQ_CACHE_SIZE_PSRAM : cacheSize <= FSEQ_CACHE_SIZE && heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) >= cacheSize + FSEQ_HEAP_RESERVE;
+	if (cacheSize > 0 && cacheFits)
+	{
+		this->cache = static_cast<uint8_t *>(heap_caps_malloc(cacheSize, psram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT));
+	}
+
+	// The buffers for streaming and decoding the frames must leave enough heap as well
+	size_t bufferSize = this->cache == nullptr ? this->frameSize * (FSEQ_READ_AHEAD_FRAMES + 1) : 0;
+	bufferSize += this->sparseRanges.size() > 0 ? this->fseqHeader.channelCount : 0;
+	bufferSize += this->deltaEncoded ? 2 * this->fseqHeader.channelCount + 2 * ((this->fseqHeader.channelCount + 16382) / 16383) : 0;
+	bufferSize += this->compressionBlocks.size() > 0 ? sizeof(tinfl_decompressor) + TINFL_LZ_DICT_SIZE + FSEQ_INPUT_BUFFER_SIZE : 0;
+	if (heap_caps_get_free_size(MALLOC_CAP_8BIT) < bufferSize + FSEQ_HEAP_RESERVE)
+	{
+		this->stopReadAhead();
+		return NL::FseqLoader::Error::ERROR_READ_AHEAD;
+	}
+
+	// Sparse frames are decoded into a separate buffer and channels outside of the ranges stay black
+	if (this->cache != nullptr)
+	{
+		std::memset(this->cache, 0, cacheSize);
+	}
+	else
+	{
+		this->ringBuffer = new uint8_t[this->frameSize * (FSEQ_READ_AHEAD_FRAMES + 1)];
+		std::memset(this->ringBuffer, 0, this->frameSize * (FSEQ_READ_AHEAD_FRAMES + 1));
+	}
+	if (this->sparseRanges.size() > 0)
+	{
+		this->frameBuffer = new uint8_t[this->fseqHeader.channelCount];
+	}
+	if (this->deltaEncoded)
+	{
+		this->deltaFrame = new uint8_t[this->fseqHeader.channelCount];
+		this->recordBufferSize = this->fseqHeader.channelCount + 2 * ((this->fseqHeader.channelCount + 16382) / 16383);
+		this->recordBuffer = new uint8_t[this->recordBufferSize];
+	}
+	if (this->compressionBlocks.size() > 0)
+	{
+		this->inflator = new tinfl_decompressor;
+		this->dictionary = new uint8_t[TINFL_LZ_DICT_SIZE];
+		this->inputBuffer = new uint8_t[FSEQ_INPUT_BUFFER_SIZE];
+	}
+
+	this->producedFrames = 0;
+	this->consumedFrames = 0;
+	this->cacheLoaded = false;
+	this->cacheGeneration = this->generation.load(std::memory_order_relaxed) - 1;
+	this->hasFrame = false;
+	this->readerRunning = true;
+	if (xTaskCreatePinnedToCore(NL::FseqLoader::readerTask, "fseqReader", FSEQ_READER_TASK_STACK_SIZE, this, FSEQ_READER_TASK_PRIORITY, &this->readerTaskHandle, FSEQ_READER_TASK_CORE) != pdPASS)
+	{
+		this->readerRunning = false;
+		this->readerTaskHandle = NULL;
+		this->stopReadAhead();
+		return NL::FseqLoader::Error::ERROR_READ_AHEAD;
+	}
+
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Check if the read ahead task has buffered enough frames to start the playback without an underrun.
+ * @return true when the ring buffer is filled or the cache is loaded
+ * @return false when the read ahead task is not running or still reading
+ */
+bool NL::FseqLoader::isBuffered()
+{
+	if (this->readerTaskHandle == NULL)
+	{
+		return false;
+	}
+	else if (this->cache != nullptr)
+	{
+		return this->cacheLoaded.load(std::memory_order_acquire);
+	}
+	return this->producedFrames.load(std::memory_order_acquire) - this->consumedFrames.load(std::memory_order_relaxed) >= FSEQ_READ_AHEAD_FRAMES;
+}
+
+/**
+ * @brief Return the number of remaining frames after the current frame.
+ * @return size_t number of frames available to read
  */
 size_t NL::FseqLoader::available()
 {
-	return this->file ? this->file.available() / 3 : 0;
+	if (!this->file)
+	{
+		return 0;
+	}
+	return this->hasFrame ? this->fseqHeader.frameCount - 1 - this->currentFrameIndex : this->fseqHeader.frameCount;
 }
 
 /**
  * @brief Reset the animation to the start.
+ * Frames which were already read ahead are dropped and the reader starts again from the first frame.
  */
 void NL::FseqLoader::moveToStart()
 {
-	if (this->file)
+	this->requestSeek(0);
+	this->hasFrame = false;
+	this->clockValid = false;
+	this->zoneCounter = 0;
+}
+
+/**
+ * @brief Continue the animation from the given frame.
+ * The offset of uncompressed frames is calculated directly, compressed files are decoded from the start of the block containing the frame.
+ * @param frameIndex index of the frame
+ * @return OK when the reader was moved to the frame
+ * @return ERROR_FILE_NOT_FOUND when no file is loaded
+ * @return ERROR_END_OF_FILE when the frame is behind the end of the file
+ */
+NL::FseqLoader::Error NL::FseqLoader::seekToFrame(const uint32_t frameIndex)
+{
+	if (!this->file)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_NOT_FOUND;
+	}
+	else if (frameIndex >= this->fseqHeader.frameCount)
 	{
-		this->file.seek(this->fseqHeader.channelDataOffset);
-		this->zoneCounter = 0;
+		return NL::FseqLoader::Error::ERROR_END_OF_FILE;
 	}
+
+	this->requestSeek(frameIndex);
+	this->hasFrame = false;
+	this->clockValid = false;
+	this->zoneCounter = 0;
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Continue the animation from the frame that is shown at the given time.
+ * @param time time since the start of the animation in ms
+ * @return OK when the reader was moved to the frame
+ * @return ERROR_FILE_NOT_FOUND when no file is loaded
+ * @return ERROR_END_OF_FILE when the time is behind the end of the file
+ */
+NL::FseqLoader::Error NL::FseqLoader::seekToTime(const uint32_t time)
+{
+	return this->seekToFrame(this->fseqHeader.stepTime > 0 ? time / this->fseqHeader.stepTime : 0);
+}
+
+/**
+ * @brief Get the index of the frame that is currently shown.
+ * @return index of the current frame or of the requested frame while seeking
+ */
+uint32_t NL::FseqLoader::getCurrentFrame()
+{
+	return this->hasFrame ? this->currentFrameIndex : this->seekFrame.load(std::memory_order_relaxed);
 }
 
 /**
- * @brief Close the input file.
+ * @brief Stop the read ahead task and close the input file.
  */
 void NL::FseqLoader::close()
 {
+	this->stopReadAhead();
 	if (this->file)
 	{
 		this->file.close();
@@ -148,66 +399,839 @@ NL::FseqLoader::FseqHeader NL::FseqLoader::getHeader()
 }
 
 /**
- * @brief Read a LED strip from the stream.
+ * @brief Get the size of a decoded frame. For sparse files this is the end of the last channel range.
+ * @return size of a decoded frame in bytes
+ */
+uint32_t NL::FseqLoader::getFrameSize()
+{
+	return this->frameSize;
+}
+
+/**
+ * @brief Check if the frames of the file fit a number of channels.
+ * The filler bytes at the end of each frame are ignored. Sparse files may end before the last channel.
+ * @param channelCount number of channels that are read from the frames
+ * @return true when the frames fit the number of channels
+ * @return false when the frames are too small or too large
+ */
+bool NL::FseqLoader::fitsChannelCount(const uint32_t channelCount)
+{
+	const uint32_t roundedChannelCount = channelCount % 4 ? channelCount + (4 - channelCount % 4) : channelCount;
+	return this->sparseRanges.size() > 0 ? this->frameSize <= roundedChannelCount : this->frameSize == roundedChannelCount;
+}
+
+/**
+ * @brief Copy the pixel data of a LED strip from the current frame.
+ * The first of the zones reading from the file moves to the next frame which was read ahead.
+ * When the next frame is not ready yet, the current frame is shown again.
+ * With interpolation enabled, the current frame is blended with the following frame by the time since the current frame started.
+ * Channels behind the last range of a sparse file are black.
  * @param ledStrip LED strip with the pixel data
+ * @param channelOffset offset of the first channel of the LED strip in the frame
+ * @param loop when true the animation continues with the first frame after the last one
  * @return OK when the pixel buffer was read
- * @return ERROR_END_OF_FILE when there is no more data to read
+ * @return ERROR_BUFFER_EMPTY when no frame was read ahead yet
+ * @return ERROR_END_OF_FILE when the frame does not contain enough data for the LED strip
+ */
+NL::FseqLoader::Error NL::FseqLoader::readLedStrip(NL::LedStrip &ledStrip, const size_t channelOffset, const bool loop)
+{
+	if (this->zoneCounter == 0)
+	{
+		this->advanceFrame(loop);
+		this->updateInterpolation(loop);
+	}
+	this->zoneCounter = this->zoneCounter + 1 < this->zoneCount ? this->zoneCounter + 1 : 0;
+
+	const size_t size = ledStrip.getLedCount() * 3;
+	const size_t offset = channelOffset;
+	if (!this->hasFrame)
+	{
+		return NL::FseqLoader::Error::ERROR_BUFFER_EMPTY;
+	}
+	else if (offset + size > this->frameSize)
+	{
+		if (this->sparseRanges.size() == 0)
+		{
+			return NL::FseqLoader::Error::ERROR_END_OF_FILE;
+		}
+
+		const size_t copySize = offset < this->frameSize ? this->frameSize - offset : 0;
+		this->copyChannels(ledStrip.getBuffer(), offset, copySize);
+		std::memset(ledStrip.getBuffer() + copySize, 0, size - copySize);
+		return NL::FseqLoader::Error::OK;
+	}
+
+	this->copyChannels(ledStrip.getBuffer(), offset, size);
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Set the number of zones that will read from the file. The first of them moves to the next frame.
+ * @param zoneCount number of zones
+ */
+void NL::FseqLoader::setZoneCount(const uint8_t zoneCount)
+{
+	this->zoneCount = zoneCount;
+}
+
+/**
+ * @brief Get the number of zones that will read from the file.
+ */
+uint8_t NL::FseqLoader::getZoneCount()
+{
+	return this->zoneCount;
+}
+
+/**
+ * @brief Enable or disable the interpolation between two frames.
+ * This allows to render low frame rate animations at a higher frame rate without storing additional frames.
+ * @param interpolation true to blend the current and the following frame
+ */
+void NL::FseqLoader::setInterpolation(const bool interpolation)
+{
+	this->interpolation = interpolation;
+}
+
+/**
+ * @brief Check if the interpolation between two frames is enabled.
+ * @return true when enabled
+ * @return false when disabled
+ */
+bool NL::FseqLoader::getInterpolation()
+{
+	return this->interpolation;
+}
+
+/**
+ * @brief Get the number of frames where the next frame was not read ahead in time.
+ * @return number of buffer underruns
+ */
+uint32_t NL::FseqLoader::getUnderrunCount()
+{
+	return this->underrunCount;
+}
+
+/**
+ * @brief Get the number of frames which were skipped because the render loop was behind the playback time.
+ * @return number of skipped frames
+ */
+uint32_t NL::FseqLoader::getSkippedFrameCount()
+{
+	return this->skippedFrameCount;
+}
+
+/**
+ * @brief Get the number of frames which were shown again because the render loop was ahead of the playback time.
+ * @return number of repeated frames
+ */
+uint32_t NL::FseqLoader::getRepeatedFrameCount()
+{
+	return this->repeatedFrameCount;
+}
+
+/**
+ * @brief Check if the animation is played from RAM.
+ * @return true when the animation is cached in RAM
+ * @return false when the animation is streamed from the SD card
+ */
+bool NL::FseqLoader::isCached()
+{
+	return this->cache != nullptr;
+}
+
+/**
+ * @brief Get the number of frames which were played from RAM since the start.
+ * @return number of cache hits
+ */
+uint32_t NL::FseqLoader::getCacheHits()
+{
+	return NL::FseqLoader::cacheHits.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the number of frames which were streamed from the SD card since the start.
+ * @return number of cache misses
+ */
+uint32_t NL::FseqLoader::getCacheMisses()
+{
+	return NL::FseqLoader::cacheMisses.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Linearly blend two frames with an 8 bit weight.
+ * Two channels are blended at once in the lower and upper byte of each 16 bit half of a word, so four channels only need
+ * four multiplications. The result is the same as blending each channel on its own.
+ * @param output output buffer, can be the same as one of the inputs
+ * @param from frame which is shown with a weight of 256 - alpha
+ * @param to frame which is shown with a weight of alpha
+ * @param size number of channels
+ * @param alpha weight of the second frame from 0 to 256
+ */
+void NL::FseqLoader::blendFrames(uint8_t *output, const uint8_t *from, const uint8_t *to, const size_t size, const uint16_t alpha)
+{
+	const uint32_t fromWeight = 256 - alpha;
+	size_t i = 0;
+	for (; i + 4 <= size; i += 4)
+	{
+		uint32_t fromChannels;
+		uint32_t toChannels;
+		std::memcpy(&fromChannels, from + i, 4);
+		std::memcpy(&toChannels, to + i, 4);
+
+		const uint32_t even = (((fromChannels & 0x00FF00FF) * fromWeight + (toChannels & 0x00FF00FF) * alpha) >> 8) & 0x00FF00FF;
+		const uint32_t odd = (((fromChannels >> 8) & 0x00FF00FF) * fromWeight + ((toChannels >> 8) & 0x00FF00FF) * alpha) & 0xFF00FF00;
+		const uint32_t blended = even | odd;
+		std::memcpy(output + i, &blended, 4);
+	}
+	for (; i < size; i++)
+	{
+		output[i] = (from[i] * fromWeight + to[i] * alpha) >> 8;
+	}
+}
+
+/**
+ * @brief Entry point of the read ahead task.
+ * @param parameter pointer to the {@link NL::FseqLoader}
+ */
+void NL::FseqLoader::readerTask(void *parameter)
+{
+	NL::FseqLoader *fseqLoader = static_cast<NL::FseqLoader *>(parameter);
+	if (fseqLoader->cache != nullptr)
+	{
+		fseqLoader->loadCache();
+	}
+	else
+	{
+		fseqLoader->readAhead();
+	}
+	xSemaphoreGive(fseqLoader->readerStopped);
+	vTaskDelete(NULL);
+}
+
+/**
+ * @brief Continuously read frames into the ring buffer until the task is stopped.
+ * One slot is always owned by the consumer, so at most {@link FSEQ_READ_AHEAD_FRAMES} frames are pending.
+ * The reader wraps around to the first frame at the end of the file.
  */
-NL::FseqLoader::Error NL::FseqLoader::readLedStrip(NL::LedStrip &ledStrip)
+void NL::FseqLoader::readAhead()
 {
-	if (this->file && this->available() >= ledStrip.getLedCount())
+	uint32_t readerGeneration = this->generation.load(std::memory_order_acquire) - 1;
+	uint32_t frameIndex = 0;
+	while (this->readerRunning.load(std::memory_order_acquire))
 	{
-		this->zoneCounter++;
-		if (this->zoneCounter >= this->zoneCount)
+		const uint32_t produced = this->producedFrames.load(std::memory_order_relaxed);
+		if (produced - this->consumedFrames.load(std::memory_order_acquire) >= FSEQ_READ_AHEAD_FRAMES)
+		{
+			ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+			continue;
+		}
+
+		// The slot is not visible to the consumer yet, so it can be used as scratch buffer while seeking
+		const uint8_t slot = produced % (FSEQ_READ_AHEAD_FRAMES + 1);
+		uint8_t *frame = this->ringBuffer + slot * this->frameSize;
+		uint8_t *storedFrame = this->frameBuffer != nullptr ? this->frameBuffer : frame;
+
+		// Seek to the requested frame or restart from the first frame at the end of the file
+		const uint32_t requestedGeneration = this->generation.load(std::memory_order_acquire);
+		if (readerGeneration != requestedGeneration || frameIndex >= this->fseqHeader.frameCount)
 		{
-			this->zoneCounter = 0;
-			if (!this->file.seek(this->fillerBytes, fs::SeekMode::SeekCur))
+			const uint32_t startFrame = readerGeneration != requestedGeneration ? this->seekFrame.load(std::memory_order_relaxed) : 0;
+			if (!this->seekReader(startFrame, storedFrame))
 			{
-				return NL::FseqLoader::Error::ERROR_END_OF_FILE;
+				vTaskDelay(pdMS_TO_TICKS(10));
+				continue;
 			}
+			readerGeneration = requestedGeneration;
+			frameIndex = startFrame;
+		}
+
+		if (!this->readFrame(storedFrame))
+		{
+			frameIndex = this->fseqHeader.frameCount;
+			vTaskDelay(pdMS_TO_TICKS(10));
+			continue;
+		}
+
+		this->scatterSparseFrame(frame);
+		this->slotFrameIndex[slot] = frameIndex;
+		this->slotGeneration[slot] = readerGeneration;
+		this->producedFrames.store(produced + 1, std::memory_order_release);
+		frameIndex++;
+	}
+}
+
+/**
+ * @brief Load all frames into the cache and wait until the task is stopped.
+ * When the file can not be read, loading is retried.
+ */
+void NL::FseqLoader::loadCache()
+{
+	bool loaded = false;
+	while (!loaded && this->readerRunning.load(std::memory_order_acquire))
+	{
+		loaded = this->seekReader(0, this->frameBuffer != nullptr ? this->frameBuffer : this->cache);
+		for (uint32_t i = 0; i < this->fseqHeader.frameCount && loaded; i++)
+		{
+			uint8_t *frame = this->cache + i * this->frameSize;
+			loaded = this->readFrame(this->frameBuffer != nullptr ? this->frameBuffer : frame);
+			this->scatterSparseFrame(frame);
 		}
 
-		if (this->file.read(ledStrip.getBuffer(), ledStrip.getLedCount() * 3) == ledStrip.getLedCount() * 3)
+		if (!loaded)
 		{
-			return NL::FseqLoader::Error::OK;
+			vTaskDelay(pdMS_TO_TICKS(100));
 		}
 	}
 
-	return NL::FseqLoader::Error::ERROR_END_OF_FILE;
+	this->cacheLoaded.store(loaded, std::memory_order_release);
+	while (this->readerRunning.load(std::memory_order_acquire))
+	{
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
 }
 
 /**
- * @brief Set the number of filler bytes which is skipped after each completed frame.
- * @param fillerBytes number of filler bytes
+ * @brief Move to the next frame from the ring buffer or the cache. Frames read before the last reset are dropped.
+ * @return true when a new frame is available
+ * @return false when no new frame was read ahead yet
  */
-void NL::FseqLoader::setFillerBytes(const uint8_t fillerBytes)
+bool NL::FseqLoader::nextFrame()
 {
-	this->fillerBytes = fillerBytes;
+	if (this->readerTaskHandle == NULL)
+	{
+		return false;
+	}
+	else if (this->cache != nullptr)
+	{
+		return this->nextCachedFrame();
+	}
+
+	const uint32_t currentGeneration = this->generation.load(std::memory_order_relaxed);
+	const uint32_t produced = this->producedFrames.load(std::memory_order_acquire);
+	uint32_t consumed = this->consumedFrames.load(std::memory_order_relaxed);
+	bool dropped = false;
+	bool found = false;
+	while (consumed != produced && !found)
+	{
+		const uint8_t slot = consumed % (FSEQ_READ_AHEAD_FRAMES + 1);
+		consumed++;
+		if (this->slotGeneration[slot] == currentGeneration)
+		{
+			this->currentFrame = this->ringBuffer + slot * this->frameSize;
+			this->currentFrameIndex = this->slotFrameIndex[slot];
+			found = true;
+		}
+		else
+		{
+			dropped = true;
+		}
+	}
+
+	// A dropped slot can be reused by the reader, so the current frame is no longer valid
+	if (found || dropped)
+	{
+		this->hasFrame = found;
+		this->consumedFrames.store(consumed, std::memory_order_release);
+	}
+	if (found)
+	{
+		NL::FseqLoader::cacheMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+	xTaskNotifyGive(this->readerTaskHandle);
+	return found;
 }
 
 /**
- * @brief Get the number of filler bytes which is skipped after each completed frame.
+ * @brief Move to the next frame of the cache. The cache contains all frames, so the next frame is always available once it is loaded.
+ * @return true when the cache is loaded
+ * @return false when the cache is still loading
  */
-uint8_t NL::FseqLoader::getFillerBytes()
+bool NL::FseqLoader::nextCachedFrame()
 {
-	return this->fillerBytes;
+	if (!this->cacheLoaded.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	const uint32_t currentGeneration = this->generation.load(std::memory_order_relaxed);
+	if (this->cacheGeneration != currentGeneration)
+	{
+		this->cacheGeneration = currentGeneration;
+		this->currentFrameIndex = this->seekFrame.load(std::memory_order_relaxed);
+	}
+	else
+	{
+		this->currentFrameIndex = this->currentFrameIndex + 1 < this->fseqHeader.frameCount ? this->currentFrameIndex + 1 : 0;
+	}
+
+	this->currentFrame = this->cache + this->currentFrameIndex * this->frameSize;
+	this->hasFrame = true;
+	NL::FseqLoader::cacheHits.fetch_add(1, std::memory_order_relaxed);
+	return true;
 }
 
 /**
- * @brief Set the number of zones that will read from the file.
- * @param zoneCount number of zones
+ * @brief Move to the frame that should be shown at the current time.
+ * When the render loop is ahead of the playback time, the current frame is shown again.
+ * When it is behind, frames which were read ahead are skipped. If it is behind by more than {@link FSEQ_MAX_FRAME_LAG}
+ * frames, the reader seeks forward instead. This keeps long animations in sync with the wall clock.
+ * @param loop when true the animation continues with the first frame after the last one
  */
-void NL::FseqLoader::setZoneCount(const uint8_t zoneCount)
+void NL::FseqLoader::advanceFrame(const bool loop)
 {
-	this->zoneCount = zoneCount;
+	const int64_t now = esp_timer_get_time();
+	if (!this->hasFrame)
+	{
+		if (!this->nextFrame())
+		{
+			this->underrunCount++;
+		}
+		else if (!this->clockValid)
+		{
+			this->playbackStart = now;
+			this->playedFrames = 0;
+			this->clockValid = true;
+		}
+		else
+		{
+			this->playedFrames++;
+		}
+		return;
+	}
+	else if (!loop && this->available() == 0)
+	{
+		return;
+	}
+
+	const uint32_t stepTime = this->fseqHeader.stepTime * 1000;
+	const uint32_t targetFrames = stepTime > 0 ? (now - this->playbackStart) / stepTime : this->playedFrames + 1;
+	if (targetFrames <= this->playedFrames)
+	{
+		this->repeatedFrameCount += this->interpolation ? 0 : 1;
+		return;
+	}
+
+	uint32_t lag = targetFrames - this->playedFrames;
+	if (lag > FSEQ_MAX_FRAME_LAG)
+	{
+		uint32_t frameIndex = this->currentFrameIndex + lag;
+		frameIndex = loop ? frameIndex % this->fseqHeader.frameCount : std::min(frameIndex, this->fseqHeader.frameCount - 1);
+		this->requestSeek(frameIndex);
+		this->skippedFrameCount += lag;
+		this->playedFrames = targetFrames;
+		return;
+	}
+
+	uint32_t advancedFrames = 0;
+	while (lag > 0 && this->nextFrame())
+	{
+		this->playedFrames++;
+		advancedFrames++;
+		lag--;
+		if (!loop && this->available() == 0)
+		{
+			break;
+		}
+	}
+
+	if (advancedFrames == 0)
+	{
+		this->underrunCount++;
+	}
+	else
+	{
+		this->skippedFrameCount += advancedFrames - 1;
+	}
 }
 
 /**
- * @brief Get the number of zones that will read from the file.
+ * @brief Find the frame following the current frame and calculate how far the playback has moved towards it.
+ * @param loop when true the first frame follows the last one
  */
-uint8_t NL::FseqLoader::getZoneCount()
+void NL::FseqLoader::updateInterpolation(const bool loop)
 {
-	return this->zoneCount;
+	this->interpolationFrame = nullptr;
+	this->interpolationAlpha = 0;
+	const uint32_t stepTime = this->fseqHeader.stepTime * 1000;
+	if (!this->interpolation || !this->hasFrame || !this->clockValid || stepTime == 0)
+	{
+		return;
+	}
+
+	const int64_t elapsed = esp_timer_get_time() - this->playbackStart - static_cast<int64_t>(this->playedFrames) * stepTime;
+	if (elapsed <= 0)
+	{
+		return;
+	}
+
+	this->interpolationFrame = this->peekNextFrame(loop);
+	this->interpolationAlpha = elapsed < stepTime ? elapsed * 256 / stepTime : 255;
+}
+
+/**
+ * @brief Get the frame following the current frame without moving to it.
+ * The frame is not consumed, so the reader will not overwrite it.
+ * @param loop when true the first frame follows the last one
+ * @return pointer to the following frame or nullptr when it was not read ahead yet
+ */
+const uint8_t *NL::FseqLoader::peekNextFrame(const bool loop)
+{
+	const uint32_t nextFrameIndex = this->currentFrameIndex + 1 < this->fseqHeader.frameCount ? this->currentFrameIndex + 1 : 0;
+	if (!loop && nextFrameIndex == 0)
+	{
+		return nullptr;
+	}
+	else if (this->cache != nullptr)
+	{
+		return this->cacheGeneration == this->generation.load(std::memory_order_relaxed) ? this->cache + nextFrameIndex * this->frameSize : nullptr;
+	}
+
+	const uint32_t consumed = this->consumedFrames.load(std::memory_order_relaxed);
+	if (this->producedFrames.load(std::memory_order_acquire) == consumed)
+	{
+		return nullptr;
+	}
+
+	const uint8_t slot = consumed % (FSEQ_READ_AHEAD_FRAMES + 1);
+	if (this->slotGeneration[slot] != this->generation.load(std::memory_order_relaxed) || this->slotFrameIndex[slot] != nextFrameIndex)
+	{
+		return nullptr;
+	}
+	return this->ringBuffer + slot * this->frameSize;
+}
+
+/**
+ * @brief Copy channels of the current frame, blended with the following frame when interpolating.
+ * @param output output buffer
+ * @param offset offset of the first channel in the frame
+ * @param size number of channels
+ */
+void NL::FseqLoader::copyChannels(uint8_t *output, const size_t offset, const size_t size)
+{
+	if (this->interpolationFrame != nullptr && this->interpolationAlpha > 0)
+	{
+		NL::FseqLoader::blendFrames(output, this->currentFrame + offset, this->interpolationFrame + offset, size, this->interpolationAlpha);
+	}
+	else
+	{
+		std::memcpy(output, this->currentFrame + offset, size);
+	}
+}
+
+/**
+ * @brief Request the reader to continue from the given frame. Frames which were already read ahead are dropped.
+ * @param frameIndex index of the frame
+ */
+void NL::FseqLoader::requestSeek(const uint32_t frameIndex)
+{
+	this->seekFrame.store(frameIndex, std::memory_order_relaxed);
+	this->generation.fetch_add(1, std::memory_order_release);
+	if (this->readerTaskHandle != NULL)
+	{
+		xTaskNotifyGive(this->readerTaskHandle);
+	}
+}
+
+/**
+ * @brief Stop the read ahead task and free the ring buffer.
+ */
+void NL::FseqLoader::stopReadAhead()
+{
+	if (this->readerTaskHandle != NULL)
+	{
+		this->readerRunning = false;
+		xTaskNotifyGive(this->readerTaskHandle);
+		xSemaphoreTake(this->readerStopped, portMAX_DELAY);
+		this->readerTaskHandle = NULL;
+	}
+
+	if (this->ringBuffer != nullptr)
+	{
+		delete[] this->ringBuffer;
+		this->ringBuffer = nullptr;
+	}
+	if (this->cache != nullptr)
+	{
+		heap_caps_free(this->cache);
+		this->cache = nullptr;
+	}
+	this->cacheLoaded = false;
+	if (this->frameBuffer != nullptr)
+	{
+		delete[] this->frameBuffer;
+		this->frameBuffer = nullptr;
+	}
+	if (this->inflator != nullptr)
+	{
+		delete this->inflator;
+		this->inflator = nullptr;
+	}
+	if (this->dictionary != nullptr)
+	{
+		delete[] this->dictionary;
+		this->dictionary = nullptr;
+	}
+	if (this->inputBuffer != nullptr)
+	{
+		delete[] this->inputBuffer;
+		this->inputBuffer = nullptr;
+	}
+	if (this->deltaFrame != nullptr)
+	{
+		delete[] this->deltaFrame;
+		this->deltaFrame = nullptr;
+	}
+	if (this->recordBuffer != nullptr)
+	{
+		delete[] this->recordBuffer;
+		this->recordBuffer = nullptr;
+	}
+	this->hasFrame = false;
+}
+
+/**
+ * @brief Move the reader to a frame of the file.
+ * Compressed blocks can only be decoded from their start, so the frames in front of the requested frame are decoded and dropped.
+ * @param frameIndex index of the frame
+ * @param buffer scratch buffer of at least channelCount bytes
+ * @return true when the reader was moved to the frame
+ * @return false when the file could not be seeked or decoded
+ */
+bool NL::FseqLoader::seekReader(const uint32_t frameIndex, uint8_t *buffer)
+{
+	if (this->deltaEncoded)
+	{
+		const uint32_t keyframe = frameIndex / this->keyframeInterval;
+		if (!this->file.seek(this->keyframeOffsets.at(keyframe)))
+		{
+			return false;
+		}
+
+		this->deltaFrameIndex = keyframe * this->keyframeInterval;
+		while (this->deltaFrameIndex < frameIndex)
+		{
+			if (!this->readDeltaFrame(buffer))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	else if (this->compressionBlocks.size() == 0)
+	{
+		return this->file.seek(this->fseqHeader.channelDataOffset + frameIndex * this->fseqHeader.channelCount);
+	}
+
+	const std::vector<NL::FseqLoader::CompressionBlock>::iterator block = std::upper_bound(
+		this->compressionBlocks.begin(), this->compressionBlocks.end(), frameIndex,
+		[](const uint32_t frameIndex, const NL::FseqLoader::CompressionBlock &block)
+		{ return frameIndex < block.firstFrame; });
+	const size_t index = block - this->compressionBlocks.begin() - 1;
+	if (!this->openBlock(index))
+	{
+		return false;
+	}
+
+	for (uint32_t i = this->compressionBlocks.at(index).firstFrame; i < frameIndex; i++)
+	{
+		if (!this->readFrame(buffer))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Read the stored channel data of the next frame. Compressed data is decoded on the fly.
+ * @param buffer buffer of at least channelCount bytes
+ * @return true when the frame was read
+ * @return false when the frame could not be read or decoded
+ */
+bool NL::FseqLoader::readFrame(uint8_t *buffer)
+{
+	if (this->deltaEncoded)
+	{
+		return this->readDeltaFrame(buffer);
+	}
+	else if (this->compressionBlocks.size() > 0)
+	{
+		return this->inflate(buffer, this->fseqHeader.channelCount);
+	}
+	return this->file.read(buffer, this->fseqHeader.channelCount) == this->fseqHeader.channelCount;
+}
+
+/**
+ * @brief Read the next frame of a NikoLight sequence and apply it to the decoded frame.
+ * Each frame is stored as XOR delta to the previous frame, keyframes are stored as delta to a black frame.
+ * The delta is a list of spans, each starting with a 16 bit code. The upper 2 bits contain the type of the span
+ * and the lower 14 bits the length. Type 0 skips unchanged channels, type 1 is followed by one XOR value per channel
+ * and type 2 is followed by a single pixel, which is XORed to the given number of pixels.
+ * @param buffer buffer of at least channelCount bytes
+ * @return true when the frame was read
+ * @return false when the frame could not be read or is invalid
+ */
+bool NL::FseqLoader::readDeltaFrame(uint8_t *buffer)
+{
+	uint32_t recordLength = 0;
+	if (this->file.read((uint8_t *)&recordLength, 4) != 4 || recordLength > this->recordBufferSize || this->file.read(this->recordBuffer, recordLength) != recordLength)
+	{
+		return false;
+	}
+
+	if (this->deltaFrameIndex % this->keyframeInterval == 0)
+	{
+		std::memset(this->deltaFrame, 0, this->fseqHeader.channelCount);
+	}
+
+	size_t position = 0;
+	size_t channel = 0;
+	while (position + 2 <= recordLength)
+	{
+		const uint16_t code = this->recordBuffer[position] | (this->recordBuffer[position + 1] << 8);
+		const uint8_t type = code >> 14;
+		const size_t length = code & 0x3FFF;
+		position += 2;
+
+		if (type == 0 && channel + length <= this->fseqHeader.channelCount)
+		{
+			channel += length;
+		}
+		else if (type == 1 && channel + length <= this->fseqHeader.channelCount && position + length <= recordLength)
+		{
+			for (size_t i = 0; i < length; i++)
+			{
+				this->deltaFrame[channel++] ^= this->recordBuffer[position++];
+			}
+		}
+		else if (type == 2 && channel + length * 3 <= this->fseqHeader.channelCount && position + 3 <= recordLength)
+		{
+			for (size_t i = 0; i < length; i++)
+			{
+				this->deltaFrame[channel++] ^= this->recordBuffer[position];
+				this->deltaFrame[channel++] ^= this->recordBuffer[position + 1];
+				this->deltaFrame[channel++] ^= this->recordBuffer[position + 2];
+			}
+			position += 3;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	std::memcpy(buffer, this->deltaFrame, this->fseqHeader.channelCount);
+	this->deltaFrameIndex++;
+	return position == recordLength;
+}
+
+/**
+ * @brief Copy the channels of a sparse frame from the frame buffer to the ranges of the output frame.
+ * Nothing is done for files without sparse ranges, because their frames are read directly into the output frame.
+ * @param frame output frame
+ */
+void NL::FseqLoader::scatterSparseFrame(uint8_t *frame)
+{
+	if (this->frameBuffer == nullptr)
+	{
+		return;
+	}
+
+	size_t position = 0;
+	for (size_t i = 0; i < this->sparseRanges.size(); i++)
+	{
+		std::memcpy(frame + this->sparseRanges.at(i).startChannel, this->frameBuffer + position, this->sparseRanges.at(i).channelCount);
+		position += this->sparseRanges.at(i).channelCount;
+	}
+}
+
+/**
+ * @brief Seek to a compression block and reset the decompressor. Each block is an independent zlib stream.
+ * @param index index of the block
+ * @return true when the block was opened
+ * @return false when there is no such block or the file could not be seeked
+ */
+bool NL::FseqLoader::openBlock(const size_t index)
+{
+	if (index >= this->compressionBlocks.size() || !this->file.seek(this->compressionBlocks.at(index).offset))
+	{
+		return false;
+	}
+
+	tinfl_init(this->inflator);
+	this->blockIndex = index;
+	this->blockRemaining = this->compressionBlocks.at(index).length;
+	this->inputPosition = 0;
+	this->inputAvailable = 0;
+	this->dictionaryOffset = 0;
+	this->pendingPosition = 0;
+	this->pendingSize = 0;
+	this->blockDone = false;
+	return true;
+}
+
+/**
+ * @brief Decode the next bytes from the compressed channel data.
+ * The decompressor writes into a wrapping 32 KB dictionary, bytes which do not fit into the buffer are kept for the next call.
+ * @param buffer output buffer
+ * @param size number of bytes to decode
+ * @return true when all bytes were decoded
+ * @return false when the compressed data is invalid or truncated
+ */
+bool NL::FseqLoader::inflate(uint8_t *buffer, size_t size)
+{
+	while (size > 0)
+	{
+		if (this->pendingSize > 0)
+		{
+			const size_t copySize = this->pendingSize < size ? this->pendingSize : size;
+			std::memcpy(buffer, this->dictionary + this->pendingPosition, copySize);
+			buffer += copySize;
+			size -= copySize;
+			this->pendingPosition += copySize;
+			this->pendingSize -= copySize;
+			continue;
+		}
+		else if (this->blockDone)
+		{
+			if (!this->openBlock(this->blockIndex + 1))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (this->inputPosition == this->inputAvailable && this->blockRemaining > 0)
+		{
+			const size_t readSize = this->blockRemaining < FSEQ_INPUT_BUFFER_SIZE ? this->blockRemaining : FSEQ_INPUT_BUFFER_SIZE;
+			if (this->file.read(this->inputBuffer, readSize) != readSize)
+			{
+				return false;
+			}
+			this->inputPosition = 0;
+			this->inputAvailable = readSize;
+			this->blockRemaining -= readSize;
+		}
+
+		size_t inputSize = this->inputAvailable - this->inputPosition;
+		size_t outputSize = TINFL_LZ_DICT_SIZE - this->dictionaryOffset;
+		const uint32_t flags = TINFL_FLAG_PARSE_ZLIB_HEADER | (this->blockRemaining > 0 ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+		const tinfl_status status = tinfl_decompress(this->inflator, this->inputBuffer + this->inputPosition, &inputSize, this->dictionary, this->dictionary + this->dictionaryOffset, &outputSize, flags);
+		this->inputPosition += inputSize;
+		this->pendingPosition = this->dictionaryOffset;
+		this->pendingSize = outputSize;
+		this->dictionaryOffset = (this->dictionaryOffset + outputSize) & (TINFL_LZ_DICT_SIZE - 1);
+		if (status < TINFL_STATUS_DONE)
+		{
+			return false;
+		}
+		else if (status == TINFL_STATUS_DONE)
+		{
+			this->blockDone = true;
+		}
+	}
+
+	return true;
 }
 
 /**
@@ -232,6 +1256,119 @@ void NL::FseqLoader::initFseqHeader()
 	this->fseqHeader.gamma = 0;
 	this->fseqHeader.colorEncoding = 0;
 	this->fseqHeader.reserved = 0;
+	this->fseqHeader.compressionType = 0;
+	this->fseqHeader.compressionBlockCount = 0;
+	this->fseqHeader.sparseRangeCount = 0;
+	this->fseqHeader.uniqueId = 0;
+	this->compressionBlocks.clear();
+	this->sparseRanges.clear();
+	this->frameSize = 0;
+	this->deltaEncoded = false;
+	this->keyframeInterval = 0;
+	this->keyframeOffsets.clear();
+}
+
+/**
+ * @brief Read the compression block index and the sparse channel ranges of a version 2 file.
+ * Blocks with a length of 0 are unused entries of the index and are skipped.
+ * The first frames of the blocks must not decrease, because the reader searches the index with a binary search.
+ * @return OK when the variable header was read
+ * @return ERROR_FILE_READ when the file could not be read
+ * @return ERROR_HEADER_LENGTH when the header length is invalid
+ * @return ERROR_COMPRESSION when the block index is not sorted
+ */
+NL::FseqLoader::Error NL::FseqLoader::readHeaderV2()
+{
+	const uint32_t indexLength = 32 + this->fseqHeader.compressionBlockCount * 8 + this->fseqHeader.sparseRangeCount * 6;
+	if (this->fseqHeader.headerLength < indexLength || this->fseqHeader.channelDataOffset < this->fseqHeader.headerLength || this->file.size() < this->fseqHeader.channelDataOffset)
+	{
+		return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
+	}
+
+	bool readError = false;
+	uint32_t blockOffset = this->fseqHeader.channelDataOffset;
+	for (uint16_t i = 0; i < this->fseqHeader.compressionBlockCount; i++)
+	{
+		NL::FseqLoader::CompressionBlock block;
+		readError = this->file.readBytes((char *)&block.firstFrame, 4) != 4 ? true : readError;
+		readError = this->file.readBytes((char *)&block.length, 4) != 4 ? true : readError;
+		block.offset = blockOffset;
+		blockOffset += block.length;
+		if (block.length > 0)
+		{
+			if (this->compressionBlocks.size() > 0 && block.firstFrame < this->compressionBlocks.back().firstFrame)
+			{
+				return readError ? NL::FseqLoader::Error::ERROR_FILE_READ : NL::FseqLoader::Error::ERROR_COMPRESSION;
+			}
+			this->compressionBlocks.push_back(block);
+		}
+	}
+
+	for (uint8_t i = 0; i < this->fseqHeader.sparseRangeCount; i++)
+	{
+		NL::FseqLoader::SparseRange range = {0, 0};
+		readError = this->file.readBytes((char *)&range.startChannel, 3) != 3 ? true : readError;
+		readError = this->file.readBytes((char *)&range.channelCount, 3) != 3 ? true : readError;
+		this->sparseRanges.push_back(range);
+	}
+
+	return readError ? NL::FseqLoader::Error::ERROR_FILE_READ : NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Read and validate the header and the keyframe index of a NikoLight sequence file.
+ * @return OK when the header is valid
+ * @return ERROR_FILE_READ when the file could not be read
+ * @return ERROR_FILE_VERSION when the file version is unsupported
+ * @return ERROR_HEADER_LENGTH when the keyframe index is invalid
+ * @return ERROR_INVALID_DATA_LENGTH when a keyframe is outside of the file
+ */
+NL::FseqLoader::Error NL::FseqLoader::readSequenceHeader()
+{
+	bool readError = false;
+	uint32_t keyframeCount = 0;
+	uint32_t dataOffset = 0;
+	readError = this->file.readBytes((char *)&this->fseqHeader.majorVersion, 1) != 1 ? true : readError;
+	readError = this->file.readBytes((char *)&this->fseqHeader.stepTime, 1) != 1 ? true : readError;
+	readError = this->file.readBytes((char *)&this->keyframeInterval, 2) != 2 ? true : readError;
+	readError = this->file.readBytes((char *)&this->fseqHeader.channelCount, 4) != 4 ? true : readError;
+	readError = this->file.readBytes((char *)&this->fseqHeader.frameCount, 4) != 4 ? true : readError;
+	readError = this->file.readBytes((char *)&keyframeCount, 4) != 4 ? true : readError;
+	readError = this->file.readBytes((char *)&dataOffset, 4) != 4 ? true : readError;
+	if (readError)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_READ;
+	}
+
+	this->fseqHeader.headerLength = 24;
+	if (this->fseqHeader.majorVersion != 1)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_VERSION;
+	}
+	else if (this->fseqHeader.frameCount == 0 || this->keyframeInterval == 0 || keyframeCount != (this->fseqHeader.frameCount + this->keyframeInterval - 1) / this->keyframeInterval || dataOffset != 24 + keyframeCount * 4 || dataOffset > this->file.size())
+	{
+		return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
+	}
+
+	this->keyframeOffsets.resize(keyframeCount);
+	if (this->file.read((uint8_t *)this->keyframeOffsets.data(), keyframeCount * 4) != keyframeCount * 4)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_READ;
+	}
+
+	uint32_t previousOffset = dataOffset;
+	for (size_t i = 0; i < this->keyframeOffsets.size(); i++)
+	{
+		if (this->keyframeOffsets.at(i) < previousOffset || this->keyframeOffsets.at(i) + 4 > this->file.size())
+		{
+			return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+		}
+		previousOffset = this->keyframeOffsets.at(i) + 4;
+	}
+
+	this->deltaEncoded = true;
+	this->frameSize = this->fseqHeader.channelCount;
+	return NL::FseqLoader::Error::OK;
 }
 
 /**
@@ -240,7 +1377,9 @@ void NL::FseqLoader::initFseqHeader()
  * @return ERROR_MAGIC_NUMBERS when the magic numbers do not match
  * @return ERROR_FILE_VERSION  when the file version is unsupported
  * @return ERROR_HEADER_LENGTH when the header length is invalid
- * @return ERROR_INVALID_DATA_LENGTH when the data length does not match the length specified in header
+ * @return ERROR_INVALID_DATA_LENGTH when the file has no frames or the data length does not match the length specified in header
+ * @return ERROR_COMPRESSION when the compression type is not supported or the block index is invalid
+ * @return ERROR_SPARSE_RANGE when the sparse channel ranges are invalid
  */
 NL::FseqLoader::Error NL::FseqLoader::isValid()
 {
@@ -251,21 +1390,68 @@ NL::FseqLoader::Error NL::FseqLoader::isValid()
 	}
 
 	// Check the version
-	if (this->fseqHeader.minorVersion != 0 || this->fseqHeader.majorVersion != 1)
+	if ((this->fseqHeader.minorVersion != 0 || this->fseqHeader.majorVersion != 1) && this->fseqHeader.majorVersion != 2)
 	{
 		return NL::FseqLoader::Error::ERROR_FILE_VERSION;
 	}
 
-	// Check the header length
-	if (this->fseqHeader.headerLength != 28)
+	// Check the header length, version 2 was already checked while reading the variable header
+	if (this->fseqHeader.majorVersion == 1 && this->fseqHeader.headerLength != 28)
 	{
 		return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
 	}
 
+	// Check the frame count, a file without frames would keep the reader searching for the next frame forever
+	if (this->fseqHeader.frameCount == 0)
+	{
+		return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+	}
+
+	// Check the compression, zstd is not supported because there is no decoder available on the controller
+	const NL::FseqLoader::CompressionType compressionType = static_cast<NL::FseqLoader::CompressionType>(this->fseqHeader.compressionType);
+	if (compressionType != NL::FseqLoader::CompressionType::NONE && compressionType != NL::FseqLoader::CompressionType::ZLIB)
+	{
+		return NL::FseqLoader::Error::ERROR_COMPRESSION;
+	}
+	else if (compressionType == NL::FseqLoader::CompressionType::NONE)
+	{
+		this->compressionBlocks.clear();
+	}
+	else if (this->compressionBlocks.size() == 0 || this->compressionBlocks.at(0).firstFrame != 0)
+	{
+		return NL::FseqLoader::Error::ERROR_COMPRESSION;
+	}
+
+	// Check the sparse ranges, the stored channels are the sum of all ranges
+	uint32_t sparseChannelCount = 0;
+	this->frameSize = this->fseqHeader.channelCount;
+	if (this->sparseRanges.size() > 0)
+	{
+		this->frameSize = 0;
+		for (size_t i = 0; i < this->sparseRanges.size(); i++)
+		{
+			const uint32_t rangeEnd = this->sparseRanges.at(i).startChannel + this->sparseRanges.at(i).channelCount;
+			sparseChannelCount += this->sparseRanges.at(i).channelCount;
+			this->frameSize = rangeEnd > this->frameSize ? rangeEnd : this->frameSize;
+		}
+		if (sparseChannelCount != this->fseqHeader.channelCount)
+		{
+			return NL::FseqLoader::Error::ERROR_SPARSE_RANGE;
+		}
+	}
+
 	// Check the channelCount, frameCount and data block length
 	uint32_t dataLength = this->file.size() - this->fseqHeader.channelDataOffset;
 	uint32_t expectedLength = this->fseqHeader.channelCount * this->fseqHeader.frameCount;
-	if (dataLength != expectedLength)
+	if (this->compressionBlocks.size() > 0)
+	{
+		const NL::FseqLoader::CompressionBlock &lastBlock = this->compressionBlocks.at(this->compressionBlocks.size() - 1);
+		if (lastBlock.offset + lastBlock.length > this->file.size())
+		{
+			return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+		}
+	}
+	else if (dataLength != expectedLength)
 	{
 		return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
 	}
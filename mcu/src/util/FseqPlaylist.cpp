@@ -0,0 +1,569 @@
+/**
+ * @file FseqPlaylist.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NL::FseqPlaylist}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "util/FseqPlaylist.h"
+
+/**
+ * @brief Create a new instance of {@link NL::FseqPlaylist}.
+ * @param fileSystem file system from which the playlist and fseq files are loaded
+ */
+NL::FseqPlaylist::FseqPlaylist(FS *fileSystem)
+{
+	this->fileSystem = fileSystem;
+	this->zoneCount = 1;
+	this->zoneCounter = 0;
+	this->channelCount = 0;
+
+	this->currentEntry = 0;
+	this->nextEntry = 0;
+	this->passCount = 0;
+	this->lastFrameIndex = 0;
+	this->fadeAlpha = 0;
+	this->lateSwitchCount = 0;
+	this->interpolation = false;
+
+	this->playlistTaskHandle = NULL;
+	this->playlistStopped = xSemaphoreCreateBinary();
+	this->playlistRunning = false;
+	this->nextReady = false;
+}
+
+/**
+ * @brief Destroy the {@link NL::FseqPlaylist} and close all fseq files.
+ */
+NL::FseqPlaylist::~FseqPlaylist()
+{
+	this->close();
+	if (this->playlistStopped != NULL)
+	{
+		vSemaphoreDelete(this->playlistStopped);
+		this->playlistStopped = NULL;
+	}
+}
+
+/**
+ * @brief Load the entries of the playlist from a file.
+ * @param fileName full path and name of the playlist file
+ * @return OK when the playlist was loaded
+ * @return ERROR_FILE_OPEN when the file could not be opened
+ * @return ERROR_FILE_READ when the file could not be read
+ * @return ERROR_FILE_VERSION when the file version is not supported
+ * @return ERROR_EMPTY when the playlist has no entries
+ * @return ERROR_TOO_MANY_ENTRIES when the playlist has too many entries
+ */
+NL::FseqPlaylist::Error NL::FseqPlaylist::loadFromFile(const String fileName)
+{
+	NL::BinaryFile file(this->fileSystem);
+	if (file.open(fileName, FILE_READ) != NL::BinaryFile::Error::OK)
+	{
+		return NL::FseqPlaylist::Error::ERROR_FILE_OPEN;
+	}
+
+	uint8_t fileVersion = 0;
+	uint8_t entryCount = 0;
+	if (file.read(fileVersion) != NL::BinaryFile::Error::OK || file.read(entryCount) != NL::BinaryFile::Error::OK)
+	{
+		file.close();
+		return NL::FseqPlaylist::Error::ERROR_FILE_READ;
+	}
+	else if (fileVersion != 1)
+	{
+		file.close();
+		return NL::FseqPlaylist::Error::ERROR_FILE_VERSION;
+	}
+	else if (entryCount > FSEQ_PLAYLIST_MAX_ENTRIES)
+	{
+		file.close();
+		return NL::FseqPlaylist::Error::ERROR_TOO_MANY_ENTRIES;
+	}
+
+	bool readError = false;
+	std::vector<NL::FseqPlaylist::Entry> entries(entryCount);
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		readError = file.readString(entries.at(i).fileName) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(entries.at(i).repeatCount) == NL::BinaryFile::Error::OK ? readError : true;
+		readError = file.read(entries.at(i).crossfadeFrames) == NL::BinaryFile::Error::OK ? readError : true;
+	}
+	file.close();
+
+	if (readError)
+	{
+		return NL::FseqPlaylist::Error::ERROR_FILE_READ;
+	}
+	return this->setEntries(entries);
+}
+
+/**
+ * @brief Save the entries of the playlist to a file.
+ * @param fileName full path and name of the playlist file
+ * @return OK when the playlist was saved
+ * @return ERROR_FILE_OPEN when the file could not be opened
+ * @return ERROR_FILE_WRITE when the file could not be written
+ */
+NL::FseqPlaylist::Error NL::FseqPlaylist::saveToFile(const String fileName)
+{
+	NL::BinaryFile file(this->fileSystem);
+	if (file.open(fileName, FILE_WRITE) != NL::BinaryFile::Error::OK)
+	{
+		return NL::FseqPlaylist::Error::ERROR_FILE_OPEN;
+	}
+
+	bool writeError = false;
+	writeError = file.write(static_cast<uint8_t>(1)) == NL::BinaryFile::Error::OK ? writeError : true;
+	writeError = file.write(static_cast<uint8_t>(this->entries.size())) == NL::BinaryFile::Error::OK ? writeError : true;
+	for (size_t i = 0; i < this->entries.size(); i++)
+	{
+		writeError = file.writeString(this->entries.at(i).fileName) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(this->entries.at(i).repeatCount) == NL::BinaryFile::Error::OK ? writeError : true;
+		writeError = file.write(this->entries.at(i).crossfadeFrames) == NL::BinaryFile::Error::OK ? writeError : true;
+	}
+	writeError = file.close() == NL::BinaryFile::Error::OK ? writeError : true;
+
+	return writeError ? NL::FseqPlaylist::Error::ERROR_FILE_WRITE : NL::FseqPlaylist::Error::OK;
+}
+
+/**
+ * @brief Set the entries of the playlist. Must be called before the playlist is opened.
+ * @param entries list of entries
+ * @return OK when the entries were set
+ * @return ERROR_EMPTY when the list is empty
+ * @return ERROR_TOO_MANY_ENTRIES when the list has too many entries
+ */
+NL::FseqPlaylist::Error NL::FseqPlaylist::setEntries(const std::vector<NL::FseqPlaylist::Entry> &entries)
+{
+	if (entries.size() == 0)
+	{
+		return NL::FseqPlaylist::Error::ERROR_EMPTY;
+	}
+	else if (entries.size() > FSEQ_PLAYLIST_MAX_ENTRIES)
+	{
+		return NL::FseqPlaylist::Error::ERROR_TOO_MANY_ENTRIES;
+	}
+
+	this->entries = entries;
+	return NL::FseqPlaylist::Error::OK;
+}
+
+/**
+ * @brief Get the entries of the playlist.
+ * @return list of entries
+ */
+std::vector<NL::FseqPlaylist::Entry> NL::FseqPlaylist::getEntries()
+{
+	return this->entries;
+}
+
+/**
+ * @brief Open the first entry of the playlist which can be loaded. Entries with invalid files are skipped.
+ * The loader of the opened file can be used to check the layout before the playlist is started.
+ * @return OK when a file was opened
+ * @return ERROR_EMPTY when the playlist has no entries
+ * @return ERROR_INVALID_FSEQ when none of the files could be loaded
+ */
+NL::FseqPlaylist::Error NL::FseqPlaylist::open()
+{
+	if (this->entries.size() == 0)
+	{
+		return NL::FseqPlaylist::Error::ERROR_EMPTY;
+	}
+
+	for (size_t i = 0; i < this->entries.size(); i++)
+	{
+		if (this->openEntry(i, this->currentLoader))
+		{
+			this->currentEntry = i;
+			return NL::FseqPlaylist::Error::OK;
+		}
+	}
+	return NL::FseqPlaylist::Error::ERROR_INVALID_FSEQ;
+}
+
+/**
+ * @brief Start the playback of the opened entry.
+ * When the playlist has more than one entry, a background task opens the next entry and waits until its first frames
+ * are buffered, while the current one is played. The next entry must fit the same number of channels.
+ * @param zoneCount number of zones reading from the playlist
+ * @param channelCount number of channels read by all zones
+ * @return OK when the playback was started
+ * @return ERROR_NOT_OPEN when no entry was opened
+ * @return ERROR_INVALID_FSEQ when the read ahead of the opened file could not be started
+ * @return ERROR_PLAYLIST_TASK when the playlist task could not be started
+ */
+NL::FseqPlaylist::Error NL::FseqPlaylist::start(const uint8_t zoneCount, const uint32_t channelCount)
+{
+	if (!this->currentLoader)
+	{
+		return NL::FseqPlaylist::Error::ERROR_NOT_OPEN;
+	}
+
+	this->zoneCount = zoneCount;
+	this->zoneCounter = 0;
+	this->channelCount = channelCount;
+	this->passCount = 0;
+	this->lastFrameIndex = 0;
+	this->fadeAlpha = 0;
+	this->currentLoader->setZoneCount(zoneCount);
+	this->currentLoader->setInterpolation(this->interpolation);
+	if (this->currentLoader->startReadAhead() != NL::FseqLoader::Error::OK)
+	{
+		return NL::FseqPlaylist::Error::ERROR_INVALID_FSEQ;
+	}
+	else if (this->entries.size() < 2)
+	{
+		return NL::FseqPlaylist::Error::OK;
+	}
+
+	// The buffer for the crossfade is allocated once, so nothing is allocated during the playback
+	for (size_t i = 0; i < this->entries.size() && this->fadeBuffer.size() == 0; i++)
+	{
+		if (this->entries.at(i).crossfadeFrames > 0)
+		{
+			this->fadeBuffer.resize(LED_MAX_COUNT_PER_ZONE * 3);
+		}
+	}
+
+	this->nextReady = false;
+	this->playlistRunning = true;
+	if (xTaskCreatePinnedToCore(NL::FseqPlaylist::playlistTask, "fseqPlaylist", FSEQ_PLAYLIST_TASK_STACK_SIZE, this, FSEQ_PLAYLIST_TASK_PRIORITY, &this->playlistTaskHandle, FSEQ_PLAYLIST_TASK_CORE) != pdPASS)
+	{
+		this->playlistRunning = false;
+		this->playlistTaskHandle = NULL;
+		return NL::FseqPlaylist::Error::ERROR_PLAYLIST_TASK;
+	}
+
+	xTaskNotifyGive(this->playlistTaskHandle);
+	return NL::FseqPlaylist::Error::OK;
+}
+
+/**
+ * @brief Stop the playlist task and close all fseq files.
+ */
+void NL::FseqPlaylist::close()
+{
+	if (this->playlistTaskHandle != NULL)
+	{
+		this->playlistRunning = false;
+		xTaskNotifyGive(this->playlistTaskHandle);
+		xSemaphoreTake(this->playlistStopped, portMAX_DELAY);
+		this->playlistTaskHandle = NULL;
+	}
+
+	this->nextReady = false;
+	this->finishedLoader.reset();
+	this->nextLoader.reset();
+	this->currentLoader.reset();
+	this->fadeBuffer.clear();
+	this->fadeBuffer.shrink_to_fit();
+}
+
+/**
+ * @brief Get the loader of the entry that is currently played.
+ * @return pointer to the loader or nullptr when the playlist is not open
+ */
+NL::FseqLoader *NL::FseqPlaylist::getCurrentLoader()
+{
+	return this->currentLoader.get();
+}
+
+/**
+ * @brief Get the index of the entry that is currently played.
+ * @return index of the entry
+ */
+size_t NL::FseqPlaylist::getCurrentEntry()
+{
+	return this->currentEntry;
+}
+
+/**
+ * @brief Get the number of times the next entry was not buffered when the current entry ended.
+ * In this case the current entry is played again.
+ * @return number of late switches
+ */
+uint32_t NL::FseqPlaylist::getLateSwitchCount()
+{
+	return this->lateSwitchCount;
+}
+
+/**
+ * @brief Enable or disable the interpolation between the frames of all entries.
+ * Must be called before the playlist is started.
+ * @param interpolation true to blend between two frames
+ */
+void NL::FseqPlaylist::setInterpolation(const bool interpolation)
+{
+	this->interpolation = interpolation;
+}
+
+/**
+ * @brief Get the interval in which the current entry should be rendered.
+ * Without interpolation this is the step time of the fseq file. With interpolation, low frame rate files are
+ * rendered with the native {@link FRAME_INTERVAL}.
+ * @return frame interval in µs
+ */
+uint32_t NL::FseqPlaylist::getFrameInterval()
+{
+	const uint32_t stepTime = this->currentLoader ? static_cast<uint32_t>(this->currentLoader->getHeader().stepTime) * 1000 : FRAME_INTERVAL;
+	return this->interpolation ? std::min(stepTime, static_cast<uint32_t>(FRAME_INTERVAL)) : stepTime;
+}
+
+/**
+ * @brief Play the current entry from the start.
+ */
+void NL::FseqPlaylist::moveToStart()
+{
+	if (!this->currentLoader)
+	{
+		return;
+	}
+
+	this->currentLoader->moveToStart();
+	if (this->fadeAlpha > 0)
+	{
+		this->nextLoader->moveToStart();
+	}
+	this->zoneCounter = 0;
+	this->passCount = 0;
+	this->lastFrameIndex = 0;
+	this->fadeAlpha = 0;
+}
+
+/**
+ * @brief Continue the current entry from the frame that is shown at the given time.
+ * @param time time since the start of the entry in ms
+ * @return OK when the reader was moved to the frame
+ * @return ERROR_FILE_NOT_FOUND when the playlist is not open
+ * @return ERROR_END_OF_FILE when the time is behind the end of the file
+ */
+NL::FseqLoader::Error NL::FseqPlaylist::seekToTime(const uint32_t time)
+{
+	if (!this->currentLoader)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_NOT_FOUND;
+	}
+
+	// Moving back must not be counted as a finished pass
+	const NL::FseqLoader::Error fseqError = this->currentLoader->seekToTime(time);
+	if (fseqError == NL::FseqLoader::Error::OK)
+	{
+		this->lastFrameIndex = this->currentLoader->getCurrentFrame();
+	}
+	return fseqError;
+}
+
+/**
+ * @brief Copy the pixel data of a LED strip from the current frame of the playlist.
+ * The first of the zones decides if the next entry is started or blended in before reading its frame.
+ * @param ledStrip LED strip with the pixel data
+ * @param channelOffset offset of the first channel of the LED strip in the frame
+ * @return OK when the pixel buffer was read
+ * @return ERROR_FILE_NOT_FOUND when the playlist is not open
+ * @return ERROR_BUFFER_EMPTY when no frame was read ahead yet
+ * @return ERROR_END_OF_FILE when the frame does not contain enough data for the LED strip
+ */
+NL::FseqLoader::Error NL::FseqPlaylist::readLedStrip(NL::LedStrip &ledStrip, const size_t channelOffset)
+{
+	if (!this->currentLoader)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_NOT_FOUND;
+	}
+
+	if (this->zoneCounter == 0)
+	{
+		this->advance();
+	}
+	this->zoneCounter = this->zoneCounter + 1 < this->zoneCount ? this->zoneCounter + 1 : 0;
+
+	const NL::FseqLoader::Error fseqError = this->currentLoader->readLedStrip(ledStrip, channelOffset, true);
+	if (this->fadeAlpha == 0)
+	{
+		return fseqError;
+	}
+
+	// The next entry is read by all zones, even when the current frame is invalid, to keep its zones in sync
+	NL::LedStrip fadeStrip(ledStrip.getLedPin(), ledStrip.getLedCount());
+	fadeStrip.setBuffer(this->fadeBuffer.data());
+	if (this->nextLoader->readLedStrip(fadeStrip, channelOffset, true) == NL::FseqLoader::Error::OK && fseqError == NL::FseqLoader::Error::OK)
+	{
+		NL::FseqLoader::blendFrames(ledStrip.getBuffer(), ledStrip.getBuffer(), this->fadeBuffer.data(), ledStrip.getLedCount() * 3, this->fadeAlpha);
+	}
+	return fseqError;
+}
+
+/**
+ * @brief Entry point of the playlist task.
+ * The task only touches the next and finished loader while no next entry is ready.
+ * @param parameter pointer to the {@link NL::FseqPlaylist}
+ */
+void NL::FseqPlaylist::playlistTask(void *parameter)
+{
+	NL::FseqPlaylist *fseqPlaylist = static_cast<NL::FseqPlaylist *>(parameter);
+	while (fseqPlaylist->playlistRunning.load(std::memory_order_acquire))
+	{
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		if (fseqPlaylist->playlistRunning.load(std::memory_order_acquire) && !fseqPlaylist->nextReady.load(std::memory_order_acquire))
+		{
+			fseqPlaylist->finishedLoader.reset();
+			fseqPlaylist->preloadNext();
+		}
+	}
+	xSemaphoreGive(fseqPlaylist->playlistStopped);
+	vTaskDelete(NULL);
+}
+
+/**
+ * @brief Open the entry after the current one, start its read ahead and wait until it is buffered.
+ * Entries which can not be loaded or do not fit the LED configuration are skipped.
+ */
+void NL::FseqPlaylist::preloadNext()
+{
+	for (size_t i = 1; i < this->entries.size() && this->playlistRunning.load(std::memory_order_acquire); i++)
+	{
+		const size_t entryIndex = (this->currentEntry + i) % this->entries.size();
+		if (!this->openEntry(entryIndex, this->nextLoader))
+		{
+			continue;
+		}
+		else if (!this->nextLoader->fitsChannelCount(this->channelCount))
+		{
+			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("The fseq file \"") + this->entries.at(entryIndex).fileName + F("\" of the playlist does not fit the LED configuration."));
+			this->nextLoader.reset();
+			continue;
+		}
+
+		this->nextLoader->setZoneCount(this->zoneCount);
+		this->nextLoader->setInterpolation(this->interpolation);
+		if (this->nextLoader->startReadAhead() != NL::FseqLoader::Error::OK)
+		{
+			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("Failed to start reading the fseq file \"") + this->entries.at(entryIndex).fileName + F("\" of the playlist."));
+			this->nextLoader.reset();
+			continue;
+		}
+
+		const int64_t start = esp_timer_get_time();
+		while (!this->nextLoader->isBuffered() && this->playlistRunning.load(std::memory_order_acquire) && esp_timer_get_time() - start < FSEQ_PLAYLIST_PRELOAD_TIMEOUT * 1000LL)
+		{
+			vTaskDelay(pdMS_TO_TICKS(10));
+		}
+		if (!this->nextLoader->isBuffered())
+		{
+			NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("The fseq file \"") + this->entries.at(entryIndex).fileName + F("\" of the playlist was not buffered in time."));
+			this->nextLoader.reset();
+			continue;
+		}
+
+		this->nextEntry = entryIndex;
+		this->nextReady.store(true, std::memory_order_release);
+		return;
+	}
+
+	if (this->playlistRunning.load(std::memory_order_acquire))
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("None of the other fseq files of the playlist could be loaded. The current file is repeated."));
+	}
+}
+
+/**
+ * @brief Load the fseq file of an entry.
+ * @param entryIndex index of the entry
+ * @param loader reference to the loader which will hold the file
+ * @return true when the file was loaded
+ * @return false when the file is invalid
+ */
+bool NL::FseqPlaylist::openEntry(const size_t entryIndex, std::unique_ptr<NL::FseqLoader> &loader)
+{
+	loader.reset(new NL::FseqLoader(this->fileSystem));
+	if (loader->loadFromFile(FSEQ_DIRECTORY + (String)F("/") + this->entries.at(entryIndex).fileName) != NL::FseqLoader::Error::OK)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, (String)F("Failed to load the fseq file \"") + this->entries.at(entryIndex).fileName + F("\" of the playlist."));
+		loader.reset();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Count the passes of the current entry and decide how the next frame is shown.
+ * After the last frame of the final pass the next entry is started, when it is buffered. Otherwise the final pass is repeated.
+ * During the last frames of the final pass the next entry is already played and blended in.
+ */
+void NL::FseqPlaylist::advance()
+{
+	const NL::FseqPlaylist::Entry &entry = this->entries.at(this->currentEntry);
+	const uint32_t frameCount = this->currentLoader->getHeader().frameCount;
+	const uint32_t frameIndex = this->currentLoader->getCurrentFrame();
+	const bool wrapped = frameIndex < this->lastFrameIndex;
+	const bool wasFading = this->fadeAlpha > 0;
+	this->lastFrameIndex = frameIndex;
+	this->fadeAlpha = 0;
+	if (this->entries.size() < 2 || entry.repeatCount == 0)
+	{
+		return;
+	}
+
+	this->passCount += wrapped ? 1 : 0;
+	if (this->passCount + 1 < entry.repeatCount)
+	{
+		return;
+	}
+
+	// The last frame of the final pass was shown, or skipped while the playback caught up
+	const bool ready = this->nextReady.load(std::memory_order_acquire);
+	if (this->passCount >= entry.repeatCount || frameIndex + 1 >= frameCount)
+	{
+		if (ready)
+		{
+			this->switchToNext();
+			return;
+		}
+
+		this->lateSwitchCount++;
+		this->passCount = entry.repeatCount - 1;
+		this->lastFrameIndex = 0;
+		xTaskNotifyGive(this->playlistTaskHandle);
+		return;
+	}
+
+	const uint32_t remainingFrames = frameCount - 1 - frameIndex;
+	if (ready && remainingFrames <= entry.crossfadeFrames)
+	{
+		this->fadeAlpha = (entry.crossfadeFrames - remainingFrames + 1) * 256 / (entry.crossfadeFrames + 1);
+	}
+	else if (ready && wasFading)
+	{
+		// The current entry was moved back while fading, so the next entry must start from the beginning again
+		this->nextLoader->moveToStart();
+	}
+}
+
+/**
+ * @brief Make the buffered next entry the current one and let the playlist task close the old file and open the following entry.
+ */
+void NL::FseqPlaylist::switchToNext()
+{
+	this->finishedLoader = std::move(this->currentLoader);
+	this->currentLoader = std::move(this->nextLoader);
+	this->currentEntry = this->nextEntry;
+	this->passCount = 0;
+	this->lastFrameIndex = 0;
+	this->nextReady.store(false, std::memory_order_release);
+	xTaskNotifyGive(this->playlistTaskHandle);
+}
@@ -0,0 +1,431 @@
+/**
+ * @file FseqValidator.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NL::FseqValidator}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "util/FseqValidator.h"
+
+/**
+ * @brief Create a new instance of {@link NL::FseqValidator}.
+ * @param zoneChannelCounts number of channels of each LED zone, the frames must fit a combination of zones, empty to skip the check
+ */
+NL::FseqValidator::FseqValidator(const std::vector<uint32_t> &zoneChannelCounts)
+{
+	this->zoneChannelCounts = zoneChannelCounts;
+	this->error = NL::FseqLoader::Error::OK;
+	this->checksum = 0;
+	this->receivedSize = 0;
+
+	std::memset(this->header, 0, sizeof(this->header));
+	std::memset(&this->fseqHeader, 0, sizeof(this->fseqHeader));
+	this->headerLength = 28;
+	this->sequence = false;
+	this->dataOffset = UINT32_MAX;
+	this->indexEnd = UINT32_MAX;
+
+	this->recordFill = 0;
+	this->recordIndex = 0;
+
+	this->indexComplete = false;
+	this->frameSize = 0;
+	this->sparseChannelCount = 0;
+	this->compressedLength = 0;
+	this->lastFirstFrame = 0;
+	this->dataEnd = 0;
+}
+
+/**
+ * @brief Destroy the {@link NL::FseqValidator}.
+ */
+NL::FseqValidator::~FseqValidator()
+{
+}
+
+/**
+ * @brief Validate the next chunk of the file.
+ * Only the header and the index are parsed byte by byte, the channel data is only added to the checksum.
+ * @param buffer chunk of the file
+ * @param size size of the chunk in bytes
+ * @return OK when the file is valid so far
+ * @return ERROR_MAGIC_NUMBERS when the magic numbers do not match
+ * @return ERROR_FILE_VERSION when the file version is unsupported
+ * @return ERROR_HEADER_LENGTH when the header length or the index is invalid
+ * @return ERROR_INVALID_DATA_LENGTH when the file is larger than specified in the header or a block is outside of the file
+ * @return ERROR_COMPRESSION when the compression type is not supported or the block index is invalid
+ * @return ERROR_SPARSE_RANGE when the sparse channel ranges are invalid
+ * @return ERROR_CHANNEL_COUNT when the frames do not fit the LED configuration
+ */
+NL::FseqLoader::Error NL::FseqValidator::write(const uint8_t *buffer, const size_t size)
+{
+	if (this->error != NL::FseqLoader::Error::OK)
+	{
+		return this->error;
+	}
+
+	this->checksum = crc32_le(this->checksum, buffer, size);
+	size_t position = 0;
+	while (position < size && this->receivedSize < this->dataOffset && this->error == NL::FseqLoader::Error::OK)
+	{
+		this->error = this->consume(buffer[position++]);
+	}
+	this->receivedSize += size - position;
+
+	// Uncompressed files have a fixed length, so additional data can be rejected right away
+	const bool uncompressed = !this->sequence && static_cast<NL::FseqLoader::CompressionType>(this->fseqHeader.compressionType) == NL::FseqLoader::CompressionType::NONE;
+	if (this->error == NL::FseqLoader::Error::OK && this->indexComplete && uncompressed && this->receivedSize > this->dataEnd)
+	{
+		this->error = NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+	}
+
+	return this->error;
+}
+
+/**
+ * @brief Check if the complete file was received.
+ * @return OK when the file is valid
+ * @return ERROR_FILE_TOO_SMALL when the file is too small to be valid
+ * @return ERROR_HEADER_LENGTH when the file ends before the channel data
+ * @return ERROR_INVALID_DATA_LENGTH when the data length does not match the length specified in header
+ * @return any error of {@link NL::FseqValidator::write} when the file was rejected before
+ */
+NL::FseqLoader::Error NL::FseqValidator::finish()
+{
+	if (this->error != NL::FseqLoader::Error::OK)
+	{
+		return this->error;
+	}
+	else if (this->receivedSize < 28)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_TOO_SMALL;
+	}
+	else if (!this->indexComplete || this->receivedSize < this->dataOffset)
+	{
+		return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
+	}
+
+	const bool uncompressed = !this->sequence && static_cast<NL::FseqLoader::CompressionType>(this->fseqHeader.compressionType) == NL::FseqLoader::CompressionType::NONE;
+	if (uncompressed ? this->receivedSize != this->dataEnd : this->receivedSize < this->dataEnd)
+	{
+		return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+	}
+
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Get the header of the file. It is only complete after the index was validated.
+ * @return header of the fseq file
+ */
+NL::FseqLoader::FseqHeader NL::FseqValidator::getHeader()
+{
+	return this->fseqHeader;
+}
+
+/**
+ * @brief Get the CRC32 checksum of the data received so far.
+ * @return checksum of the file
+ */
+uint32_t NL::FseqValidator::getChecksum()
+{
+	return this->checksum;
+}
+
+/**
+ * @brief Get the number of bytes received so far.
+ * @return size of the file in bytes
+ */
+uint32_t NL::FseqValidator::getSize()
+{
+	return this->receivedSize;
+}
+
+/**
+ * @brief Parse a single byte of the header or the index.
+ * @param value next byte of the file
+ * @return OK when the file is valid so far
+ * @return any error of {@link NL::FseqValidator::write} when the file is invalid
+ */
+NL::FseqLoader::Error NL::FseqValidator::consume(const uint8_t value)
+{
+	const uint32_t offset = this->receivedSize++;
+	if (offset < this->headerLength)
+	{
+		this->header[offset] = value;
+		if (offset == 3)
+		{
+			this->sequence = std::memcmp(this->header, "NLSQ", 4) == 0;
+			if (!this->sequence && std::memcmp(this->header, "PSEQ", 4) != 0)
+			{
+				return NL::FseqLoader::Error::ERROR_MAGIC_NUMBERS;
+			}
+			this->headerLength = this->sequence ? 24 : 28;
+		}
+		else if (offset == 7 && !this->sequence)
+		{
+			this->headerLength = this->header[7] == 2 ? 32 : 28;
+		}
+
+		if (offset + 1 < this->headerLength)
+		{
+			return NL::FseqLoader::Error::OK;
+		}
+
+		const NL::FseqLoader::Error headerError = this->sequence ? this->parseSequenceHeader() : this->parseHeader();
+		if (headerError != NL::FseqLoader::Error::OK)
+		{
+			return headerError;
+		}
+		return this->receivedSize == this->indexEnd ? this->finishIndex() : NL::FseqLoader::Error::OK;
+	}
+	else if (offset < this->indexEnd)
+	{
+		// Version 2 files start with the compression blocks followed by the sparse ranges
+		const uint8_t recordSize = this->sequence ? 4 : (this->recordIndex < this->fseqHeader.compressionBlockCount ? 8 : 6);
+		this->record[this->recordFill++] = value;
+		if (this->recordFill == recordSize)
+		{
+			const NL::FseqLoader::Error recordError = this->parseRecord();
+			this->recordFill = 0;
+			this->recordIndex++;
+			if (recordError != NL::FseqLoader::Error::OK)
+			{
+				return recordError;
+			}
+		}
+		return this->receivedSize == this->indexEnd ? this->finishIndex() : NL::FseqLoader::Error::OK;
+	}
+
+	// Variable headers between the index and the channel data are not validated
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Parse and validate the fixed header of a fseq 1.0 or 2.0 file.
+ * @return OK when the header is valid
+ * @return ERROR_FILE_VERSION when the file version is unsupported
+ * @return ERROR_HEADER_LENGTH when the header length is invalid
+ * @return ERROR_INVALID_DATA_LENGTH when the file has no frames
+ * @return ERROR_COMPRESSION when the compression type is not supported
+ */
+NL::FseqLoader::Error NL::FseqValidator::parseHeader()
+{
+	std::memcpy(this->fseqHeader.identifier, &this->header[0], 4);
+	std::memcpy(&this->fseqHeader.channelDataOffset, &this->header[4], 2);
+	this->fseqHeader.minorVersion = this->header[6];
+	this->fseqHeader.majorVersion = this->header[7];
+	std::memcpy(&this->fseqHeader.headerLength, &this->header[8], 2);
+	std::memcpy(&this->fseqHeader.channelCount, &this->header[10], 4);
+	std::memcpy(&this->fseqHeader.frameCount, &this->header[14], 4);
+	this->fseqHeader.stepTime = this->header[18];
+	this->fseqHeader.flags = this->header[19];
+	if (this->fseqHeader.majorVersion == 2)
+	{
+		this->fseqHeader.compressionType = this->header[20] & 0x0F;
+		this->fseqHeader.compressionBlockCount = ((this->header[20] & 0xF0) << 4) | this->header[21];
+		this->fseqHeader.sparseRangeCount = this->header[22];
+	}
+
+	if ((this->fseqHeader.minorVersion != 0 || this->fseqHeader.majorVersion != 1) && this->fseqHeader.majorVersion != 2)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_VERSION;
+	}
+
+	this->indexEnd = 32 + this->fseqHeader.compressionBlockCount * 8 + this->fseqHeader.sparseRangeCount * 6;
+	if (this->fseqHeader.majorVersion == 1)
+	{
+		this->indexEnd = 28;
+		if (this->fseqHeader.headerLength != 28)
+		{
+			return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
+		}
+	}
+	if (this->fseqHeader.headerLength < this->indexEnd || this->fseqHeader.channelDataOffset < this->fseqHeader.headerLength)
+	{
+		return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
+	}
+	else if (this->fseqHeader.frameCount == 0)
+	{
+		return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+	}
+
+	const NL::FseqLoader::CompressionType compressionType = static_cast<NL::FseqLoader::CompressionType>(this->fseqHeader.compressionType);
+	if (compressionType != NL::FseqLoader::CompressionType::NONE && compressionType != NL::FseqLoader::CompressionType::ZLIB)
+	{
+		return NL::FseqLoader::Error::ERROR_COMPRESSION;
+	}
+
+	this->dataOffset = this->fseqHeader.channelDataOffset;
+	this->frameSize = this->fseqHeader.sparseRangeCount > 0 ? 0 : this->fseqHeader.channelCount;
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Parse and validate the header of a NikoLight sequence file.
+ * @return OK when the header is valid
+ * @return ERROR_FILE_VERSION when the file version is unsupported
+ * @return ERROR_HEADER_LENGTH when the keyframe index is invalid
+ */
+NL::FseqLoader::Error NL::FseqValidator::parseSequenceHeader()
+{
+	uint16_t keyframeInterval = 0;
+	uint32_t keyframeCount = 0;
+	std::memcpy(this->fseqHeader.identifier, &this->header[0], 4);
+	this->fseqHeader.majorVersion = this->header[4];
+	this->fseqHeader.stepTime = this->header[5];
+	std::memcpy(&keyframeInterval, &this->header[6], 2);
+	std::memcpy(&this->fseqHeader.channelCount, &this->header[8], 4);
+	std::memcpy(&this->fseqHeader.frameCount, &this->header[12], 4);
+	std::memcpy(&keyframeCount, &this->header[16], 4);
+	std::memcpy(&this->dataOffset, &this->header[20], 4);
+	this->fseqHeader.headerLength = 24;
+
+	if (this->fseqHeader.majorVersion != 1)
+	{
+		return NL::FseqLoader::Error::ERROR_FILE_VERSION;
+	}
+	else if (this->fseqHeader.frameCount == 0 || keyframeInterval == 0 || keyframeCount != (this->fseqHeader.frameCount + keyframeInterval - 1) / keyframeInterval || this->dataOffset != 24 + static_cast<uint64_t>(keyframeCount) * 4)
+	{
+		return NL::FseqLoader::Error::ERROR_HEADER_LENGTH;
+	}
+
+	this->indexEnd = this->dataOffset;
+	this->dataEnd = this->dataOffset;
+	this->frameSize = this->fseqHeader.channelCount;
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Validate a compression block, sparse range or keyframe offset.
+ * Blocks with a length of 0 are unused entries of the index and are skipped.
+ * @return OK when the record is valid
+ * @return ERROR_COMPRESSION when the first compression block does not start with the first frame or the blocks are not sorted
+ * @return ERROR_INVALID_DATA_LENGTH when the data would be outside of a 4 GB file or the keyframes are not in order
+ */
+NL::FseqLoader::Error NL::FseqValidator::parseRecord()
+{
+	if (this->sequence)
+	{
+		uint32_t keyframeOffset = 0;
+		std::memcpy(&keyframeOffset, &this->record[0], 4);
+		if (keyframeOffset < this->dataEnd || keyframeOffset > UINT32_MAX - 4)
+		{
+			return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+		}
+		this->dataEnd = keyframeOffset + 4;
+	}
+	else if (this->recordIndex < this->fseqHeader.compressionBlockCount)
+	{
+		// The block index of uncompressed files is ignored like by the loader
+		if (static_cast<NL::FseqLoader::CompressionType>(this->fseqHeader.compressionType) == NL::FseqLoader::CompressionType::NONE)
+		{
+			return NL::FseqLoader::Error::OK;
+		}
+
+		uint32_t firstFrame = 0;
+		uint32_t length = 0;
+		std::memcpy(&firstFrame, &this->record[0], 4);
+		std::memcpy(&length, &this->record[4], 4);
+		if (length > 0 && ((this->compressedLength == 0 && firstFrame != 0) || firstFrame < this->lastFirstFrame))
+		{
+			return NL::FseqLoader::Error::ERROR_COMPRESSION;
+		}
+		else if (length > UINT32_MAX - this->compressedLength)
+		{
+			return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+		}
+		this->compressedLength += length;
+		this->lastFirstFrame = length > 0 ? firstFrame : this->lastFirstFrame;
+	}
+	else
+	{
+		const uint32_t startChannel = this->record[0] | (this->record[1] << 8) | (this->record[2] << 16);
+		const uint32_t channelCount = this->record[3] | (this->record[4] << 8) | (this->record[5] << 16);
+		this->sparseChannelCount += channelCount;
+		this->frameSize = std::max(this->frameSize, startChannel + channelCount);
+	}
+
+	return NL::FseqLoader::Error::OK;
+}
+
+/**
+ * @brief Validate the complete index and check the frames against the LED configuration.
+ * @return OK when the index is valid and the frames fit the LED configuration
+ * @return ERROR_COMPRESSION when a compressed file has no compression blocks
+ * @return ERROR_SPARSE_RANGE when the sparse channel ranges do not match the channel count
+ * @return ERROR_INVALID_DATA_LENGTH when the data would be outside of a 4 GB file
+ * @return ERROR_CHANNEL_COUNT when the frames do not fit the LED configuration
+ */
+NL::FseqLoader::Error NL::FseqValidator::finishIndex()
+{
+	this->indexComplete = true;
+	if (!this->sequence)
+	{
+		const bool uncompressed = static_cast<NL::FseqLoader::CompressionType>(this->fseqHeader.compressionType) == NL::FseqLoader::CompressionType::NONE;
+		if (!uncompressed && this->compressedLength == 0)
+		{
+			return NL::FseqLoader::Error::ERROR_COMPRESSION;
+		}
+		else if (this->fseqHeader.sparseRangeCount > 0 && this->sparseChannelCount != this->fseqHeader.channelCount)
+		{
+			return NL::FseqLoader::Error::ERROR_SPARSE_RANGE;
+		}
+
+		const uint64_t dataLength = uncompressed ? static_cast<uint64_t>(this->fseqHeader.channelCount) * this->fseqHeader.frameCount : this->compressedLength;
+		if (this->dataOffset + dataLength > UINT32_MAX)
+		{
+			return NL::FseqLoader::Error::ERROR_INVALID_DATA_LENGTH;
+		}
+		this->dataEnd = this->dataOffset + dataLength;
+	}
+
+	return this->fitsZones() ? NL::FseqLoader::Error::OK : NL::FseqLoader::Error::ERROR_CHANNEL_COUNT;
+}
+
+/**
+ * @brief Check if the frames fit the channels of any combination of LED zones.
+ * This uses the same rule as {@link NL::FseqLoader::fitsChannelCount}, since the fseq file may be played on all zones
+ * or only on the zones with a custom animation.
+ * @return true when the frames fit
+ * @return false when the frames do not fit any combination of zones
+ */
+bool NL::FseqValidator::fitsZones()
+{
+	if (this->zoneChannelCounts.size() == 0)
+	{
+		return true;
+	}
+
+	const bool sparse = !this->sequence && this->fseqHeader.sparseRangeCount > 0;
+	for (uint32_t zoneMask = 1; zoneMask < (1UL << this->zoneChannelCounts.size()); zoneMask++)
+	{
+		uint32_t channelCount = 0;
+		for (size_t i = 0; i < this->zoneChannelCounts.size(); i++)
+		{
+			channelCount += (zoneMask & (1UL << i)) ? this->zoneChannelCounts.at(i) : 0;
+		}
+
+		const uint32_t roundedChannelCount = channelCount % 4 ? channelCount + (4 - channelCount % 4) : channelCount;
+		if (sparse ? this->frameSize <= roundedChannelCount : this->frameSize == roundedChannelCount)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
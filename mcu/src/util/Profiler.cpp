@@ -0,0 +1,260 @@
+/**
+ * @file Profiler.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NL::Profiler}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "util/Profiler.h"
+
+bool NL::Profiler::initialized = false;
+portMUX_TYPE NL::Profiler::mux = portMUX_INITIALIZER_UNLOCKED;
+uint32_t NL::Profiler::cpuFrequency;
+NL::Profiler::StageData NL::Profiler::stageData[NL::Profiler::STAGE_COUNT];
+
+/**
+ * @brief Start the profiler.
+ * Each stage keeps a histogram with 4 linear sub buckets per power of two in fixed RAM.
+ * This allows to estimate percentiles with an error of less than 25% without storing single measurements.
+ */
+void NL::Profiler::begin()
+{
+	NL::Profiler::cpuFrequency = ESP.getCpuFreqMHz();
+	NL::Profiler::reset();
+	NL::Profiler::initialized = true;
+}
+
+/**
+ * @brief Stop the profiler.
+ */
+void NL::Profiler::end()
+{
+	NL::Profiler::initialized = false;
+}
+
+/**
+ * @brief Check if the profiler is initialized.
+ * @return true when initialized
+ * @return false when not initialized
+ */
+bool NL::Profiler::isInitialized()
+{
+	return NL::Profiler::initialized;
+}
+
+/**
+ * @brief Start a new measurement.
+ * The cycle counter is per core, so a measurement must be recorded by the same task.
+ * @return current value of the cpu cycle counter
+ */
+uint32_t NL::Profiler::start()
+{
+	return ESP.getCycleCount();
+}
+
+/**
+ * @brief Record the execution time of a stage.
+ * @param stage stage that was measured
+ * @param startCycles value returned by {@link NL::Profiler::start}
+ */
+void NL::Profiler::record(const NL::Profiler::Stage stage, const uint32_t startCycles)
+{
+	const uint32_t cycles = ESP.getCycleCount() - startCycles;
+	if (!NL::Profiler::initialized)
+	{
+		return;
+	}
+
+	const uint8_t bucketIndex = NL::Profiler::getBucketIndex(cycles);
+	NL::Profiler::StageData &data = NL::Profiler::stageData[static_cast<uint8_t>(stage)];
+	portENTER_CRITICAL(&NL::Profiler::mux);
+	data.count++;
+	data.sum += cycles;
+	data.min = cycles < data.min ? cycles : data.min;
+	data.max = cycles > data.max ? cycles : data.max;
+	data.histogram[bucketIndex]++;
+	portEXIT_CRITICAL(&NL::Profiler::mux);
+}
+
+/**
+ * @brief Get the stage of a calculated animator, so every animator type is recorded separately.
+ * @param animatorType type of the animator like in the LED configuration
+ * @return stage of the animator
+ */
+NL::Profiler::Stage NL::Profiler::getAnimatorStage(const uint8_t animatorType)
+{
+	return static_cast<NL::Profiler::Stage>(static_cast<uint8_t>(NL::Profiler::Stage::ANIMATOR_RAINBOW) + animatorType);
+}
+
+/**
+ * @brief Reset the measurements of all stages.
+ */
+void NL::Profiler::reset()
+{
+	for (uint8_t i = 0; i < NL::Profiler::STAGE_COUNT; i++)
+	{
+		portENTER_CRITICAL(&NL::Profiler::mux);
+		NL::Profiler::resetStage(NL::Profiler::stageData[i]);
+		portEXIT_CRITICAL(&NL::Profiler::mux);
+	}
+}
+
+/**
+ * @brief Get the statistics of a single stage.
+ * @param stage stage to get the statistics for
+ * @param statistics reference to a variable holding the statistics
+ */
+void NL::Profiler::getStageStatistics(const NL::Profiler::Stage stage, NL::Profiler::StageStatistics &statistics)
+{
+	NL::Profiler::StageData data;
+	portENTER_CRITICAL(&NL::Profiler::mux);
+	data = NL::Profiler::stageData[static_cast<uint8_t>(stage)];
+	portEXIT_CRITICAL(&NL::Profiler::mux);
+
+	const float cyclesPerMicrosecond = NL::Profiler::cpuFrequency > 0 ? NL::Profiler::cpuFrequency : 1.0f;
+	statistics.count = data.count;
+	if (data.count == 0)
+	{
+		statistics.min = 0.0f;
+		statistics.avg = 0.0f;
+		statistics.max = 0.0f;
+		statistics.p99 = 0.0f;
+		return;
+	}
+
+	// Find the bucket containing the 99th percentile and use its upper bound
+	const uint32_t rank = (static_cast<uint64_t>(data.count) * 99 + 99) / 100;
+	uint32_t p99 = data.max;
+	uint32_t cumulativeCount = 0;
+	for (uint8_t i = 0; i < NL::Profiler::BUCKET_COUNT; i++)
+	{
+		cumulativeCount += data.histogram[i];
+		if (cumulativeCount >= rank)
+		{
+			const uint32_t upperBound = NL::Profiler::getBucketUpperBound(i);
+			p99 = upperBound < data.max ? upperBound : data.max;
+			break;
+		}
+	}
+
+	statistics.min = data.min / cyclesPerMicrosecond;
+	statistics.avg = data.sum / static_cast<float>(data.count) / cyclesPerMicrosecond;
+	statistics.max = data.max / cyclesPerMicrosecond;
+	statistics.p99 = p99 / cyclesPerMicrosecond;
+}
+
+/**
+ * @brief Get the name of a stage.
+ * @param stage stage to get the name for
+ * @return name of the stage
+ */
+String NL::Profiler::getStageName(const NL::Profiler::Stage stage)
+{
+	switch (stage)
+	{
+	case NL::Profiler::Stage::FRAME:
+		return F("frame");
+	case NL::Profiler::Stage::SENSOR_DATA:
+		return F("sensorData");
+	case NL::Profiler::Stage::POST_PROCESSING:
+		return F("postProcessing");
+	case NL::Profiler::Stage::LED_DRIVER_WAIT:
+		return F("ledDriverWait");
+	case NL::Profiler::Stage::AUDIO_UNIT:
+		return F("audioUnit");
+	case NL::Profiler::Stage::MPU6050:
+		return F("mpu6050");
+	case NL::Profiler::Stage::BH1750:
+		return F("bh1750");
+	case NL::Profiler::Stage::DS18B20:
+		return F("ds18b20");
+	case NL::Profiler::Stage::WEB_SERVER:
+		return F("webServer");
+	case NL::Profiler::Stage::ANIMATOR_RAINBOW:
+		return F("rainbowAnimator");
+	case NL::Profiler::Stage::ANIMATOR_SPARKLE:
+		return F("sparkleAnimator");
+	case NL::Profiler::Stage::ANIMATOR_GRADIENT:
+		return F("gradientAnimator");
+	case NL::Profiler::Stage::ANIMATOR_STATIC_COLOR:
+		return F("staticColorAnimator");
+	case NL::Profiler::Stage::ANIMATOR_COLOR_BAR:
+		return F("colorBarAnimator");
+	case NL::Profiler::Stage::ANIMATOR_RAINBOW_MOTION:
+		return F("rainbowMotionAnimator");
+	case NL::Profiler::Stage::ANIMATOR_GRADIENT_MOTION:
+		return F("gradientMotionAnimator");
+	case NL::Profiler::Stage::ANIMATOR_PULSE:
+		return F("pulseAnimator");
+	case NL::Profiler::Stage::ANIMATOR_EQUALIZER:
+		return F("equalizerAnimator");
+	case NL::Profiler::Stage::ANIMATOR_FSEQ:
+		return F("fseqAnimator");
+	}
+	return F("unknown");
+}
+
+/**
+ * @brief Reset the measurements of a single stage.
+ * @param data measurements of the stage
+ */
+void NL::Profiler::resetStage(NL::Profiler::StageData &data)
+{
+	data.count = 0;
+	data.sum = 0;
+	data.min = UINT32_MAX;
+	data.max = 0;
+	for (uint8_t i = 0; i < NL::Profiler::BUCKET_COUNT; i++)
+	{
+		data.histogram[i] = 0;
+	}
+}
+
+/**
+ * @brief Get the histogram bucket for a number of cycles.
+ * Values below 4 have their own bucket, larger values are split into 4 buckets per power of two.
+ * @param cycles number of cycles
+ * @return index of the bucket
+ */
+uint8_t NL::Profiler::getBucketIndex(const uint32_t cycles)
+{
+	if (cycles < 4)
+	{
+		return cycles;
+	}
+
+	const uint8_t msb = 31 - __builtin_clz(cycles);
+	return (msb - 1) * 4 + ((cycles >> (msb - 2)) & 0x03);
+}
+
+/**
+ * @brief Get the largest number of cycles that falls into a histogram bucket.
+ * @param bucketIndex index of the bucket
+ * @return upper bound of the bucket in cycles
+ */
+uint32_t NL::Profiler::getBucketUpperBound(const uint8_t bucketIndex)
+{
+	if (bucketIndex < 4)
+	{
+		return bucketIndex;
+	}
+
+	const uint8_t msb = bucketIndex / 4 + 1;
+	const uint32_t subBucket = bucketIndex % 4;
+	const uint32_t lowerBound = (4 + subBucket) << (msb - 2);
+	return lowerBound + (1UL << (msb - 2)) - 1;
+}
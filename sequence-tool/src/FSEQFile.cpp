@@ -0,0 +1,154 @@
+/**
+ * @file FSEQFile.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link FSEQFile} class.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "FSEQFile.h"
+
+/**
+ * @brief Create a new instance of {@link FSEQFile}.
+ */
+FSEQFile::FSEQFile()
+{
+	this->channelCount = 0;
+	this->frameCount = 0;
+	this->stepTime = 0;
+	this->fileSize = 0;
+}
+
+/**
+ * @brief Destroy the {@link FSEQFile} instance.
+ */
+FSEQFile::~FSEQFile()
+{
+}
+
+/**
+ * @brief Load a fseq file into memory. Version 1.0 and uncompressed version 2 files without sparse ranges are supported.
+ * @param fileName file path and name of the fseq file
+ * @return true when the file was loaded successfully
+ * @return false when the file could not be read or is not supported
+ */
+bool FSEQFile::loadFromFile(const std::filesystem::path fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	this->fileSize = std::filesystem::file_size(fileName);
+
+	char magic[4];
+	uint16_t channelDataOffset = 0;
+	uint8_t minorVersion = 0;
+	uint8_t majorVersion = 0;
+	uint16_t headerLength = 0;
+	uint8_t flags = 0;
+	uint8_t compression = 0;
+	uint8_t blockCount = 0;
+	uint8_t sparseRangeCount = 0;
+	file.read(magic, 4);
+	file.read((char *)&channelDataOffset, 2);
+	file.read((char *)&minorVersion, 1);
+	file.read((char *)&majorVersion, 1);
+	file.read((char *)&headerLength, 2);
+	file.read((char *)&this->channelCount, 4);
+	file.read((char *)&this->frameCount, 4);
+	file.read((char *)&this->stepTime, 1);
+	file.read((char *)&flags, 1);
+	file.read((char *)&compression, 1);
+	file.read((char *)&blockCount, 1);
+	file.read((char *)&sparseRangeCount, 1);
+	if (!file || std::memcmp(magic, "PSEQ", 4) != 0)
+	{
+		return false;
+	}
+
+	// Compressed and sparse files are not supported
+	if (majorVersion != 1 && majorVersion != 2)
+	{
+		return false;
+	}
+	else if (majorVersion == 2 && ((compression & 0x0F) != 0 || sparseRangeCount != 0))
+	{
+		return false;
+	}
+
+	const size_t dataLength = static_cast<size_t>(this->channelCount) * this->frameCount;
+	if (channelDataOffset + dataLength > this->fileSize)
+	{
+		return false;
+	}
+
+	this->data.resize(dataLength);
+	file.seekg(channelDataOffset);
+	if (!file.read((char *)this->data.data(), dataLength))
+	{
+		return false;
+	}
+
+	file.close();
+	return true;
+}
+
+/**
+ * @brief Get the number of channels per frame.
+ * @return number of channels
+ */
+uint32_t FSEQFile::getChannelCount()
+{
+	return this->channelCount;
+}
+
+/**
+ * @brief Get the number of frames.
+ * @return number of frames
+ */
+uint32_t FSEQFile::getFrameCount()
+{
+	return this->frameCount;
+}
+
+/**
+ * @brief Get the time between two frames.
+ * @return time between two frames in ms
+ */
+uint8_t FSEQFile::getStepTime()
+{
+	return this->stepTime;
+}
+
+/**
+ * @brief Get the channel data of a frame.
+ * @param frameIndex index of the frame
+ * @return pointer to the channel data of the frame
+ */
+const uint8_t *FSEQFile::getFrame(const uint32_t frameIndex)
+{
+	return this->data.data() + static_cast<size_t>(frameIndex) * this->channelCount;
+}
+
+/**
+ * @brief Get the size of the loaded file.
+ * @return size of the file in bytes
+ */
+size_t FSEQFile::getFileSize()
+{
+	return this->fileSize;
+}
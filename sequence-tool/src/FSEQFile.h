@@ -0,0 +1,53 @@
+/**
+ * @file FSEQFile.h
+ * @author TheRealKasumi
+ * @brief Contains a class for reading uncompressed fseq files.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef FSEQ_FILE_H
+#define FSEQ_FILE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <filesystem>
+#include <fstream>
+
+class FSEQFile
+{
+public:
+	FSEQFile();
+	~FSEQFile();
+
+	bool loadFromFile(const std::filesystem::path fileName);
+
+	uint32_t getChannelCount();
+	uint32_t getFrameCount();
+	uint8_t getStepTime();
+	const uint8_t *getFrame(const uint32_t frameIndex);
+	size_t getFileSize();
+
+private:
+	uint32_t channelCount;
+	uint32_t frameCount;
+	uint8_t stepTime;
+	size_t fileSize;
+	std::vector<uint8_t> data;
+};
+
+#endif
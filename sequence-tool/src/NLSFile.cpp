@@ -0,0 +1,286 @@
+/**
+ * @file NLSFile.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link NLSFile} class.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "NLSFile.h"
+
+/**
+ * @brief Create a new instance of {@link NLSFile}.
+ */
+NLSFile::NLSFile()
+{
+	this->header.magic[0] = 'N';
+	this->header.magic[1] = 'L';
+	this->header.magic[2] = 'S';
+	this->header.magic[3] = 'Q';
+	this->header.fileVersion = 1;
+	this->header.stepTime = 0;
+	this->header.keyframeInterval = 0;
+	this->header.channelCount = 0;
+	this->header.frameCount = 0;
+	this->header.keyframeCount = 0;
+	this->header.dataOffset = 0;
+}
+
+/**
+ * @brief Destroy the {@link NLSFile} instance.
+ */
+NLSFile::~NLSFile()
+{
+}
+
+/**
+ * @brief Encode the frames of a fseq file.
+ * Every frame is stored as XOR delta to the previous frame. Keyframes are stored as delta to a black frame,
+ * so the controller can start decoding at any keyframe.
+ * @param fseqFile loaded fseq file
+ * @param keyframeInterval number of frames between two keyframes
+ * @return true when the file was generated successfully (in memory)
+ * @return false when the fseq file can not be encoded
+ */
+bool NLSFile::generateFromFseq(FSEQFile &fseqFile, const uint16_t keyframeInterval)
+{
+	if (keyframeInterval == 0)
+	{
+		return false;
+	}
+
+	const uint32_t channelCount = fseqFile.getChannelCount();
+	const uint32_t frameCount = fseqFile.getFrameCount();
+	this->header.stepTime = fseqFile.getStepTime();
+	this->header.keyframeInterval = keyframeInterval;
+	this->header.channelCount = channelCount;
+	this->header.frameCount = frameCount;
+	this->header.keyframeCount = (frameCount + keyframeInterval - 1) / keyframeInterval;
+	this->header.dataOffset = 24 + this->header.keyframeCount * 4;
+	this->keyframeOffsets.clear();
+	this->frames.clear();
+
+	std::vector<uint8_t> delta(channelCount);
+	uint32_t offset = this->header.dataOffset;
+	for (uint32_t i = 0; i < frameCount; i++)
+	{
+		const uint8_t *frame = fseqFile.getFrame(i);
+		const uint8_t *previousFrame = i % keyframeInterval != 0 ? fseqFile.getFrame(i - 1) : nullptr;
+		for (uint32_t j = 0; j < channelCount; j++)
+		{
+			delta[j] = previousFrame != nullptr ? frame[j] ^ previousFrame[j] : frame[j];
+		}
+
+		if (i % keyframeInterval == 0)
+		{
+			this->keyframeOffsets.push_back(offset);
+		}
+
+		std::vector<uint8_t> record;
+		this->encodeFrame(delta.data(), channelCount, record);
+		offset += 4 + record.size();
+		this->frames.push_back(record);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Save the in memory NLS file to a file on the disk.
+ * @param fileName output file name for the NLS file
+ * @return true when the file was written successfully
+ * @return false when there was an error writing the file
+ */
+bool NLSFile::saveToFile(const std::filesystem::path fileName)
+{
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(this->header.magic, 4);
+	file.write((char *)&this->header.fileVersion, 1);
+	file.write((char *)&this->header.stepTime, 1);
+	file.write((char *)&this->header.keyframeInterval, 2);
+	file.write((char *)&this->header.channelCount, 4);
+	file.write((char *)&this->header.frameCount, 4);
+	file.write((char *)&this->header.keyframeCount, 4);
+	file.write((char *)&this->header.dataOffset, 4);
+	file.write((char *)this->keyframeOffsets.data(), this->keyframeOffsets.size() * 4);
+
+	for (size_t i = 0; i < this->frames.size(); i++)
+	{
+		const uint32_t recordLength = this->frames[i].size();
+		file.write((char *)&recordLength, 4);
+		file.write((char *)this->frames[i].data(), recordLength);
+	}
+
+	file.close();
+	return !file.fail();
+}
+
+/**
+ * @brief Get the size of the encoded file.
+ * @return size of the file in bytes
+ */
+size_t NLSFile::getFileSize()
+{
+	size_t fileSize = this->header.dataOffset;
+	for (size_t i = 0; i < this->frames.size(); i++)
+	{
+		fileSize += 4 + this->frames[i].size();
+	}
+	return fileSize;
+}
+
+/**
+ * @brief Encode the delta of a single frame into spans.
+ * Unchanged channels are skipped and pixels with the same delta are run length encoded.
+ * Short runs are kept in the literal spans, because a new span costs more than it saves.
+ * The record is never larger than a frame that is stored as literal spans only.
+ * @param delta XOR delta of the frame
+ * @param channelCount number of channels
+ * @param record output record
+ */
+void NLSFile::encodeFrame(const uint8_t *delta, const uint32_t channelCount, std::vector<uint8_t> &record)
+{
+	size_t position = 0;
+	while (position < channelCount)
+	{
+		// Unchanged channels at the end of the frame are not stored at all
+		const size_t zeroRun = this->getZeroRun(delta, position, channelCount);
+		if (position + zeroRun == channelCount)
+		{
+			break;
+		}
+		else if (zeroRun > 4)
+		{
+			for (size_t length = zeroRun; length > 0;)
+			{
+				const uint16_t spanLength = length < NLSFile::MAX_SPAN_LENGTH ? length : NLSFile::MAX_SPAN_LENGTH;
+				this->addSpan(record, NLSSpanType::SKIP, spanLength);
+				length -= spanLength;
+			}
+			position += zeroRun;
+			continue;
+		}
+
+		const size_t repeatRun = this->getRepeatRun(delta, position, channelCount);
+		if (repeatRun >= 3)
+		{
+			for (size_t length = repeatRun; length > 0;)
+			{
+				const uint16_t spanLength = length < NLSFile::MAX_SPAN_LENGTH ? length : NLSFile::MAX_SPAN_LENGTH;
+				this->addSpan(record, NLSSpanType::REPEAT, spanLength);
+				record.insert(record.end(), delta + position, delta + position + 3);
+				length -= spanLength;
+			}
+			position += repeatRun * 3;
+			continue;
+		}
+
+		// Collect channels until a skip or repeat span is worth it
+		const size_t start = position;
+		while (position < channelCount && position - start < NLSFile::MAX_SPAN_LENGTH)
+		{
+			const size_t zeros = this->getZeroRun(delta, position, channelCount);
+			if (position > start && (zeros > 4 || position + zeros == channelCount || this->getRepeatRun(delta, position, channelCount) >= 3))
+			{
+				break;
+			}
+			position++;
+		}
+		this->addSpan(record, NLSSpanType::LITERAL, position - start);
+		record.insert(record.end(), delta + start, delta + position);
+	}
+
+	const size_t literalSize = channelCount + 2 * ((channelCount + NLSFile::MAX_SPAN_LENGTH - 1) / NLSFile::MAX_SPAN_LENGTH);
+	if (record.size() > literalSize)
+	{
+		record.clear();
+		this->encodeLiteralFrame(delta, channelCount, record);
+	}
+}
+
+/**
+ * @brief Encode the delta of a single frame as literal spans only.
+ * @param delta XOR delta of the frame
+ * @param channelCount number of channels
+ * @param record output record
+ */
+void NLSFile::encodeLiteralFrame(const uint8_t *delta, const uint32_t channelCount, std::vector<uint8_t> &record)
+{
+	for (size_t position = 0; position < channelCount;)
+	{
+		const uint16_t spanLength = channelCount - position < NLSFile::MAX_SPAN_LENGTH ? channelCount - position : NLSFile::MAX_SPAN_LENGTH;
+		this->addSpan(record, NLSSpanType::LITERAL, spanLength);
+		record.insert(record.end(), delta + position, delta + position + spanLength);
+		position += spanLength;
+	}
+}
+
+/**
+ * @brief Add the 16 bit code of a span to the record. The upper 2 bits contain the type and the lower 14 bits the length.
+ * @param record output record
+ * @param type type of the span
+ * @param length length of the span
+ */
+void NLSFile::addSpan(std::vector<uint8_t> &record, const NLSSpanType type, const uint16_t length)
+{
+	const uint16_t code = (type << 14) | (length & NLSFile::MAX_SPAN_LENGTH);
+	record.push_back(code & 0xFF);
+	record.push_back(code >> 8);
+}
+
+/**
+ * @brief Get the number of unchanged channels starting at a position.
+ * @param delta XOR delta of the frame
+ * @param position start position
+ * @param channelCount number of channels
+ * @return number of unchanged channels
+ */
+size_t NLSFile::getZeroRun(const uint8_t *delta, const size_t position, const uint32_t channelCount)
+{
+	size_t length = 0;
+	while (position + length < channelCount && delta[position + length] == 0)
+	{
+		length++;
+	}
+	return length;
+}
+
+/**
+ * @brief Get the number of pixels with the same delta starting at a position.
+ * @param delta XOR delta of the frame
+ * @param position start position
+ * @param channelCount number of channels
+ * @return number of pixels with the same delta
+ */
+size_t NLSFile::getRepeatRun(const uint8_t *delta, const size_t position, const uint32_t channelCount)
+{
+	if (position + 3 > channelCount)
+	{
+		return 0;
+	}
+
+	size_t length = 1;
+	while (position + (length + 1) * 3 <= channelCount && std::memcmp(delta + position, delta + position + length * 3, 3) == 0)
+	{
+		length++;
+	}
+	return length;
+}
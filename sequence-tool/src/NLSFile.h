@@ -0,0 +1,76 @@
+/**
+ * @file NLSFile.h
+ * @author TheRealKasumi
+ * @brief Contains a class for building a NikoLight Sequence file from a fseq file.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef NLS_FILE_H
+#define NLS_FILE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <filesystem>
+#include <fstream>
+
+#include "FSEQFile.h"
+
+class NLSFile
+{
+public:
+	struct NLSHeader
+	{
+		char magic[4];
+		uint8_t fileVersion;
+		uint8_t stepTime;
+		uint16_t keyframeInterval;
+		uint32_t channelCount;
+		uint32_t frameCount;
+		uint32_t keyframeCount;
+		uint32_t dataOffset;
+	};
+
+	enum NLSSpanType
+	{
+		SKIP = 0,
+		LITERAL = 1,
+		REPEAT = 2
+	};
+
+	NLSFile();
+	~NLSFile();
+
+	bool generateFromFseq(FSEQFile &fseqFile, const uint16_t keyframeInterval);
+	bool saveToFile(const std::filesystem::path fileName);
+	size_t getFileSize();
+
+private:
+	static const uint16_t MAX_SPAN_LENGTH = 0x3FFF;
+
+	NLSHeader header;
+	std::vector<uint32_t> keyframeOffsets;
+	std::vector<std::vector<uint8_t>> frames;
+
+	void encodeFrame(const uint8_t *delta, const uint32_t channelCount, std::vector<uint8_t> &record);
+	void encodeLiteralFrame(const uint8_t *delta, const uint32_t channelCount, std::vector<uint8_t> &record);
+	void addSpan(std::vector<uint8_t> &record, const NLSSpanType type, const uint16_t length);
+	size_t getZeroRun(const uint8_t *delta, const size_t position, const uint32_t channelCount);
+	size_t getRepeatRun(const uint8_t *delta, const size_t position, const uint32_t channelCount);
+};
+
+#endif
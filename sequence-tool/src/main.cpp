@@ -0,0 +1,128 @@
+/**
+ * @file main.cpp
+ * @author TheRealKasumi
+ * @brief Entry point for the NikoLight Sequence Tool.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include <iostream>
+#include <filesystem>
+#include <string>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+#include "FSEQFile.h"
+#include "NLSFile.h"
+
+// Function declarations
+void printHeader();
+void printHelp();
+
+/**
+ * @brief Entry point of the application.
+ * @param argc number of command line arguments
+ * @param argv command line argument
+ * @return int status code, 0 for success or the error code otherwise
+ */
+int main(int argc, char *argv[])
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+	_setmode(_fileno(stdout), _O_U16TEXT);
+#elif __APPLE__
+	std::wcout.sync_with_stdio(false);
+	std::wcout.imbue(std::locale("en_US.UTF-8"));
+#else
+	std::wcout.sync_with_stdio(false);
+	std::wcout.imbue(std::locale("en_US.utf8"));
+#endif
+
+	printHeader();
+	if (argc != 3 && argc != 4)
+	{
+		printHelp();
+		exit(1);
+	}
+
+	const std::filesystem::path inputFile = argv[1];
+	const std::filesystem::path outputFile = argv[2];
+	const unsigned long keyframeInterval = argc == 4 ? std::strtoul(argv[3], nullptr, 10) : 30;
+	if (keyframeInterval == 0 || keyframeInterval > UINT16_MAX)
+	{
+		std::cerr << "The keyframe interval must be between 1 and " << UINT16_MAX << "." << std::endl
+				  << std::endl;
+		printHelp();
+		exit(2);
+	}
+
+	// Load the fseq file
+	std::wcout << L"Load fseq file: " << inputFile << std::endl;
+	FSEQFile fseqFile;
+	if (!fseqFile.loadFromFile(inputFile))
+	{
+		std::cerr << "Failed to load the fseq file. Only fseq 1.0 and uncompressed, non sparse fseq 2.0 files are supported.";
+		exit(3);
+	}
+
+	// Encode the frames
+	std::wcout << L"Encode " << fseqFile.getFrameCount() << L" frames with " << fseqFile.getChannelCount() << L" channels and a keyframe every " << keyframeInterval << L" frames." << std::endl;
+	NLSFile nlsFile;
+	if (!nlsFile.generateFromFseq(fseqFile, keyframeInterval))
+	{
+		std::cerr << "Failed to encode the NikoLight Sequence.";
+		exit(4);
+	}
+
+	// Write the NLS file to the disk
+	std::wcout << L"Write NikoLight Sequence to: " << outputFile << std::endl;
+	if (!nlsFile.saveToFile(outputFile))
+	{
+		std::cerr << "Failed to write NikoLight Sequence.";
+		exit(5);
+	}
+
+	const size_t rawSize = static_cast<size_t>(fseqFile.getChannelCount()) * fseqFile.getFrameCount();
+	std::wcout << L"Size of the fseq file: " << fseqFile.getFileSize() << L" bytes, raw channel data: " << rawSize << L" bytes." << std::endl;
+	std::wcout << L"Size of the NikoLight Sequence: " << nlsFile.getFileSize() << L" bytes (" << (rawSize > 0 ? nlsFile.getFileSize() * 100 / rawSize : 0) << L"% of the raw channel data)." << std::endl;
+	std::wcout << L"Nice! The NikoLight Sequence was created successfully.";
+	exit(0);
+}
+
+/**
+ * @brief Print the header because we can.
+ */
+void printHeader()
+{
+	std::wcout << L"NikoLight Sequence Tool (NLST)" << std::endl;
+	std::wcout << std::endl;
+}
+
+/**
+ * @brief Print the help.
+ */
+void printHelp()
+{
+	std::wcout << L"This tool converts a fseq file from xLights into a NikoLight Sequence (NLS). ";
+	std::wcout << L"Every frame is stored as difference to the previous frame, so static parts of the animation take almost no space on the MicroSD card. ";
+	std::wcout << L"Keyframes are stored in a fixed interval and allow the controller to jump to any position quickly. ";
+	std::wcout << L"A smaller interval makes seeking faster but the file larger. ";
+	std::wcout << L"The created file can be uploaded to the controller like a normal fseq file." << std::endl
+			   << std::endl;
+	std::wcout << L"Please call me again with the following arguments: nlst <input_fseq> <output_file> [keyframe_interval]";
+}
@@ -0,0 +1,451 @@
+/**
+ * @file ConfigurationBenchmark.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link ConfigurationBenchmark}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "ConfigurationBenchmark.h"
+#include "HostSimulation.h"
+
+#include <SD.h>
+#include <iomanip>
+#include <vector>
+
+/**
+ * @brief Create a new instance of {@link ConfigurationBenchmark}.
+ * @param workDirectory directory for the configuration files
+ */
+ConfigurationBenchmark::ConfigurationBenchmark(const std::filesystem::path workDirectory)
+{
+	this->workDirectory = workDirectory;
+}
+
+/**
+ * @brief Destroy the {@link ConfigurationBenchmark} instance.
+ */
+ConfigurationBenchmark::~ConfigurationBenchmark()
+{
+}
+
+/**
+ * @brief Create the maximum number of profiles and measure the file access to save, load, list and switch them.
+ * The baseline writes and reads the same profiles field by field, like the configuration did before the file access was buffered.
+ * @param output stream for the results
+ * @return true when all steps succeeded
+ * @return false when a step failed
+ */
+bool ConfigurationBenchmark::run(std::ostream &output)
+{
+	std::filesystem::remove_all(this->workDirectory);
+	std::filesystem::create_directories(this->workDirectory);
+	SD.setRoot(this->workDirectory.string());
+	HostSimulation::disableSdCardModel();
+
+	// All profile records are written while the profiles are created and saved
+	NL::Configuration::begin(&SD, CONFIGURATION_FILE_NAME);
+	this->startMeasurement();
+	bool error = !this->createProfiles() || NL::Configuration::save() != NL::Configuration::Error::OK;
+	const Measurement saveAll = this->stopMeasurement();
+	if (error)
+	{
+		output << "Failed to create the profiles." << std::endl;
+		return false;
+	}
+
+	Measurement baselineSave;
+	Measurement baselineLoad;
+	if (!this->runBaseline(baselineSave, baselineLoad))
+	{
+		output << "Failed to write or read the baseline file." << std::endl;
+		return false;
+	}
+
+	// The typical change of a single zone by the REST API
+	NL::Configuration::LedConfig ledConfig;
+	NL::Configuration::getLedConfig(0, ledConfig);
+	ledConfig.brightness++;
+	NL::Configuration::setLedConfig(0, ledConfig);
+	this->startMeasurement();
+	error = NL::Configuration::save() != NL::Configuration::Error::OK;
+	const Measurement saveOne = this->stopMeasurement();
+
+	NL::Configuration::end();
+	NL::Configuration::begin(&SD, CONFIGURATION_FILE_NAME);
+	this->startMeasurement();
+	error = NL::Configuration::load() != NL::Configuration::Error::OK || error;
+	const Measurement load = this->stopMeasurement();
+
+	this->startMeasurement();
+	for (size_t i = 0; i < NL::Configuration::getProfileCount(); i++)
+	{
+		String profileName;
+		error = NL::Configuration::getProfileNameByIndex(i, profileName) != NL::Configuration::Error::OK || error;
+	}
+	const Measurement list = this->stopMeasurement();
+
+	this->startMeasurement();
+	error = NL::Configuration::setActiveProfile("Profile 17") != NL::Configuration::Error::OK || error;
+	const Measurement activate = this->stopMeasurement();
+
+	NL::Configuration::end();
+	std::filesystem::remove_all(this->workDirectory);
+	if (error)
+	{
+		output << "Failed to save, load, list or activate the profiles." << std::endl;
+		return false;
+	}
+
+	const HostSimulation::SdCardModel sdCardModel = HostSimulation::getDefaultSdCardModel();
+	output << "Profiles: " << CONFIGURATION_MAX_PROFILES << std::endl;
+	output << std::endl;
+	output << "File access per step, the MicroSD card time is calculated with " << sdCardModel.accessTime << " µs per call and " << sdCardModel.byteTime / 1000.0 << " µs per byte:" << std::endl;
+	output << std::left << std::setw(34) << "step" << std::right << std::setw(10) << "calls" << std::setw(10) << "bytes" << std::setw(12) << "card ms" << std::endl;
+	this->printResult(output, "save, per field (baseline)", baselineSave);
+	this->printResult(output, "load, per field (baseline)", baselineLoad);
+	this->printResult(output, "create all profiles and save", saveAll);
+	this->printResult(output, "save, one profile changed", saveOne);
+	this->printResult(output, "load", load);
+	this->printResult(output, "list all profile names", list);
+	this->printResult(output, "activate an uncached profile", activate);
+	return true;
+}
+
+/**
+ * @brief Create the maximum number of profiles. Every profile has a different brightness of the first zone.
+ * @return true when the profiles were created
+ * @return false when a profile could not be created or changed
+ */
+bool ConfigurationBenchmark::createProfiles()
+{
+	for (size_t i = NL::Configuration::getProfileCount(); i < CONFIGURATION_MAX_PROFILES; i++)
+	{
+		const String profileName = String("Profile ") + String(i);
+		if (NL::Configuration::createProfile(profileName) != NL::Configuration::Error::OK || NL::Configuration::setActiveProfile(profileName) != NL::Configuration::Error::OK)
+		{
+			return false;
+		}
+
+		NL::Configuration::LedConfig ledConfig;
+		NL::Configuration::getLedConfig(0, ledConfig);
+		ledConfig.brightness = i;
+		if (NL::Configuration::setLedConfig(0, ledConfig) != NL::Configuration::Error::OK)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Write and read all profiles field by field in the format which was used before the file access was buffered.
+ * @param save file access to write the file
+ * @param load file access to read the file
+ * @return true when the file was written and read
+ * @return false when the file could not be written or read
+ */
+bool ConfigurationBenchmark::runBaseline(Measurement &save, Measurement &load)
+{
+	std::vector<NL::Configuration::Profile> profiles;
+	for (size_t i = 0; i < NL::Configuration::getProfileCount(); i++)
+	{
+		String profileName;
+		profiles.push_back(NL::Configuration::Profile());
+		if (NL::Configuration::getProfileNameByIndex(i, profileName) != NL::Configuration::Error::OK || NL::Configuration::getProfile(profileName, profiles.back()) != NL::Configuration::Error::OK)
+		{
+			return false;
+		}
+	}
+
+	this->startMeasurement();
+	File file = SD.open("/baseline.nli", FILE_WRITE);
+	bool error = !file || !ConfigurationBenchmark::writeBaselineFile(file, profiles);
+	file.close();
+	save = this->stopMeasurement();
+
+	this->startMeasurement();
+	file = SD.open("/baseline.nli", FILE_READ);
+	error = !file || !ConfigurationBenchmark::readBaselineFile(file) || error;
+	file.close();
+	load = this->stopMeasurement();
+
+	SD.remove("/baseline.nli");
+	return !error;
+}
+
+/**
+ * @brief Reset the statistics of the simulated MicroSD card.
+ */
+void ConfigurationBenchmark::startMeasurement()
+{
+	HostSimulation::resetSdCardStatistics();
+}
+
+/**
+ * @brief Get the file access since the measurement was started.
+ * @return measured file access
+ */
+ConfigurationBenchmark::Measurement ConfigurationBenchmark::stopMeasurement()
+{
+	const HostSimulation::SdCardStatistics statistics = HostSimulation::getSdCardStatistics();
+	Measurement measurement;
+	measurement.calls = statistics.calls;
+	measurement.bytes = statistics.bytes;
+	return measurement;
+}
+
+/**
+ * @brief Print one line of the result table.
+ * @param output output stream
+ * @param name name of the step
+ * @param measurement file access of the step
+ */
+void ConfigurationBenchmark::printResult(std::ostream &output, const std::string name, const Measurement &measurement)
+{
+	const HostSimulation::SdCardModel sdCardModel = HostSimulation::getDefaultSdCardModel();
+	const double cardTime = (measurement.calls * sdCardModel.accessTime + measurement.bytes * sdCardModel.byteTime / 1000.0) / 1000.0;
+	output << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(1);
+	output << std::setw(10) << measurement.calls << std::setw(10) << measurement.bytes << std::setw(12) << cardTime << std::endl;
+}
+
+/**
+ * @brief Write all profiles and the global settings field by field.
+ * @param file file to write to
+ * @param profiles all profiles
+ * @return true when the file was written
+ * @return false when the file could not be written
+ */
+bool ConfigurationBenchmark::writeBaselineFile(File &file, const std::vector<NL::Configuration::Profile> &profiles)
+{
+	bool writeError = false;
+	writeError = !ConfigurationBenchmark::writeField(file, static_cast<uint16_t>(CONFIGURATION_FILE_VERSION)) || writeError;
+	writeError = !ConfigurationBenchmark::writeField(file, static_cast<uint16_t>(profiles.size())) || writeError;
+	writeError = !ConfigurationBenchmark::writeField(file, static_cast<uint16_t>(0)) || writeError;
+
+	for (const NL::Configuration::Profile &profile : profiles)
+	{
+		writeError = !ConfigurationBenchmark::writeString(file, profile.name) || writeError;
+		const uint8_t *systemConfig = reinterpret_cast<const uint8_t *>(&profile.systemConfig);
+		for (size_t j = 0; j < sizeof(profile.systemConfig); j++)
+		{
+			writeError = !ConfigurationBenchmark::writeField(file, systemConfig[j]) || writeError;
+		}
+
+		for (uint8_t j = 0; j < LED_NUM_ZONES; j++)
+		{
+			const NL::Configuration::LedConfig &ledConfig = profile.ledConfig[j];
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.ledPin) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.ledCount) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.type) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.dataSource) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.speed) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.offset) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.brightness) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.reverse) || writeError;
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.fadeSpeed) || writeError;
+			for (uint8_t k = 0; k < ANIMATOR_NUM_ANIMATION_SETTINGS; k++)
+			{
+				writeError = !ConfigurationBenchmark::writeField(file, ledConfig.animationSettings[k]) || writeError;
+			}
+			writeError = !ConfigurationBenchmark::writeField(file, ledConfig.ledVoltage) || writeError;
+			for (uint8_t k = 0; k < 3; k++)
+			{
+				writeError = !ConfigurationBenchmark::writeField(file, ledConfig.ledChannelCurrent[k]) || writeError;
+			}
+		}
+
+		writeError = !ConfigurationBenchmark::writeString(file, profile.uiConfiguration.language) || writeError;
+		writeError = !ConfigurationBenchmark::writeString(file, profile.uiConfiguration.theme) || writeError;
+		writeError = !ConfigurationBenchmark::writeField(file, profile.uiConfiguration.expertMode) || writeError;
+	}
+
+	const NL::Configuration::WiFiConfig wifiConfig = NL::Configuration::getWiFiConfig();
+	writeError = !ConfigurationBenchmark::writeString(file, wifiConfig.accessPointSsid) || writeError;
+	writeError = !ConfigurationBenchmark::writeString(file, wifiConfig.accessPointPassword) || writeError;
+	writeError = !ConfigurationBenchmark::writeField(file, wifiConfig.accessPointChannel) || writeError;
+	writeError = !ConfigurationBenchmark::writeField(file, wifiConfig.accessPointHidden) || writeError;
+	writeError = !ConfigurationBenchmark::writeField(file, wifiConfig.accessPointMaxConnections) || writeError;
+	writeError = !ConfigurationBenchmark::writeString(file, wifiConfig.wifiSsid) || writeError;
+	writeError = !ConfigurationBenchmark::writeString(file, wifiConfig.wifiPassword) || writeError;
+
+	const NL::Configuration::MotionSensorCalibration calibration = NL::Configuration::getMotionSensorCalibration();
+	const int16_t rawValues[6] = {calibration.accXRaw, calibration.accYRaw, calibration.accZRaw, calibration.gyroXRaw, calibration.gyroYRaw, calibration.gyroZRaw};
+	const float values[6] = {calibration.accXG, calibration.accYG, calibration.accZG, calibration.gyroXDeg, calibration.gyroYDeg, calibration.gyroZDeg};
+	for (uint8_t i = 0; i < 6; i++)
+	{
+		writeError = !ConfigurationBenchmark::writeField(file, rawValues[i]) || writeError;
+	}
+	for (uint8_t i = 0; i < 6; i++)
+	{
+		writeError = !ConfigurationBenchmark::writeField(file, values[i]) || writeError;
+	}
+
+	const NL::Configuration::AudioUnitConfig audioUnitConfig = NL::Configuration::getAudioUnitConfig();
+	writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.noiseThreshold) || writeError;
+	for (size_t i = 0; i < AUDIO_UNIT_NUM_BANDS; i++)
+	{
+		writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.frequencyBandIndex[i].first) || writeError;
+		writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.frequencyBandIndex[i].second) || writeError;
+		writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.peakDetectorConfig[i].historySize) || writeError;
+		writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.peakDetectorConfig[i].threshold) || writeError;
+		writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.peakDetectorConfig[i].influence) || writeError;
+		writeError = !ConfigurationBenchmark::writeField(file, audioUnitConfig.peakDetectorConfig[i].noiseGate) || writeError;
+	}
+
+	writeError = !ConfigurationBenchmark::writeField(file, static_cast<uint32_t>(0)) || writeError;
+	return !writeError;
+}
+
+/**
+ * @brief Read all profiles and the global settings field by field.
+ * @param file file to read from
+ * @return true when the file was read
+ * @return false when the file could not be read
+ */
+bool ConfigurationBenchmark::readBaselineFile(File &file)
+{
+	bool readError = false;
+	uint16_t version;
+	uint16_t profileCount;
+	uint16_t activeProfile;
+	readError = !ConfigurationBenchmark::readField(file, version) || readError;
+	readError = !ConfigurationBenchmark::readField(file, profileCount) || readError;
+	readError = !ConfigurationBenchmark::readField(file, activeProfile) || readError;
+	if (readError || profileCount > CONFIGURATION_MAX_PROFILES)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < profileCount; i++)
+	{
+		NL::Configuration::Profile profile;
+		readError = !ConfigurationBenchmark::readString(file, profile.name) || readError;
+		uint8_t *systemConfig = reinterpret_cast<uint8_t *>(&profile.systemConfig);
+		for (size_t j = 0; j < sizeof(profile.systemConfig); j++)
+		{
+			readError = !ConfigurationBenchmark::readField(file, systemConfig[j]) || readError;
+		}
+
+		for (uint8_t j = 0; j < LED_NUM_ZONES; j++)
+		{
+			NL::Configuration::LedConfig &ledConfig = profile.ledConfig[j];
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.ledPin) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.ledCount) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.type) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.dataSource) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.speed) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.offset) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.brightness) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.reverse) || readError;
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.fadeSpeed) || readError;
+			for (uint8_t k = 0; k < ANIMATOR_NUM_ANIMATION_SETTINGS; k++)
+			{
+				readError = !ConfigurationBenchmark::readField(file, ledConfig.animationSettings[k]) || readError;
+			}
+			readError = !ConfigurationBenchmark::readField(file, ledConfig.ledVoltage) || readError;
+			for (uint8_t k = 0; k < 3; k++)
+			{
+				readError = !ConfigurationBenchmark::readField(file, ledConfig.ledChannelCurrent[k]) || readError;
+			}
+		}
+
+		readError = !ConfigurationBenchmark::readString(file, profile.uiConfiguration.language) || readError;
+		readError = !ConfigurationBenchmark::readString(file, profile.uiConfiguration.theme) || readError;
+		readError = !ConfigurationBenchmark::readField(file, profile.uiConfiguration.expertMode) || readError;
+	}
+
+	NL::Configuration::WiFiConfig wifiConfig;
+	readError = !ConfigurationBenchmark::readString(file, wifiConfig.accessPointSsid) || readError;
+	readError = !ConfigurationBenchmark::readString(file, wifiConfig.accessPointPassword) || readError;
+	readError = !ConfigurationBenchmark::readField(file, wifiConfig.accessPointChannel) || readError;
+	readError = !ConfigurationBenchmark::readField(file, wifiConfig.accessPointHidden) || readError;
+	readError = !ConfigurationBenchmark::readField(file, wifiConfig.accessPointMaxConnections) || readError;
+	readError = !ConfigurationBenchmark::readString(file, wifiConfig.wifiSsid) || readError;
+	readError = !ConfigurationBenchmark::readString(file, wifiConfig.wifiPassword) || readError;
+
+	int16_t rawValues[6];
+	float values[6];
+	for (uint8_t i = 0; i < 6; i++)
+	{
+		readError = !ConfigurationBenchmark::readField(file, rawValues[i]) || readError;
+	}
+	for (uint8_t i = 0; i < 6; i++)
+	{
+		readError = !ConfigurationBenchmark::readField(file, values[i]) || readError;
+	}
+
+	NL::Configuration::AudioUnitConfig audioUnitConfig;
+	readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.noiseThreshold) || readError;
+	for (size_t i = 0; i < AUDIO_UNIT_NUM_BANDS; i++)
+	{
+		readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.frequencyBandIndex[i].first) || readError;
+		readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.frequencyBandIndex[i].second) || readError;
+		readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.peakDetectorConfig[i].historySize) || readError;
+		readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.peakDetectorConfig[i].threshold) || readError;
+		readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.peakDetectorConfig[i].influence) || readError;
+		readError = !ConfigurationBenchmark::readField(file, audioUnitConfig.peakDetectorConfig[i].noiseGate) || readError;
+	}
+
+	uint32_t checksum;
+	readError = !ConfigurationBenchmark::readField(file, checksum) || readError;
+	return !readError;
+}
+
+/**
+ * @brief Write a string with its length and one call per character.
+ * @param file file to write to
+ * @param string string to write
+ * @return true when the string was written
+ * @return false when the string could not be written
+ */
+bool ConfigurationBenchmark::writeString(File &file, const String &string)
+{
+	bool writeError = !ConfigurationBenchmark::writeField(file, static_cast<uint16_t>(string.length()));
+	for (unsigned int i = 0; i < string.length(); i++)
+	{
+		writeError = !ConfigurationBenchmark::writeField(file, string[i]) || writeError;
+	}
+	return !writeError;
+}
+
+/**
+ * @brief Read a string with its length and one call per character.
+ * @param file file to read from
+ * @param string reference to the string
+ * @return true when the string was read
+ * @return false when the string could not be read
+ */
+bool ConfigurationBenchmark::readString(File &file, String &string)
+{
+	uint16_t length;
+	if (!ConfigurationBenchmark::readField(file, length))
+	{
+		return false;
+	}
+
+	string.clear();
+	for (uint16_t i = 0; i < length; i++)
+	{
+		char c;
+		if (!ConfigurationBenchmark::readField(file, c))
+		{
+			return false;
+		}
+		string += c;
+	}
+	return true;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ConfigurationBenchmark.h
+ * @author TheRealKasumi
+ * @brief Measure the file access of the {@link NL::Configuration} with the maximum number of profiles.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef CONFIGURATION_BENCHMARK_H
+#define CONFIGURATION_BENCHMARK_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <filesystem>
+#include <FS.h>
+
+#include "configuration/Configuration.h"
+
+class ConfigurationBenchmark
+{
+public:
+	ConfigurationBenchmark(const std::filesystem::path workDirectory);
+	~ConfigurationBenchmark();
+
+	bool run(std::ostream &output);
+
+private:
+	struct Measurement
+	{
+		uint64_t calls;
+		uint64_t bytes;
+	};
+
+	std::filesystem::path workDirectory;
+
+	bool createProfiles();
+	bool runBaseline(Measurement &save, Measurement &load);
+	void startMeasurement();
+	Measurement stopMeasurement();
+	void printResult(std::ostream &output, const std::string name, const Measurement &measurement);
+
+	static bool writeBaselineFile(File &file, const std::vector<NL::Configuration::Profile> &profiles);
+	static bool readBaselineFile(File &file);
+
+	/**
+	 * @brief Write a single field, like the {@link NL::BinaryFile} did before it was buffered.
+	 * @param file file to write to
+	 * @param value value to write
+	 * @return true when the value was written
+	 * @return false when the value could not be written
+	 */
+	template <typename T>
+	static bool writeField(File &file, const T value)
+	{
+		return file.write(reinterpret_cast<const uint8_t *>(&value), sizeof(value)) == sizeof(value);
+	}
+
+	/**
+	 * @brief Read a single field, like the {@link NL::BinaryFile} did before it was buffered.
+	 * @param file file to read from
+	 * @param value reference to the variable which will hold the value
+	 * @return true when the value was read
+	 * @return false when the value could not be read
+	 */
+	template <typename T>
+	static bool readField(File &file, T &value)
+	{
+		return file.read(reinterpret_cast<uint8_t *>(&value), sizeof(value)) == sizeof(value);
+	}
+
+	static bool writeString(File &file, const String &string);
+	static bool readString(File &file, String &string);
+};
+
+#endif
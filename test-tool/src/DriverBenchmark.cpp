@@ -0,0 +1,278 @@
+/**
+ * @file DriverBenchmark.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link DriverBenchmark}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "DriverBenchmark.h"
+#include "HostI2S.h"
+#include "HostSimulation.h"
+
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+/**
+ * @brief Create a new instance of {@link DriverBenchmark}.
+ */
+DriverBenchmark::DriverBenchmark()
+{
+}
+
+/**
+ * @brief Destroy the {@link DriverBenchmark} instance.
+ */
+DriverBenchmark::~DriverBenchmark()
+{
+}
+
+/**
+ * @brief Send frames to 8 zones of 250 LEDs in both output modes and compare the interrupts, CPU time and sent data.
+ * @param output stream for the results
+ * @param frameCount number of frames per output mode
+ * @return true when both modes sent the same data and both I2S devices can be used at the same time
+ * @return false when a mode failed or the data differs
+ */
+bool DriverBenchmark::run(std::ostream &output, const uint32_t frameCount)
+{
+	Result isrResult;
+	Result frameResult;
+	if (!this->runMode(NL::LedDriver::OutputMode::OUTPUT_ISR, frameCount, isrResult) || !this->runMode(NL::LedDriver::OutputMode::OUTPUT_FRAME, frameCount, frameResult))
+	{
+		output << "Failed to send the frames." << std::endl;
+		return false;
+	}
+
+	output << "Zones: " << DriverBenchmark::ZONE_COUNT << " x " << DriverBenchmark::LEDS_PER_ZONE << " LEDs, " << frameCount << " frames per mode" << std::endl;
+	output << std::endl;
+	output << "Per frame, CPU time in µs measured on this computer:" << std::endl;
+	output << std::left << std::setw(14) << "mode" << std::right << std::setw(12) << "interrupts" << std::setw(12) << "ISR time" << std::setw(12) << "task time" << std::setw(12) << "total" << std::setw(14) << "DMA memory" << std::endl;
+	this->printResult(output, "OUTPUT_ISR", isrResult, frameCount);
+	this->printResult(output, "OUTPUT_FRAME", frameResult, frameCount);
+	output << std::endl;
+	bool success = this->compareOutput(output, isrResult, frameResult);
+	success = this->checkDevices(output, NL::LedDriver::OutputMode::OUTPUT_ISR, "OUTPUT_ISR") && success;
+	success = this->checkDevices(output, NL::LedDriver::OutputMode::OUTPUT_FRAME, "OUTPUT_FRAME") && success;
+	return success;
+}
+
+/**
+ * @brief Render and send frames in one output mode.
+ * The pixels are written into the back buffer, then the driver swaps the buffers and the simulated DMA sends the frame.
+ * @param outputMode output mode of the driver
+ * @param frameCount number of frames
+ * @param result interrupts, time and sent data
+ * @return true when all frames were sent
+ * @return false when the driver could not be started or a frame was not sent
+ */
+bool DriverBenchmark::runMode(const NL::LedDriver::OutputMode outputMode, const uint32_t frameCount, Result &result)
+{
+	std::vector<NL::LedStrip> ledStrips;
+	for (uint32_t i = 0; i < DriverBenchmark::ZONE_COUNT; i++)
+	{
+		ledStrips.push_back(NL::LedStrip(13 + i, DriverBenchmark::LEDS_PER_ZONE));
+	}
+
+	NL::LedBuffer ledBuffer(ledStrips);
+	NL::LedDriver ledDriver;
+	const size_t dmaMemory = HostSimulation::getDmaMemory();
+	if (ledDriver.begin(ledBuffer, outputMode) != NL::LedDriver::Error::OK)
+	{
+		return false;
+	}
+
+	result.dmaMemory = HostSimulation::getDmaMemory() - dmaMemory;
+	result.interruptCount = 0;
+	result.interruptTime = 0;
+	result.taskTime = 0;
+	for (uint32_t frame = 0; frame < frameCount; frame++)
+	{
+		uint8_t *buffer = ledBuffer.getBuffer();
+		for (size_t i = 0; i < ledBuffer.getBufferSize(); i++)
+		{
+			buffer[i] = (i * 7 + frame * 13 + (i / 3) * (frame % 5)) & 0xFF;
+		}
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (ledDriver.showPixels() != NL::LedDriver::Error::OK)
+		{
+			return false;
+		}
+		result.taskTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+		HostI2S::Statistics statistics;
+		result.frames.push_back(std::vector<uint16_t>());
+		if (!HostI2S::transmit(0, result.frames.back(), statistics))
+		{
+			return false;
+		}
+		result.interruptCount += statistics.interruptCount;
+		result.interruptTime += statistics.interruptTime;
+	}
+
+	ledDriver.end();
+	return true;
+}
+
+/**
+ * @brief Print one line of the result table.
+ * @param output output stream
+ * @param name name of the output mode
+ * @param result interrupts, time and sent data
+ * @param frameCount number of frames
+ */
+void DriverBenchmark::printResult(std::ostream &output, const std::string name, const Result &result, const uint32_t frameCount)
+{
+	output << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1);
+	output << std::setw(12) << static_cast<double>(result.interruptCount) / frameCount;
+	output << std::setw(12) << result.interruptTime / 1000.0 / frameCount;
+	output << std::setw(12) << result.taskTime / 1000.0 / frameCount;
+	output << std::setw(12) << (result.interruptTime + result.taskTime) / 1000.0 / frameCount;
+	output << std::setw(14) << result.dmaMemory << std::endl;
+}
+
+/**
+ * @brief Compare the data which was sent in both output modes.
+ * Only the low byte of each 16 bit word drives the 8 output pins of an I2S device.
+ * Both modes start with the blank buffer, followed by one buffer per LED and the reset buffer.
+ * In {@code OUTPUT_ISR}, the interrupt handler links the reset buffer behind the buffer it loads with LED {@code ledStripMaxLength - 3}.
+ * The DMA of the controller has already fetched the descriptors of the next two LEDs at that point, so they are still sent.
+ * The simulated DMA does not fetch ahead. It follows each link when the previous descriptor is finished,
+ * so the last {@link ISR_MISSING_LED_COUNT} LEDs of the longest strip are not sent in {@code OUTPUT_ISR}.
+ * The output of {@code OUTPUT_ISR} must be exactly the output of {@code OUTPUT_FRAME} without these LEDs.
+ * @param output stream for the result
+ * @param isrResult result of the ISR mode
+ * @param frameResult result of the frame mode
+ * @return true when all frames are equal, except for the LEDs which the simulated DMA does not send
+ * @return false when a frame differs
+ */
+bool DriverBenchmark::compareOutput(std::ostream &output, const Result &isrResult, const Result &frameResult)
+{
+	const size_t ledWords = 3 * 8 * 3;
+	const size_t sentWords = (1 + DriverBenchmark::LEDS_PER_ZONE - DriverBenchmark::ISR_MISSING_LED_COUNT) * ledWords;
+	for (size_t frame = 0; frame < isrResult.frames.size(); frame++)
+	{
+		const std::vector<uint16_t> &isrFrame = isrResult.frames.at(frame);
+		const std::vector<uint16_t> &frameFrame = frameResult.frames.at(frame);
+		if (frameFrame.size() != (1 + DriverBenchmark::LEDS_PER_ZONE) * ledWords + DriverBenchmark::RESET_WORDS ||
+			isrFrame.size() != frameFrame.size() - DriverBenchmark::ISR_MISSING_LED_COUNT * ledWords)
+		{
+			output << "Frame " << frame << " has " << isrFrame.size() << " words in OUTPUT_ISR and " << frameFrame.size() << " words in OUTPUT_FRAME." << std::endl;
+			return false;
+		}
+
+		for (size_t i = 0; i < isrFrame.size(); i++)
+		{
+			const size_t j = i < sentWords ? i : i + DriverBenchmark::ISR_MISSING_LED_COUNT * ledWords;
+			if ((isrFrame.at(i) & 0xFF) != (frameFrame.at(j) & 0xFF))
+			{
+				output << "Frame " << frame << " differs at word " << i << "." << std::endl;
+				return false;
+			}
+		}
+	}
+
+	output << "Both modes sent the same data, except for the last " << DriverBenchmark::ISR_MISSING_LED_COUNT << " LEDs of the longest strip which the simulated DMA does not send in OUTPUT_ISR." << std::endl;
+	return true;
+}
+
+/**
+ * @brief Drive 2 x 8 zones with one driver per I2S device, like the {@link NL::LedManager} does for more than {@link LED_MAX_ZONES_PER_DRIVER} zones.
+ * Each device is first sent alone as reference. Then both drivers are started and both devices are sent at the same time.
+ * Every device must send exactly its reference, so the drivers do not share any state.
+ * @param output stream for the result
+ * @param outputMode output mode of both drivers
+ * @param name name of the output mode
+ * @return true when both devices sent their reference data
+ * @return false when a driver could not be started or the data differs
+ */
+bool DriverBenchmark::checkDevices(std::ostream &output, const NL::LedDriver::OutputMode outputMode, const std::string name)
+{
+	std::vector<std::unique_ptr<NL::LedBuffer>> ledBuffers;
+	std::vector<std::unique_ptr<NL::LedDriver>> ledDrivers;
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		std::vector<NL::LedStrip> ledStrips;
+		for (uint32_t j = 0; j < DriverBenchmark::ZONE_COUNT; j++)
+		{
+			ledStrips.push_back(NL::LedStrip(13 + i * DriverBenchmark::ZONE_COUNT + j, DriverBenchmark::LEDS_PER_ZONE - i * 20 - j));
+		}
+		ledBuffers.push_back(std::unique_ptr<NL::LedBuffer>(new NL::LedBuffer(ledStrips)));
+		ledDrivers.push_back(std::unique_ptr<NL::LedDriver>(new NL::LedDriver(static_cast<NL::LedDriver::I2SDevice>(i))));
+	}
+
+	std::vector<uint16_t> reference[2];
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		HostI2S::Statistics statistics;
+		DriverBenchmark::fillBuffer(*ledBuffers.at(i), i);
+		if (ledDrivers.at(i)->begin(*ledBuffers.at(i), outputMode) != NL::LedDriver::Error::OK || ledDrivers.at(i)->showPixels() != NL::LedDriver::Error::OK || !HostI2S::transmit(i, reference[i], statistics))
+		{
+			output << "Failed to send the reference of I2S device " << static_cast<int>(i) << " in " << name << "." << std::endl;
+			return false;
+		}
+		ledDrivers.at(i)->end();
+	}
+
+	NL::LedDriver secondDriver(NL::LedDriver::I2SDevice::I2S_DEV_0);
+	bool started = true;
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		DriverBenchmark::fillBuffer(*ledBuffers.at(i), i);
+		started = started && ledDrivers.at(i)->begin(*ledBuffers.at(i), outputMode) == NL::LedDriver::Error::OK && ledDrivers.at(i)->showPixels() == NL::LedDriver::Error::OK;
+	}
+	if (!started || secondDriver.begin(*ledBuffers.at(0), outputMode) != NL::LedDriver::Error::ERROR_DEVICE_IN_USE)
+	{
+		output << "Failed to start both I2S devices in " << name << "." << std::endl;
+		return false;
+	}
+
+	std::vector<uint16_t> sent[2];
+	bool transmitted[2] = {false, false};
+	std::thread device1([&sent, &transmitted]()
+						{ HostI2S::Statistics statistics;
+						  transmitted[1] = HostI2S::transmit(1, sent[1], statistics); });
+	HostI2S::Statistics statistics;
+	transmitted[0] = HostI2S::transmit(0, sent[0], statistics);
+	device1.join();
+	ledDrivers.at(0)->end();
+	ledDrivers.at(1)->end();
+
+	if (!transmitted[0] || !transmitted[1] || sent[0] != reference[0] || sent[1] != reference[1] || reference[0] == reference[1])
+	{
+		output << "Both I2S devices did not send their own data at the same time in " << name << "." << std::endl;
+		return false;
+	}
+
+	output << "Both I2S devices sent their own " << DriverBenchmark::ZONE_COUNT << " zones at the same time in " << name << "." << std::endl;
+	return true;
+}
+
+/**
+ * @brief Fill the back buffer with a pattern, which is different for each I2S device.
+ * @param ledBuffer LED buffer of the device
+ * @param deviceIndex index of the I2S device
+ */
+void DriverBenchmark::fillBuffer(NL::LedBuffer &ledBuffer, const uint8_t deviceIndex)
+{
+	uint8_t *buffer = ledBuffer.getBuffer();
+	for (size_t i = 0; i < ledBuffer.getBufferSize(); i++)
+	{
+		buffer[i] = (i * 11 + deviceIndex * 101 + i / 7) & 0xFF;
+	}
+}
@@ -0,0 +1,64 @@
+/**
+ * @file DriverBenchmark.h
+ * @author TheRealKasumi
+ * @brief Compare the interrupts and CPU time per frame of the output modes of the {@link NL::LedDriver}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef DRIVER_BENCHMARK_H
+#define DRIVER_BENCHMARK_H
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <string>
+#include <ostream>
+
+#include "led/driver/LedBuffer.h"
+#include "led/driver/LedDriver.h"
+
+class DriverBenchmark
+{
+public:
+	DriverBenchmark();
+	~DriverBenchmark();
+
+	bool run(std::ostream &output, const uint32_t frameCount);
+
+private:
+	static const uint32_t ZONE_COUNT = 8;
+	static const uint32_t LEDS_PER_ZONE = 250;
+	static const uint32_t ISR_MISSING_LED_COUNT = 2;
+	static const uint32_t RESET_WORDS = 3 * 8 * 3 * 4;
+
+	struct Result
+	{
+		size_t dmaMemory;
+		uint64_t interruptCount;
+		int64_t interruptTime;
+		int64_t taskTime;
+		std::vector<std::vector<uint16_t>> frames;
+	};
+
+	bool runMode(const NL::LedDriver::OutputMode outputMode, const uint32_t frameCount, Result &result);
+	void printResult(std::ostream &output, const std::string name, const Result &result, const uint32_t frameCount);
+	bool compareOutput(std::ostream &output, const Result &isrResult, const Result &frameResult);
+	bool checkDevices(std::ostream &output, const NL::LedDriver::OutputMode outputMode, const std::string name);
+	static void fillBuffer(NL::LedBuffer &ledBuffer, const uint8_t deviceIndex);
+};
+
+#endif
@@ -0,0 +1,281 @@
+/**
+ * @file FseqBenchmark.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link FseqBenchmark}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "FseqBenchmark.h"
+#include "HostSimulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+/**
+ * @brief Create a new instance of {@link FseqBenchmark}.
+ * @param workDirectory directory for the generated files
+ */
+FseqBenchmark::FseqBenchmark(const std::filesystem::path workDirectory)
+{
+	this->workDirectory = workDirectory;
+}
+
+/**
+ * @brief Destroy the {@link FseqBenchmark} instance.
+ */
+FseqBenchmark::~FseqBenchmark()
+{
+}
+
+/**
+ * @brief Play a file with 8 zones of 250 LEDs from a simulated MicroSD card and measure the time of each rendered frame.
+ * The render loop runs at the frame interval of the controller and only the reads of the zones are measured.
+ * The baseline reads every zone from the file in the render task, like the loader did before the read ahead task.
+ * @param output stream for the results
+ * @param renderFrames number of rendered frames per run
+ * @return true when all runs completed
+ * @return false when a file could not be written or played
+ */
+bool FseqBenchmark::run(std::ostream &output, const uint32_t renderFrames)
+{
+	const uint32_t channelCount = FseqBenchmark::ZONE_COUNT * FseqBenchmark::LEDS_PER_ZONE * 3;
+	FseqFileWriter::Frames frames(FseqBenchmark::FILE_FRAMES, std::vector<uint8_t>(channelCount));
+	for (uint32_t i = 0; i < frames.size(); i++)
+	{
+		for (uint32_t channel = 0; channel < channelCount; channel++)
+		{
+			frames.at(i).at(channel) = ((channel / 3) * 3 + i * 5 + (channel % 3) * 85) & 0xFF;
+		}
+	}
+
+	std::filesystem::remove_all(this->workDirectory);
+	std::filesystem::create_directories(this->workDirectory);
+	const std::filesystem::path uncompressedFile = this->workDirectory / "benchmark.fseq";
+	const std::filesystem::path compressedFile = this->workDirectory / "benchmark_zlib.fseq";
+	if (!FseqFileWriter::writeV2(uncompressedFile, channelCount, FseqBenchmark::STEP_TIME, frames, 0, {}) || !FseqFileWriter::writeV2(compressedFile, channelCount, FseqBenchmark::STEP_TIME, frames, 10, {}))
+	{
+		output << "Failed to write the benchmark files." << std::endl;
+		return false;
+	}
+
+	const HostSimulation::SdCardModel model = HostSimulation::getDefaultSdCardModel();
+	output << "Zones: " << FseqBenchmark::ZONE_COUNT << " x " << FseqBenchmark::LEDS_PER_ZONE << " LEDs, step time " << static_cast<int>(FseqBenchmark::STEP_TIME) << " ms, render interval " << FseqBenchmark::RENDER_INTERVAL << " µs, " << renderFrames << " frames" << std::endl;
+	output << "MicroSD card: " << model.accessTime << " µs per call, " << model.byteTime << " ns per byte, 1 in " << model.stallProbability << " calls stalls for " << model.stallTime << " µs" << std::endl;
+	output << std::endl;
+	output << "Time in µs which the render task spends reading all zones of a frame:" << std::endl;
+	output << std::left << std::setw(28) << "path" << std::right << std::setw(10) << "mean" << std::setw(10) << "p99" << std::setw(10) << "max" << std::setw(10) << "late" << std::setw(12) << "SD calls" << std::setw(8) << "stalls" << std::setw(10) << "underrun" << std::setw(8) << "skipped" << std::endl;
+
+	Result baseline;
+	Result readAhead;
+	Result readAheadCompressed;
+	if (!this->runBaseline(uncompressedFile, renderFrames, baseline))
+	{
+		output << "Failed to run the baseline." << std::endl;
+		return false;
+	}
+	this->printResult(output, "per zone reads (baseline)", baseline);
+
+	if (!this->runReadAhead(uncompressedFile, renderFrames, readAhead))
+	{
+		output << "Failed to play the uncompressed file." << std::endl;
+		return false;
+	}
+	this->printResult(output, "read ahead, uncompressed", readAhead);
+
+	if (!this->runReadAhead(compressedFile, renderFrames, readAheadCompressed))
+	{
+		output << "Failed to play the compressed file." << std::endl;
+		return false;
+	}
+	this->printResult(output, "read ahead, zlib", readAheadCompressed);
+
+	output << std::endl;
+	output << "late: frames which took longer than the render interval, SD calls: per rendered frame, including the read ahead task" << std::endl;
+	return true;
+}
+
+/**
+ * @brief Read one zone after another directly from the file in the render loop.
+ * @param fseqFile file to play
+ * @param renderFrames number of rendered frames
+ * @param result measured frame times and counters
+ * @return true when the file was played
+ * @return false when the file could not be opened
+ */
+bool FseqBenchmark::runBaseline(const std::filesystem::path fseqFile, const uint32_t renderFrames, Result &result)
+{
+	HostSimulation::useRealClock();
+	HostSimulation::disableSdCardModel();
+	FS fileSystem(fseqFile.parent_path().string());
+	File file = fileSystem.open(String("/") + fseqFile.filename().string().c_str(), FILE_READ);
+	uint16_t channelDataOffset = 0;
+	if (!file || !file.seek(4) || file.read(reinterpret_cast<uint8_t *>(&channelDataOffset), 2) != 2 || !file.seek(channelDataOffset))
+	{
+		return false;
+	}
+
+	const size_t frameSize = FseqBenchmark::ZONE_COUNT * FseqBenchmark::LEDS_PER_ZONE * 3;
+	std::vector<uint8_t> buffer(frameSize);
+	HostSimulation::setSdCardModel(HostSimulation::getDefaultSdCardModel());
+	HostSimulation::resetSdCardStatistics();
+	int64_t nextFrame = FseqBenchmark::getTime();
+	for (uint32_t i = 0; i < renderFrames; i++)
+	{
+		FseqBenchmark::waitUntil(nextFrame);
+		nextFrame += FseqBenchmark::RENDER_INTERVAL;
+
+		const int64_t start = FseqBenchmark::getTime();
+		if (file.position() + frameSize > file.size())
+		{
+			file.seek(channelDataOffset);
+		}
+		for (uint32_t zone = 0; zone < FseqBenchmark::ZONE_COUNT; zone++)
+		{
+			file.read(buffer.data() + zone * FseqBenchmark::LEDS_PER_ZONE * 3, FseqBenchmark::LEDS_PER_ZONE * 3);
+		}
+		result.frameTimes.push_back(FseqBenchmark::getTime() - start);
+	}
+
+	const HostSimulation::SdCardStatistics statistics = HostSimulation::getSdCardStatistics();
+	HostSimulation::disableSdCardModel();
+	result.sdCalls = statistics.calls;
+	result.sdStalls = statistics.stalls;
+	result.underrunCount = 0;
+	result.skippedFrameCount = 0;
+	return true;
+}
+
+/**
+ * @brief Play the file through the {@link NL::FseqLoader} and its read ahead task.
+ * The playback starts when the ring buffer is filled, like the playlist does.
+ * @param fseqFile file to play
+ * @param renderFrames number of rendered frames
+ * @param result measured frame times and counters
+ * @return true when the file was played
+ * @return false when the file could not be loaded or the read ahead could not be started
+ */
+bool FseqBenchmark::runReadAhead(const std::filesystem::path fseqFile, const uint32_t renderFrames, Result &result)
+{
+	HostSimulation::useRealClock();
+	HostSimulation::setHeap(160 * 1024, 110 * 1024);
+	HostSimulation::setPsram(false);
+	HostSimulation::disableSdCardModel();
+	FS fileSystem(fseqFile.parent_path().string());
+	NL::FseqLoader fseqLoader(&fileSystem);
+	if (fseqLoader.loadFromFile(String("/") + fseqFile.filename().string().c_str()) != NL::FseqLoader::Error::OK)
+	{
+		return false;
+	}
+
+	std::vector<uint8_t> buffer(FseqBenchmark::ZONE_COUNT * FseqBenchmark::LEDS_PER_ZONE * 3);
+	std::vector<NL::LedStrip> ledStrips;
+	for (uint32_t zone = 0; zone < FseqBenchmark::ZONE_COUNT; zone++)
+	{
+		ledStrips.push_back(NL::LedStrip(0, FseqBenchmark::LEDS_PER_ZONE));
+		ledStrips.back().setBuffer(buffer.data() + zone * FseqBenchmark::LEDS_PER_ZONE * 3);
+	}
+	fseqLoader.setZoneCount(FseqBenchmark::ZONE_COUNT);
+
+	HostSimulation::setSdCardModel(HostSimulation::getDefaultSdCardModel());
+	HostSimulation::resetSdCardStatistics();
+	if (fseqLoader.startReadAhead() != NL::FseqLoader::Error::OK)
+	{
+		HostSimulation::disableSdCardModel();
+		return false;
+	}
+	while (!fseqLoader.isBuffered())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	HostSimulation::resetSdCardStatistics();
+	int64_t nextFrame = FseqBenchmark::getTime();
+	for (uint32_t i = 0; i < renderFrames; i++)
+	{
+		FseqBenchmark::waitUntil(nextFrame);
+		nextFrame += FseqBenchmark::RENDER_INTERVAL;
+
+		const int64_t start = FseqBenchmark::getTime();
+		for (uint32_t zone = 0; zone < FseqBenchmark::ZONE_COUNT; zone++)
+		{
+			fseqLoader.readLedStrip(ledStrips.at(zone), zone * FseqBenchmark::LEDS_PER_ZONE * 3);
+		}
+		result.frameTimes.push_back(FseqBenchmark::getTime() - start);
+	}
+
+	const HostSimulation::SdCardStatistics statistics = HostSimulation::getSdCardStatistics();
+	result.sdCalls = statistics.calls;
+	result.sdStalls = statistics.stalls;
+	result.underrunCount = fseqLoader.getUnderrunCount();
+	result.skippedFrameCount = fseqLoader.getSkippedFrameCount();
+	fseqLoader.close();
+	HostSimulation::disableSdCardModel();
+	return true;
+}
+
+/**
+ * @brief Print one line of the result table.
+ * @param output output stream
+ * @param name name of the path
+ * @param result measured frame times and counters
+ */
+void FseqBenchmark::printResult(std::ostream &output, const std::string name, Result &result)
+{
+	std::sort(result.frameTimes.begin(), result.frameTimes.end());
+	int64_t sum = 0;
+	size_t lateFrames = 0;
+	for (const int64_t frameTime : result.frameTimes)
+	{
+		sum += frameTime;
+		lateFrames += frameTime > FseqBenchmark::RENDER_INTERVAL ? 1 : 0;
+	}
+
+	const size_t frameCount = result.frameTimes.size();
+	output << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1);
+	output << std::setw(10) << static_cast<double>(sum) / frameCount;
+	output << std::setw(10) << result.frameTimes.at(frameCount * 99 / 100);
+	output << std::setw(10) << result.frameTimes.back();
+	output << std::setw(10) << lateFrames;
+	output << std::setw(12) << static_cast<double>(result.sdCalls) / frameCount;
+	output << std::setw(8) << result.sdStalls;
+	output << std::setw(10) << result.underrunCount;
+	output << std::setw(8) << result.skippedFrameCount << std::endl;
+}
+
+/**
+ * @brief Get the time of the host.
+ * @return int64_t time in µs
+ */
+int64_t FseqBenchmark::getTime()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Sleep until the given time, the render loop of the controller waits for the next frame the same way.
+ * @param time time in µs
+ */
+void FseqBenchmark::waitUntil(const int64_t time)
+{
+	const int64_t now = FseqBenchmark::getTime();
+	if (time > now)
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(time - now));
+	}
+}
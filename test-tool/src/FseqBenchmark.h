@@ -0,0 +1,67 @@
+/**
+ * @file FseqBenchmark.h
+ * @author TheRealKasumi
+ * @brief Measure the time the render task spends reading a large fseq file from a simulated MicroSD card.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef FSEQ_BENCHMARK_H
+#define FSEQ_BENCHMARK_H
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <ostream>
+
+#include "FseqFileWriter.h"
+#include "util/FseqLoader.h"
+
+class FseqBenchmark
+{
+public:
+	FseqBenchmark(const std::filesystem::path workDirectory);
+	~FseqBenchmark();
+
+	bool run(std::ostream &output, const uint32_t renderFrames);
+
+private:
+	static const uint32_t ZONE_COUNT = 8;
+	static const uint32_t LEDS_PER_ZONE = 250;
+	static const uint32_t FILE_FRAMES = 400;
+	static const uint8_t STEP_TIME = 25;
+	static const uint32_t RENDER_INTERVAL = 16666;
+
+	struct Result
+	{
+		std::vector<int64_t> frameTimes;
+		uint64_t sdCalls;
+		uint64_t sdStalls;
+		uint32_t underrunCount;
+		uint32_t skippedFrameCount;
+	};
+
+	std::filesystem::path workDirectory;
+
+	bool runBaseline(const std::filesystem::path fseqFile, const uint32_t renderFrames, Result &result);
+	bool runReadAhead(const std::filesystem::path fseqFile, const uint32_t renderFrames, Result &result);
+	void printResult(std::ostream &output, const std::string name, Result &result);
+	static int64_t getTime();
+	static void waitUntil(const int64_t time);
+};
+
+#endif
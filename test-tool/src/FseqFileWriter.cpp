@@ -0,0 +1,246 @@
+/**
+ * @file FseqFileWriter.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link FseqFileWriter}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "FseqFileWriter.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <zlib.h>
+
+/**
+ * @brief Write an uncompressed fseq v1 file.
+ * @param fileName name of the output file
+ * @param channelCount number of channels per frame
+ * @param stepTime time between two frames in ms
+ * @param frames frames with channelCount channels each
+ * @return true when the file was written
+ * @return false when the file could not be written
+ */
+bool FseqFileWriter::writeV1(const std::filesystem::path fileName, const uint32_t channelCount, const uint8_t stepTime, const Frames &frames)
+{
+	std::vector<uint8_t> data = {'P', 'S', 'E', 'Q'};
+	FseqFileWriter::writeUint16(data, 28);
+	data.push_back(0);
+	data.push_back(1);
+	FseqFileWriter::writeUint16(data, 28);
+	FseqFileWriter::writeUint32(data, channelCount);
+	FseqFileWriter::writeUint32(data, frames.size());
+	data.push_back(stepTime);
+	data.push_back(0);
+	FseqFileWriter::writeUint16(data, 0);
+	FseqFileWriter::writeUint16(data, 0);
+	data.push_back(1);
+	data.push_back(2);
+	FseqFileWriter::writeUint16(data, 0);
+
+	for (const std::vector<uint8_t> &frame : frames)
+	{
+		data.insert(data.end(), frame.begin(), frame.begin() + channelCount);
+	}
+	return FseqFileWriter::writeFile(fileName, data);
+}
+
+/**
+ * @brief Write a fseq v2 file.
+ * The compressed data is split into blocks of framesPerBlock frames and an unused block is appended to the index like xLights does.
+ * Only the channels in the sparse ranges are stored when there are sparse ranges.
+ * @param fileName name of the output file
+ * @param channelCount number of channels per frame
+ * @param stepTime time between two frames in ms
+ * @param frames frames with channelCount channels each
+ * @param framesPerBlock number of frames per zlib block, 0 to write uncompressed data
+ * @param sparseRanges pairs of start channel and channel count, empty to store all channels
+ * @return true when the file was written
+ * @return false when the file could not be written or compressed
+ */
+bool FseqFileWriter::writeV2(const std::filesystem::path fileName, const uint32_t channelCount, const uint8_t stepTime, const Frames &frames, const uint32_t framesPerBlock, const SparseRanges &sparseRanges)
+{
+	std::vector<std::vector<uint8_t>> storedFrames;
+	for (const std::vector<uint8_t> &frame : frames)
+	{
+		if (sparseRanges.size() == 0)
+		{
+			storedFrames.push_back(std::vector<uint8_t>(frame.begin(), frame.begin() + channelCount));
+			continue;
+		}
+
+		std::vector<uint8_t> storedFrame;
+		for (const std::pair<uint32_t, uint32_t> &range : sparseRanges)
+		{
+			storedFrame.insert(storedFrame.end(), frame.begin() + range.first, frame.begin() + range.first + range.second);
+		}
+		storedFrames.push_back(storedFrame);
+	}
+
+	std::vector<std::pair<uint32_t, std::vector<uint8_t>>> blocks;
+	if (framesPerBlock > 0)
+	{
+		for (size_t firstFrame = 0; firstFrame < storedFrames.size(); firstFrame += framesPerBlock)
+		{
+			std::vector<uint8_t> input;
+			for (size_t i = firstFrame; i < storedFrames.size() && i < firstFrame + framesPerBlock; i++)
+			{
+				input.insert(input.end(), storedFrames.at(i).begin(), storedFrames.at(i).end());
+			}
+
+			uLongf outputSize = compressBound(input.size());
+			std::vector<uint8_t> output(outputSize);
+			if (compress2(output.data(), &outputSize, input.data(), input.size(), 6) != Z_OK)
+			{
+				return false;
+			}
+			output.resize(outputSize);
+			blocks.push_back({firstFrame, output});
+		}
+	}
+
+	// The channel count of sparse files is the number of stored channels
+	uint32_t storedChannelCount = channelCount;
+	if (sparseRanges.size() > 0)
+	{
+		storedChannelCount = 0;
+		for (const std::pair<uint32_t, uint32_t> &range : sparseRanges)
+		{
+			storedChannelCount += range.second;
+		}
+	}
+
+	const uint32_t blockCount = blocks.size() > 0 ? blocks.size() + 1 : 0;
+	const uint16_t headerLength = 32 + blockCount * 8 + sparseRanges.size() * 6;
+	const uint16_t channelDataOffset = (headerLength + 3) & ~3;
+	std::vector<uint8_t> data = {'P', 'S', 'E', 'Q'};
+	FseqFileWriter::writeUint16(data, channelDataOffset);
+	data.push_back(0);
+	data.push_back(2);
+	FseqFileWriter::writeUint16(data, headerLength);
+	FseqFileWriter::writeUint32(data, storedChannelCount);
+	FseqFileWriter::writeUint32(data, frames.size());
+	data.push_back(stepTime);
+	data.push_back(0);
+	data.push_back((blocks.size() > 0 ? 2 : 0) | ((blockCount >> 4) & 0xF0));
+	data.push_back(blockCount & 0xFF);
+	data.push_back(sparseRanges.size());
+	data.push_back(0);
+	FseqFileWriter::writeUint32(data, 0x4E4C5454);
+	FseqFileWriter::writeUint32(data, 0);
+
+	for (const std::pair<uint32_t, std::vector<uint8_t>> &block : blocks)
+	{
+		FseqFileWriter::writeUint32(data, block.first);
+		FseqFileWriter::writeUint32(data, block.second.size());
+	}
+	if (blocks.size() > 0)
+	{
+		FseqFileWriter::writeUint32(data, 0);
+		FseqFileWriter::writeUint32(data, 0);
+	}
+	for (const std::pair<uint32_t, uint32_t> &range : sparseRanges)
+	{
+		FseqFileWriter::writeUint24(data, range.first);
+		FseqFileWriter::writeUint24(data, range.second);
+	}
+	data.resize(channelDataOffset, 0);
+
+	if (blocks.size() > 0)
+	{
+		for (const std::pair<uint32_t, std::vector<uint8_t>> &block : blocks)
+		{
+			data.insert(data.end(), block.second.begin(), block.second.end());
+		}
+	}
+	else
+	{
+		for (const std::vector<uint8_t> &frame : storedFrames)
+		{
+			data.insert(data.end(), frame.begin(), frame.end());
+		}
+	}
+	return FseqFileWriter::writeFile(fileName, data);
+}
+
+/**
+ * @brief Read all frames of an uncompressed fseq v1 file.
+ * @param fileName name of the input file
+ * @param channelCount number of channels per frame
+ * @param stepTime time between two frames in ms
+ * @param frames frames of the file
+ * @return true when the file was read
+ * @return false when the file could not be read or is no fseq v1 file
+ */
+bool FseqFileWriter::readV1(const std::filesystem::path fileName, uint32_t &channelCount, uint8_t &stepTime, Frames &frames)
+{
+	std::ifstream input(fileName, std::ios::binary);
+	const std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	if (!input.good() && !input.eof())
+	{
+		return false;
+	}
+	else if (data.size() < 28 || std::memcmp(data.data(), "PSEQ", 4) != 0 || data.at(7) != 1)
+	{
+		return false;
+	}
+
+	uint16_t channelDataOffset = 0;
+	uint32_t frameCount = 0;
+	std::memcpy(&channelDataOffset, data.data() + 4, 2);
+	std::memcpy(&channelCount, data.data() + 10, 4);
+	std::memcpy(&frameCount, data.data() + 14, 4);
+	stepTime = data.at(18);
+	if (channelDataOffset + static_cast<uint64_t>(channelCount) * frameCount > data.size())
+	{
+		return false;
+	}
+
+	frames.clear();
+	for (uint32_t i = 0; i < frameCount; i++)
+	{
+		const uint8_t *frame = data.data() + channelDataOffset + static_cast<size_t>(i) * channelCount;
+		frames.push_back(std::vector<uint8_t>(frame, frame + channelCount));
+	}
+	return true;
+}
+
+void FseqFileWriter::writeUint16(std::vector<uint8_t> &data, const uint16_t value)
+{
+	data.push_back(value & 0xFF);
+	data.push_back(value >> 8);
+}
+
+void FseqFileWriter::writeUint24(std::vector<uint8_t> &data, const uint32_t value)
+{
+	FseqFileWriter::writeUint16(data, value & 0xFFFF);
+	data.push_back((value >> 16) & 0xFF);
+}
+
+void FseqFileWriter::writeUint32(std::vector<uint8_t> &data, const uint32_t value)
+{
+	FseqFileWriter::writeUint16(data, value & 0xFFFF);
+	FseqFileWriter::writeUint16(data, value >> 16);
+}
+
+bool FseqFileWriter::writeFile(const std::filesystem::path fileName, const std::vector<uint8_t> &data)
+{
+	std::ofstream output(fileName, std::ios::binary);
+	output.write(reinterpret_cast<const char *>(data.data()), data.size());
+	output.close();
+	return output.good();
+}
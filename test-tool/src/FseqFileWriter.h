@@ -0,0 +1,47 @@
+/**
+ * @file FseqFileWriter.h
+ * @author TheRealKasumi
+ * @brief Write fseq files in the formats which are exported by xLights.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef FSEQ_FILE_WRITER_H
+#define FSEQ_FILE_WRITER_H
+
+#include <stdint.h>
+#include <vector>
+#include <utility>
+#include <filesystem>
+
+class FseqFileWriter
+{
+public:
+	typedef std::vector<std::vector<uint8_t>> Frames;
+	typedef std::vector<std::pair<uint32_t, uint32_t>> SparseRanges;
+
+	static bool writeV1(const std::filesystem::path fileName, const uint32_t channelCount, const uint8_t stepTime, const Frames &frames);
+	static bool writeV2(const std::filesystem::path fileName, const uint32_t channelCount, const uint8_t stepTime, const Frames &frames, const uint32_t framesPerBlock, const SparseRanges &sparseRanges);
+	static bool readV1(const std::filesystem::path fileName, uint32_t &channelCount, uint8_t &stepTime, Frames &frames);
+
+private:
+	static void writeUint16(std::vector<uint8_t> &data, const uint16_t value);
+	static void writeUint24(std::vector<uint8_t> &data, const uint32_t value);
+	static void writeUint32(std::vector<uint8_t> &data, const uint32_t value);
+	static bool writeFile(const std::filesystem::path fileName, const std::vector<uint8_t> &data);
+};
+
+#endif
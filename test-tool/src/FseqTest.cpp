@@ -0,0 +1,358 @@
+/**
+ * @file FseqTest.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link FseqTest}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "FseqTest.h"
+#include "HostSimulation.h"
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <thread>
+
+/**
+ * @brief Create a new instance of {@link FseqTest}.
+ * @param workDirectory directory for the generated sample files
+ */
+FseqTest::FseqTest(const std::filesystem::path workDirectory)
+{
+	this->workDirectory = workDirectory;
+}
+
+/**
+ * @brief Destroy the {@link FseqTest} instance.
+ */
+FseqTest::~FseqTest()
+{
+}
+
+/**
+ * @brief Generate sample files in all supported v2 variants and compare them with the v1 export of the same frames.
+ * @param output stream for the results
+ * @return true when all frames are equal
+ * @return false when a frame differs or a file could not be played
+ */
+bool FseqTest::runSamples(std::ostream &output)
+{
+	struct Sample
+	{
+		std::string fileName;
+		uint32_t framesPerBlock;
+		FseqFileWriter::SparseRanges sparseRanges;
+	};
+
+	const uint32_t channelCount = 360;
+	const uint32_t frameCount = 160;
+	const uint8_t stepTime = 25;
+	// The last sample has blocks larger than the 32 KB dictionary of the decompressor
+	const std::vector<Sample> samples = {
+		{"v2_uncompressed.fseq", 0, {}},
+		{"v2_zlib.fseq", 25, {}},
+		{"v2_sparse.fseq", 0, {{0, 90}, {150, 120}}},
+		{"v2_sparse_zlib.fseq", 32, {{30, 60}, {180, 90}}},
+		{"v2_zlib_large_blocks.fseq", 120, {}}};
+
+	std::filesystem::remove_all(this->workDirectory);
+	std::filesystem::create_directories(this->workDirectory);
+	bool success = true;
+	std::vector<std::filesystem::path> fseqFiles;
+	for (const Sample &sample : samples)
+	{
+		const FseqFileWriter::Frames frames = FseqTest::createFrames(channelCount, frameCount, sample.sparseRanges);
+		const std::filesystem::path fseqFile = this->workDirectory / sample.fileName;
+		const std::filesystem::path referenceFile = this->workDirectory / ("v1_" + sample.fileName);
+		if (!FseqFileWriter::writeV2(fseqFile, channelCount, stepTime, frames, sample.framesPerBlock, sample.sparseRanges) || !FseqFileWriter::writeV1(referenceFile, channelCount, stepTime, frames))
+		{
+			output << "Failed to write the sample file " << sample.fileName << "." << std::endl;
+			return false;
+		}
+
+		success = this->compareFiles(fseqFile, referenceFile, output) && success;
+		fseqFiles.push_back(fseqFile);
+	}
+	return this->checkIdentifiers(fseqFiles, output) && success;
+}
+
+/**
+ * @brief Play a fseq file from the cache and streamed from the file and compare every frame with a v1 export.
+ * Channels outside of the sparse ranges of the file must be black in the export.
+ * @param fseqFile file which is played
+ * @param referenceFile uncompressed v1 export of the same frames
+ * @param output stream for the results
+ * @return true when all frames are equal
+ * @return false when a frame differs or the file could not be played
+ */
+bool FseqTest::compareFiles(const std::filesystem::path fseqFile, const std::filesystem::path referenceFile, std::ostream &output)
+{
+	uint32_t channelCount = 0;
+	uint8_t stepTime = 0;
+	FseqFileWriter::Frames reference;
+	if (!FseqFileWriter::readV1(referenceFile, channelCount, stepTime, reference) || reference.size() == 0)
+	{
+		output << "Failed to read the reference file " << referenceFile.filename() << ", only uncompressed fseq v1 files are supported." << std::endl;
+		return false;
+	}
+
+	const bool cached = this->checkPlayback(fseqFile, reference, true, output);
+	const bool streamed = this->checkPlayback(fseqFile, reference, false, output);
+	return cached && streamed;
+}
+
+/**
+ * @brief Add files to the {@link NL::FseqIndex} like an upload does, then lose the index file and let it be rebuilt.
+ * The rebuilt index must find every file by the identifier it got from the {@link NL::FseqValidator}, because the animation settings and the playlist refer to it.
+ * @param fseqFiles files which are uploaded
+ * @param output stream for the results
+ * @return true when all identifiers are equal after the rebuild
+ * @return false when a file could not be validated or an identifier changed
+ */
+bool FseqTest::checkIdentifiers(const std::vector<std::filesystem::path> &fseqFiles, std::ostream &output)
+{
+	const std::filesystem::path rootDirectory = this->workDirectory / "sd";
+	const std::filesystem::path fseqDirectory = rootDirectory / std::string(FSEQ_DIRECTORY).substr(1);
+	std::filesystem::remove_all(rootDirectory);
+	std::filesystem::create_directories(fseqDirectory);
+	FS fileSystem(rootDirectory.string());
+	NL::FseqIndex::begin(&fileSystem);
+
+	std::vector<NL::FseqIndex::Entry> uploads;
+	for (const std::filesystem::path &fseqFile : fseqFiles)
+	{
+		std::ifstream input(fseqFile, std::ios::binary);
+		const std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+		NL::FseqValidator validator({});
+		for (size_t position = 0; position < data.size(); position += 1000)
+		{
+			validator.write(data.data() + position, std::min<size_t>(1000, data.size() - position));
+		}
+		if (validator.finish() != NL::FseqLoader::Error::OK)
+		{
+			output << fseqFile.filename().string() << " was rejected by the upload validation." << std::endl;
+			NL::FseqIndex::end();
+			return false;
+		}
+
+		std::filesystem::copy_file(fseqFile, fseqDirectory / fseqFile.filename());
+		const NL::FseqLoader::FseqHeader header = validator.getHeader();
+		const NL::FseqIndex::Entry entry = {validator.getChecksum(), fseqFile.filename().string().c_str(), validator.getSize(), header.channelCount, header.frameCount, header.stepTime};
+		NL::FseqIndex::addEntry(entry);
+		uploads.push_back(entry);
+	}
+
+	NL::FseqIndex::end();
+	std::filesystem::remove(rootDirectory / std::string(FSEQ_INDEX_FILE_NAME).substr(1));
+	NL::FseqIndex::begin(&fileSystem);
+
+	bool success = true;
+	for (const NL::FseqIndex::Entry &upload : uploads)
+	{
+		NL::FseqIndex::Entry entry;
+		if (!NL::FseqIndex::getEntry(upload.identifier, entry) || entry.fileName != upload.fileName)
+		{
+			output << "The identifier of " << upload.fileName.c_str() << " changed when the index was rebuilt." << std::endl;
+			success = false;
+		}
+	}
+	NL::FseqIndex::end();
+
+	if (success)
+	{
+		output << "The identifiers of " << uploads.size() << " uploaded files are equal after the index was rebuilt." << std::endl;
+	}
+	return success;
+}
+
+/**
+ * @brief Play all frames of a file in order, then seek to random frames and compare them with the reference.
+ * The clock is moved by exactly one step per frame, so no frame is skipped or repeated.
+ * @param fseqFile file which is played
+ * @param reference frames of the reference file
+ * @param cached true to play from the cache, false to stream the frames from the file
+ * @param output stream for the results
+ * @return true when all frames are equal
+ * @return false when a frame differs or the file could not be played
+ */
+bool FseqTest::checkPlayback(const std::filesystem::path fseqFile, const FseqFileWriter::Frames &reference, const bool cached, std::ostream &output)
+{
+	const std::string mode = cached ? "cached" : "streamed";
+	output << fseqFile.filename().string() << " (" << mode << "): ";
+
+	HostSimulation::setHeap(1024 * 1024, cached ? 1024 * 1024 : 0);
+	HostSimulation::setPsram(cached);
+	HostSimulation::setClock(0);
+	FS fileSystem(fseqFile.parent_path().string());
+	NL::FseqLoader fseqLoader(&fileSystem);
+	const NL::FseqLoader::Error loadError = fseqLoader.loadFromFile(String("/") + fseqFile.filename().string().c_str());
+	if (loadError != NL::FseqLoader::Error::OK)
+	{
+		output << "failed to load the file, error " << static_cast<int>(loadError) << "." << std::endl;
+		return false;
+	}
+	else if (fseqLoader.getHeader().frameCount != reference.size() || fseqLoader.getFrameSize() > reference.at(0).size() || (fseqLoader.getHeader().sparseRangeCount == 0 && fseqLoader.getFrameSize() != reference.at(0).size()))
+	{
+		output << "the frame count or frame size differs from the reference." << std::endl;
+		return false;
+	}
+
+	const NL::FseqLoader::Error readAheadError = fseqLoader.startReadAhead();
+	if (readAheadError != NL::FseqLoader::Error::OK)
+	{
+		output << "failed to start the read ahead, error " << static_cast<int>(readAheadError) << "." << std::endl;
+		return false;
+	}
+	else if (fseqLoader.isCached() != cached)
+	{
+		output << "skipped, the file is too large for the cache." << std::endl;
+		return true;
+	}
+
+	const size_t ledCount = reference.at(0).size() / 3;
+	std::vector<uint8_t> buffer(ledCount * 3);
+	std::vector<NL::LedStrip> ledStrips;
+	for (size_t firstLed = 0; firstLed < ledCount; firstLed += FseqTest::LEDS_PER_ZONE)
+	{
+		ledStrips.push_back(NL::LedStrip(0, std::min(FseqTest::LEDS_PER_ZONE, ledCount - firstLed)));
+		ledStrips.back().setBuffer(buffer.data() + firstLed * 3);
+	}
+	fseqLoader.setZoneCount(ledStrips.size());
+
+	bool success = true;
+	const int64_t stepTime = fseqLoader.getHeader().stepTime * 1000;
+	for (uint32_t i = 0; i < reference.size(); i++)
+	{
+		HostSimulation::setClock(i * stepTime);
+		if (!this->waitForFrame(fseqLoader, ledStrips, i))
+		{
+			output << "timed out waiting for frame " << i << "." << std::endl;
+			return false;
+		}
+		success = this->compareFrame(ledStrips, reference.at(i), i, output) && success;
+	}
+
+	std::mt19937 random(reference.size());
+	for (size_t i = 0; i < FseqTest::SEEK_COUNT; i++)
+	{
+		const uint32_t frameIndex = random() % reference.size();
+		fseqLoader.seekToFrame(frameIndex);
+		if (!this->waitForFrame(fseqLoader, ledStrips, frameIndex))
+		{
+			output << "timed out waiting for frame " << frameIndex << " after seeking." << std::endl;
+			return false;
+		}
+		success = this->compareFrame(ledStrips, reference.at(frameIndex), frameIndex, output) && success;
+	}
+
+	if (success)
+	{
+		output << reference.size() << " frames and " << FseqTest::SEEK_COUNT << " seeks are equal." << std::endl;
+	}
+	else
+	{
+		output << std::endl;
+	}
+	return success;
+}
+
+/**
+ * @brief Read all zones until the given frame was read ahead.
+ * @param fseqLoader loader to read from
+ * @param ledStrips one LED strip per zone
+ * @param frameIndex index of the expected frame
+ * @return true when the frame was read into the LED strips
+ * @return false when the frame was not read in time
+ */
+bool FseqTest::waitForFrame(NL::FseqLoader &fseqLoader, std::vector<NL::LedStrip> &ledStrips, const uint32_t frameIndex)
+{
+	const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(FseqTest::FRAME_TIMEOUT);
+	while (std::chrono::steady_clock::now() < timeout)
+	{
+		bool read = true;
+		for (size_t i = 0; i < ledStrips.size(); i++)
+		{
+			read = fseqLoader.readLedStrip(ledStrips.at(i), i * FseqTest::LEDS_PER_ZONE * 3, false) == NL::FseqLoader::Error::OK && read;
+		}
+
+		if (read && fseqLoader.getCurrentFrame() == frameIndex)
+		{
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+
+/**
+ * @brief Compare the channels of the LED strips with a reference frame.
+ * @param ledStrips one LED strip per zone
+ * @param reference reference frame
+ * @param frameIndex index of the frame
+ * @param output stream for the first differing channel
+ * @return true when all channels are equal
+ * @return false when a channel differs
+ */
+bool FseqTest::compareFrame(std::vector<NL::LedStrip> &ledStrips, const std::vector<uint8_t> &reference, const uint32_t frameIndex, std::ostream &output)
+{
+	size_t channel = 0;
+	for (NL::LedStrip &ledStrip : ledStrips)
+	{
+		for (size_t i = 0; i < ledStrip.getLedCount() * 3; i++, channel++)
+		{
+			if (ledStrip.getBuffer()[i] != reference.at(channel))
+			{
+				output << std::endl
+					   << "  frame " << frameIndex << " differs at channel " << channel << ": expected " << static_cast<int>(reference.at(channel)) << ", got " << static_cast<int>(ledStrip.getBuffer()[i]) << ".";
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Create frames with gradients that move and change their speed, so they compress like real animations.
+ * Channels outside of the sparse ranges are black.
+ * @param channelCount number of channels per frame
+ * @param frameCount number of frames
+ * @param sparseRanges pairs of start channel and channel count, empty for all channels
+ * @return FseqFileWriter::Frames generated frames
+ */
+FseqFileWriter::Frames FseqTest::createFrames(const uint32_t channelCount, const uint32_t frameCount, const FseqFileWriter::SparseRanges &sparseRanges)
+{
+	std::mt19937 random(channelCount ^ frameCount);
+	FseqFileWriter::Frames frames(frameCount, std::vector<uint8_t>(channelCount, 0));
+	for (uint32_t i = 0; i < frameCount; i++)
+	{
+		for (uint32_t channel = 0; channel < channelCount; channel++)
+		{
+			bool used = sparseRanges.size() == 0;
+			for (const std::pair<uint32_t, uint32_t> &range : sparseRanges)
+			{
+				used = used || (channel >= range.first && channel < range.first + range.second);
+			}
+
+			const uint32_t led = channel / 3;
+			const uint32_t color = channel % 3;
+			const uint32_t value = (led * (color + 1) * 5 + i * (i / 40 + 2) * (color + 1)) & 0xFF;
+			frames.at(i).at(channel) = used ? static_cast<uint8_t>(i % 17 == 0 ? random() : value) : 0;
+		}
+	}
+	return frames;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file FseqTest.h
+ * @author TheRealKasumi
+ * @brief Check that the {@link NL::FseqLoader} decodes fseq v2 files to the same frames as a v1 export.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef FSEQ_TEST_H
+#define FSEQ_TEST_H
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <ostream>
+
+#include "FseqFileWriter.h"
+#include "util/FseqLoader.h"
+#include "util/FseqIndex.h"
+#include "util/FseqValidator.h"
+
+class FseqTest
+{
+public:
+	FseqTest(const std::filesystem::path workDirectory);
+	~FseqTest();
+
+	bool runSamples(std::ostream &output);
+	bool compareFiles(const std::filesystem::path fseqFile, const std::filesystem::path referenceFile, std::ostream &output);
+
+private:
+	static const size_t LEDS_PER_ZONE = 100;
+	static const size_t SEEK_COUNT = 8;
+	static const uint32_t FRAME_TIMEOUT = 5000;
+
+	std::filesystem::path workDirectory;
+
+	bool checkIdentifiers(const std::vector<std::filesystem::path> &fseqFiles, std::ostream &output);
+	bool checkPlayback(const std::filesystem::path fseqFile, const FseqFileWriter::Frames &reference, const bool cached, std::ostream &output);
+	bool waitForFrame(NL::FseqLoader &fseqLoader, std::vector<NL::LedStrip> &ledStrips, const uint32_t frameIndex);
+	bool compareFrame(std::vector<NL::LedStrip> &ledStrips, const std::vector<uint8_t> &reference, const uint32_t frameIndex, std::ostream &output);
+	static FseqFileWriter::Frames createFrames(const uint32_t channelCount, const uint32_t frameCount, const FseqFileWriter::SparseRanges &sparseRanges);
+};
+
+#endif
@@ -0,0 +1,516 @@
+/**
+ * @file LogTest.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link LogTest}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "LogTest.h"
+#include "HostSimulation.h"
+
+#include <SD.h>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <iterator>
+#include <unordered_map>
+
+/**
+ * @brief Create a new instance of {@link LogTest}.
+ * @param workDirectory directory for the log files
+ */
+LogTest::LogTest(const std::filesystem::path workDirectory)
+{
+	this->workDirectory = workDirectory;
+	this->minLogLevel = NL::Logger::LogLevel::DEBUG;
+}
+
+/**
+ * @brief Destroy the {@link LogTest} instance.
+ */
+LogTest::~LogTest()
+{
+}
+
+/**
+ * @brief Run all steps. Every logged message is rendered as expected text line, which is compared with the decoded log file.
+ * @param output stream for the results
+ * @return true when all steps passed
+ * @return false when a step failed
+ */
+bool LogTest::run(std::ostream &output)
+{
+	std::filesystem::remove_all(this->workDirectory);
+	std::filesystem::create_directories(this->workDirectory);
+	SD.setRoot(this->workDirectory.string());
+	HostSimulation::setClock(0);
+	this->expectedLines.clear();
+	this->minLogLevel = NL::Logger::LogLevel::DEBUG;
+	if (!NL::Logger::begin(&SD, LOG_FILE_NAME, this->minLogLevel))
+	{
+		return this->report(output, "Start the logger", false);
+	}
+
+	bool passed = this->report(output, "Messages are written as binary records", this->writeMessages());
+	passed = passed && this->report(output, "Constant messages are written once and referenced", this->writeConstantMessages());
+	passed = passed && this->report(output, "Records are rendered as text lines", this->readMessages());
+	passed = passed && this->report(output, "Reading from any offset starts at the next record", this->readFromOffsets());
+	passed = passed && this->report(output, "Dropped messages are counted and reported", this->dropMessages());
+	passed = passed && this->report(output, "The logger can be restarted while other tasks log", this->restartLogger());
+	passed = passed && this->report(output, "A rotated log file has its own location and text records", this->rotateLog());
+
+	NL::Logger::end();
+	HostSimulation::useRealClock();
+	std::filesystem::remove_all(this->workDirectory);
+	return passed;
+}
+
+/**
+ * @brief Log messages of all levels from several locations, including a filtered and a too long message.
+ * The log file is decoded without the {@link NL::LogReader} and compared with the expected lines.
+ * @return true when the records and the location records are as expected
+ * @return false when the file could not be decoded or differs
+ */
+bool LogTest::writeMessages()
+{
+	for (size_t i = 0; i < MESSAGE_COUNT; i++)
+	{
+		HostSimulation::setClock((3599990 + i * 250) * 1000ll);
+		const NL::Logger::LogLevel logLevel = static_cast<NL::Logger::LogLevel>(i % 4);
+		if (i % 2 == 0)
+		{
+			this->logMessage(logLevel, SOURCE_LOCATION, String("Even message ") + String(i));
+		}
+		else
+		{
+			this->logMessage(logLevel, SOURCE_LOCATION, String("Odd message ") + String(i));
+		}
+	}
+
+	NL::Logger::setMinLogLevel(NL::Logger::LogLevel::INFO);
+	this->minLogLevel = NL::Logger::LogLevel::INFO;
+	this->logMessage(NL::Logger::LogLevel::DEBUG, SOURCE_LOCATION, "This message is filtered.");
+	this->logMessage(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, String(LOG_MAX_MESSAGE_LENGTH + 50, 'x'));
+	NL::Logger::setMinLogLevel(NL::Logger::LogLevel::DEBUG);
+	this->minLogLevel = NL::Logger::LogLevel::DEBUG;
+	NL::Logger::flush();
+
+	std::vector<std::string> lines;
+	size_t locationCount = 0;
+	size_t textCount = 0;
+	return this->decodeFile(this->workDirectory / std::string(LOG_FILE_NAME).substr(1), lines, locationCount, textCount) && locationCount == 3 && textCount == 0 && lines == this->expectedLines;
+}
+
+/**
+ * @brief Log the same constant messages several times from two locations.
+ * Each text must be written once, after that every message must only take the size of a constant message record.
+ * @return true when the texts were written once and the following messages are referencing them
+ * @return false when the file could not be decoded, differs or a text was written again
+ */
+bool LogTest::writeConstantMessages()
+{
+	const std::filesystem::path fileName = this->workDirectory / std::string(LOG_FILE_NAME).substr(1);
+	uint32_t firstRoundSize = 0;
+	for (size_t i = 0; i < CONSTANT_MESSAGE_ROUNDS; i++)
+	{
+		HostSimulation::setClock((3610000 + i * 250) * 1000ll);
+		this->logMessage(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("The animation was changed."));
+		this->logMessage(NL::Logger::LogLevel::WARN, SOURCE_LOCATION, F("The light sensor is not responding."));
+		NL::Logger::flush();
+		if (i == 0)
+		{
+			firstRoundSize = std::filesystem::file_size(fileName);
+		}
+	}
+
+	std::vector<std::string> lines;
+	size_t locationCount = 0;
+	size_t textCount = 0;
+	return this->decodeFile(fileName, lines, locationCount, textCount) && locationCount == 5 && textCount == 2 && lines == this->expectedLines &&
+		   std::filesystem::file_size(fileName) - firstRoundSize == (CONSTANT_MESSAGE_ROUNDS - 1) * 2 * 13;
+}
+
+/**
+ * @brief Render the log file with the {@link NL::LogReader}, like the log endpoint of the REST API does.
+ * @return true when all lines are equal to the expected lines
+ * @return false when the file could not be read or a line differs
+ */
+bool LogTest::readMessages()
+{
+	std::vector<std::string> lines;
+	return this->readLines(LOG_FILE_NAME, 0, lines) && lines == this->expectedLines;
+}
+
+/**
+ * @brief Start reading at every byte of the log file, like a client requesting any byte range.
+ * The reader must skip the broken part of the first record and continue with the following records.
+ * @return true when the lines read from every offset are the end of the expected lines
+ * @return false when a line differs or a message was skipped
+ */
+bool LogTest::readFromOffsets()
+{
+	std::vector<std::string> previousLines = this->expectedLines;
+	const size_t fileSize = std::filesystem::file_size(this->workDirectory / std::string(LOG_FILE_NAME).substr(1));
+	for (size_t position = 0; position < fileSize; position++)
+	{
+		std::vector<std::string> lines;
+		if (!this->readLines(LOG_FILE_NAME, position, lines) || lines.size() > previousLines.size() ||
+			!std::equal(lines.begin(), lines.end(), this->expectedLines.end() - lines.size()) ||
+			previousLines.size() - lines.size() > 1)
+		{
+			return false;
+		}
+		previousLines = lines;
+	}
+	return previousLines.size() <= 1;
+}
+
+/**
+ * @brief Log more messages at once than the ring buffer can hold, before the writer task wakes up.
+ * @return true when all messages are either written or reported as dropped
+ * @return false when the numbers do not match or no message was dropped
+ */
+bool LogTest::dropMessages()
+{
+	const uint32_t droppedBefore = NL::Logger::getDroppedMessageCount();
+	for (size_t i = 0; i < BURST_MESSAGE_COUNT; i++)
+	{
+		NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, String("Burst message ") + String(i));
+	}
+	const uint32_t dropped = NL::Logger::getDroppedMessageCount() - droppedBefore;
+	NL::Logger::flush();
+
+	std::vector<std::string> lines;
+	size_t locationCount = 0;
+	size_t textCount = 0;
+	if (dropped == 0 || !this->decodeFile(this->workDirectory / std::string(LOG_FILE_NAME).substr(1), lines, locationCount, textCount))
+	{
+		return false;
+	}
+
+	size_t written = 0;
+	uint32_t reported = 0;
+	for (size_t i = this->expectedLines.size(); i < lines.size(); i++)
+	{
+		unsigned int count = 0;
+		if (lines[i].find("): Burst message ") != std::string::npos)
+		{
+			written++;
+		}
+		else if (sscanf(lines[i].substr(lines[i].find("): ") + 3).c_str(), "%u log messages were dropped.", &count) == 1)
+		{
+			reported += count;
+		}
+	}
+
+	this->expectedLines = lines;
+	return written + dropped == BURST_MESSAGE_COUNT && reported == dropped;
+}
+
+/**
+ * @brief Stop and start the logger while other tasks keep logging.
+ * The ring buffer must not be deleted while a task is adding a record, and no broken record may be written.
+ * @return true when the logger was restarted and the log file can be decoded
+ * @return false when the logger could not be started or the log file contains a broken record
+ */
+bool LogTest::restartLogger()
+{
+	std::atomic<bool> running(true);
+	std::vector<std::thread> tasks;
+	for (size_t i = 0; i < LOGGING_TASK_COUNT; i++)
+	{
+		tasks.push_back(std::thread([&running, i]()
+									{
+										for (size_t j = 0; running.load(); j++)
+										{
+											NL::Logger::log(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, String("Task ") + String(i) + String(" message ") + String(j));
+										} }));
+	}
+
+	bool started = true;
+	for (size_t i = 0; i < RESTART_COUNT && started; i++)
+	{
+		NL::Logger::end();
+		started = NL::Logger::begin(&SD, LOG_FILE_NAME, this->minLogLevel);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	running = false;
+	for (std::thread &task : tasks)
+	{
+		task.join();
+	}
+	NL::Logger::flush();
+
+	std::vector<std::string> lines;
+	size_t locationCount = 0;
+	size_t textCount = 0;
+	return started && this->decodeFile(this->workDirectory / std::string(LOG_FILE_NAME).substr(1), lines, locationCount, textCount);
+}
+
+/**
+ * @brief Write messages until the log file is rotated, then write one more round from the same location and read both files after the logger was stopped.
+ * The {@link NL::LogReader} can not ask the {@link NL::Logger} for locations any more, so both files must contain all of their location records.
+ * @return true when both files end with the expected lines and contain no unknown location
+ * @return false when the log was not rotated or a file could not be read
+ */
+bool LogTest::rotateLog()
+{
+	this->expectedLines.clear();
+	bool rotated = false;
+	for (size_t i = 0; i < MAX_ROTATION_ROUNDS && !rotated; i++)
+	{
+		rotated = SD.exists(LOG_ROTATED_FILE_NAME);
+		for (size_t j = 0; j < ROTATION_ROUND_MESSAGE_COUNT; j++)
+		{
+			this->logMessage(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, String(200, 'r'));
+		}
+		this->logMessage(NL::Logger::LogLevel::INFO, SOURCE_LOCATION, F("The rotation round is complete."));
+		NL::Logger::flush();
+	}
+	NL::Logger::end();
+
+	std::vector<std::string> lines;
+	std::vector<std::string> rotatedLines;
+	if (!rotated || std::filesystem::file_size(this->workDirectory / std::string(LOG_ROTATED_FILE_NAME).substr(1)) <= LOG_MAX_FILE_SIZE ||
+		!this->readLines(LOG_ROTATED_FILE_NAME, 0, rotatedLines) || !this->readLines(LOG_FILE_NAME, 0, lines) ||
+		lines.size() != ROTATION_ROUND_MESSAGE_COUNT + 1 || !std::equal(lines.begin(), lines.end(), this->expectedLines.end() - lines.size()))
+	{
+		return false;
+	}
+
+	rotatedLines.insert(rotatedLines.end(), lines.begin(), lines.end());
+	for (const std::string &line : rotatedLines)
+	{
+		if (line.find("(unknown)") != std::string::npos)
+		{
+			return false;
+		}
+	}
+	return rotatedLines.size() >= this->expectedLines.size() && std::equal(this->expectedLines.begin(), this->expectedLines.end(), rotatedLines.end() - this->expectedLines.size());
+}
+
+/**
+ * @brief Log a message and remember the line which is expected in the log file.
+ * @param logLevel log level for the message
+ * @param locationId id of the source location
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message message text
+ */
+void LogTest::logMessage(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const String &message)
+{
+	if (logLevel >= this->minLogLevel)
+	{
+		this->expectedLines.push_back(LogTest::formatLine(logLevel, millis(), file, function, line, message.c_str(), std::min<size_t>(message.length(), LOG_MAX_MESSAGE_LENGTH)));
+	}
+	NL::Logger::log(logLevel, locationId, file, function, line, message);
+}
+
+/**
+ * @brief Log a constant message and remember the line which is expected in the log file.
+ * @param logLevel log level for the message
+ * @param locationId id of the source location
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message constant message text
+ */
+void LogTest::logMessage(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const __FlashStringHelper *message)
+{
+	const char *text = reinterpret_cast<const char *>(message);
+	if (logLevel >= this->minLogLevel)
+	{
+		this->expectedLines.push_back(LogTest::formatLine(logLevel, millis(), file, function, line, text, std::min<size_t>(strlen(text), LOG_MAX_MESSAGE_LENGTH)));
+	}
+	NL::Logger::log(logLevel, locationId, file, function, line, message);
+}
+
+/**
+ * @brief Decode a log file and render all messages as text lines.
+ * This follows the file format in the ReadMe of the log tool and does not use the {@link NL::LogReader}.
+ * @param fileName path and name of the log file
+ * @param lines rendered log lines
+ * @param locationCount number of location records in the file
+ * @param textCount number of text records in the file
+ * @return true when the file was decoded
+ * @return false when the file contains an invalid record, a location or text record twice or a message before its location or text
+ */
+bool LogTest::decodeFile(const std::filesystem::path fileName, std::vector<std::string> &lines, size_t &locationCount, size_t &textCount)
+{
+	struct Location
+	{
+		std::string file;
+		std::string function;
+		uint16_t line;
+	};
+
+	std::ifstream input(fileName, std::ios::binary);
+	const std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	if (data.size() < 5 || memcmp(data.data(), "NLLG", 4) != 0 || data[4] != LOG_FILE_VERSION)
+	{
+		return false;
+	}
+
+	std::unordered_map<uint32_t, Location> locations;
+	std::unordered_map<uint32_t, std::string> texts;
+	lines.clear();
+	locationCount = 0;
+	textCount = 0;
+	size_t position = 5;
+	while (position < data.size())
+	{
+		const uint8_t *record = &data[position];
+		const size_t remaining = data.size() - position;
+		if (record[0] == static_cast<uint8_t>(NL::Logger::RecordType::LOCATION))
+		{
+			if (remaining < 9u + record[7] || remaining < 9u + record[7] + record[8 + record[7]])
+			{
+				return false;
+			}
+
+			const uint32_t locationId = record[1] | record[2] << 8 | record[3] << 16 | static_cast<uint32_t>(record[4]) << 24;
+			Location location;
+			location.line = record[5] | record[6] << 8;
+			location.file.assign(reinterpret_cast<const char *>(record + 8), record[7]);
+			location.function.assign(reinterpret_cast<const char *>(record + 9 + record[7]), record[8 + record[7]]);
+			if (!locations.emplace(locationId, location).second)
+			{
+				return false;
+			}
+			locationCount++;
+			position += 9 + location.file.length() + location.function.length();
+		}
+		else if ((record[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::MESSAGE))
+		{
+			const uint32_t time = record[1] | record[2] << 8 | record[3] << 16 | static_cast<uint32_t>(record[4]) << 24;
+			const uint32_t locationId = record[5] | record[6] << 8 | record[7] << 16 | static_cast<uint32_t>(record[8]) << 24;
+			const uint16_t messageLength = remaining >= 11 ? record[9] | record[10] << 8 : 0;
+			const std::unordered_map<uint32_t, Location>::const_iterator location = locations.find(locationId);
+			if (remaining < 11 || remaining < 11u + messageLength || messageLength > LOG_MAX_MESSAGE_LENGTH || location == locations.end())
+			{
+				return false;
+			}
+
+			const Location &source = location->second;
+			lines.push_back(LogTest::formatLine(static_cast<NL::Logger::LogLevel>(record[0] & 0x03), time, source.file.c_str(), source.function.c_str(), source.line, reinterpret_cast<const char *>(record + 11), messageLength));
+			position += 11 + messageLength;
+		}
+		else if (record[0] == static_cast<uint8_t>(NL::Logger::RecordType::TEXT))
+		{
+			const uint32_t textId = remaining >= 7 ? record[1] | record[2] << 8 | record[3] << 16 | static_cast<uint32_t>(record[4]) << 24 : 0;
+			const uint16_t textLength = remaining >= 7 ? record[5] | record[6] << 8 : 0;
+			if (remaining < 7 || remaining < 7u + textLength || textLength > LOG_MAX_MESSAGE_LENGTH ||
+				!texts.emplace(textId, std::string(reinterpret_cast<const char *>(record + 7), textLength)).second)
+			{
+				return false;
+			}
+			textCount++;
+			position += 7 + textLength;
+		}
+		else if ((record[0] & 0xFC) == static_cast<uint8_t>(NL::Logger::RecordType::CONSTANT_MESSAGE))
+		{
+			if (remaining < 13)
+			{
+				return false;
+			}
+
+			const uint32_t time = record[1] | record[2] << 8 | record[3] << 16 | static_cast<uint32_t>(record[4]) << 24;
+			const uint32_t locationId = record[5] | record[6] << 8 | record[7] << 16 | static_cast<uint32_t>(record[8]) << 24;
+			const uint32_t textId = record[9] | record[10] << 8 | record[11] << 16 | static_cast<uint32_t>(record[12]) << 24;
+			const std::unordered_map<uint32_t, Location>::const_iterator location = locations.find(locationId);
+			const std::unordered_map<uint32_t, std::string>::const_iterator text = texts.find(textId);
+			if (location == locations.end() || text == texts.end())
+			{
+				return false;
+			}
+
+			const Location &source = location->second;
+			lines.push_back(LogTest::formatLine(static_cast<NL::Logger::LogLevel>(record[0] & 0x03), time, source.file.c_str(), source.function.c_str(), source.line, text->second.c_str(), text->second.length()));
+			position += 13;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Render a log file with the {@link NL::LogReader}.
+ * @param fileName name of the log file on the MicroSD card
+ * @param position offset from which the reader starts
+ * @param lines rendered log lines
+ * @return true when the file was read until its end
+ * @return false when the file could not be opened or read
+ */
+bool LogTest::readLines(const String fileName, const uint32_t position, std::vector<std::string> &lines)
+{
+	File file = SD.open(fileName, FILE_READ);
+	if (!file)
+	{
+		return false;
+	}
+
+	NL::LogReader logReader(file);
+	NL::LogReader::Error error = logReader.begin();
+	if (error == NL::LogReader::Error::OK)
+	{
+		logReader.seek(position);
+		char buffer[LOG_MAX_LINE_LENGTH];
+		size_t length = 0;
+		while ((error = logReader.readLine(buffer, sizeof(buffer), length)) == NL::LogReader::Error::OK)
+		{
+			lines.push_back(std::string(buffer, length));
+		}
+	}
+	file.close();
+	return error == NL::LogReader::Error::ERROR_END_OF_FILE;
+}
+
+/**
+ * @brief Render a message like the {@link NL::Logger} does.
+ * @param logLevel log level for the message
+ * @param time time in ms
+ * @param file path and name of the source file
+ * @param function name of the function
+ * @param current line in code
+ * @param message message text, does not need to be null terminated
+ * @param messageLength length of the message
+ * @return log line
+ */
+std::string LogTest::formatLine(const NL::Logger::LogLevel logLevel, const uint32_t time, const char *file, const char *function, const int line, const char *message, const size_t messageLength)
+{
+	char buffer[LOG_MAX_LINE_LENGTH];
+	const size_t length = NL::Logger::formatLine(buffer, sizeof(buffer), logLevel, time, file, function, line, message, messageLength);
+	return std::string(buffer, length);
+}
+
+/**
+ * @brief Print the result of a step.
+ * @param output output stream
+ * @param step description of the step
+ * @param passed true when the step passed
+ * @return passed
+ */
+bool LogTest::report(std::ostream &output, const std::string step, const bool passed)
+{
+	output << step << ": " << (passed ? "passed" : "failed") << "." << std::endl;
+	return passed;
+}
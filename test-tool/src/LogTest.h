@@ -0,0 +1,71 @@
+/**
+ * @file LogTest.h
+ * @author TheRealKasumi
+ * @brief Check the binary log file written by the {@link NL::Logger} and the text rendered by the {@link NL::LogReader}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef LOG_TEST_H
+#define LOG_TEST_H
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <ostream>
+
+#include "logging/Logger.h"
+#include "logging/LogReader.h"
+
+class LogTest
+{
+public:
+	LogTest(const std::filesystem::path workDirectory);
+	~LogTest();
+
+	bool run(std::ostream &output);
+
+private:
+	static const size_t MESSAGE_COUNT = 40;
+	static const size_t CONSTANT_MESSAGE_ROUNDS = 20;
+	static const size_t BURST_MESSAGE_COUNT = 2000;
+	static const size_t RESTART_COUNT = 20;
+	static const size_t LOGGING_TASK_COUNT = 4;
+	static const size_t MAX_ROTATION_ROUNDS = 1000;
+	static const size_t ROTATION_ROUND_MESSAGE_COUNT = 20;
+
+	std::filesystem::path workDirectory;
+	NL::Logger::LogLevel minLogLevel;
+	std::vector<std::string> expectedLines;
+
+	bool writeMessages();
+	bool writeConstantMessages();
+	bool readMessages();
+	bool readFromOffsets();
+	bool dropMessages();
+	bool restartLogger();
+	bool rotateLog();
+
+	void logMessage(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const String &message);
+	void logMessage(const NL::Logger::LogLevel logLevel, const uint32_t locationId, const char *file, const char *function, const int line, const __FlashStringHelper *message);
+	bool decodeFile(const std::filesystem::path fileName, std::vector<std::string> &lines, size_t &locationCount, size_t &textCount);
+	bool readLines(const String fileName, const uint32_t position, std::vector<std::string> &lines);
+	static std::string formatLine(const NL::Logger::LogLevel logLevel, const uint32_t time, const char *file, const char *function, const int line, const char *message, const size_t messageLength);
+	bool report(std::ostream &output, const std::string step, const bool passed);
+};
+
+#endif
@@ -0,0 +1,354 @@
+/**
+ * @file PostProcessingBenchmark.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link PostProcessingBenchmark}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "PostProcessingBenchmark.h"
+#include "HostSimulation.h"
+
+#include <SD.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#include "configuration/Configuration.h"
+#include "led/LedManager.h"
+#include "sensor/SensorSnapshot.h"
+
+/**
+ * @brief Create a new instance of {@link PostProcessingBenchmark}.
+ * @param workDirectory directory for the configuration file
+ */
+PostProcessingBenchmark::PostProcessingBenchmark(const std::filesystem::path workDirectory)
+{
+	this->workDirectory = workDirectory;
+}
+
+/**
+ * @brief Destroy the {@link PostProcessingBenchmark} instance.
+ */
+PostProcessingBenchmark::~PostProcessingBenchmark()
+{
+}
+
+/**
+ * @brief Render frames for all zones with 250 LEDs each and measure the post-processing.
+ * The brightness, power limit and temperature limit are all active.
+ * @param output stream for the results
+ * @param frameCount number of frames
+ * @return true when the LED manager could be started
+ * @return false when the LED manager failed
+ */
+bool PostProcessingBenchmark::run(std::ostream &output, const uint32_t frameCount)
+{
+	NL::Profiler::StageStatistics postProcessing;
+	NL::Profiler::StageStatistics animatorRender;
+	NL::Profiler::StageStatistics baseline;
+	if (!this->runLedManager(frameCount, postProcessing, animatorRender))
+	{
+		output << "Failed to render the frames with the LED manager." << std::endl;
+		return false;
+	}
+	this->runBaseline(frameCount, baseline);
+
+	output << "Zones: " << LED_NUM_ZONES << " x " << PostProcessingBenchmark::LEDS_PER_ZONE << " LEDs, " << frameCount << " frames" << std::endl;
+	output << std::endl;
+	output << "Per frame, CPU time in µs measured on this computer:" << std::endl;
+	output << std::left << std::setw(40) << "stage" << std::right << std::setw(10) << "min" << std::setw(10) << "avg" << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+	this->printResult(output, "separate float passes (baseline)", baseline);
+	this->printResult(output, "fused post-processing", postProcessing);
+	this->printResult(output, "rainbow animator, per zone", animatorRender);
+	return true;
+}
+
+/**
+ * @brief Configure all zones with the maximum number of LEDs and render frames with the {@link NL::LedManager}.
+ * The time of each stage is taken from the {@link NL::Profiler}, which is also used on the controller.
+ * @param frameCount number of frames
+ * @param postProcessing time of the post-processing
+ * @param animatorRender time of the rainbow animator, which is the default animation
+ * @return true when all frames were rendered and every zone was recorded as rainbow animator
+ * @return false when the LED manager could not be started or the animator times were recorded for the wrong stage
+ */
+bool PostProcessingBenchmark::runLedManager(const uint32_t frameCount, NL::Profiler::StageStatistics &postProcessing, NL::Profiler::StageStatistics &animatorRender)
+{
+	std::filesystem::create_directories(this->workDirectory);
+	SD.setRoot(this->workDirectory.string());
+	HostSimulation::useRealClock();
+
+	NL::Configuration::begin(&SD, "/benchmark.nlc");
+	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		NL::Configuration::LedConfig ledConfig;
+		NL::Configuration::getLedConfig(i, ledConfig);
+		ledConfig.ledCount = PostProcessingBenchmark::LEDS_PER_ZONE;
+		ledConfig.brightness = PostProcessingBenchmark::ZONE_BRIGHTNESS;
+		NL::Configuration::setLedConfig(i, ledConfig);
+	}
+
+	NL::SensorSnapshot::begin();
+	NL::SensorSnapshot::setRegulatorTemperature(PostProcessingBenchmark::getRegulatorTemperature());
+	NL::Profiler::begin();
+	if (NL::LedManager::begin() != NL::LedManager::Error::OK || NL::LedManager::reloadAnimations() != NL::LedManager::Error::OK)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < PostProcessingBenchmark::WARM_UP_FRAMES; i++)
+	{
+		NL::LedManager::render();
+	}
+
+	NL::Profiler::reset();
+	for (uint32_t i = 0; i < frameCount; i++)
+	{
+		NL::LedManager::render();
+	}
+	NL::Profiler::getStageStatistics(NL::Profiler::Stage::POST_PROCESSING, postProcessing);
+	NL::Profiler::getStageStatistics(NL::Profiler::Stage::ANIMATOR_RAINBOW, animatorRender);
+
+	NL::LedManager::end();
+	NL::Profiler::end();
+	NL::SensorSnapshot::end();
+	NL::Configuration::end();
+	std::filesystem::remove_all(this->workDirectory);
+	return animatorRender.count == frameCount * LED_NUM_ZONES;
+}
+
+/**
+ * @brief Run the separate float passes, which were used before the post-processing was fused.
+ * The brightness was applied by each animator, followed by the power limit, the temperature limit and the power calculation.
+ * @param frameCount number of frames
+ * @param postProcessing time of the passes
+ */
+void PostProcessingBenchmark::runBaseline(const uint32_t frameCount, NL::Profiler::StageStatistics &postProcessing)
+{
+	std::filesystem::create_directories(this->workDirectory);
+	SD.setRoot(this->workDirectory.string());
+	NL::Configuration::begin(&SD, "/benchmark.nlc");
+
+	std::vector<uint8_t> buffer(LED_NUM_ZONES * PostProcessingBenchmark::LEDS_PER_ZONE * 3);
+	std::vector<NL::LedStrip> ledStrips;
+	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		NL::Configuration::LedConfig ledConfig;
+		NL::Configuration::getLedConfig(i, ledConfig);
+		ledConfig.ledCount = PostProcessingBenchmark::LEDS_PER_ZONE;
+		ledConfig.brightness = PostProcessingBenchmark::ZONE_BRIGHTNESS;
+		NL::Configuration::setLedConfig(i, ledConfig);
+
+		ledStrips.push_back(NL::LedStrip(ledConfig.ledPin, ledConfig.ledCount, LED_MAX_COUNT_PER_ZONE));
+		ledStrips.back().setBuffer(buffer.data() + i * PostProcessingBenchmark::LEDS_PER_ZONE * 3);
+	}
+
+	const float regulatorTemperature = PostProcessingBenchmark::getRegulatorTemperature();
+	std::vector<uint32_t> frameTime;
+	uint64_t sum = 0;
+	for (uint32_t frame = 0; frame < PostProcessingBenchmark::WARM_UP_FRAMES + frameCount; frame++)
+	{
+		for (size_t i = 0; i < buffer.size(); i++)
+		{
+			buffer[i] = (i * 7 + frame * 13) & 0xFF;
+		}
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (NL::LedStrip &ledStrip : ledStrips)
+		{
+			PostProcessingBenchmark::applyBrightness(ledStrip, PostProcessingBenchmark::ZONE_BRIGHTNESS / 255.0f);
+		}
+		PostProcessingBenchmark::limitPowerConsumption(ledStrips);
+		PostProcessingBenchmark::limitRegulatorTemperature(ledStrips, regulatorTemperature);
+		float regulatorPower[REGULATOR_COUNT];
+		PostProcessingBenchmark::calculateRegulatorPowerDraw(ledStrips, regulatorPower);
+		const uint32_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+		if (frame >= PostProcessingBenchmark::WARM_UP_FRAMES)
+		{
+			frameTime.push_back(time);
+			sum += time;
+		}
+	}
+
+	std::sort(frameTime.begin(), frameTime.end());
+	postProcessing.count = frameTime.size();
+	postProcessing.min = frameTime.front() / 1000.0f;
+	postProcessing.avg = sum / 1000.0f / frameTime.size();
+	postProcessing.p99 = frameTime.at(frameTime.size() * 99 / 100) / 1000.0f;
+	postProcessing.max = frameTime.back() / 1000.0f;
+
+	NL::Configuration::end();
+	std::filesystem::remove_all(this->workDirectory);
+}
+
+/**
+ * @brief Print one line of the result table.
+ * @param output output stream
+ * @param name name of the stage
+ * @param statistics execution time of the stage
+ */
+void PostProcessingBenchmark::printResult(std::ostream &output, const std::string name, const NL::Profiler::StageStatistics &statistics)
+{
+	output << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1);
+	output << std::setw(10) << statistics.min << std::setw(10) << statistics.avg << std::setw(10) << statistics.p99 << std::setw(10) << statistics.max << std::endl;
+}
+
+/**
+ * @brief Get a regulator temperature half way between the high and the cut off temperature, so the LEDs are dimmed to 50 %.
+ * @return regulator temperature in °C
+ */
+float PostProcessingBenchmark::getRegulatorTemperature()
+{
+	const NL::Configuration::SystemConfig systemConfig = NL::Configuration::getSystemConfig();
+	return (systemConfig.regulatorHighTemperature + systemConfig.regulatorCutoffTemperature) / 2.0f;
+}
+
+/**
+ * @brief Apply the brightness to all pixels, like the animators did before.
+ * @param ledStrip LED strip with the pixel data
+ * @param totalBrightness brightness from 0.0 to 1.0
+ */
+void PostProcessingBenchmark::applyBrightness(NL::LedStrip &ledStrip, const float totalBrightness)
+{
+	for (size_t i = 0; i < ledStrip.getLedCount(); i++)
+	{
+		NL::Pixel pixel = ledStrip.getPixel(i);
+		pixel.red *= totalBrightness;
+		pixel.green *= totalBrightness;
+		pixel.blue *= totalBrightness;
+		ledStrip.setPixel(pixel, i);
+	}
+}
+
+/**
+ * @brief Calculate the total power draw from each regulator, like the LED manager did before.
+ * @param ledStrips LED strips with the pixel data
+ * @param regulatorPower array containing the power draw per regulator after the call
+ */
+void PostProcessingBenchmark::calculateRegulatorPowerDraw(std::vector<NL::LedStrip> &ledStrips, float regulatorPower[REGULATOR_COUNT])
+{
+	for (uint8_t i = 0; i < REGULATOR_COUNT; i++)
+	{
+		regulatorPower[i] = 0.0f;
+	}
+
+	for (size_t i = 0; i < ledStrips.size(); i++)
+	{
+		NL::LedStrip ledStrip = ledStrips.at(i);
+		NL::Configuration::LedConfig ledConfig;
+		NL::Configuration::getLedConfig(i, ledConfig);
+
+		float zoneCurrent = 0.0f;
+		for (size_t j = 0; j < ledStrip.getLedCount(); j++)
+		{
+			zoneCurrent += ledConfig.ledChannelCurrent[0] * ledStrip.getPixel(j).red / 255.0f;
+			zoneCurrent += ledConfig.ledChannelCurrent[1] * ledStrip.getPixel(j).green / 255.0f;
+			zoneCurrent += ledConfig.ledChannelCurrent[2] * ledStrip.getPixel(j).blue / 255.0f;
+		}
+
+		const uint8_t regulatorIndex = PostProcessingBenchmark::getRegulatorIndexFromPin(ledConfig.ledPin);
+		regulatorPower[regulatorIndex] += zoneCurrent * ledConfig.ledVoltage / 1000.0f;
+	}
+}
+
+/**
+ * @brief Limit the power consumption of the current frame, like the LED manager did before.
+ * @param ledStrips LED strips with the pixel data
+ */
+void PostProcessingBenchmark::limitPowerConsumption(std::vector<NL::LedStrip> &ledStrips)
+{
+	float regulatorPower[REGULATOR_COUNT];
+	PostProcessingBenchmark::calculateRegulatorPowerDraw(ledStrips, regulatorPower);
+
+	const NL::Configuration::SystemConfig systemConfig = NL::Configuration::getSystemConfig();
+	for (size_t i = 0; i < ledStrips.size(); i++)
+	{
+		NL::LedStrip ledStrip = ledStrips.at(i);
+		NL::Configuration::LedConfig ledConfig;
+		NL::Configuration::getLedConfig(i, ledConfig);
+
+		const uint8_t regulatorIndex = PostProcessingBenchmark::getRegulatorIndexFromPin(ledConfig.ledPin);
+		float multiplicator = (static_cast<float>(systemConfig.regulatorPowerLimit) / REGULATOR_COUNT) / regulatorPower[regulatorIndex];
+		if (multiplicator < 0.0f)
+		{
+			multiplicator = 0.0f;
+		}
+		else if (multiplicator > 1.0f)
+		{
+			multiplicator = 1.0f;
+		}
+
+		for (size_t j = 0; j < ledStrip.getLedCount(); j++)
+		{
+			NL::Pixel pixel = ledStrip.getPixel(j);
+			pixel.red *= multiplicator;
+			pixel.green *= multiplicator;
+			pixel.blue *= multiplicator;
+			ledStrip.setPixel(pixel, j);
+		}
+	}
+}
+
+/**
+ * @brief Limit the regulator temperature, like the LED manager did before.
+ * @param ledStrips LED strips with the pixel data
+ * @param regulatorTemperature temperature of the regulators in °C
+ */
+void PostProcessingBenchmark::limitRegulatorTemperature(std::vector<NL::LedStrip> &ledStrips, const float regulatorTemperature)
+{
+	float multiplicator = 1.0f - (regulatorTemperature - NL::Configuration::getSystemConfig().regulatorHighTemperature) / (NL::Configuration::getSystemConfig().regulatorCutoffTemperature - NL::Configuration::getSystemConfig().regulatorHighTemperature);
+	if (multiplicator < 0.0f)
+	{
+		multiplicator = 0.0f;
+	}
+	else if (multiplicator > 1.0f)
+	{
+		multiplicator = 1.0f;
+	}
+
+	for (size_t i = 0; i < ledStrips.size(); i++)
+	{
+		NL::LedStrip ledStrip = ledStrips.at(i);
+		for (size_t j = 0; j < ledStrip.getLedCount(); j++)
+		{
+			NL::Pixel pixel = ledStrip.getPixel(j);
+			pixel.red *= multiplicator;
+			pixel.green *= multiplicator;
+			pixel.blue *= multiplicator;
+			ledStrip.setPixel(pixel, j);
+		}
+	}
+}
+
+/**
+ * @brief Get the regulator index by providing the pin number.
+ * @param pin physical pin number
+ * @return regulator index
+ */
+uint8_t PostProcessingBenchmark::getRegulatorIndexFromPin(const uint8_t pin)
+{
+	const uint8_t regulatorMap[LED_NUM_ZONES][2] = REGULATOR_ZONE_MAPPING;
+	for (uint8_t i = 0; i < LED_NUM_ZONES; i++)
+	{
+		if (regulatorMap[i][0] == pin)
+		{
+			return regulatorMap[i][1];
+		}
+	}
+	return 0;
+}
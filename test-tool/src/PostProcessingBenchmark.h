@@ -0,0 +1,62 @@
+/**
+ * @file PostProcessingBenchmark.h
+ * @author TheRealKasumi
+ * @brief Measure the post-processing of the {@link NL::LedManager} and compare it with the separate passes it replaced.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef POST_PROCESSING_BENCHMARK_H
+#define POST_PROCESSING_BENCHMARK_H
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <filesystem>
+
+#include "configuration/SystemConfiguration.h"
+#include "led/driver/LedStrip.h"
+#include "util/Profiler.h"
+
+class PostProcessingBenchmark
+{
+public:
+	PostProcessingBenchmark(const std::filesystem::path workDirectory);
+	~PostProcessingBenchmark();
+
+	bool run(std::ostream &output, const uint32_t frameCount);
+
+private:
+	static const uint16_t LEDS_PER_ZONE = 250;
+	static const uint8_t ZONE_BRIGHTNESS = 200;
+	static const uint32_t WARM_UP_FRAMES = 50;
+
+	std::filesystem::path workDirectory;
+
+	bool runLedManager(const uint32_t frameCount, NL::Profiler::StageStatistics &postProcessing, NL::Profiler::StageStatistics &animatorRender);
+	void runBaseline(const uint32_t frameCount, NL::Profiler::StageStatistics &postProcessing);
+	void printResult(std::ostream &output, const std::string name, const NL::Profiler::StageStatistics &statistics);
+
+	static float getRegulatorTemperature();
+	static void applyBrightness(NL::LedStrip &ledStrip, const float totalBrightness);
+	static void calculateRegulatorPowerDraw(std::vector<NL::LedStrip> &ledStrips, float regulatorPower[REGULATOR_COUNT]);
+	static void limitPowerConsumption(std::vector<NL::LedStrip> &ledStrips);
+	static void limitRegulatorTemperature(std::vector<NL::LedStrip> &ledStrips, const float regulatorTemperature);
+	static uint8_t getRegulatorIndexFromPin(const uint8_t pin);
+};
+
+#endif
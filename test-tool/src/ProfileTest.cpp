@@ -0,0 +1,311 @@
+/**
+ * @file ProfileTest.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the {@link ProfileTest}.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "ProfileTest.h"
+
+#include <SD.h>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Create a new instance of {@link ProfileTest}.
+ * @param workDirectory directory for the configuration files
+ */
+ProfileTest::ProfileTest(const std::filesystem::path workDirectory)
+{
+	this->workDirectory = workDirectory;
+}
+
+/**
+ * @brief Destroy the {@link ProfileTest} instance.
+ */
+ProfileTest::~ProfileTest()
+{
+}
+
+/**
+ * @brief Run all steps with the maximum number of profiles.
+ * Every profile has its own brightness of the first zone, which is compared after each step.
+ * @param output stream for the results
+ * @return true when all steps passed
+ * @return false when a step failed
+ */
+bool ProfileTest::run(std::ostream &output)
+{
+	std::filesystem::remove_all(this->workDirectory);
+	std::filesystem::create_directories(this->workDirectory);
+	SD.setRoot(this->workDirectory.string());
+	NL::Configuration::begin(&SD, CONFIGURATION_FILE_NAME);
+	this->expectedBrightness.clear();
+
+	bool passed = this->report(output, "Create " + std::to_string(CONFIGURATION_MAX_PROFILES) + " profiles with cache evictions", this->createProfiles());
+	passed = passed && this->report(output, "Rename, delete and clone profiles", this->renameDeleteAndClone());
+	passed = passed && this->report(output, "Change profiles while switching between them", this->changeProfiles());
+	passed = passed && this->report(output, "Save and load", this->reload(true));
+	passed = passed && this->report(output, "Load without saving discards the changes", this->reload(false));
+	passed = passed && this->report(output, "A corrupted profile record is reported", this->corruptProfileFile());
+	passed = passed && this->report(output, "A hard reset removes the profiles", this->hardReset());
+
+	NL::Configuration::end();
+	std::filesystem::remove_all(this->workDirectory);
+	return passed;
+}
+
+/**
+ * @brief Fill up the configuration with profiles. Only a few of them fit into the cache, the others are written to the profile file.
+ * @return true when all profiles were created and one more was rejected
+ * @return false when a profile could not be created or differs
+ */
+bool ProfileTest::createProfiles()
+{
+	String profileName;
+	if (NL::Configuration::getProfileNameByIndex(0, profileName) != NL::Configuration::Error::OK || !this->setBrightness(profileName, 0))
+	{
+		return false;
+	}
+
+	for (size_t i = 1; i < CONFIGURATION_MAX_PROFILES; i++)
+	{
+		profileName = String("Profile ") + String(i);
+		if (NL::Configuration::createProfile(profileName) != NL::Configuration::Error::OK || !this->setBrightness(profileName, i))
+		{
+			return false;
+		}
+	}
+
+	return NL::Configuration::createProfile("One Too Many") == NL::Configuration::Error::ERROR_TOO_MANY_PROFILES && this->checkProfiles();
+}
+
+/**
+ * @brief Rename, delete and clone profiles, including the error cases.
+ * @return true when all profiles are as expected
+ * @return false when a profile differs or an error was not reported
+ */
+bool ProfileTest::renameDeleteAndClone()
+{
+	if (NL::Configuration::renameProfile("Profile 5", "Renamed") != NL::Configuration::Error::OK ||
+		NL::Configuration::renameProfile("Profile 7", "Profile 8") != NL::Configuration::Error::ERROR_PROFILE_NAME_EXISTS ||
+		NL::Configuration::renameProfile("Profile 5", "Profile 50") != NL::Configuration::Error::ERROR_PROFILE_NOT_FOUND)
+	{
+		return false;
+	}
+	this->expectedBrightness["Renamed"] = this->expectedBrightness["Profile 5"];
+	this->expectedBrightness.erase("Profile 5");
+
+	if (NL::Configuration::deleteProfile("Profile 6") != NL::Configuration::Error::OK ||
+		NL::Configuration::deleteProfile(NL::Configuration::getActiveProfile()) != NL::Configuration::Error::ERROR_PROFILE_IS_ACTIVE)
+	{
+		return false;
+	}
+	this->expectedBrightness.erase("Profile 6");
+
+	if (NL::Configuration::cloneProfile("Profile 7", "Clone") != NL::Configuration::Error::OK ||
+		NL::Configuration::cloneProfile("Profile 7", "Clone 2") != NL::Configuration::Error::ERROR_TOO_MANY_PROFILES)
+	{
+		return false;
+	}
+	this->expectedBrightness["Clone"] = this->expectedBrightness["Profile 7"];
+
+	return this->checkProfiles();
+}
+
+/**
+ * @brief Activate and change profiles in an order which evicts changed profiles from the cache.
+ * @return true when all profiles are as expected
+ * @return false when a profile could not be changed or differs
+ */
+bool ProfileTest::changeProfiles()
+{
+	for (size_t i = 0; i < 3; i++)
+	{
+		for (size_t j = i; j < CONFIGURATION_MAX_PROFILES; j += 3)
+		{
+			String profileName;
+			if (NL::Configuration::getProfileNameByIndex(j, profileName) != NL::Configuration::Error::OK || !this->setBrightness(profileName, 100 + j + i * 50))
+			{
+				return false;
+			}
+		}
+	}
+	return this->checkProfiles();
+}
+
+/**
+ * @brief Load the configuration again, with or without saving it first.
+ * The first zone of the active profile is changed before, so the change must only be kept when the configuration was saved.
+ * @param save save the configuration before it is loaded
+ * @return true when all profiles and the active profile are as expected
+ * @return false when the configuration could not be loaded or a profile differs
+ */
+bool ProfileTest::reload(const bool save)
+{
+	const String activeProfile = NL::Configuration::getActiveProfile();
+	NL::Configuration::LedConfig ledConfig;
+	if (NL::Configuration::getLedConfig(0, ledConfig) != NL::Configuration::Error::OK)
+	{
+		return false;
+	}
+
+	ledConfig.brightness++;
+	if (NL::Configuration::setLedConfig(0, ledConfig) != NL::Configuration::Error::OK)
+	{
+		return false;
+	}
+
+	if (save)
+	{
+		this->expectedBrightness[activeProfile.c_str()] = ledConfig.brightness;
+		if (NL::Configuration::save() != NL::Configuration::Error::OK)
+		{
+			return false;
+		}
+	}
+
+	NL::Configuration::end();
+	NL::Configuration::begin(&SD, CONFIGURATION_FILE_NAME);
+	return NL::Configuration::load() == NL::Configuration::Error::OK && NL::Configuration::getActiveProfile() == activeProfile && this->checkProfiles();
+}
+
+/**
+ * @brief Flip all bits of the profile file, so the record of the active profile can not be read any more.
+ * @return true when the load reports the corrupted record
+ * @return false when the load succeeded or reported another error
+ */
+bool ProfileTest::corruptProfileFile()
+{
+	NL::Configuration::end();
+	const std::filesystem::path profileFile = this->workDirectory / std::string(CONFIGURATION_PROFILE_FILE_NAME).substr(1);
+	std::ifstream input(profileFile, std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	input.close();
+	for (uint8_t &value : data)
+	{
+		value = ~value;
+	}
+	std::ofstream(profileFile, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), data.size());
+
+	NL::Configuration::begin(&SD, CONFIGURATION_FILE_NAME);
+	return NL::Configuration::load() == NL::Configuration::Error::ERROR_FILE_HASH;
+}
+
+/**
+ * @brief Remove the configuration in the same way as the hard reset of the REST API, then load it again.
+ * No profile record may survive the reset.
+ * @return true when only the default profile is left after the reset
+ * @return false when a file was left or an old profile is still available
+ */
+bool ProfileTest::hardReset()
+{
+	NL::Configuration::discardSave();
+	NL::Configuration::closeProfileFile();
+	SD.remove(CONFIGURATION_TEMP_FILE_NAME);
+	SD.remove(CONFIGURATION_PROFILE_FILE_NAME);
+	SD.remove(CONFIGURATION_FILE_NAME);
+	if (SD.exists(CONFIGURATION_PROFILE_FILE_NAME) || SD.exists(CONFIGURATION_FILE_NAME))
+	{
+		return false;
+	}
+
+	NL::Configuration::end();
+	NL::Configuration::begin(&SD, CONFIGURATION_FILE_NAME);
+	if (NL::Configuration::load() != NL::Configuration::Error::ERROR_FILE_OPEN || NL::Configuration::getProfileCount() != 1)
+	{
+		return false;
+	}
+
+	// The first profile after the reset must not find an old record
+	String profileName;
+	NL::Configuration::Profile profile;
+	return NL::Configuration::createProfile("Profile 1") == NL::Configuration::Error::OK &&
+		   NL::Configuration::save() == NL::Configuration::Error::OK &&
+		   NL::Configuration::getProfileNameByIndex(1, profileName) == NL::Configuration::Error::OK &&
+		   NL::Configuration::getProfile(profileName, profile) == NL::Configuration::Error::OK &&
+		   profile.ledConfig[0].brightness == ANIMATOR_DEFAULT_BRIGHTNESS;
+}
+
+/**
+ * @brief Activate a profile and set the brightness of its first zone.
+ * @param profileName name of the profile
+ * @param brightness brightness of the first zone
+ * @return true when the brightness was set
+ * @return false when the profile could not be activated or changed
+ */
+bool ProfileTest::setBrightness(const String &profileName, const uint8_t brightness)
+{
+	NL::Configuration::LedConfig ledConfig;
+	if (NL::Configuration::setActiveProfile(profileName) != NL::Configuration::Error::OK || NL::Configuration::getLedConfig(0, ledConfig) != NL::Configuration::Error::OK)
+	{
+		return false;
+	}
+
+	ledConfig.brightness = brightness;
+	if (NL::Configuration::setLedConfig(0, ledConfig) != NL::Configuration::Error::OK)
+	{
+		return false;
+	}
+
+	this->expectedBrightness[profileName.c_str()] = brightness;
+	return true;
+}
+
+/**
+ * @brief Compare all profiles of the configuration with the expected profiles.
+ * @return true when the names and the brightness of all profiles are equal
+ * @return false when a profile differs, is missing or could not be read
+ */
+bool ProfileTest::checkProfiles()
+{
+	if (NL::Configuration::getProfileCount() != this->expectedBrightness.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < NL::Configuration::getProfileCount(); i++)
+	{
+		String profileName;
+		NL::Configuration::Profile profile;
+		if (NL::Configuration::getProfileNameByIndex(i, profileName) != NL::Configuration::Error::OK || NL::Configuration::getProfile(profileName, profile) != NL::Configuration::Error::OK)
+		{
+			return false;
+		}
+
+		const std::map<std::string, uint8_t>::const_iterator expected = this->expectedBrightness.find(profileName.c_str());
+		if (expected == this->expectedBrightness.end() || profile.name != profileName || profile.ledConfig[0].brightness != expected->second)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Print the result of a step.
+ * @param output output stream
+ * @param step description of the step
+ * @param passed true when the step passed
+ * @return passed
+ */
+bool ProfileTest::report(std::ostream &output, const std::string step, const bool passed)
+{
+	output << step << ": " << (passed ? "passed" : "failed") << "." << std::endl;
+	return passed;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file ProfileTest.h
+ * @author TheRealKasumi
+ * @brief Check the profile storage of the {@link NL::Configuration} with the maximum number of profiles.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef PROFILE_TEST_H
+#define PROFILE_TEST_H
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <filesystem>
+#include <ostream>
+
+#include "configuration/Configuration.h"
+
+class ProfileTest
+{
+public:
+	ProfileTest(const std::filesystem::path workDirectory);
+	~ProfileTest();
+
+	bool run(std::ostream &output);
+
+private:
+	std::filesystem::path workDirectory;
+	std::map<std::string, uint8_t> expectedBrightness;
+
+	bool createProfiles();
+	bool renameDeleteAndClone();
+	bool changeProfiles();
+	bool reload(const bool save);
+	bool corruptProfileFile();
+	bool hardReset();
+
+	bool setBrightness(const String &profileName, const uint8_t brightness);
+	bool checkProfiles();
+	bool report(std::ostream &output, const std::string step, const bool passed);
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file main.cpp
+ * @author TheRealKasumi
+ * @brief Entry point for the NikoLight Test Tool.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include <stdlib.h>
+#include <iostream>
+#include <filesystem>
+#include <string>
+
+#include "FseqTest.h"
+#include "FseqBenchmark.h"
+#include "DriverBenchmark.h"
+#include "PostProcessingBenchmark.h"
+#include "ConfigurationBenchmark.h"
+#include "ProfileTest.h"
+#include "LogTest.h"
+
+// Function declarations
+void printHeader();
+void printHelp();
+std::filesystem::path createWorkDirectory();
+
+/**
+ * @brief Entry point of the application.
+ * @param argc number of command line arguments
+ * @param argv command line argument
+ * @return int status code, 0 for success or the error code otherwise
+ */
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		printHeader();
+		printHelp();
+		exit(1);
+	}
+
+	printHeader();
+	const std::string command = argv[1];
+	const std::filesystem::path workDirectory = createWorkDirectory();
+	if (workDirectory.empty())
+	{
+		std::cout << "Failed to create the work directory." << std::endl;
+		exit(1);
+	}
+
+	int status = -1;
+	if (command == "fseq" && (argc == 2 || argc == 4))
+	{
+		FseqTest fseqTest(workDirectory);
+		const bool success = argc == 2 ? fseqTest.runSamples(std::cout) : fseqTest.compareFiles(argv[2], argv[3], std::cout);
+		status = success ? 0 : 2;
+	}
+	else if (command == "fseq-benchmark" && (argc == 2 || argc == 3))
+	{
+		FseqBenchmark fseqBenchmark(workDirectory);
+		const uint32_t renderFrames = argc == 3 ? std::stoul(argv[2]) : 600;
+		status = fseqBenchmark.run(std::cout, renderFrames) ? 0 : 2;
+	}
+	else if (command == "driver-benchmark" && (argc == 2 || argc == 3))
+	{
+		DriverBenchmark driverBenchmark;
+		const uint32_t frameCount = argc == 3 ? std::stoul(argv[2]) : 200;
+		status = driverBenchmark.run(std::cout, frameCount) ? 0 : 2;
+	}
+	else if (command == "post-processing-benchmark" && (argc == 2 || argc == 3))
+	{
+		PostProcessingBenchmark postProcessingBenchmark(workDirectory);
+		const uint32_t frameCount = argc == 3 ? std::stoul(argv[2]) : 1000;
+		status = postProcessingBenchmark.run(std::cout, frameCount) ? 0 : 2;
+	}
+	else if (command == "configuration-benchmark" && argc == 2)
+	{
+		ConfigurationBenchmark configurationBenchmark(workDirectory);
+		status = configurationBenchmark.run(std::cout) ? 0 : 2;
+	}
+	else if (command == "profiles" && argc == 2)
+	{
+		ProfileTest profileTest(workDirectory);
+		status = profileTest.run(std::cout) ? 0 : 1;
+	}
+	else if (command == "log" && argc == 2)
+	{
+		LogTest logTest(workDirectory);
+		status = logTest.run(std::cout) ? 0 : 1;
+	}
+
+	std::filesystem::remove_all(workDirectory);
+	if (status < 0)
+	{
+		printHelp();
+		exit(1);
+	}
+	exit(status);
+}
+
+/**
+ * @brief Print the header because we can.
+ */
+void printHeader()
+{
+	std::cout << "NikoLight Test Tool (NLTT)" << std::endl;
+	std::cout << std::endl;
+}
+
+/**
+ * @brief Print the help.
+ */
+void printHelp()
+{
+	std::cout << "This tool runs parts of the controller firmware on the computer to check and measure them." << std::endl
+			  << std::endl;
+	std::cout << "Please call me again with one of the following arguments:" << std::endl;
+	std::cout << "  nltt fseq                                 compare generated fseq v2 files with a v1 export" << std::endl;
+	std::cout << "  nltt fseq <fseq_file> <v1_file>           compare a fseq file with an uncompressed v1 export" << std::endl;
+	std::cout << "  nltt fseq-benchmark [frames]              measure the frame time while a large fseq file plays" << std::endl;
+	std::cout << "  nltt driver-benchmark [frames]            compare the interrupts and CPU time of the LED driver output modes" << std::endl;
+	std::cout << "  nltt post-processing-benchmark [frames]   measure the brightness, power and temperature limiting" << std::endl;
+	std::cout << "  nltt configuration-benchmark              measure saving and loading the maximum number of profiles" << std::endl;
+	std::cout << "  nltt profiles                             check the profile storage with the maximum number of profiles" << std::endl;
+	std::cout << "  nltt log                                  check the binary log file and its rendering as text" << std::endl;
+}
+
+/**
+ * @brief Create a new and empty work directory in the temporary directory.
+ * The name is unique, so several instances can run at the same time.
+ * @return path of the work directory or an empty path when it could not be created
+ */
+std::filesystem::path createWorkDirectory()
+{
+	std::string workDirectory = (std::filesystem::temp_directory_path() / "nltt-XXXXXX").string();
+	if (mkdtemp(workDirectory.data()) == nullptr)
+	{
+		return std::filesystem::path();
+	}
+	return workDirectory;
+}
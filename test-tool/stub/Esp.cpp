@@ -0,0 +1,80 @@
+/**
+ * @file Esp.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the ESP class.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "Esp.h"
+#include "HostSimulation.h"
+
+#include <chrono>
+#include <cstdlib>
+
+EspClass ESP;
+
+EspClass::EspClass()
+{
+}
+
+/**
+ * @brief Get the CPU frequency.
+ * The cycle counter runs with 1 GHz, so one cycle is one ns.
+ * @return always 1000 MHz
+ */
+uint32_t EspClass::getCpuFreqMHz()
+{
+	return 1000;
+}
+
+/**
+ * @brief Get the cycle counter, which is the time of the host in ns.
+ * It always uses the real clock, so the profiler measures the time that is spent on the host.
+ * @return cycle counter
+ */
+uint32_t EspClass::getCycleCount()
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t EspClass::getHeapSize()
+{
+	return HostSimulation::getFreeSize();
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+	return HostSimulation::getFreeSize();
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+	return HostSimulation::getFreeSize();
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+	return HostSimulation::getLargestFreeBlock();
+}
+
+/**
+ * @brief A restart ends the test tool.
+ */
+void EspClass::restart()
+{
+	std::exit(3);
+}
@@ -0,0 +1,43 @@
+/**
+ * @file Esp.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the ESP class of the Arduino core.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef ESP_H
+#define ESP_H
+
+#include <stdint.h>
+
+class EspClass
+{
+public:
+	EspClass();
+
+	uint32_t getCpuFreqMHz();
+	uint32_t getCycleCount();
+	uint32_t getHeapSize();
+	uint32_t getFreeHeap();
+	uint32_t getMinFreeHeap();
+	uint32_t getMaxAllocHeap();
+	void restart();
+};
+
+extern EspClass ESP;
+
+#endif
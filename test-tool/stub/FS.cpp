@@ -0,0 +1,359 @@
+/**
+ * @file FS.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the Arduino file system API.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "FS.h"
+#include "HostSimulation.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <sys/stat.h>
+
+/**
+ * @brief Close the host file when the last {@link fs::File} referencing it is gone.
+ */
+fs::File::Handle::~Handle()
+{
+	if (this->file != nullptr)
+	{
+		std::fclose(this->file);
+	}
+}
+
+/**
+ * @brief Create a closed {@link fs::File}.
+ */
+fs::File::File()
+{
+}
+
+/**
+ * @brief Create a {@link fs::File} from an open handle.
+ * @param handle handle of the host file or directory
+ */
+fs::File::File(std::shared_ptr<Handle> handle)
+{
+	this->handle = handle;
+}
+
+size_t fs::File::write(const uint8_t data)
+{
+	return this->write(&data, 1);
+}
+
+size_t fs::File::write(const uint8_t *buffer, const size_t size)
+{
+	if (!this->handle || this->handle->file == nullptr)
+	{
+		return 0;
+	}
+
+	HostSimulation::simulateSdCardAccess(size);
+	return std::fwrite(buffer, 1, size, this->handle->file);
+}
+
+int fs::File::available()
+{
+	if (!this->handle || this->handle->file == nullptr)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(this->size() - this->position());
+}
+
+int fs::File::read()
+{
+	if (!this->handle || this->handle->file == nullptr)
+	{
+		return -1;
+	}
+
+	const int value = std::fgetc(this->handle->file);
+	return value == EOF ? -1 : value;
+}
+
+int fs::File::peek()
+{
+	const int value = this->read();
+	if (value >= 0)
+	{
+		std::fseek(this->handle->file, -1, SEEK_CUR);
+	}
+	return value;
+}
+
+size_t fs::File::read(uint8_t *buffer, const size_t size)
+{
+	if (!this->handle || this->handle->file == nullptr)
+	{
+		return 0;
+	}
+
+	HostSimulation::simulateSdCardAccess(size);
+	return std::fread(buffer, 1, size, this->handle->file);
+}
+
+size_t fs::File::readBytes(char *buffer, const size_t length)
+{
+	return this->read(reinterpret_cast<uint8_t *>(buffer), length);
+}
+
+void fs::File::flush()
+{
+	if (this->handle && this->handle->file != nullptr)
+	{
+		HostSimulation::simulateSdCardAccess(0);
+		std::fflush(this->handle->file);
+	}
+}
+
+bool fs::File::seek(const uint32_t position, const SeekMode mode)
+{
+	if (!this->handle || this->handle->file == nullptr)
+	{
+		return false;
+	}
+
+	const int origin = mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR
+																	: SEEK_END;
+	if (mode == SeekSet && position > this->size())
+	{
+		return false;
+	}
+	return std::fseek(this->handle->file, position, origin) == 0;
+}
+
+bool fs::File::seek(const uint32_t position)
+{
+	return this->seek(position, SeekSet);
+}
+
+size_t fs::File::position() const
+{
+	if (!this->handle || this->handle->file == nullptr)
+	{
+		return 0;
+	}
+
+	const long position = std::ftell(this->handle->file);
+	return position < 0 ? 0 : static_cast<size_t>(position);
+}
+
+size_t fs::File::size() const
+{
+	if (!this->handle)
+	{
+		return 0;
+	}
+	else if (this->handle->file != nullptr)
+	{
+		std::fflush(this->handle->file);
+	}
+
+	struct stat status;
+	if (stat(this->handle->hostPath.c_str(), &status) != 0 || this->handle->directory)
+	{
+		return 0;
+	}
+	return static_cast<size_t>(status.st_size);
+}
+
+void fs::File::close()
+{
+	this->handle.reset();
+}
+
+fs::File::operator bool() const
+{
+	return this->handle != nullptr;
+}
+
+time_t fs::File::getLastWrite()
+{
+	struct stat status;
+	if (!this->handle || stat(this->handle->hostPath.c_str(), &status) != 0)
+	{
+		return 0;
+	}
+	return status.st_mtime;
+}
+
+const char *fs::File::path() const
+{
+	return this->handle ? this->handle->path.c_str() : nullptr;
+}
+
+const char *fs::File::name() const
+{
+	return this->handle ? this->handle->name.c_str() : nullptr;
+}
+
+bool fs::File::isDirectory()
+{
+	return this->handle && this->handle->directory;
+}
+
+/**
+ * @brief Open the next entry of a directory.
+ * @param mode mode for opening files
+ * @return fs::File next entry or a closed file when there are no more entries
+ */
+fs::File fs::File::openNextFile(const char *mode)
+{
+	if (!this->handle || !this->handle->directory || this->handle->nextEntry >= this->handle->entries.size())
+	{
+		return File();
+	}
+
+	const std::string parent = this->handle->path == "/" ? "" : this->handle->path;
+	const std::string path = parent + "/" + this->handle->entries.at(this->handle->nextEntry++);
+	return FS(this->handle->root).open(path.c_str(), mode);
+}
+
+void fs::File::rewindDirectory()
+{
+	if (this->handle)
+	{
+		this->handle->nextEntry = 0;
+	}
+}
+
+/**
+ * @brief Create a new file system which is backed by a directory of the host.
+ * @param root directory of the host which is used as root of the file system
+ */
+fs::FS::FS(const std::string root)
+{
+	this->root = root;
+}
+
+/**
+ * @brief Open a file or directory.
+ * @param path absolute path of the file or directory
+ * @param mode fopen mode, the binary flag is added automatically
+ * @param create not used
+ * @return fs::File opened file or a closed file when it could not be opened
+ */
+fs::File fs::FS::open(const char *path, const char *mode, const bool create)
+{
+	std::shared_ptr<File::Handle> handle = std::make_shared<File::Handle>();
+	handle->file = nullptr;
+	handle->path = path;
+	handle->name = std::filesystem::path(path).filename().string();
+	handle->hostPath = this->toHostPath(path);
+	handle->directory = std::filesystem::is_directory(handle->hostPath);
+	handle->nextEntry = 0;
+	handle->root = this->root;
+
+	HostSimulation::simulateSdCardAccess(0);
+	if (handle->directory)
+	{
+		if (mode[0] != 'r')
+		{
+			return File();
+		}
+
+		for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(handle->hostPath))
+		{
+			handle->entries.push_back(entry.path().filename().string());
+		}
+		std::sort(handle->entries.begin(), handle->entries.end());
+		return File(handle);
+	}
+
+	std::string hostMode = mode;
+	hostMode.insert(1, "b");
+	handle->file = std::fopen(handle->hostPath.c_str(), hostMode.c_str());
+	return handle->file != nullptr ? File(handle) : File();
+}
+
+fs::File fs::FS::open(const String &path, const char *mode, const bool create)
+{
+	return this->open(path.c_str(), mode, create);
+}
+
+bool fs::FS::exists(const char *path)
+{
+	return std::filesystem::exists(this->toHostPath(path));
+}
+
+bool fs::FS::exists(const String &path)
+{
+	return this->exists(path.c_str());
+}
+
+bool fs::FS::remove(const char *path)
+{
+	const std::string hostPath = this->toHostPath(path);
+	return !std::filesystem::is_directory(hostPath) && std::remove(hostPath.c_str()) == 0;
+}
+
+bool fs::FS::remove(const String &path)
+{
+	return this->remove(path.c_str());
+}
+
+bool fs::FS::rename(const char *pathFrom, const char *pathTo)
+{
+	return std::rename(this->toHostPath(pathFrom).c_str(), this->toHostPath(pathTo).c_str()) == 0;
+}
+
+bool fs::FS::rename(const String &pathFrom, const String &pathTo)
+{
+	return this->rename(pathFrom.c_str(), pathTo.c_str());
+}
+
+bool fs::FS::mkdir(const char *path)
+{
+	std::error_code error;
+	return std::filesystem::create_directory(this->toHostPath(path), error) || std::filesystem::is_directory(this->toHostPath(path));
+}
+
+bool fs::FS::mkdir(const String &path)
+{
+	return this->mkdir(path.c_str());
+}
+
+bool fs::FS::rmdir(const char *path)
+{
+	std::error_code error;
+	return std::filesystem::is_directory(this->toHostPath(path)) && std::filesystem::remove(this->toHostPath(path), error);
+}
+
+bool fs::FS::rmdir(const String &path)
+{
+	return this->rmdir(path.c_str());
+}
+
+const std::string &fs::FS::getRoot() const
+{
+	return this->root;
+}
+
+/**
+ * @brief Map a path of the controller to the directory of the host.
+ * @param path absolute path on the controller
+ * @return std::string path on the host
+ */
+std::string fs::FS::toHostPath(const char *path) const
+{
+	return this->root + (path[0] == '/' ? "" : "/") + path;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file FS.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the Arduino file system API, backed by a directory of the host.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef FS_H
+#define FS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+	enum SeekMode
+	{
+		SeekSet = 0,
+		SeekCur = 1,
+		SeekEnd = 2
+	};
+
+	class File
+	{
+	public:
+		struct Handle
+		{
+			~Handle();
+
+			std::FILE *file;
+			std::string path;
+			std::string name;
+			std::string hostPath;
+			bool directory;
+			std::vector<std::string> entries;
+			size_t nextEntry;
+			std::string root;
+		};
+
+		File();
+		File(std::shared_ptr<Handle> handle);
+
+		size_t write(const uint8_t data);
+		size_t write(const uint8_t *buffer, const size_t size);
+		int available();
+		int read();
+		int peek();
+		size_t read(uint8_t *buffer, const size_t size);
+		size_t readBytes(char *buffer, const size_t length);
+		void flush();
+		bool seek(const uint32_t position, const SeekMode mode);
+		bool seek(const uint32_t position);
+		size_t position() const;
+		size_t size() const;
+		void close();
+		operator bool() const;
+		time_t getLastWrite();
+		const char *path() const;
+		const char *name() const;
+		bool isDirectory();
+		File openNextFile(const char *mode = FILE_READ);
+		void rewindDirectory();
+
+	private:
+		std::shared_ptr<Handle> handle;
+	};
+
+	class FS
+	{
+	public:
+		FS(const std::string root);
+
+		File open(const char *path, const char *mode = FILE_READ, const bool create = false);
+		File open(const String &path, const char *mode = FILE_READ, const bool create = false);
+		bool exists(const char *path);
+		bool exists(const String &path);
+		bool remove(const char *path);
+		bool remove(const String &path);
+		bool rename(const char *pathFrom, const char *pathTo);
+		bool rename(const String &pathFrom, const String &pathTo);
+		bool mkdir(const char *path);
+		bool mkdir(const String &path);
+		bool rmdir(const char *path);
+		bool rmdir(const String &path);
+
+		const std::string &getRoot() const;
+
+	protected:
+		std::string root;
+
+	private:
+		std::string toHostPath(const char *path) const;
+	};
+};
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+#endif
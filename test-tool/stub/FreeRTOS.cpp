@@ -0,0 +1,414 @@
+/**
+ * @file FreeRTOS.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the FreeRTOS task and semaphore API.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/ringbuf.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Task which is executed as thread of the host.
+ * Tasks are never freed because other tasks can still notify them after they ended.
+ */
+struct HostTask
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	uint32_t notificationCount = 0;
+};
+
+/**
+ * @brief Binary, counting and (recursive) mutex semaphores share one implementation.
+ */
+struct HostSemaphore
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	UBaseType_t count = 0;
+	UBaseType_t maxCount = 1;
+	bool recursive = false;
+	std::thread::id owner;
+	UBaseType_t recursion = 0;
+};
+
+/**
+ * @brief No-split ring buffer, every item is allocated on its own.
+ * The used size includes the 8 byte header and the alignment of each item, like the ESP-IDF version.
+ * The space which is lost at the wrap around of the ESP-IDF version is not simulated.
+ */
+struct HostRingbuffer
+{
+	struct Item
+	{
+		std::unique_ptr<uint8_t[]> data;
+		size_t size;
+		bool complete;
+		bool received;
+	};
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<Item> items;
+	size_t bufferSize = 0;
+	size_t usedSize = 0;
+
+	static size_t getStoredSize(const size_t itemSize)
+	{
+		return 8 + ((itemSize + 3) & ~static_cast<size_t>(3));
+	}
+};
+
+namespace
+{
+	std::mutex taskListMutex;
+	std::deque<HostTask> taskList;
+	thread_local HostTask *currentTask = nullptr;
+
+	/**
+	 * @brief Get the task of the calling thread, the main thread gets a task on first use.
+	 * @return HostTask* task of the calling thread
+	 */
+	HostTask *getCurrentTask()
+	{
+		if (currentTask == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(taskListMutex);
+			currentTask = &taskList.emplace_back();
+		}
+		return currentTask;
+	}
+
+	/**
+	 * @brief Wait on a condition with a FreeRTOS timeout.
+	 * @param lock locked mutex of the condition
+	 * @param condition condition to wait for
+	 * @param ticksToWait timeout in ticks
+	 * @param predicate predicate which must become true
+	 * @return true when the predicate is true
+	 * @return false when the timeout expired
+	 */
+	template <typename Predicate>
+	bool waitFor(std::unique_lock<std::mutex> &lock, std::condition_variable &condition, const TickType_t ticksToWait, Predicate predicate)
+	{
+		if (ticksToWait == portMAX_DELAY)
+		{
+			condition.wait(lock, predicate);
+			return true;
+		}
+		return condition.wait_for(lock, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS), predicate);
+	}
+}
+
+void vPortEnterCritical(portMUX_TYPE *mux)
+{
+	while (__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE) != 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void vPortExitCritical(portMUX_TYPE *mux)
+{
+	__atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskFunction, const char *name, const uint32_t stackSize, void *parameter, UBaseType_t priority, TaskHandle_t *taskHandle, const BaseType_t coreId)
+{
+	HostTask *task = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(taskListMutex);
+		task = &taskList.emplace_back();
+	}
+
+	if (taskHandle != nullptr)
+	{
+		*taskHandle = task;
+	}
+
+	std::thread([task, taskFunction, parameter]()
+				{
+					currentTask = task;
+					taskFunction(parameter); })
+		.detach();
+	return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t taskFunction, const char *name, const uint32_t stackSize, void *parameter, UBaseType_t priority, TaskHandle_t *taskHandle)
+{
+	return xTaskCreatePinnedToCore(taskFunction, name, stackSize, parameter, priority, taskHandle, 0);
+}
+
+/**
+ * @brief Tasks on the host end by returning from the task function, so deleting the calling task does nothing.
+ * @param taskHandle task to delete, must be NULL
+ */
+void vTaskDelete(TaskHandle_t taskHandle)
+{
+}
+
+void vTaskDelay(const TickType_t ticks)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCount()
+{
+	static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+	return getCurrentTask();
+}
+
+uint32_t ulTaskNotifyTake(const BaseType_t clearCountOnExit, const TickType_t ticksToWait)
+{
+	HostTask *task = getCurrentTask();
+	std::unique_lock<std::mutex> lock(task->mutex);
+	if (!waitFor(lock, task->condition, ticksToWait, [task]()
+				 { return task->notificationCount > 0; }))
+	{
+		return 0;
+	}
+
+	const uint32_t count = task->notificationCount;
+	task->notificationCount = clearCountOnExit == pdTRUE ? 0 : count - 1;
+	return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t taskHandle)
+{
+	{
+		std::lock_guard<std::mutex> lock(taskHandle->mutex);
+		taskHandle->notificationCount++;
+	}
+	taskHandle->condition.notify_all();
+	return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t taskHandle, BaseType_t *higherPriorityTaskWoken)
+{
+	xTaskNotifyGive(taskHandle);
+	if (higherPriorityTaskWoken != nullptr)
+	{
+		*higherPriorityTaskWoken = pdTRUE;
+	}
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+	return new HostSemaphore();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+	HostSemaphore *semaphore = new HostSemaphore();
+	semaphore->count = 1;
+	return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex()
+{
+	HostSemaphore *semaphore = xSemaphoreCreateMutex();
+	semaphore->recursive = true;
+	return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t maxCount, const UBaseType_t initialCount)
+{
+	HostSemaphore *semaphore = new HostSemaphore();
+	semaphore->count = initialCount;
+	semaphore->maxCount = maxCount;
+	return semaphore;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+	delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, const TickType_t ticksToWait)
+{
+	std::unique_lock<std::mutex> lock(semaphore->mutex);
+	if (!waitFor(lock, semaphore->condition, ticksToWait, [semaphore]()
+				 { return semaphore->count > 0; }))
+	{
+		return pdFALSE;
+	}
+
+	semaphore->count--;
+	semaphore->owner = std::this_thread::get_id();
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+	{
+		std::lock_guard<std::mutex> lock(semaphore->mutex);
+		if (semaphore->count >= semaphore->maxCount)
+		{
+			return pdFALSE;
+		}
+		semaphore->count++;
+	}
+	semaphore->condition.notify_one();
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, const TickType_t ticksToWait)
+{
+	{
+		std::lock_guard<std::mutex> lock(semaphore->mutex);
+		if (semaphore->recursion > 0 && semaphore->owner == std::this_thread::get_id())
+		{
+			semaphore->recursion++;
+			return pdTRUE;
+		}
+	}
+
+	if (xSemaphoreTake(semaphore, ticksToWait) != pdTRUE)
+	{
+		return pdFALSE;
+	}
+
+	std::lock_guard<std::mutex> lock(semaphore->mutex);
+	semaphore->recursion = 1;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore)
+{
+	{
+		std::lock_guard<std::mutex> lock(semaphore->mutex);
+		if (semaphore->recursion == 0 || semaphore->owner != std::this_thread::get_id())
+		{
+			return pdFALSE;
+		}
+		else if (--semaphore->recursion > 0)
+		{
+			return pdTRUE;
+		}
+	}
+	return xSemaphoreGive(semaphore);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *higherPriorityTaskWoken)
+{
+	const BaseType_t result = xSemaphoreGive(semaphore);
+	if (higherPriorityTaskWoken != nullptr)
+	{
+		*higherPriorityTaskWoken = result;
+	}
+	return result;
+}
+
+RingbufHandle_t xRingbufferCreate(const size_t bufferSize, const RingbufferType_t type)
+{
+	RingbufHandle_t ringbuffer = new HostRingbuffer();
+	ringbuffer->bufferSize = bufferSize;
+	return ringbuffer;
+}
+
+void vRingbufferDelete(RingbufHandle_t ringbuffer)
+{
+	delete ringbuffer;
+}
+
+BaseType_t xRingbufferSendAcquire(RingbufHandle_t ringbuffer, void **item, const size_t itemSize, const TickType_t ticksToWait)
+{
+	const size_t storedSize = HostRingbuffer::getStoredSize(itemSize);
+	std::unique_lock<std::mutex> lock(ringbuffer->mutex);
+	if (!waitFor(lock, ringbuffer->condition, ticksToWait, [&]()
+				 { return ringbuffer->usedSize + storedSize <= ringbuffer->bufferSize; }))
+	{
+		return pdFALSE;
+	}
+
+	ringbuffer->items.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[itemSize > 0 ? itemSize : 1]), itemSize, false, false});
+	ringbuffer->usedSize += storedSize;
+	*item = ringbuffer->items.back().data.get();
+	return pdTRUE;
+}
+
+BaseType_t xRingbufferSendComplete(RingbufHandle_t ringbuffer, void *item)
+{
+	std::lock_guard<std::mutex> lock(ringbuffer->mutex);
+	for (HostRingbuffer::Item &entry : ringbuffer->items)
+	{
+		if (entry.data.get() == item)
+		{
+			entry.complete = true;
+			ringbuffer->condition.notify_all();
+			return pdTRUE;
+		}
+	}
+	return pdFALSE;
+}
+
+void *xRingbufferReceive(RingbufHandle_t ringbuffer, size_t *itemSize, const TickType_t ticksToWait)
+{
+	std::unique_lock<std::mutex> lock(ringbuffer->mutex);
+	const auto nextItem = [&]() -> HostRingbuffer::Item *
+	{
+		for (HostRingbuffer::Item &entry : ringbuffer->items)
+		{
+			if (!entry.received)
+			{
+				return entry.complete ? &entry : nullptr;
+			}
+		}
+		return nullptr;
+	};
+
+	if (!waitFor(lock, ringbuffer->condition, ticksToWait, [&]()
+				 { return nextItem() != nullptr; }))
+	{
+		return nullptr;
+	}
+
+	HostRingbuffer::Item *entry = nextItem();
+	entry->received = true;
+	*itemSize = entry->size;
+	return entry->data.get();
+}
+
+void vRingbufferReturnItem(RingbufHandle_t ringbuffer, void *item)
+{
+	std::lock_guard<std::mutex> lock(ringbuffer->mutex);
+	for (std::deque<HostRingbuffer::Item>::iterator entry = ringbuffer->items.begin(); entry != ringbuffer->items.end(); entry++)
+	{
+		if (entry->data.get() == item)
+		{
+			ringbuffer->usedSize -= HostRingbuffer::getStoredSize(entry->size);
+			ringbuffer->items.erase(entry);
+			ringbuffer->condition.notify_all();
+			return;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+/**
+ * @file HardwareSerial.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the serial port.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "HardwareSerial.h"
+
+#include <cstdio>
+
+HardwareSerial Serial;
+
+HardwareSerial::HardwareSerial()
+{
+	this->enabled = false;
+}
+
+void HardwareSerial::begin(const uint32_t baudRate)
+{
+}
+
+/**
+ * @brief Enable or disable the output, which is disabled by default to keep the output of the tests readable.
+ * @param enabled true to write to the standard output
+ */
+void HardwareSerial::setOutput(const bool enabled)
+{
+	this->enabled = enabled;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, const size_t size)
+{
+	return this->enabled ? std::fwrite(buffer, 1, size, stdout) : size;
+}
+
+size_t HardwareSerial::println(const String &line)
+{
+	return this->write(reinterpret_cast<const uint8_t *>(line.c_str()), line.length()) + this->write(reinterpret_cast<const uint8_t *>("\r\n"), 2);
+}
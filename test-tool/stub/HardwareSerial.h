@@ -0,0 +1,46 @@
+/**
+ * @file HardwareSerial.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the serial port, which writes to the standard output.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef HARDWARE_SERIAL_H
+#define HARDWARE_SERIAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "WString.h"
+
+class HardwareSerial
+{
+public:
+	HardwareSerial();
+
+	void begin(const uint32_t baudRate);
+	void setOutput(const bool enabled);
+	size_t write(const uint8_t *buffer, const size_t size);
+	size_t println(const String &line = String());
+
+private:
+	bool enabled;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * @file HostI2S.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the simulated I2S devices, interrupts and pins.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "HostI2S.h"
+#include "esp_intr_alloc.h"
+#include "driver/gpio.h"
+#include "driver/periph_ctrl.h"
+#include "rom/ets_sys.h"
+#include "rom/lldesc.h"
+#include "soc/i2s_reg.h"
+#include "soc/i2s_struct.h"
+#include "soc/io_mux_reg.h"
+
+#include <chrono>
+#include <list>
+
+i2s_dev_t I2S0;
+i2s_dev_t I2S1;
+const uint32_t GPIO_PIN_MUX_REG[40] = {0};
+
+/**
+ * @brief Interrupt which was allocated by a driver.
+ */
+struct HostInterrupt
+{
+	int source;
+	intr_handler_t handler;
+	void *arg;
+	bool enabled;
+};
+
+namespace
+{
+	std::list<HostInterrupt> interrupts;
+
+	/**
+	 * @brief Find the allocated interrupt of an I2S device.
+	 * @param deviceIndex index of the I2S device
+	 * @return HostInterrupt* interrupt or nullptr when none was allocated
+	 */
+	HostInterrupt *findInterrupt(const uint8_t deviceIndex)
+	{
+		for (HostInterrupt &interrupt : interrupts)
+		{
+			if (interrupt.source == ETS_I2S0_INTR_SOURCE + deviceIndex)
+			{
+				return &interrupt;
+			}
+		}
+		return nullptr;
+	}
+}
+
+/**
+ * @brief Send the linked list of DMA descriptors of a started I2S device, like the DMA of the controller does.
+ * The next descriptor is fetched before the interrupt of the current one is raised, so the handler can only change
+ * the link of a descriptor for the next time it is sent.
+ * @param deviceIndex index of the I2S device
+ * @param output all 16 bit words which were sent
+ * @param statistics number of interrupts and time in ns spent in the interrupt handler
+ * @return true when the device was started and the list was sent
+ * @return false when the device was not started or the list did not end
+ */
+bool HostI2S::transmit(const uint8_t deviceIndex, std::vector<uint16_t> &output, Statistics &statistics)
+{
+	i2s_dev_t &device = deviceIndex == 0 ? I2S0 : I2S1;
+	statistics = Statistics{};
+	if (!device.conf.tx_start || !device.out_link.start)
+	{
+		return false;
+	}
+
+	const uint32_t maxDescriptorCount = 1 << 20;
+	lldesc_t *descriptor = reinterpret_cast<lldesc_t *>(static_cast<uintptr_t>(device.out_link.addr));
+	while (descriptor != nullptr && device.conf.tx_start && statistics.descriptorCount < maxDescriptorCount)
+	{
+		const uint16_t *words = reinterpret_cast<const uint16_t *>(const_cast<const uint8_t *>(descriptor->buf));
+		output.insert(output.end(), words, words + descriptor->length / 2);
+		statistics.descriptorCount++;
+
+		lldesc_t *next = descriptor->qe.stqe_next;
+		uint32_t interruptBits = descriptor->eof ? 1 << I2S_OUT_EOF_INT_ST_S : 0;
+		interruptBits |= next == nullptr ? 1 << I2S_OUT_TOTAL_EOF_INT_ST_S : 0;
+		HostI2S::raiseInterrupt(deviceIndex, interruptBits, statistics);
+		descriptor = next;
+	}
+
+	device.out_link.start = 0;
+	return descriptor == nullptr;
+}
+
+/**
+ * @brief Set the raw interrupt bits and call the handler when one of them is enabled.
+ * @param deviceIndex index of the I2S device
+ * @param interruptBits raw interrupt bits
+ * @param statistics number of interrupts and time in ns spent in the interrupt handler
+ */
+void HostI2S::raiseInterrupt(const uint8_t deviceIndex, const uint32_t interruptBits, Statistics &statistics)
+{
+	i2s_dev_t &device = deviceIndex == 0 ? I2S0 : I2S1;
+	device.int_raw.val |= interruptBits;
+	device.int_st.val = device.int_raw.val & device.int_ena.val;
+
+	HostInterrupt *interrupt = findInterrupt(deviceIndex);
+	if (interrupt != nullptr && interrupt->enabled && device.int_st.val != 0)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		interrupt->handler(interrupt->arg);
+		statistics.interruptTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		statistics.interruptCount++;
+	}
+
+	device.int_raw.val &= ~device.int_clr.val;
+	device.int_clr.val = 0;
+	device.int_st.val = device.int_raw.val & device.int_ena.val;
+}
+
+esp_err_t esp_intr_alloc(const int source, const int flags, intr_handler_t handler, void *arg, intr_handle_t *handle)
+{
+	interrupts.push_back({source, handler, arg, (flags & ESP_INTR_FLAG_INTRDISABLED) == 0});
+	*handle = &interrupts.back();
+	return ESP_OK;
+}
+
+esp_err_t esp_intr_free(intr_handle_t handle)
+{
+	interrupts.remove_if([handle](const HostInterrupt &interrupt)
+						 { return &interrupt == handle; });
+	return ESP_OK;
+}
+
+esp_err_t esp_intr_enable(intr_handle_t handle)
+{
+	handle->enabled = true;
+	return ESP_OK;
+}
+
+esp_err_t esp_intr_disable(intr_handle_t handle)
+{
+	handle->enabled = false;
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(const gpio_num_t gpio, const gpio_mode_t mode)
+{
+	return gpio >= 0 && gpio < 40 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+void gpio_matrix_out(const uint32_t gpio, const uint32_t signalIndex, const bool outputInvert, const bool outputEnableInvert)
+{
+}
+
+void periph_module_enable(const periph_module_t periph)
+{
+}
+
+/**
+ * @brief Busy wait like the ROM function, so the time is included in the measured interrupt time.
+ * @param us time in µs
+ */
+void ets_delay_us(const uint32_t us)
+{
+	const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+	while (std::chrono::steady_clock::now() < end)
+	{
+	}
+}
@@ -0,0 +1,45 @@
+/**
+ * @file HostI2S.h
+ * @author TheRealKasumi
+ * @brief Simulate the DMA of the I2S devices and raise their interrupts like the controller does.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef HOST_I2S_H
+#define HOST_I2S_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+class HostI2S
+{
+public:
+	struct Statistics
+	{
+		uint32_t interruptCount;
+		int64_t interruptTime;
+		uint32_t descriptorCount;
+	};
+
+	static bool transmit(const uint8_t deviceIndex, std::vector<uint16_t> &output, Statistics &statistics);
+
+private:
+	static void raiseInterrupt(const uint8_t deviceIndex, const uint32_t interruptBits, Statistics &statistics);
+};
+
+#endif
@@ -0,0 +1,295 @@
+/**
+ * @file HostSimulation.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the simulated clock, heap and MicroSD card behind the host stubs.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "HostSimulation.h"
+#include "Arduino.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp32-hal-psram.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <sys/mman.h>
+
+namespace
+{
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	std::atomic<bool> manualClock(false);
+	std::atomic<int64_t> clockTime(0);
+
+	std::atomic<size_t> freeSize(160 * 1024);
+	std::atomic<size_t> largestFreeBlock(110 * 1024);
+	std::atomic<bool> psram(false);
+
+	std::mutex sdCardMutex;
+	bool sdCardEnabled = false;
+	HostSimulation::SdCardModel sdCardModel;
+	HostSimulation::SdCardStatistics sdCardStatistics;
+	std::mt19937 sdCardRandom;
+
+	std::mutex dmaMutex;
+	std::map<void *, size_t> dmaAllocations;
+}
+
+/**
+ * @brief Let the clock follow the steady clock of the host.
+ */
+void HostSimulation::useRealClock()
+{
+	manualClock = false;
+}
+
+/**
+ * @brief Stop the clock at the given time, it only moves when it is set again.
+ * @param time time in µs
+ */
+void HostSimulation::setClock(const int64_t time)
+{
+	clockTime = time;
+	manualClock = true;
+}
+
+/**
+ * @brief Move the stopped clock forward.
+ * @param time time in µs
+ */
+void HostSimulation::advanceClock(const int64_t time)
+{
+	clockTime += time;
+	manualClock = true;
+}
+
+/**
+ * @brief Get the time of the simulated clock.
+ * @return int64_t time in µs
+ */
+int64_t HostSimulation::getClock()
+{
+	if (manualClock)
+	{
+		return clockTime;
+	}
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/**
+ * @brief Set the heap which is reported by the heap functions. Allocations are not limited.
+ * @param freeSize total free heap in bytes
+ * @param largestFreeBlock largest free block in bytes
+ */
+void HostSimulation::setHeap(const size_t freeSize, const size_t largestFreeBlock)
+{
+	::freeSize = freeSize;
+	::largestFreeBlock = largestFreeBlock;
+}
+
+size_t HostSimulation::getFreeSize()
+{
+	return freeSize;
+}
+
+size_t HostSimulation::getLargestFreeBlock()
+{
+	return largestFreeBlock;
+}
+
+/**
+ * @brief Get the size of all allocations in DMA capable memory.
+ * @return size_t size in bytes
+ */
+size_t HostSimulation::getDmaMemory()
+{
+	std::lock_guard<std::mutex> lock(dmaMutex);
+	size_t size = 0;
+	for (const std::pair<void *const, size_t> &allocation : dmaAllocations)
+	{
+		size += allocation.second;
+	}
+	return size;
+}
+
+void HostSimulation::setPsram(const bool available)
+{
+	psram = available;
+}
+
+bool HostSimulation::getPsram()
+{
+	return psram;
+}
+
+/**
+ * @brief Make every file access take as long as it would on the MicroSD card.
+ * The calling thread sleeps for the simulated time. Stalls are random, but reproducible for the same seed.
+ * @param model timing of the card
+ * @param seed seed for the stalls
+ */
+void HostSimulation::setSdCardModel(const SdCardModel model, const uint32_t seed)
+{
+	std::lock_guard<std::mutex> lock(sdCardMutex);
+	sdCardModel = model;
+	sdCardRandom.seed(seed);
+	sdCardEnabled = true;
+}
+
+/**
+ * @brief Let file accesses run at the speed of the host again.
+ */
+void HostSimulation::disableSdCardModel()
+{
+	std::lock_guard<std::mutex> lock(sdCardMutex);
+	sdCardEnabled = false;
+}
+
+void HostSimulation::resetSdCardStatistics()
+{
+	std::lock_guard<std::mutex> lock(sdCardMutex);
+	sdCardStatistics = SdCardStatistics{};
+}
+
+HostSimulation::SdCardStatistics HostSimulation::getSdCardStatistics()
+{
+	std::lock_guard<std::mutex> lock(sdCardMutex);
+	return sdCardStatistics;
+}
+
+/**
+ * @brief Count a file access and sleep for the simulated time when the card model is enabled.
+ * Accesses are serialized like on the SPI bus.
+ * @param bytes number of transferred bytes
+ */
+void HostSimulation::simulateSdCardAccess(const size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(sdCardMutex);
+	sdCardStatistics.calls++;
+	sdCardStatistics.bytes += bytes;
+	if (!sdCardEnabled)
+	{
+		return;
+	}
+
+	uint64_t time = sdCardModel.accessTime + static_cast<uint64_t>(bytes) * sdCardModel.byteTime / 1000;
+	if (sdCardModel.stallProbability > 0 && sdCardRandom() % sdCardModel.stallProbability == 0)
+	{
+		time += sdCardModel.stallTime;
+		sdCardStatistics.stalls++;
+	}
+	sdCardStatistics.busyTime += time;
+	std::this_thread::sleep_for(std::chrono::microseconds(time));
+}
+
+/**
+ * @brief Get a rough model of a MicroSD card on the 4 MHz SPI bus of the controller.
+ * Stalls are more frequent than on most cards, so the worst case shows up in short runs.
+ * @return HostSimulation::SdCardModel default timing
+ */
+HostSimulation::SdCardModel HostSimulation::getDefaultSdCardModel()
+{
+	SdCardModel model;
+	model.accessTime = 300;
+	model.byteTime = 2500;
+	model.stallProbability = 100;
+	model.stallTime = 40000;
+	return model;
+}
+
+int64_t esp_timer_get_time()
+{
+	return HostSimulation::getClock();
+}
+
+unsigned long millis()
+{
+	return static_cast<unsigned long>(HostSimulation::getClock() / 1000);
+}
+
+unsigned long micros()
+{
+	return static_cast<unsigned long>(HostSimulation::getClock());
+}
+
+void delay(const uint32_t ms)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(const uint32_t us)
+{
+	std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+/**
+ * @brief Allocate memory, DMA capable memory is placed in the lower 2 GB of the address space.
+ * Drivers write the address of DMA descriptors into 32 bit registers, so the simulation must be able to read it back from there.
+ * @param size size in bytes
+ * @param caps capabilities of the memory
+ * @return void* allocated memory or nullptr
+ */
+void *heap_caps_malloc(const size_t size, const uint32_t caps)
+{
+	if ((caps & MALLOC_CAP_DMA) == 0)
+	{
+		return std::malloc(size);
+	}
+
+	void *pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+	if (pointer == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(dmaMutex);
+	dmaAllocations[pointer] = size;
+	return pointer;
+}
+
+void heap_caps_free(void *pointer)
+{
+	std::lock_guard<std::mutex> lock(dmaMutex);
+	const std::map<void *, size_t>::iterator allocation = dmaAllocations.find(pointer);
+	if (allocation == dmaAllocations.end())
+	{
+		std::free(pointer);
+		return;
+	}
+
+	munmap(allocation->first, allocation->second);
+	dmaAllocations.erase(allocation);
+}
+
+size_t heap_caps_get_free_size(const uint32_t caps)
+{
+	return (caps & MALLOC_CAP_SPIRAM) != 0 ? (psram ? 4 * 1024 * 1024 : 0) : freeSize.load();
+}
+
+size_t heap_caps_get_largest_free_block(const uint32_t caps)
+{
+	return (caps & MALLOC_CAP_SPIRAM) != 0 ? (psram ? 4 * 1024 * 1024 : 0) : largestFreeBlock.load();
+}
+
+bool psramFound()
+{
+	return psram;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file HostSimulation.h
+ * @author TheRealKasumi
+ * @brief Control the simulated clock, heap and MicroSD card behind the host stubs.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef HOST_SIMULATION_H
+#define HOST_SIMULATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class HostSimulation
+{
+public:
+	struct SdCardModel
+	{
+		uint32_t accessTime;
+		uint32_t byteTime;
+		uint32_t stallProbability;
+		uint32_t stallTime;
+	};
+
+	struct SdCardStatistics
+	{
+		uint64_t calls;
+		uint64_t bytes;
+		uint64_t stalls;
+		uint64_t busyTime;
+	};
+
+	static void useRealClock();
+	static void setClock(const int64_t time);
+	static void advanceClock(const int64_t time);
+	static int64_t getClock();
+
+	static void setHeap(const size_t freeSize, const size_t largestFreeBlock);
+	static size_t getFreeSize();
+	static size_t getLargestFreeBlock();
+	static size_t getDmaMemory();
+	static void setPsram(const bool available);
+	static bool getPsram();
+
+	static void setSdCardModel(const SdCardModel model, const uint32_t seed = 1);
+	static void disableSdCardModel();
+	static void resetSdCardStatistics();
+	static SdCardStatistics getSdCardStatistics();
+	static void simulateSdCardAccess(const size_t bytes);
+
+	static SdCardModel getDefaultSdCardModel();
+};
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file SD.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the MicroSD card file system.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "SD.h"
+
+SDFS SD;
+
+/**
+ * @brief Create the file system in the working directory.
+ */
+SDFS::SDFS() : fs::FS(".")
+{
+}
+
+/**
+ * @brief Set the directory of the host which is used as root of the file system.
+ * @param root directory of the host
+ */
+void SDFS::setRoot(const std::string root)
+{
+	this->root = root;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file SD.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the MicroSD card file system, backed by a directory of the host.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef SD_H
+#define SD_H
+
+#include <string>
+
+#include "FS.h"
+
+class SDFS : public fs::FS
+{
+public:
+	SDFS();
+
+	void setRoot(const std::string root);
+};
+
+extern SDFS SD;
+
+#endif
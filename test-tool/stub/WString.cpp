@@ -0,0 +1,180 @@
+/**
+ * @file WString.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the Arduino String class.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "WString.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+	/**
+	 * @brief Convert an integer into text with the given base.
+	 * @param value value to convert
+	 * @param negative true when the value is negative
+	 * @param base base between 2 and 36
+	 * @return std::string text representation
+	 */
+	std::string integerToString(unsigned long long value, const bool negative, const unsigned char base)
+	{
+		const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+		const unsigned char radix = base < 2 || base > 36 ? 10 : base;
+		std::string text;
+		do
+		{
+			text.insert(text.begin(), digits[value % radix]);
+			value /= radix;
+		} while (value > 0);
+		return negative ? "-" + text : text;
+	}
+
+	/**
+	 * @brief Convert a floating point number into text.
+	 * @param value value to convert
+	 * @param decimalPlaces number of decimal places
+	 * @return std::string text representation
+	 */
+	std::string floatToString(const double value, const unsigned char decimalPlaces)
+	{
+		char buffer[64];
+		std::snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+		return buffer;
+	}
+}
+
+String::String(const char *cstr) : value(cstr != nullptr ? cstr : "") {}
+String::String(const std::string &str) : value(str) {}
+String::String(const __FlashStringHelper *str) : value(str != nullptr ? reinterpret_cast<const char *>(str) : "") {}
+String::String(const char c) : value(1, c) {}
+String::String(const unsigned char value, const unsigned char base) : value(integerToString(value, false, base)) {}
+String::String(const int value, const unsigned char base) : value(value < 0 && base == 10 ? integerToString(-static_cast<long long>(value), true, base) : integerToString(static_cast<unsigned int>(value), false, base)) {}
+String::String(const unsigned int value, const unsigned char base) : value(integerToString(value, false, base)) {}
+String::String(const long value, const unsigned char base) : value(value < 0 && base == 10 ? integerToString(-static_cast<long long>(value), true, base) : integerToString(static_cast<unsigned long>(value), false, base)) {}
+String::String(const unsigned long value, const unsigned char base) : value(integerToString(value, false, base)) {}
+String::String(const long long value, const unsigned char base) : value(value < 0 && base == 10 ? integerToString(0ULL - static_cast<unsigned long long>(value), true, base) : integerToString(static_cast<unsigned long long>(value), false, base)) {}
+String::String(const unsigned long long value, const unsigned char base) : value(integerToString(value, false, base)) {}
+String::String(const float value, const unsigned char decimalPlaces) : value(floatToString(value, decimalPlaces)) {}
+String::String(const double value, const unsigned char decimalPlaces) : value(floatToString(value, decimalPlaces)) {}
+
+unsigned int String::length() const { return this->value.length(); }
+const char *String::c_str() const { return this->value.c_str(); }
+bool String::isEmpty() const { return this->value.empty(); }
+void String::clear() { this->value.clear(); }
+
+bool String::reserve(const unsigned int size)
+{
+	this->value.reserve(size);
+	return true;
+}
+
+bool String::concat(const String &str)
+{
+	this->value += str.value;
+	return true;
+}
+
+String &String::operator+=(const String &str)
+{
+	this->value += str.value;
+	return *this;
+}
+
+String &String::operator+=(const char *cstr)
+{
+	this->value += cstr != nullptr ? cstr : "";
+	return *this;
+}
+
+String &String::operator+=(const char c)
+{
+	this->value += c;
+	return *this;
+}
+
+bool String::operator==(const String &str) const { return this->value == str.value; }
+bool String::operator==(const char *cstr) const { return this->value == (cstr != nullptr ? cstr : ""); }
+bool String::operator!=(const String &str) const { return !(*this == str); }
+bool String::operator!=(const char *cstr) const { return !(*this == cstr); }
+bool String::operator<(const String &str) const { return this->value < str.value; }
+char String::operator[](const unsigned int index) const { return index < this->value.length() ? this->value[index] : 0; }
+char &String::operator[](const unsigned int index) { return this->value[index]; }
+
+bool String::equals(const String &str) const { return *this == str; }
+bool String::startsWith(const String &prefix) const { return this->value.compare(0, prefix.value.length(), prefix.value) == 0; }
+
+bool String::endsWith(const String &suffix) const
+{
+	return this->value.length() >= suffix.value.length() && this->value.compare(this->value.length() - suffix.value.length(), suffix.value.length(), suffix.value) == 0;
+}
+
+int String::indexOf(const char c, const unsigned int from) const
+{
+	const size_t index = this->value.find(c, from);
+	return index == std::string::npos ? -1 : static_cast<int>(index);
+}
+
+int String::indexOf(const String &str, const unsigned int from) const
+{
+	const size_t index = this->value.find(str.value, from);
+	return index == std::string::npos ? -1 : static_cast<int>(index);
+}
+
+int String::lastIndexOf(const char c) const
+{
+	const size_t index = this->value.rfind(c);
+	return index == std::string::npos ? -1 : static_cast<int>(index);
+}
+
+String String::substring(const unsigned int from) const
+{
+	return from < this->value.length() ? String(this->value.substr(from)) : String();
+}
+
+String String::substring(const unsigned int from, const unsigned int to) const
+{
+	const unsigned int start = from < to ? from : to;
+	const unsigned int end = from < to ? to : from;
+	return start < this->value.length() ? String(this->value.substr(start, end - start)) : String();
+}
+
+long String::toInt() const { return std::strtol(this->value.c_str(), nullptr, 10); }
+float String::toFloat() const { return std::strtof(this->value.c_str(), nullptr); }
+
+String operator+(const String &lhs, const String &rhs)
+{
+	String result(lhs);
+	result += rhs;
+	return result;
+}
+
+String operator+(const String &lhs, const char *rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const __FlashStringHelper *rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const char rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const unsigned char rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const int rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const unsigned int rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const long rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const unsigned long rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const long long rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const unsigned long long rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const float rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const double rhs) { return lhs + String(rhs); }
+String operator+(const char *lhs, const String &rhs) { return String(lhs) + rhs; }
@@ -0,0 +1,103 @@
+/**
+ * @file WString.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the Arduino String class.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef WSTRING_H
+#define WSTRING_H
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class String
+{
+public:
+	String(const char *cstr = "");
+	String(const std::string &str);
+	String(const __FlashStringHelper *str);
+	explicit String(const char c);
+	explicit String(const unsigned char value, const unsigned char base = 10);
+	explicit String(const int value, const unsigned char base = 10);
+	explicit String(const unsigned int value, const unsigned char base = 10);
+	explicit String(const long value, const unsigned char base = 10);
+	explicit String(const unsigned long value, const unsigned char base = 10);
+	explicit String(const long long value, const unsigned char base = 10);
+	explicit String(const unsigned long long value, const unsigned char base = 10);
+	explicit String(const float value, const unsigned char decimalPlaces = 2);
+	explicit String(const double value, const unsigned char decimalPlaces = 2);
+
+	unsigned int length() const;
+	const char *c_str() const;
+	bool isEmpty() const;
+	void clear();
+	bool reserve(const unsigned int size);
+
+	bool concat(const String &str);
+	String &operator+=(const String &str);
+	String &operator+=(const char *cstr);
+	String &operator+=(const char c);
+
+	bool operator==(const String &str) const;
+	bool operator==(const char *cstr) const;
+	bool operator!=(const String &str) const;
+	bool operator!=(const char *cstr) const;
+	bool operator<(const String &str) const;
+	char operator[](const unsigned int index) const;
+	char &operator[](const unsigned int index);
+
+	bool equals(const String &str) const;
+	bool startsWith(const String &prefix) const;
+	bool endsWith(const String &suffix) const;
+	int indexOf(const char c, const unsigned int from = 0) const;
+	int indexOf(const String &str, const unsigned int from = 0) const;
+	int lastIndexOf(const char c) const;
+	String substring(const unsigned int from) const;
+	String substring(const unsigned int from, const unsigned int to) const;
+	long toInt() const;
+	float toFloat() const;
+
+private:
+	std::string value;
+};
+
+String operator+(const String &lhs, const String &rhs);
+String operator+(const String &lhs, const char *rhs);
+String operator+(const String &lhs, const __FlashStringHelper *rhs);
+String operator+(const String &lhs, const char rhs);
+String operator+(const String &lhs, const unsigned char rhs);
+String operator+(const String &lhs, const int rhs);
+String operator+(const String &lhs, const unsigned int rhs);
+String operator+(const String &lhs, const long rhs);
+String operator+(const String &lhs, const unsigned long rhs);
+String operator+(const String &lhs, const long long rhs);
+String operator+(const String &lhs, const unsigned long long rhs);
+String operator+(const String &lhs, const float rhs);
+String operator+(const String &lhs, const double rhs);
+String operator+(const char *lhs, const String &rhs);
+
+#endif
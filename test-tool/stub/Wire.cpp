@@ -0,0 +1,88 @@
+/**
+ * @file Wire.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the IIC bus.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "Wire.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire()
+{
+}
+
+bool TwoWire::begin(const int sdaPin, const int sclPin, const uint32_t frequency)
+{
+	return true;
+}
+
+void TwoWire::beginTransmission(const int address)
+{
+}
+
+/**
+ * @brief End the transmission.
+ * @param sendStop send a stop condition
+ * @return always 2, the address is not acknowledged
+ */
+uint8_t TwoWire::endTransmission(const bool sendStop)
+{
+	return 2;
+}
+
+size_t TwoWire::write(const uint8_t data)
+{
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *buffer, const size_t size)
+{
+	return size;
+}
+
+/**
+ * @brief Request data from a device.
+ * @param address address of the device
+ * @param size number of bytes
+ * @param sendStop send a stop condition
+ * @return always 0, no data is received
+ */
+uint8_t TwoWire::requestFrom(const int address, const int size, const int sendStop)
+{
+	return 0;
+}
+
+int TwoWire::available()
+{
+	return 0;
+}
+
+int TwoWire::read()
+{
+	return -1;
+}
+
+size_t TwoWire::readBytes(uint8_t *buffer, const size_t length)
+{
+	return 0;
+}
+
+void TwoWire::flush()
+{
+}
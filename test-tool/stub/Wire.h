@@ -0,0 +1,47 @@
+/**
+ * @file Wire.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the IIC bus. No devices are connected, every transmission is not acknowledged.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class TwoWire
+{
+public:
+	TwoWire();
+
+	bool begin(const int sdaPin, const int sclPin, const uint32_t frequency);
+	void beginTransmission(const int address);
+	uint8_t endTransmission(const bool sendStop = true);
+	size_t write(const uint8_t data);
+	size_t write(const uint8_t *buffer, const size_t size);
+	uint8_t requestFrom(const int address, const int size, const int sendStop = 1);
+	int available();
+	int read();
+	size_t readBytes(uint8_t *buffer, const size_t length);
+	void flush();
+};
+
+extern TwoWire Wire;
+
+#endif
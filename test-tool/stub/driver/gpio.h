@@ -0,0 +1,40 @@
+/**
+ * @file gpio.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the GPIO driver, pins are not simulated.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_intr_alloc.h"
+
+#define GPIO_MODE_DEF_OUTPUT (1 << 1)
+#define I2S0O_DATA_OUT0_IDX 140
+#define I2S1O_DATA_OUT0_IDX 166
+
+typedef int gpio_num_t;
+typedef int gpio_mode_t;
+
+esp_err_t gpio_set_direction(const gpio_num_t gpio, const gpio_mode_t mode);
+void gpio_matrix_out(const uint32_t gpio, const uint32_t signalIndex, const bool outputInvert, const bool outputEnableInvert);
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file periph_ctrl.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the peripheral clock control.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef PERIPH_CTRL_H
+#define PERIPH_CTRL_H
+
+typedef enum
+{
+	PERIPH_I2S0_MODULE,
+	PERIPH_I2S1_MODULE
+} periph_module_t;
+
+void periph_module_enable(const periph_module_t periph);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file miniz.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the tinfl decompressor in the ROM of the ESP32, backed by zlib.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef MINIZ_H
+#define MINIZ_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum
+{
+	TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+	TINFL_FLAG_HAS_MORE_INPUT = 2,
+	TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+	TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum
+{
+	TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS = -4,
+	TINFL_STATUS_BAD_PARAM = -3,
+	TINFL_STATUS_ADLER32_MISMATCH = -2,
+	TINFL_STATUS_FAILED = -1,
+	TINFL_STATUS_DONE = 0,
+	TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+	TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+/**
+ * @brief Unlike the ROM implementation, zlib keeps its own window and does not read back from the output buffer.
+ * To still catch callers which modify the wrapping dictionary, the written output is kept and compared on every call.
+ */
+struct tinfl_decompressor
+{
+	tinfl_decompressor();
+	~tinfl_decompressor();
+
+	z_stream stream;
+	bool initialized;
+	bool started;
+	uint8_t history[TINFL_LZ_DICT_SIZE];
+	size_t outputCount;
+};
+
+#define tinfl_init(r) ((r)->started = false, (r)->outputCount = 0)
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *inputBuffer, size_t *inputSize, uint8_t *outputStart, uint8_t *outputNext, size_t *outputSize, const uint32_t flags);
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file esp_intr_alloc.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the ESP interrupt allocation, interrupts are raised by the simulated peripherals.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef ESP_INTR_ALLOC_H
+#define ESP_INTR_ALLOC_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+#define ESP_INTR_FLAG_LEVEL2 (1 << 2)
+#define ESP_INTR_FLAG_LEVEL3 (1 << 3)
+#define ESP_INTR_FLAG_IRAM (1 << 10)
+#define ESP_INTR_FLAG_INTRDISABLED (1 << 11)
+
+typedef void (*intr_handler_t)(void *arg);
+typedef struct HostInterrupt *intr_handle_t;
+
+esp_err_t esp_intr_alloc(const int source, const int flags, intr_handler_t handler, void *arg, intr_handle_t *handle);
+esp_err_t esp_intr_free(intr_handle_t handle);
+esp_err_t esp_intr_enable(intr_handle_t handle);
+esp_err_t esp_intr_disable(intr_handle_t handle);
+
+#endif
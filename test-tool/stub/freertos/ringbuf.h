@@ -0,0 +1,43 @@
+/**
+ * @file ringbuf.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the no-split ring buffer of the ESP-IDF.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef RINGBUF_H
+#define RINGBUF_H
+
+#include <stddef.h>
+
+#include "freertos/FreeRTOS.h"
+
+typedef enum
+{
+	RINGBUF_TYPE_NOSPLIT = 0
+} RingbufferType_t;
+
+typedef struct HostRingbuffer *RingbufHandle_t;
+
+RingbufHandle_t xRingbufferCreate(const size_t bufferSize, const RingbufferType_t type);
+void vRingbufferDelete(RingbufHandle_t ringbuffer);
+BaseType_t xRingbufferSendAcquire(RingbufHandle_t ringbuffer, void **item, const size_t itemSize, const TickType_t ticksToWait);
+BaseType_t xRingbufferSendComplete(RingbufHandle_t ringbuffer, void *item);
+void *xRingbufferReceive(RingbufHandle_t ringbuffer, size_t *itemSize, const TickType_t ticksToWait);
+void vRingbufferReturnItem(RingbufHandle_t ringbuffer, void *item);
+
+#endif
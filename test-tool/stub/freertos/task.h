@@ -0,0 +1,40 @@
+/**
+ * @file task.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the FreeRTOS task API, tasks run as threads of the host.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef TASK_H
+#define TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+typedef struct HostTask *TaskHandle_t;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskFunction, const char *name, const uint32_t stackSize, void *parameter, UBaseType_t priority, TaskHandle_t *taskHandle, const BaseType_t coreId);
+BaseType_t xTaskCreate(TaskFunction_t taskFunction, const char *name, const uint32_t stackSize, void *parameter, UBaseType_t priority, TaskHandle_t *taskHandle);
+void vTaskDelete(TaskHandle_t taskHandle);
+void vTaskDelay(const TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+uint32_t ulTaskNotifyTake(const BaseType_t clearCountOnExit, const TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t taskHandle);
+void vTaskNotifyGiveFromISR(TaskHandle_t taskHandle, BaseType_t *higherPriorityTaskWoken);
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file miniz.cpp
+ * @author TheRealKasumi
+ * @brief Implementation of the host replacement of the tinfl decompressor.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#include "esp32/rom/miniz.h"
+
+#include <cstring>
+
+tinfl_decompressor::tinfl_decompressor()
+{
+	std::memset(&this->stream, 0, sizeof(this->stream));
+	this->initialized = false;
+	this->started = false;
+	this->outputCount = 0;
+}
+
+tinfl_decompressor::~tinfl_decompressor()
+{
+	if (this->initialized)
+	{
+		inflateEnd(&this->stream);
+	}
+}
+
+/**
+ * @brief Decompress the next part of a deflate stream like the tinfl decompressor does with a wrapping output buffer.
+ * @param r decompressor which was initialized with tinfl_init
+ * @param inputBuffer compressed input
+ * @param inputSize size of the input, set to the number of consumed bytes
+ * @param outputStart start of the output buffer
+ * @param outputNext position in the output buffer
+ * @param outputSize free bytes after the position, set to the number of written bytes
+ * @param flags TINFL_FLAG_PARSE_ZLIB_HEADER and TINFL_FLAG_HAS_MORE_INPUT are supported
+ * @return tinfl_status status of the stream
+ */
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *inputBuffer, size_t *inputSize, uint8_t *outputStart, uint8_t *outputNext, size_t *outputSize, const uint32_t flags)
+{
+	if (!r->started)
+	{
+		if (r->initialized)
+		{
+			inflateEnd(&r->stream);
+		}
+
+		std::memset(&r->stream, 0, sizeof(r->stream));
+		r->initialized = inflateInit2(&r->stream, (flags & TINFL_FLAG_PARSE_ZLIB_HEADER) != 0 ? 15 : -15) == Z_OK;
+		r->started = r->initialized;
+		if (!r->initialized)
+		{
+			return TINFL_STATUS_BAD_PARAM;
+		}
+	}
+
+	// The ROM implementation reads back references from the dictionary, so it must be continued where it was left unmodified
+	const size_t dictionaryOffset = r->outputCount & (TINFL_LZ_DICT_SIZE - 1);
+	const size_t historySize = r->outputCount < TINFL_LZ_DICT_SIZE ? r->outputCount : TINFL_LZ_DICT_SIZE;
+	if (outputNext != outputStart + dictionaryOffset || dictionaryOffset + *outputSize > TINFL_LZ_DICT_SIZE || std::memcmp(outputStart, r->history, historySize) != 0)
+	{
+		return TINFL_STATUS_BAD_PARAM;
+	}
+
+	const size_t availableInput = *inputSize;
+	const size_t availableOutput = *outputSize;
+	r->stream.next_in = const_cast<Bytef *>(inputBuffer);
+	r->stream.avail_in = static_cast<uInt>(availableInput);
+	r->stream.next_out = outputNext;
+	r->stream.avail_out = static_cast<uInt>(availableOutput);
+	const int result = inflate(&r->stream, Z_NO_FLUSH);
+	*inputSize = availableInput - r->stream.avail_in;
+	*outputSize = availableOutput - r->stream.avail_out;
+	std::memcpy(r->history + dictionaryOffset, outputNext, *outputSize);
+	r->outputCount += *outputSize;
+
+	if (result == Z_STREAM_END)
+	{
+		return TINFL_STATUS_DONE;
+	}
+	else if (result != Z_OK && result != Z_BUF_ERROR)
+	{
+		return result == Z_DATA_ERROR ? TINFL_STATUS_FAILED : TINFL_STATUS_BAD_PARAM;
+	}
+	else if (r->stream.avail_out == 0)
+	{
+		return TINFL_STATUS_HAS_MORE_OUTPUT;
+	}
+	else if (r->stream.avail_in == 0)
+	{
+		return (flags & TINFL_FLAG_HAS_MORE_INPUT) != 0 ? TINFL_STATUS_NEEDS_MORE_INPUT : TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+	}
+	return TINFL_STATUS_FAILED;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file ets_sys.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the ROM system functions of the ESP32.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef ETS_SYS_H
+#define ETS_SYS_H
+
+#include <stdint.h>
+
+#include "esp_attr.h"
+
+#define ETS_I2S0_INTR_SOURCE 32
+#define ETS_I2S1_INTR_SOURCE 33
+
+void ets_delay_us(const uint32_t us);
+
+#endif
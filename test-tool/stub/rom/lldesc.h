@@ -0,0 +1,46 @@
+/**
+ * @file lldesc.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the linked list DMA descriptor of the ESP32.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef LLDESC_H
+#define LLDESC_H
+
+#include <stdint.h>
+
+typedef struct lldesc_s
+{
+	volatile uint32_t size : 12,
+		length : 12,
+		offset : 5,
+		sosf : 1,
+		eof : 1,
+		owner : 1;
+	volatile const uint8_t *buf;
+	union
+	{
+		volatile uint32_t empty;
+		struct
+		{
+			struct lldesc_s *stqe_next;
+		} qe;
+	};
+} lldesc_t;
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file i2s_reg.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the I2S register definitions, the registers are mapped to the simulated devices.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef I2S_REG_H
+#define I2S_REG_H
+
+#include <stdint.h>
+
+#include "soc/i2s_struct.h"
+
+#define REG_READ(reg) (*(reg))
+#define REG_WRITE(reg, value) (*(reg) = (value))
+#define GET_PERI_REG_BITS(reg, bitMap, shift) ((REG_READ(reg) >> (shift)) & (bitMap))
+
+#define I2S_INT_RAW_REG(i) (&((i) == 0 ? I2S0 : I2S1).int_raw.val)
+#define I2S_INT_ST_REG(i) (&((i) == 0 ? I2S0 : I2S1).int_st.val)
+#define I2S_INT_CLR_REG(i) (&((i) == 0 ? I2S0 : I2S1).int_clr.val)
+
+#define I2S_OUT_EOF_INT_ST_V 0x1
+#define I2S_OUT_EOF_INT_ST_S 12
+#define I2S_OUT_TOTAL_EOF_INT_ST_V 0x1
+#define I2S_OUT_TOTAL_EOF_INT_ST_S 16
+
+#define I2S_TX_RESET_M (1 << 0)
+#define I2S_RX_RESET_M (1 << 1)
+#define I2S_TX_FIFO_RESET_M (1 << 2)
+#define I2S_RX_FIFO_RESET_M (1 << 3)
+
+#define I2S_IN_RST_M (1 << 0)
+#define I2S_OUT_RST_M (1 << 1)
+#define I2S_AHBM_FIFO_RST_M (1 << 2)
+#define I2S_AHBM_RST_M (1 << 3)
+#define I2S_OUTDSCR_BURST_EN (1 << 10)
+#define I2S_OUT_DATA_BURST_EN (1 << 11)
+
+#endif
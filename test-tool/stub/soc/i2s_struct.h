@@ -0,0 +1,183 @@
+/**
+ * @file i2s_struct.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the I2S registers, only the fields used by the LED driver are available.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef I2S_STRUCT_H
+#define I2S_STRUCT_H
+
+#include <stdint.h>
+
+typedef union
+{
+	struct
+	{
+		uint32_t rx_take_data : 1;
+		uint32_t tx_put_data : 1;
+		uint32_t rx_wfull : 1;
+		uint32_t rx_rempty : 1;
+		uint32_t tx_wfull : 1;
+		uint32_t tx_rempty : 1;
+		uint32_t rx_hung : 1;
+		uint32_t tx_hung : 1;
+		uint32_t in_done : 1;
+		uint32_t in_suc_eof : 1;
+		uint32_t in_err_eof : 1;
+		uint32_t out_done : 1;
+		uint32_t out_eof : 1;
+		uint32_t in_dscr_err : 1;
+		uint32_t out_dscr_err : 1;
+		uint32_t in_dscr_empty : 1;
+		uint32_t out_total_eof : 1;
+		uint32_t reserved17 : 15;
+	};
+	uint32_t val;
+} i2s_int_reg_t;
+
+typedef struct
+{
+	union
+	{
+		struct
+		{
+			uint32_t tx_reset : 1;
+			uint32_t rx_reset : 1;
+			uint32_t tx_fifo_reset : 1;
+			uint32_t rx_fifo_reset : 1;
+			uint32_t tx_start : 1;
+			uint32_t rx_start : 1;
+			uint32_t tx_slave_mod : 1;
+			uint32_t tx_right_first : 1;
+			uint32_t reserved8 : 24;
+		};
+		uint32_t val;
+	} conf;
+	i2s_int_reg_t int_raw;
+	i2s_int_reg_t int_st;
+	i2s_int_reg_t int_ena;
+	i2s_int_reg_t int_clr;
+	union
+	{
+		uint32_t val;
+	} timing;
+	union
+	{
+		struct
+		{
+			uint32_t rx_data_num : 6;
+			uint32_t tx_data_num : 6;
+			uint32_t dscr_en : 1;
+			uint32_t tx_fifo_mod : 3;
+			uint32_t rx_fifo_mod : 3;
+			uint32_t tx_fifo_mod_force_en : 1;
+			uint32_t rx_fifo_mod_force_en : 1;
+			uint32_t reserved21 : 11;
+		};
+		uint32_t val;
+	} fifo_conf;
+	union
+	{
+		struct
+		{
+			uint32_t tx_chan_mod : 3;
+			uint32_t rx_chan_mod : 2;
+			uint32_t reserved5 : 27;
+		};
+		uint32_t val;
+	} conf_chan;
+	// The address has 20 bits on the controller, the simulation needs the full address of the descriptor
+	struct
+	{
+		uint32_t addr;
+		uint32_t stop : 1;
+		uint32_t start : 1;
+		uint32_t restart : 1;
+		uint32_t park : 1;
+	} out_link;
+	union
+	{
+		struct
+		{
+			uint32_t in_rst : 1;
+			uint32_t out_rst : 1;
+			uint32_t ahbm_fifo_rst : 1;
+			uint32_t ahbm_rst : 1;
+			uint32_t reserved4 : 28;
+		};
+		uint32_t val;
+	} lc_conf;
+	union
+	{
+		struct
+		{
+			uint32_t tx_pcm_conf : 3;
+			uint32_t tx_pcm_bypass : 1;
+			uint32_t rx_pcm_conf : 3;
+			uint32_t rx_pcm_bypass : 1;
+			uint32_t tx_stop_en : 1;
+			uint32_t tx_zeros_rm_en : 1;
+			uint32_t reserved10 : 22;
+		};
+		uint32_t val;
+	} conf1;
+	union
+	{
+		struct
+		{
+			uint32_t camera_en : 1;
+			uint32_t lcd_tx_wrx2_en : 1;
+			uint32_t lcd_tx_sdx2_en : 1;
+			uint32_t data_enable_test_en : 1;
+			uint32_t data_enable : 1;
+			uint32_t lcd_en : 1;
+			uint32_t reserved6 : 26;
+		};
+		uint32_t val;
+	} conf2;
+	union
+	{
+		struct
+		{
+			uint32_t clkm_div_num : 8;
+			uint32_t clkm_div_b : 6;
+			uint32_t clkm_div_a : 6;
+			uint32_t clk_en : 1;
+			uint32_t clka_en : 1;
+			uint32_t reserved22 : 10;
+		};
+		uint32_t val;
+	} clkm_conf;
+	union
+	{
+		struct
+		{
+			uint32_t tx_bck_div_num : 6;
+			uint32_t rx_bck_div_num : 6;
+			uint32_t tx_bits_mod : 6;
+			uint32_t rx_bits_mod : 6;
+			uint32_t reserved24 : 8;
+		};
+		uint32_t val;
+	} sample_rate_conf;
+} i2s_dev_t;
+
+extern i2s_dev_t I2S0;
+extern i2s_dev_t I2S1;
+
+#endif
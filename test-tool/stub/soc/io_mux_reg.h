@@ -0,0 +1,32 @@
+/**
+ * @file io_mux_reg.h
+ * @author TheRealKasumi
+ * @brief Host replacement of the IO MUX registers, pin functions are ignored on the host.
+ *
+ * @copyright Copyright (c) 2023 TheRealKasumi
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+ */
+#ifndef IO_MUX_REG_H
+#define IO_MUX_REG_H
+
+#include <stdint.h>
+
+#define PIN_FUNC_GPIO 2
+#define PIN_FUNC_SELECT(PIN_NAME, FUNC) ((void)(PIN_NAME), (void)(FUNC))
+
+extern const uint32_t GPIO_PIN_MUX_REG[40];
+
+#endif